@@ -4,11 +4,24 @@
 #include <cassert>
 #include <conio.h>
 #include <sstream>
+#include <chrono>
 
 #include <cctype>
 
 #include "mcu_trace.hpp"
 #include "mcu_core.hpp"
+#include "mcu_aot.hpp"
+#include "mcu_devices.hpp"
+#include "mcu_bus.hpp"
+#include "mcu_execute.hpp"
+#include "mcu_fleet.hpp"
+#include "mcu_lockstep.hpp"
+#include "mcu_savestate.hpp"
+#include "mcu_rewind.hpp"
+#include "mcu_textlog.hpp"
+#include "mcu_branchtrace.hpp"
+
+#include <fstream>
 
 struct tHexFormat
 {
@@ -46,10 +59,41 @@ void printDisassembly( tMCUState& rState, uint16_t memPos, unsigned totalInstruc
     }
 }
 
+//   Prints the last instructions from mcu's history, oldest first, each with the registers it started with.  The
+// disassembly is of memory as it is now.
+void printHistory( tMCUState& mcu, unsigned totalInstructions )
+{
+    tMCUState::tHistoryEntry entries[tMCUState::cHistorySize];
+    unsigned entryCount = mcu.getHistory( entries, std::min( totalInstructions, tMCUState::cHistorySize ) );
+
+    for( unsigned entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        const tMCUState::tHistoryEntry& rEntry = entries[entryIndex];
+        tMCURegisters registers = rEntry.getRegisters();
+
+        std::ostringstream disassembly;
+        if( mcu.memReadByte( registers.regPC ) == rEntry.getOpCode() )
+            disassembly << mcu.decodeFullOpcode( registers.regPC );
+        else
+            disassembly << "(was opcode " << tHexFormat( rEntry.getOpCode() ) << ")";
+
+        std::cout << "  " << tHexFormat( registers.regPC ) << " : " << std::left << std::setw( 20 ) << std::setfill( ' ' ) << disassembly.str() << std::right
+            << "A=" << tHexFormat( registers.regA ) << " X=" << tHexFormat( registers.regX ) << " Y=" << tHexFormat( registers.regY )
+            << " S=" << tHexFormat( registers.regSP ) << " P=" << tHexFormat( registers.regP );
+
+        if( rEntry.m_translated )
+            std::cout << "  + translated code, " << std::dec << rEntry.m_count << " instructions";
+        else if( rEntry.m_count > 1 )
+            std::cout << "  x " << std::dec << rEntry.m_count;
+
+        std::cout << std::endl;
+    }
+}
+
 void printState( tMCUState& mcu )
 {
     std::cout
-        << "A=" << tHexFormat( mcu.regA ) << "  X=" << tHexFormat( mcu.regX ) << "  Y=" << tHexFormat( mcu.regY ) << "  S=" << tHexFormat( mcu.regSP ) << "  PC=" << tHexFormat( mcu.regPC ) << std::endl
+        << "A=" << tHexFormat( mcu.regA ) << "  X=" << tHexFormat( mcu.regX ) << "  Y=" << tHexFormat( mcu.regY ) << "  S=" << tHexFormat( mcu.regSP ) << "  PC=" << tHexFormat( mcu.regPC ) << "  Cycles=" << std::dec << mcu.getCycleCount() << std::endl
         << "P=" << tHexFormat( mcu.regP ) << "  ";
 
     const char *pFlagNames[] = { "C", "Z", "I", "D", "B", "X", "V", "N" };
@@ -71,14 +115,914 @@ void printState( tMCUState& mcu )
     flag_N = 0x80, // Negative*/
 }
 
+// The board's devices, other than the serial port
+tMCULcd g_lcd;
+tMCUKeypad g_keypad;
+tMCUBankSelect g_bankSelect;
+
 void load_rom( uint8_t *pMemory );
 void load_brk( uint8_t *pMemory );
 
+// Where load_rom() puts the ROM
+const uint16_t cRomStart    = 0xE800;
+const uint16_t cRomEnd      = 0xF9CF;
+
+// Clears memory, and then loads the ROM, BRK handler, and vectors
+void initMemory( uint8_t *pMemory )
+{
+    memset( pMemory, 0, 65536 );
+
+    load_rom( pMemory );
+    load_brk( pMemory );
+	pMemory[0xFFFC] = 0x00;	//RESET vector
+	pMemory[0xFFFD] = 0xE8;
+	pMemory[0xFFFE] = 0x00;	//IRQ(BRK) vector
+	pMemory[0xFFFF] = 0x10;
+}
+
+const char *execEngineName( eExecEngine engine )
+{
+    switch( engine )
+    {
+    case engine_Switch:     return "switch";
+    case engine_Threaded:   return "threaded";
+    case engine_BlockCache: return "blocks";
+    case engine_Jit:        return "jit";
+    case engine_JitVerify:  return "jitverify";
+    case engine_Aot:        return "aot";
+    }
+
+    return "?";
+}
+
+// Typed in over and over by the benchmarks, so that the time goes on dumping, moving and disassembling memory
+// through the ROM's zero page pointers rather than on waiting for input
+const char cBenchmarkCommands[] = "E800.F9CF\rE800.F9CF>2000M\r2000.31CF\rE800L\r";
+
+// History kept for the debugger to step back through - a checkpoint every cHistoryInterval instructions
+const unsigned cHistoryCheckpoints = 256;
+const uint64_t cHistoryInterval = 10000;
+
+#ifdef NDEBUG
+const size_t cDefaultHistorySize = 0;
+#else
+const size_t cDefaultHistorySize = 1 << 20;
+#endif
+
+// Types the next benchmark command byte into the MCU if it's ready for one, and throws away whatever it's sent
+static void feedBenchmarkLane( tMCUState& rState, unsigned& rCommandPos )
+{
+    if( rState.serialToMCUEmpty() )
+    {
+        rState.serialToMCUPushByte( cBenchmarkCommands[rCommandPos] );
+        rCommandPos = (rCommandPos + 1) % (sizeof(cBenchmarkCommands) - 1);
+    }
+
+    while( !rState.serialFromMCUEmpty() )
+        rState.serialFromMCUPopByte();
+}
+
+//   Runs instructions of the benchmark on rState, typing in the commands from rCommandPos.  With a quantum, the
+// next byte is only typed in at the start of each quantum, so that two ways of running it see the input at the
+// same instructions - otherwise it's typed in whenever the run loop comes back (e.g. with serial output).
+static void runBenchmark( tMCUState& rState, unsigned& rCommandPos, uint64_t instructions, uint64_t quantum = 0 )
+{
+    for( uint64_t done = 0; done < instructions; done += (quantum ? quantum : instructions) )
+    {
+        feedBenchmarkLane( rState, rCommandPos );
+
+        uint64_t remaining = quantum ? std::min( quantum, instructions - done ) : instructions;
+        while( remaining > 0 )
+        {
+            remaining -= rState.runInstructions( remaining ).m_instructions;
+            if( !quantum && remaining > 0 )
+                feedBenchmarkLane( rState, rCommandPos );
+        }
+    }
+}
+
+//   The ROM from reset on memory of its own, with the benchmark commands typed in from commandPos - what the
+// benchmarks and checks start from.  Two of them run the same way end up in the same state (see sameState()).
+class tBenchmarkMCU
+{
+public:
+    explicit tBenchmarkMCU( eExecEngine engine = engine_Switch, bool lazyFlags = false, unsigned commandPos = 0 )
+        : m_memory( 65536 )
+        , m_state( bootMemory( m_memory ) )
+        , m_commandPos( commandPos )
+    {
+        m_state.setExecEngine( engine );
+        m_state.setLazyFlags( lazyFlags );
+        m_state.setAotBlocks( g_romAotBlocks, g_romAotBlockCount );
+    }
+
+    tMCUState& getState() { return m_state; }
+    const uint8_t *getMemory() const { return &m_memory[0]; }
+
+    // Types the next command byte in if the ROM is ready for it, and throws its output away
+    void feed() { feedBenchmarkLane( m_state, m_commandPos ); }
+
+    // As runBenchmark()
+    void run( uint64_t instructions, uint64_t quantum = 0 ) { runBenchmark( m_state, m_commandPos, instructions, quantum ); }
+
+    // Starts typing the commands again from commandPos
+    void restartCommands( unsigned commandPos = 0 ) { m_commandPos = commandPos; }
+
+private:
+    tBenchmarkMCU( const tBenchmarkMCU& ); // Disallowed
+
+    static uint8_t *bootMemory( std::vector< uint8_t >& rMemory )
+    {
+        initMemory( &rMemory[0] );
+        return &rMemory[0];
+    }
+
+    std::vector< uint8_t >  m_memory;
+    tMCUState               m_state; // On m_memory
+    unsigned                m_commandPos;
+};
+
+// The engines that -b and -w go through in turn
+const struct { eExecEngine m_engine; bool m_lazyFlags; } cBenchmarkEngines[] =
+{
+    { engine_Switch, false }, { engine_Switch, true }, { engine_Threaded, false }, { engine_Threaded, true },
+    { engine_BlockCache, false }, { engine_Jit, false }, { engine_Aot, false },
+};
+
+const unsigned cBenchmarkEngineCount = sizeof(cBenchmarkEngines) / sizeof(cBenchmarkEngines[0]);
+
+// Runs the ROM from reset on each engine in turn, and reports how many millions of instructions per second each managed
+// With historySize, each engine is run with that much history being kept, to see what it costs
+void benchmarkEngines( unsigned instructions, size_t historySize )
+{
+    for( unsigned engineIndex = 0; engineIndex < cBenchmarkEngineCount; ++engineIndex )
+    {
+        tBenchmarkMCU bench( cBenchmarkEngines[engineIndex].m_engine, cBenchmarkEngines[engineIndex].m_lazyFlags );
+
+        tMCURewind rewind( historySize, cHistoryCheckpoints, cHistoryInterval );
+        if( historySize > 0 )
+            bench.getState().setRewind( &rewind );
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        bench.run( instructions );
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+        std::cout << std::setw( 10 ) << std::setfill( ' ' ) << execEngineName( cBenchmarkEngines[engineIndex].m_engine )
+            << (cBenchmarkEngines[engineIndex].m_lazyFlags ? " (lazy)" : "       ") << ": "
+            << std::fixed << std::setprecision( 1 ) << (instructions / elapsed.count() / 1e6) << " MIPS" << std::endl;
+    }
+}
+
+//   Runs instanceCount copies of the benchmark at once, on as many threads as the host has cores, and reports
+// each one's MIPS and the total
+void benchmarkFleet( unsigned instanceCount, unsigned instructions, eExecEngine engine, bool lazyFlags )
+{
+    tBenchmarkMCU image;
+
+    tMCUFleet fleet;
+    for( unsigned instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex )
+    {
+        tMCUState& rState = fleet.getState( fleet.addInstance( image.getMemory(), instructions, cBenchmarkCommands, true ) );
+        rState.setExecEngine( engine );
+        rState.setLazyFlags( lazyFlags );
+        rState.setAotBlocks( g_romAotBlocks, g_romAotBlockCount );
+    }
+
+    double seconds = fleet.run();
+
+    uint64_t totalInstructions = 0;
+    for( unsigned instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex )
+    {
+        const tMCUFleet::tInstanceStats& rStats = fleet.getStats( instanceIndex );
+        totalInstructions += rStats.m_instructions;
+
+        std::cout << "  instance " << std::dec << std::setw( 3 ) << std::setfill( ' ' ) << instanceIndex << ": "
+            << std::fixed << std::setprecision( 1 ) << (rStats.m_instructions / rStats.m_seconds / 1e6) << " MIPS" << std::endl;
+    }
+
+    std::cout << instanceCount << " instances of " << execEngineName( engine ) << (lazyFlags ? " (lazy)" : "") << " on "
+        << fleet.getThreadCount() << " threads: " << std::fixed << std::setprecision( 1 )
+        << (totalInstructions / seconds / 1e6) << " MIPS in total" << std::endl;
+}
+
+//   Runs laneCount copies of the benchmark in lockstep, each typing the commands from a different point so that
+// they go their own ways, and then the same again one lane at a time on engine_Switch.  Input is only typed
+// between quanta, so both see it at the same instructions.  Reports the MIPS of each, and returns whether every
+// lane ended up in the same state both ways.
+bool benchmarkLockstep( unsigned laneCount, unsigned instructions )
+{
+    static const unsigned cQuantum = 10000;
+
+    laneCount = std::max( 1u, std::min( laneCount, tMCULockstep::cMaxLanes ) );
+
+    tMCULockstep lockstep;
+    std::vector< tBenchmarkMCU* > lockstepLanes;
+    std::vector< tBenchmarkMCU* > switchLanes;
+    for( unsigned lane = 0; lane < laneCount; ++lane )
+    {
+        unsigned commandPos = (lane * 5) % (sizeof(cBenchmarkCommands) - 1);
+        lockstepLanes.push_back( new tBenchmarkMCU( engine_Switch, false, commandPos ) );
+        switchLanes.push_back( new tBenchmarkMCU( engine_Switch, false, commandPos ) );
+        lockstep.addLane( lockstepLanes[lane]->getState() );
+    }
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    for( unsigned done = 0; done < instructions; done += cQuantum )
+    {
+        for( unsigned lane = 0; lane < laneCount; ++lane )
+            lockstepLanes[lane]->feed();
+
+        lockstep.runInstructions( std::min( cQuantum, instructions - done ) );
+    }
+
+    std::chrono::duration<double> lockstepTime = std::chrono::steady_clock::now() - startTime;
+    startTime = std::chrono::steady_clock::now();
+
+    for( unsigned lane = 0; lane < laneCount; ++lane )
+        switchLanes[lane]->run( instructions, cQuantum );
+
+    std::chrono::duration<double> switchTime = std::chrono::steady_clock::now() - startTime;
+
+    bool matched = true;
+    for( unsigned lane = 0; lane < laneCount; ++lane )
+    {
+        matched = matched && lockstepLanes[lane]->getState().sameState( switchLanes[lane]->getState() );
+
+        delete lockstepLanes[lane];
+        delete switchLanes[lane];
+    }
+
+    double totalInstructions = double(instructions) * laneCount;
+    uint64_t vectorInstructions = lockstep.getVectorInstructions();
+    std::cout << laneCount << " lanes in lockstep: " << std::fixed << std::setprecision( 1 ) << (totalInstructions / lockstepTime.count() / 1e6)
+        << " MIPS (" << (100.0 * vectorInstructions / (vectorInstructions + lockstep.getScalarInstructions())) << "% vectorised), one at a time: "
+        << (totalInstructions / switchTime.count() / 1e6) << " MIPS - " << (matched ? "lanes matched" : "LANES DIFFER") << std::endl;
+
+    return matched;
+}
+
+//   Boots the ROM, snapshots it, and then runs resets times from the snapshot: i instructions of the benchmark on
+// the selected engine, and a restore.  Every run has to end up in the same state as the first, and memory has to be
+// back to the snapshot after every restore.  Reports the average restore time, and returns whether it all matched.
+bool benchmarkSnapshots( unsigned resets, unsigned instructions, eExecEngine engine )
+{
+    // Into the monitor's input loop
+    static const unsigned cBootInstructions = 10000;
+
+    tBenchmarkMCU bench( engine );
+    tMCUState& rMCU = bench.getState();
+    rMCU.runInstructions( cBootInstructions );
+
+    tMCUSnapshot *pSnapshot = new tMCUSnapshot;
+    rMCU.saveSnapshot( *pSnapshot );
+
+    // What every restore should go back to, and what every run from the snapshot should end up as
+    tBenchmarkMCU booted( engine );
+    booted.getState().runInstructions( cBootInstructions );
+    tBenchmarkMCU expected( engine );
+    expected.getState().runInstructions( cBootInstructions );
+    expected.run( instructions );
+
+    bool matched = true;
+    double restoreSeconds = 0;
+
+    for( unsigned reset = 0; reset < resets; ++reset )
+    {
+        bench.restartCommands();
+        bench.run( instructions );
+        matched = matched && rMCU.sameState( expected.getState() );
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        rMCU.restoreSnapshot( *pSnapshot );
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        restoreSeconds += elapsed.count();
+
+        matched = matched && rMCU.sameState( booted.getState() );
+    }
+
+    delete pSnapshot;
+
+    std::cout << resets << " restores after " << instructions << " instructions on " << execEngineName( engine ) << ": "
+        << std::fixed << std::setprecision( 2 ) << (resets > 0 ? restoreSeconds / resets * 1e6 : 0.0) << " us each - "
+        << (matched ? "runs matched" : "RUNS DIFFER") << std::endl;
+
+    return matched;
+}
+
+//   On each engine in turn, runs i instructions of the benchmark with history being kept, snapshotting a second MCU
+// running alongside at each of steps points on the way.  Then steps back to each of those points in turn, newest
+// first, and checks that the MCU is the same as the snapshot was.  Returns whether they all matched.
+bool checkRewind( unsigned steps, unsigned instructions )
+{
+    static const unsigned cQuantum = 1000;
+
+    steps = std::max( 1u, steps );
+    unsigned stepInstructions = std::max( 1u, instructions / steps );
+
+    bool allMatched = true;
+    for( unsigned engineIndex = 0; engineIndex < cBenchmarkEngineCount; ++engineIndex )
+    {
+        eExecEngine engine = cBenchmarkEngines[engineIndex].m_engine;
+        bool lazyFlags = cBenchmarkEngines[engineIndex].m_lazyFlags;
+
+        tBenchmarkMCU bench( engine, lazyFlags );
+        tMCURewind rewind( size_t(1) << 20, cHistoryCheckpoints, cHistoryInterval );
+        bench.getState().setRewind( &rewind );
+
+        tBenchmarkMCU reference;
+        std::vector< tMCUSnapshot* > snapshots;
+
+        bool matched = true;
+        for( unsigned step = 0; step <= steps; ++step )
+        {
+            if( step > 0 )
+            {
+                bench.run( stepInstructions, cQuantum );
+                reference.run( stepInstructions, cQuantum );
+                matched = matched && bench.getState().sameState( reference.getState() );
+            }
+
+            snapshots.push_back( new tMCUSnapshot );
+            reference.getState().saveSnapshot( *snapshots.back() );
+        }
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        for( unsigned step = steps; step > 0 && matched; --step )
+        {
+            reference.getState().restoreSnapshot( *snapshots[step - 1] );
+            matched = rewind.stepBack( bench.getState(), stepInstructions ) && bench.getState().sameState( reference.getState() );
+            if( !matched )
+                std::cout << "Stepping back to instruction " << std::dec << (step - 1) * stepInstructions << " differs" << std::endl;
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+        for( size_t snapshotIndex = 0; snapshotIndex < snapshots.size(); ++snapshotIndex )
+            delete snapshots[snapshotIndex];
+
+        bench.getState().setRewind( 0 );
+
+        std::cout << std::setw( 10 ) << std::setfill( ' ' ) << execEngineName( engine ) << (lazyFlags ? " (lazy)" : "       ") << ": "
+            << std::dec << steps << " steps back of " << stepInstructions << " instructions, " << std::fixed << std::setprecision( 2 )
+            << (elapsed.count() / steps * 1e3) << " ms each - " << (matched ? "states matched" : "STATES DIFFER") << std::endl;
+
+        allMatched = allMatched && matched;
+    }
+
+    std::cout << (allMatched ? "rewind matched" : "REWIND DIFFERS") << std::endl;
+
+    return allMatched;
+}
+
+//   Runs the benchmark an instruction at a time with every access in [firstAddress, lastAddress] streamed into
+// pFileName, and reports how fast that went.  Then reads the file back, and returns whether it has them all.
+bool benchmarkTrace( const char *pFileName, unsigned instructions, uint16_t firstAddress, uint16_t lastAddress )
+{
+    tBenchmarkMCU bench;
+
+    tMCUTraceWriter writer;
+    writer.addFilter( firstAddress, lastAddress );
+    if( !writer.open( pFileName ) )
+    {
+        std::cout << "Couldn't create " << pFileName << std::endl;
+        return false;
+    }
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    for( unsigned instruction = 0; instruction < instructions; ++instruction )
+    {
+        if( instruction % 1000 == 0 )
+            bench.feed();
+
+        bench.getState().pcExecuteTraced( writer );
+    }
+
+    uint64_t recordCount = writer.getRecordCount();
+    uint64_t stallCount = writer.getStallCount();
+    bool written = writer.close();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    // Every record has to be there, in order, and in range
+    std::ifstream traceFile( pFileName, std::ios::binary );
+    tTraceFileHeader header;
+    traceFile.read( reinterpret_cast<char*>(&header), sizeof(header) );
+    bool matched = written && traceFile && memcmp( header.m_magic, "HK65TRCE", sizeof(header.m_magic) ) == 0
+        && header.m_recordSize == sizeof(tTraceRecord);
+
+    uint64_t recordsRead = 0;
+    uint64_t lastCycle = 0;
+    tTraceRecord record;
+    while( matched && traceFile.read( reinterpret_cast<char*>(&record), sizeof(record) ) )
+    {
+        matched = record.getCycle() >= lastCycle && record.m_address >= firstAddress && record.m_address <= lastAddress;
+        lastCycle = record.getCycle();
+        ++recordsRead;
+    }
+
+    matched = matched && recordsRead == recordCount;
+
+    std::cout << recordCount << " accesses from " << instructions << " instructions: " << std::fixed << std::setprecision( 1 )
+        << (instructions / elapsed.count() / 1e6) << " MIPS, " << (recordCount / elapsed.count() / 1e6) << " M accesses/s, "
+        << (recordCount * sizeof(tTraceRecord) / elapsed.count() / (1 << 20)) << " MB/s, " << stallCount << " stalls - "
+        << (matched ? "trace read back" : "TRACE DIFFERS") << std::endl;
+
+    return matched;
+}
+
+//   Logs n instructions of the benchmark on the selected engine into pFileName, and reports how fast that went.  Then
+// single steps the benchmark again, and returns whether the file has a line for each instruction exactly as
+// tMCUTextLog::formatLine() gives it.
+bool benchmarkTextLog( const char *pFileName, unsigned instructions, eExecEngine engine )
+{
+    static const unsigned cQuantum = 1000;
+
+    tBenchmarkMCU bench( engine );
+    tMCUState& rMCU = bench.getState();
+
+    tMCUTextLog textLog( rMCU );
+    if( !textLog.open( pFileName ) )
+    {
+        std::cout << "Couldn't create " << pFileName << std::endl;
+        return false;
+    }
+
+    rMCU.setObserver( &textLog );
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    bench.run( instructions, cQuantum );
+
+    rMCU.setObserver( 0 );
+    uint64_t lineCount = textLog.getLineCount();
+    bool matched = textLog.close();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    tBenchmarkMCU steppedBench;
+    tMCUState& rStepped = steppedBench.getState();
+    tMCUTextLog steppedLog( rStepped );
+
+    std::ifstream logFile( pFileName, std::ios::binary );
+    std::string line;
+    char expected[tMCUTextLog::cMaxLineLength];
+
+    for( unsigned instruction = 0; matched && instruction < instructions; ++instruction )
+    {
+        if( instruction % cQuantum == 0 )
+            steppedBench.feed();
+
+        size_t length = steppedLog.formatLine( expected, rStepped, rStepped.getCycleCount() );
+        matched = std::getline( logFile, line ) && line.size() + 1 == length && memcmp( line.data(), expected, line.size() ) == 0;
+        if( !matched )
+            std::cout << "Expected " << std::string( expected, length ) << "Logged   " << line << std::endl;
+
+        rStepped.pcExecute();
+    }
+
+    matched = matched && lineCount == instructions && !std::getline( logFile, line );
+
+    std::cout << lineCount << " lines on " << execEngineName( engine ) << ": " << std::fixed << std::setprecision( 1 )
+        << (lineCount / elapsed.count() / 1e6) << " M lines/s - " << (matched ? "log matched" : "LOG DIFFERS") << std::endl;
+
+    return matched;
+}
+
+// Counts everything it's told about, for benchmarkObserver()
+class tCountingObserver : public tMCUObserver
+{
+public:
+    tCountingObserver() : m_instructions( 0 ), m_cycles( 0 ), m_reads( 0 ), m_writes( 0 ), m_branches( 0 ), m_calls( 0 ), m_returns( 0 ) {}
+
+    virtual void instructionEnd( const tMCURegisters&, unsigned cycles ) { ++m_instructions; m_cycles += cycles; }
+    virtual void memoryRead( uint16_t, uint8_t ) { ++m_reads; }
+    virtual void memoryWrite( uint16_t, uint8_t ) { ++m_writes; }
+    virtual void branchTaken( uint16_t ) { ++m_branches; }
+    virtual void subroutineCall( uint16_t, uint16_t ) { ++m_calls; }
+    virtual void subroutineReturn( uint16_t ) { ++m_returns; }
+
+    uint64_t m_instructions;
+    uint64_t m_cycles;
+    uint64_t m_reads;
+    uint64_t m_writes;
+    uint64_t m_branches;
+    uint64_t m_calls;
+    uint64_t m_returns;
+};
+
+//   Runs the benchmark on the selected engine without an observer, and then again with a tCountingObserver
+// attached.  Reports the MIPS of each and what the observer saw, and returns whether both runs ended up in the same
+// state, with the observer having seen every instruction and cycle.
+bool benchmarkObserver( unsigned instructions, eExecEngine engine )
+{
+    tBenchmarkMCU plain( engine );
+    tBenchmarkMCU observed( engine );
+    tCountingObserver observer;
+    observed.getState().setObserver( &observer );
+
+    double seconds[2];
+    tBenchmarkMCU *pBenches[2] = { &plain, &observed };
+    for( unsigned run = 0; run < 2; ++run )
+    {
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        pBenches[run]->run( instructions );
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        seconds[run] = elapsed.count();
+    }
+
+    bool matched = plain.getState().sameState( observed.getState() )
+        && observer.m_instructions == instructions && observer.m_cycles == observed.getState().getCycleCount();
+
+    std::cout << execEngineName( engine ) << ": " << std::fixed << std::setprecision( 1 ) << (instructions / seconds[0] / 1e6)
+        << " MIPS without an observer, " << (instructions / seconds[1] / 1e6) << " MIPS with one, which saw "
+        << observer.m_reads << " reads, " << observer.m_writes << " writes, " << observer.m_branches << " branches taken, "
+        << observer.m_calls << " calls and " << observer.m_returns << " returns - "
+        << (matched ? "runs matched" : "RUNS DIFFER") << std::endl;
+
+    return matched;
+}
+
+//   Runs n instructions of the benchmark on the selected engine without a branch trace, and then again recording one
+// into pFileName, and reports the MIPS of each and how big the trace is.  Then decodes the trace, and returns whether
+// it gives the same PC for every instruction as single stepping the benchmark.
+bool benchmarkBranchTrace( const char *pFileName, unsigned instructions, eExecEngine engine )
+{
+    static const unsigned cQuantum = 1000;
+
+    double seconds[2];
+    uint64_t packetBytes = 0;
+    bool matched = true;
+    for( unsigned run = 0; run < 2; ++run )
+    {
+        tBenchmarkMCU bench( engine );
+        tMCUState& rMCU = bench.getState();
+
+        tMCUBranchTrace branchTrace( rMCU );
+        if( run == 1 )
+        {
+            if( !branchTrace.open( pFileName ) )
+            {
+                std::cout << "Couldn't create " << pFileName << std::endl;
+                return false;
+            }
+
+            rMCU.setBranchTrace( &branchTrace );
+        }
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        bench.run( instructions, cQuantum );
+
+        if( run == 1 )
+        {
+            rMCU.setBranchTrace( 0 );
+            matched = branchTrace.close() && branchTrace.getInstructionCount() == instructions;
+            packetBytes = branchTrace.getPacketBytes();
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        seconds[run] = elapsed.count();
+    }
+
+    tBenchmarkMCU steppedBench;
+    tMCUState& rStepped = steppedBench.getState();
+
+    tMCUBranchTraceDecoder decoder;
+    matched = matched && decoder.open( pFileName );
+
+    uint16_t pc = 0;
+    for( unsigned instruction = 0; matched && instruction < instructions; ++instruction )
+    {
+        if( instruction % cQuantum == 0 )
+            steppedBench.feed();
+
+        matched = decoder.next( pc ) && pc == rStepped.regPC;
+        if( !matched )
+            std::cout << "Instruction " << std::dec << instruction << " is at $" << std::hex << std::setw( 4 ) << std::setfill( '0' )
+                << rStepped.regPC << ", the trace has $" << std::setw( 4 ) << pc << (decoder.isBroken() ? " (broken)" : "") << std::endl;
+
+        rStepped.pcExecute();
+    }
+
+    matched = matched && !decoder.next( pc ) && !decoder.isBroken();
+
+    std::cout << execEngineName( engine ) << ": " << std::fixed << std::setprecision( 1 ) << (instructions / seconds[0] / 1e6)
+        << " MIPS without a branch trace, " << (instructions / seconds[1] / 1e6) << " MIPS with one - " << std::dec << packetBytes
+        << " bytes, " << std::setprecision( 3 ) << (packetBytes * 8.0 / instructions) << " bits an instruction - "
+        << (matched ? "trace decoded" : "TRACE DIFFERS") << std::endl;
+
+    return matched;
+}
+
+//   Starts instanceCount MCUs from the save state in pFileName, each on its own mapping of the file, and reports
+// how long that took.  Then runs i instructions of the benchmark on each, and returns whether they all ended up in
+// the same state.
+bool benchmarkSaveStates( const char *pFileName, unsigned instanceCount, unsigned instructions, eExecEngine engine )
+{
+    std::vector< tMCUSaveState* > saveStates;
+    std::vector< tMCUState* > states;
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    for( unsigned instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex )
+    {
+        tMCUSaveState *pSaveState = new tMCUSaveState;
+        if( !pSaveState->load( pFileName ) )
+        {
+            std::cout << "Couldn't load " << pFileName << std::endl;
+            delete pSaveState;
+            break;
+        }
+
+        tMCUState *pState = new tMCUState( pSaveState->getMemory() );
+        pSaveState->apply( *pState );
+        pState->setExecEngine( engine );
+
+        saveStates.push_back( pSaveState );
+        states.push_back( pState );
+    }
+
+    std::chrono::duration<double> loadTime = std::chrono::steady_clock::now() - startTime;
+
+    bool matched = !states.empty();
+    for( size_t instanceIndex = 0; instanceIndex < states.size(); ++instanceIndex )
+    {
+        unsigned commandPos = 0;
+        runBenchmark( *states[instanceIndex], commandPos, instructions );
+
+        matched = matched && states[instanceIndex]->sameState( *states[0] );
+    }
+
+    // The states first, as they're on the save states' memory
+    for( size_t instanceIndex = 0; instanceIndex < states.size(); ++instanceIndex )
+    {
+        delete states[instanceIndex];
+        delete saveStates[instanceIndex];
+    }
+
+    std::cout << states.size() << " instances loaded in " << std::fixed << std::setprecision( 2 )
+        << (states.empty() ? 0.0 : loadTime.count() / states.size() * 1e6) << " us each - "
+        << (matched ? "runs matched" : "RUNS DIFFER") << std::endl;
+
+    return matched;
+}
+
+//   Runs the ROM on an eager and a lazy flags core side by side, one instruction at a time, while typing the same
+// monitor commands into both.  Stops at the first instruction after which their registers, serial output or
+// memory differ.
+//   Returns true if they agreed throughout.
+bool compareLazyFlags( unsigned instructions )
+{
+    const char cCommands[] = "?\rE800.E83F\rE800L\r0280:A9 41 8D 02 03 60\r0280G\r0600:F8 18 A9 19 69 28 D8 38 E9 50 08 68 60\r0600G\r0600.060F\r";
+    unsigned commandPos = 0;
+
+    tBenchmarkMCU eagerBench;
+    tBenchmarkMCU lazyBench( engine_Switch, true );
+    tMCUState& eager = eagerBench.getState();
+    tMCUState& lazy = lazyBench.getState();
+
+    for( unsigned instruction = 1; instruction <= instructions; ++instruction )
+    {
+        if( eager.serialToMCUEmpty() && lazy.serialToMCUEmpty() )
+        {
+            eager.serialToMCUPushByte( cCommands[commandPos] );
+            lazy.serialToMCUPushByte( cCommands[commandPos] );
+            commandPos = (commandPos + 1) % (sizeof(cCommands) - 1);
+        }
+
+        eager.runInstructions( 1 );
+        lazy.runInstructions( 1 );
+
+        bool same = eager == lazy;
+
+        while( same && !eager.serialFromMCUEmpty() )
+            same = !lazy.serialFromMCUEmpty() && eager.serialFromMCUPopByte() == lazy.serialFromMCUPopByte();
+
+        if( same && (instruction % 4096 == 0 || instruction == instructions) )
+            same = eager.sameState( lazy );
+
+        if( !same )
+        {
+            std::cout << "Lazy flags differ after " << std::dec << instruction << " instructions" << std::endl;
+            std::cout << "Eager:" << std::endl;
+            printState( eager );
+            std::cout << "Lazy:" << std::endl;
+            printState( lazy );
+            return false;
+        }
+    }
+
+    std::cout << "Lazy flags matched over " << std::dec << instructions << " instructions" << std::endl;
+    return true;
+}
+
+//   Executes an instruction on rCore, after putting the serial port's registers into memory as the page table bus's
+// device would read them, and returns whether it left the same registers and took the same cycles as rReference
+template< typename tBus >
+static bool stepBusCore( tMCUCore< tBus >& rCore, uint8_t serialByte, const tMCUState& rReference, unsigned referenceCycles )
+{
+    rCore.m_rBus.memWriteByte( tMCUState::cSerialTx, 0 );
+    rCore.m_rBus.memWriteByte( tMCUState::cSerialRx, serialByte );
+
+    unsigned cycles = mcuExecuteInstruction( rCore );
+
+    return cycles == referenceCycles && rCore.getRegisters() == rReference;
+}
+
+// Whether all of memory on rBus is the same as rReference's, apart from the serial port and VIA (its devices)
+template< typename tBus >
+static bool sameBusMemory( tBus& rBus, const tMCUState& rReference )
+{
+    for( unsigned address = 0; address < 65536; ++address )
+    {
+        if( (address < tMCUState::cSerialTx || address > tMCUState::cViaLast)
+            && rBus.memReadByte( static_cast<uint16_t>(address) ) != rReference.m_pMemory[address] )
+            return false;
+    }
+
+    return true;
+}
+
+//   Runs the benchmark an instruction at a time on a core on tMCUFlatBus and another on tMCUBankedBus (with the ROM
+// in bank 1), next to tMCUState's page table bus.  Neither bus has the serial port, so the byte that the ROM would
+// read from cSerialRx is put there before each instruction.  Returns whether the registers and cycles agreed after
+// every instruction, and memory every so often.
+bool compareBuses( unsigned instructions )
+{
+    static const unsigned cQuantum = 1000;
+
+    tBenchmarkMCU reference;
+    tMCUState& rReference = reference.getState();
+
+    std::vector< uint8_t > flatMemory( rReference.m_pMemory, rReference.m_pMemory + 65536 );
+    tMCUFlatBus flatBus( &flatMemory[0] );
+    tMCUCore< tMCUFlatBus > flatCore( flatBus, rReference );
+
+    std::vector< uint8_t > bankedMemory( rReference.m_pMemory, rReference.m_pMemory + 65536 );
+    tMCUBankedBus bankedBus( &bankedMemory[0] );
+    bankedBus.setBank( 1, &bankedMemory[tMCUBankedBus::cWindowStart] );
+    tMCUCore< tMCUBankedBus > bankedCore( bankedBus, rReference );
+
+    unsigned commandPos = 0;
+    uint8_t serialByte = 0; // What a read of cSerialRx gets - 0 when there's nothing waiting
+    bool flatMatched = true;
+    bool bankedMatched = true;
+    unsigned instruction = 0;
+    for( ; instruction < instructions && (flatMatched || bankedMatched); ++instruction )
+    {
+        if( instruction % cQuantum == 0 && rReference.serialToMCUEmpty() )
+        {
+            serialByte = cBenchmarkCommands[commandPos];
+            rReference.serialToMCUPushByte( serialByte );
+            commandPos = (commandPos + 1) % (sizeof(cBenchmarkCommands) - 1);
+        }
+
+        while( !rReference.serialFromMCUEmpty() )
+            rReference.serialFromMCUPopByte();
+
+        unsigned cycles = rReference.pcExecute();
+
+        flatMatched = flatMatched && stepBusCore( flatCore, serialByte, rReference, cycles );
+        bankedMatched = bankedMatched && stepBusCore( bankedCore, serialByte, rReference, cycles );
+
+        if( rReference.serialToMCUEmpty() )
+            serialByte = 0;
+
+        if( instruction % 4096 == 0 || instruction + 1 == instructions )
+        {
+            flatMatched = flatMatched && sameBusMemory( flatBus, rReference );
+            bankedMatched = bankedMatched && sameBusMemory( bankedBus, rReference );
+        }
+    }
+
+    std::cout << "Flat bus " << (flatMatched ? "matched" : "DIFFERS") << ", banked bus " << (bankedMatched ? "matched" : "DIFFERS")
+        << " over " << std::dec << instruction << " instructions - " << (flatMatched && bankedMatched ? "buses matched" : "BUSES DIFFER") << std::endl;
+
+    return flatMatched && bankedMatched;
+}
+
+//   On each engine in turn, runs the ROM with idle detection on until it's polling the empty serial port, then
+// starts VIA timer 1 free running with its IRQ going to a handler that counts them.  The timer's events have to
+// keep coming due while the ROM polls, so that interrupts number of them are taken without the MCU ever being
+// reported idle.  Once the timer is back in one shot mode and has run out, it has to be idle again.  Returns whether
+// that held on every engine.
+bool checkIdleTimer( unsigned interrupts )
+{
+    static const uint16_t cPollPC = 0xE92E; // LDA cSerialRx / BEQ back to it
+    static const uint16_t cHandler = 0x0600;
+    static const uint16_t cInterruptCount = 0x0640; // A word the handler counts the interrupts in
+    static const uint16_t cTimerCounter = tMCUState::cViaFirst + tMCUVia::cT1CounterLow;
+    static const uint16_t cTimerLatch = 1000;
+    static const unsigned cMaxRuns = 10000;
+
+    // Reads the counter to clear the T1 flag, and counts the interrupt
+    const uint8_t cHandlerCode[] =
+    {
+        0x48,                                                           // PHA
+        0xAD, cTimerCounter & 0xFF, cTimerCounter >> 8,                 // LDA T1CL
+        0xEE, cInterruptCount & 0xFF, cInterruptCount >> 8,             // INC count
+        0xD0, 0x03,                                                     // BNE +3
+        0xEE, (cInterruptCount + 1) & 0xFF, cInterruptCount >> 8,       // INC count+1
+        0x68,                                                           // PLA
+        0x40,                                                           // RTI
+    };
+
+    bool allMatched = true;
+    for( unsigned engineIndex = 0; engineIndex < cBenchmarkEngineCount; ++engineIndex )
+    {
+        eExecEngine engine = cBenchmarkEngines[engineIndex].m_engine;
+        bool lazyFlags = cBenchmarkEngines[engineIndex].m_lazyFlags;
+
+        tBenchmarkMCU bench( engine, lazyFlags );
+        tMCUState& rState = bench.getState();
+        rState.setIdleDetection( true );
+
+        // From reset to the prompt, with nothing typed in
+        tRunResult result;
+        for( unsigned run = 0; run < cMaxRuns && result.m_exit != run_Idle; ++run )
+        {
+            result = rState.runInstructions( 100000 );
+            while( !rState.serialFromMCUEmpty() )
+                rState.serialFromMCUPopByte();
+        }
+
+        bool polling = result.m_exit == run_Idle && (rState.regPC == cPollPC || rState.regPC == cPollPC + 3);
+
+        for( unsigned codePos = 0; codePos < sizeof(cHandlerCode); ++codePos )
+            rState.memWriteByte( static_cast<uint16_t>(cHandler + codePos), cHandlerCode[codePos] );
+
+        rState.memWriteByte( cInterruptCount, 0 );
+        rState.memWriteByte( cInterruptCount + 1, 0 );
+        rState.memWriteByte( 0xFFFE, cHandler & 0xFF );
+        rState.memWriteByte( 0xFFFF, cHandler >> 8 );
+
+        rState.memWriteByte( tMCUState::cViaFirst + tMCUVia::cAuxControl, tMCUVia::cAuxT1FreeRun );
+        rState.memWriteByte( tMCUState::cViaFirst + tMCUVia::cT1CounterLow, cTimerLatch & 0xFF );
+        rState.memWriteByte( tMCUState::cViaFirst + tMCUVia::cT1CounterHigh, cTimerLatch >> 8 );
+        rState.memWriteByte( tMCUState::cViaFirst + tMCUVia::cInterruptEnable, 0x80 | tMCUVia::cFlagT1 );
+        rState.regP &= ~flag_I;
+
+        // Never idle while the timer's running
+        bool idleWhileTimed = false;
+        unsigned taken = 0;
+        for( unsigned run = 0; run < cMaxRuns && taken < interrupts && !idleWhileTimed; ++run )
+        {
+            result = rState.runInstructions( 1000 );
+            idleWhileTimed = result.m_exit == run_Idle;
+            taken = rState.memReadByte( cInterruptCount ) | (rState.memReadByte( cInterruptCount + 1 ) << 8);
+        }
+
+        // Idle again once the timer's stopped
+        rState.memWriteByte( tMCUState::cViaFirst + tMCUVia::cAuxControl, 0 );
+
+        result = tRunResult();
+        for( unsigned run = 0; run < cMaxRuns && result.m_exit != run_Idle; ++run )
+            result = rState.runInstructions( 1000 );
+
+        bool matched = polling && !idleWhileTimed && taken >= interrupts && result.m_exit == run_Idle && !rState.hasScheduledEvents();
+
+        std::cout << std::setw( 10 ) << std::setfill( ' ' ) << execEngineName( engine ) << (lazyFlags ? " (lazy)" : "       ") << ": "
+            << std::dec << taken << " timer interrupts taken while polling" << (polling ? "" : " (NEVER REACHED THE POLL)")
+            << (idleWhileTimed ? ", IDLE WITH THE TIMER RUNNING" : "") << (result.m_exit == run_Idle ? ", then idle" : ", NEVER IDLE AGAIN")
+            << " - " << (matched ? "ok" : "FAILED") << std::endl;
+
+        allMatched = allMatched && matched;
+    }
+
+    std::cout << (allMatched ? "idle timer matched" : "IDLE TIMER DIFFERS") << std::endl;
+
+    return allMatched;
+}
+
 void freeRunMode( tMCUState& mcu )
 {
+    // Instructions executed between each check of the keyboard
+    const unsigned cFreeRunBatch = 256;
+
+    // How long to sleep between checks of the keyboard while the ROM waits for input - _kbhit() can't block
+    const unsigned cIdleWaitMilliseconds = 10;
+
+    mcu.setIdleDetection( true );
+
     while( true )
     {
-        mcu.pcExecute();
+        eRunExit exitReason = mcu.runInstructions( cFreeRunBatch ).m_exit;
+
+        if( exitReason == run_Breakpoint )
+            break;
+
+        if( exitReason == run_VerifyFailed )
+        {
+            std::cout << std::endl << "JIT mismatch in block at " << tHexFormat( mcu.getVerifyFailPC() ) << std::endl;
+            break;
+        }
 
         if( _kbhit() )
         {
@@ -96,9 +1040,27 @@ void freeRunMode( tMCUState& mcu )
                 mcu.serialToMCUPushByte( ch );
         }
 
-        if( !mcu.serialFromMCUEmpty() )
+        while( !mcu.serialFromMCUEmpty() )
             std::cout << mcu.serialFromMCUPopByte();
+
+        while( !g_lcd.empty() )
+            std::cout << g_lcd.popByte();
+
+        if( exitReason == run_Stop )
+        {
+            std::cout << std::endl << "STP executed - reset ('r') to continue" << std::endl;
+            break;
+        }
+
+        // Waiting or idle with events scheduled is still letting time pass, so only sleep if there aren't any
+        if( (exitReason == run_Idle || exitReason == run_Wait) && !mcu.hasScheduledEvents() && mcu.serialToMCUEmpty() )
+        {
+            std::cout.flush();
+            mcu.waitForInput( cIdleWaitMilliseconds );
+        }
     }
+
+    mcu.setIdleDetection( false );
 }
 
 // Enters debugging mode
@@ -114,24 +1076,218 @@ int main( int argc, char *argv[] )
     const unsigned cMemSize = 65536;
     uint8_t mcuMemory[cMemSize];
 
-    memset( mcuMemory, 0, cMemSize );
-
-    load_rom( mcuMemory );
-    load_brk( mcuMemory );
-	mcuMemory[0xFFFC] = 0x00;	//RESET vector
-	mcuMemory[0xFFFD] = 0xE8;
-	mcuMemory[0xFFFE] = 0x00;	//IRQ(BRK) vector
-	mcuMemory[0xFFFF] = 0x10;
+    initMemory( mcuMemory );
 
     tMCUState mcu( mcuMemory );
+    mcu.addDevice( tMCULcd::cAddress, tMCULcd::cAddress, &g_lcd );
+    mcu.addDevice( tMCUKeypad::cAddress, tMCUKeypad::cAddress, &g_keypad );
+    mcu.addDevice( tMCUBankSelect::cAddress, tMCUBankSelect::cAddress, &g_bankSelect );
+    mcu.setAotBlocks( g_romAotBlocks, g_romAotBlockCount );
+
+    size_t historySize = cDefaultHistorySize;
+
+    // Command line:
+    //   -e switch|threaded|blocks|jit|jitverify|aot - selects the execution engine
+    //   -l                 - uses lazy flags (switch and threaded engines only)
+    //   -d [n]             - runs the ROM with eager and lazy flags over n instructions, and stops at any difference
+    //   -k n               - keeps the last n writes, serial reads and interrupts, for the debugger to step back through
+    //                        (0 for none - the default in release builds).  Before -b, benchmarks with it.
+    //   -b [n]             - benchmarks each engine over n instructions of the ROM, then exits
+    //   -f n [i]           - benchmarks n instances of the selected engine at once, over i instructions each, then exits
+    //   -s n [i]           - benchmarks n (up to 32) instances in lockstep against engine_Switch, over i instructions each, then exits
+    //   -r n [i]           - runs i instructions of the benchmark on the selected engine n times over from a snapshot, and times the restores, then exits
+    //   -w n [i]           - steps back n times through i instructions of the benchmark on each engine, checking the MCU against snapshots taken on the way, then exits
+    //   -m file n [i]      - starts n instances mapped from the save state in file, and runs i instructions of the benchmark on each, then exits
+    //   -t file [n] [a-b]  - streams every memory access (from hex address a to b) in n instructions of the benchmark into file, then exits
+    //   -x file [n]        - writes a line of text for each of n instructions of the benchmark on the selected engine into file, then exits
+    //   -c file [n]        - records a branch trace of n instructions of the benchmark on the selected engine into file, and decodes it, then exits
+    //   -o [n]             - runs n instructions of the benchmark on the selected engine with and without an observer attached, then exits
+    //   -g file            - translates the ROM into C++ for engine_Aot (i.e. regenerates mcu_rom_aot.cpp), then exits
+    //   -i [n]             - takes n VIA timer interrupts while the ROM polls the empty serial port with idle detection on, on each engine, then exits
+    //   -u [n]             - runs n instructions of the benchmark on cores on tMCUFlatBus and tMCUBankedBus, and checks them against tMCUState's bus, then exits
+    //   -v                 - checks every opcode against the Halkun core (mcu_halkun.cpp) on replayed reads, then exits
+    for( int argIndex = 1; argIndex < argc; ++argIndex )
+    {
+        std::string argument = argv[argIndex];
+
+        if( argument == "-e" && argIndex + 1 < argc )
+        {
+            std::string engineName = argv[++argIndex];
+            if( engineName == execEngineName( engine_Threaded ) )
+                mcu.setExecEngine( engine_Threaded );
+            else if( engineName == execEngineName( engine_BlockCache ) )
+                mcu.setExecEngine( engine_BlockCache );
+            else if( engineName == execEngineName( engine_Jit ) )
+                mcu.setExecEngine( engine_Jit );
+            else if( engineName == execEngineName( engine_JitVerify ) )
+                mcu.setExecEngine( engine_JitVerify );
+            else if( engineName == execEngineName( engine_Aot ) )
+                mcu.setExecEngine( engine_Aot );
+            else
+                mcu.setExecEngine( engine_Switch );
+        }
+        else if( argument == "-b" )
+        {
+            unsigned instructions = 100000000;
+            if( argIndex + 1 < argc )
+                std::istringstream( argv[++argIndex] ) >> instructions;
+
+            benchmarkEngines( instructions, historySize );
+            return 0;
+        }
+        else if( argument == "-k" && argIndex + 1 < argc )
+            std::istringstream( argv[++argIndex] ) >> historySize;
+        else if( argument == "-f" && argIndex + 1 < argc )
+        {
+            unsigned instanceCount = 1;
+            std::istringstream( argv[++argIndex] ) >> instanceCount;
 
-#ifdef DO_MCU_TRACE
+            unsigned instructions = 100000000;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) )
+                std::istringstream( argv[++argIndex] ) >> instructions;
 
-    verifyBehaviour( mcu );
+            benchmarkFleet( instanceCount, instructions, mcu.getExecEngine(), mcu.getLazyFlags() );
+            return 0;
+        }
+        else if( argument == "-s" && argIndex + 1 < argc )
+        {
+            unsigned laneCount = 1;
+            std::istringstream( argv[++argIndex] ) >> laneCount;
 
-    return 0;
+            unsigned instructions = 10000000;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) )
+                std::istringstream( argv[++argIndex] ) >> instructions;
 
-#endif
+            return benchmarkLockstep( laneCount, instructions ) ? 0 : 1;
+        }
+        else if( argument == "-r" && argIndex + 1 < argc )
+        {
+            unsigned resets = 1;
+            std::istringstream( argv[++argIndex] ) >> resets;
+
+            unsigned instructions = 100000;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) )
+                std::istringstream( argv[++argIndex] ) >> instructions;
+
+            return benchmarkSnapshots( resets, instructions, mcu.getExecEngine() ) ? 0 : 1;
+        }
+        else if( argument == "-w" && argIndex + 1 < argc )
+        {
+            unsigned steps = 20;
+            std::istringstream( argv[++argIndex] ) >> steps;
+
+            unsigned instructions = 150000;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) )
+                std::istringstream( argv[++argIndex] ) >> instructions;
+
+            return checkRewind( steps, instructions ) ? 0 : 1;
+        }
+        else if( argument == "-m" && argIndex + 2 < argc )
+        {
+            const char *pFileName = argv[++argIndex];
+
+            unsigned instanceCount = 1;
+            std::istringstream( argv[++argIndex] ) >> instanceCount;
+
+            unsigned instructions = 100000;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) )
+                std::istringstream( argv[++argIndex] ) >> instructions;
+
+            return benchmarkSaveStates( pFileName, instanceCount, instructions, mcu.getExecEngine() ) ? 0 : 1;
+        }
+        else if( argument == "-t" && argIndex + 1 < argc )
+        {
+            const char *pFileName = argv[++argIndex];
+
+            // The range is the one with a '-' in it
+            unsigned instructions = 10000000;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) && !strchr( argv[argIndex + 1], '-' ) )
+                std::istringstream( argv[++argIndex] ) >> instructions;
+
+            unsigned firstAddress = 0, lastAddress = 0xFFFF;
+            if( argIndex + 1 < argc && strchr( argv[argIndex + 1], '-' ) )
+            {
+                char separator;
+                std::istringstream( argv[++argIndex] ) >> std::hex >> firstAddress >> separator >> lastAddress;
+            }
+
+            return benchmarkTrace( pFileName, instructions, uint16_t( firstAddress ), uint16_t( lastAddress ) ) ? 0 : 1;
+        }
+        else if( argument == "-x" && argIndex + 1 < argc )
+        {
+            const char *pFileName = argv[++argIndex];
+
+            unsigned instructions = 10000000;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) )
+                std::istringstream( argv[++argIndex] ) >> instructions;
+
+            return benchmarkTextLog( pFileName, instructions, mcu.getExecEngine() ) ? 0 : 1;
+        }
+        else if( argument == "-c" && argIndex + 1 < argc )
+        {
+            const char *pFileName = argv[++argIndex];
+
+            unsigned instructions = 10000000;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) )
+                std::istringstream( argv[++argIndex] ) >> instructions;
+
+            return benchmarkBranchTrace( pFileName, instructions, mcu.getExecEngine() ) ? 0 : 1;
+        }
+        else if( argument == "-o" )
+        {
+            unsigned instructions = 10000000;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) )
+                std::istringstream( argv[++argIndex] ) >> instructions;
+
+            return benchmarkObserver( instructions, mcu.getExecEngine() ) ? 0 : 1;
+        }
+        else if( argument == "-l" )
+            mcu.setLazyFlags( true );
+        else if( argument == "-d" )
+        {
+            unsigned instructions = 10000000;
+            if( argIndex + 1 < argc )
+                std::istringstream( argv[++argIndex] ) >> instructions;
+
+            return compareLazyFlags( instructions ) ? 0 : 1;
+        }
+        else if( argument == "-i" )
+        {
+            unsigned interrupts = 100;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) )
+                std::istringstream( argv[++argIndex] ) >> interrupts;
+
+            return checkIdleTimer( interrupts ) ? 0 : 1;
+        }
+        else if( argument == "-u" )
+        {
+            unsigned instructions = 10000000;
+            if( argIndex + 1 < argc && isdigit( argv[argIndex + 1][0] ) )
+                std::istringstream( argv[++argIndex] ) >> instructions;
+
+            return compareBuses( instructions ) ? 0 : 1;
+        }
+        else if( argument == "-v" )
+        {
+            verifyBehaviour( mcu );
+            return 0;
+        }
+        else if( argument == "-g" && argIndex + 1 < argc )
+        {
+            std::ofstream sourceFile( argv[++argIndex] );
+            unsigned blockCount = tMCUAot::generate( mcu, cRomStart, cRomEnd, sourceFile );
+
+            std::cout << "Translated " << blockCount << " blocks" << std::endl;
+            return blockCount > 0 ? 0 : 1;
+        }
+    }
+
+    tMCURewind *pRewind = 0;
+    if( historySize > 0 )
+    {
+        pRewind = new tMCURewind( historySize, cHistoryCheckpoints, cHistoryInterval );
+        mcu.setRewind( pRewind );
+    }
 
     while( true )
     {
@@ -142,6 +1298,9 @@ int main( int argc, char *argv[] )
             break;
     }
 
+    mcu.setRewind( 0 );
+    delete pRewind;
+
     return 0;
 }
 
@@ -559,7 +1718,9 @@ bool debugMode( tMCUState& mcu )
 {
     std::cout << std::endl;
 
-    // Dump the current state
+    // How it got here, and the current state
+    printHistory( mcu, 16 );
+    std::cout << std::endl;
     printState( mcu );
 
     while( true )
@@ -585,7 +1746,13 @@ bool debugMode( tMCUState& mcu )
                 << " q - Quit\n"
                 << " g - Go - exit debugger\n"
                 << " t [n] - Trace - n instruction(s) - default of 1 instruction\n"
-                << " u [n] - Disassemble 'n' instructions from current PC\n";
+                << " p [n] - steP back - n instruction(s) - default of 1 instruction\n"
+                << " u [n] - Disassemble 'n' instructions from current PC\n"
+                << " i [n] - Instruction history - the last 'n' instructions run - default of 32\n"
+                << " b [addr] - Toggle breakpoint at hex address 'addr' - default of current PC\n"
+                << " r - Reset the CPU (e.g. after STP)\n"
+                << " w file - Write a save state to 'file'\n"
+                << " l file - Load a save state from 'file'\n";
             break;
         case 'q': // 'Quit'
             return false;
@@ -603,6 +1770,27 @@ bool debugMode( tMCUState& mcu )
                 printState( mcu );
             }
             break;
+        case 'p': // Step back
+            {
+                unsigned instructions = 1;
+                parseLine >> instructions;
+
+                tMCURewind *pRewind = mcu.getRewind();
+                if( !pRewind )
+                    std::cout << "No history is being kept (see -k)" << std::endl;
+                else if( pRewind->stepBack( mcu, instructions ) )
+                    printState( mcu );
+                else
+                    std::cout << "The history only goes back " << std::dec << pRewind->getHistoryLength( mcu ) << " instructions" << std::endl;
+            }
+            break;
+        case 'i': // Instruction history
+            {
+                unsigned instructions = 32;
+                parseLine >> instructions;
+                printHistory( mcu, instructions );
+            }
+            break;
         case 'u': // Disassemble
             {
                 unsigned instructions = 1;
@@ -610,14 +1798,65 @@ bool debugMode( tMCUState& mcu )
                 printDisassembly( mcu, mcu.regPC, instructions );
             }
             break;
+        case 'b': // Toggle breakpoint
+            {
+                unsigned address = mcu.regPC;
+                parseLine >> std::hex >> address;
+                address &= 0xFFFF;
+
+                if( mcu.isBreakpoint( address ) )
+                {
+                    mcu.clearBreakpoint( address );
+                    std::cout << "Breakpoint cleared at " << tHexFormat( uint16_t( address ) ) << std::endl;
+                }
+                else
+                {
+                    mcu.setBreakpoint( address );
+                    std::cout << "Breakpoint set at " << tHexFormat( uint16_t( address ) ) << std::endl;
+                }
+            }
+            break;
+        case 'r': // Reset
+            // Nothing before a reset can be stepped back to
+            if( mcu.getRewind() )
+                mcu.getRewind()->clear();
+
+            mcu.cpuReset();
+            printState( mcu );
+            break;
+        case 'w': // Write save state
+            {
+                std::string fileName;
+                parseLine >> fileName;
+                if( tMCUSaveState::save( mcu, fileName.c_str() ) )
+                    std::cout << "Saved to " << fileName << std::endl;
+                else
+                    std::cout << "Couldn't save to " << fileName << std::endl;
+            }
+            break;
+        case 'l': // Load save state
+            {
+                std::string fileName;
+                parseLine >> fileName;
+
+                // Copied into the memory the MCU already has
+                tMCUSaveState saveState;
+                if( saveState.load( fileName.c_str() ) )
+                {
+                    saveState.apply( mcu );
+                    printState( mcu );
+                }
+                else
+                    std::cout << "Couldn't load " << fileName << std::endl;
+            }
+            break;
         }
     }
 
     return false;
 }
 
-#ifdef DO_MCU_TRACE
-
+// The Halkun core, in mcu_halkun.cpp
 void setReadSequence( const uint8_t *pDebugRead );
 tMemoryTraceQueue& getMemoryTraceQueue();
 void setTraceState( const tTraceState& rTrace );
@@ -626,10 +1865,42 @@ void execute();
 void resetLastWrite();
 uint8_t getLastWrite();
 
-void resetMemTraces( tMCUState& mcu )
+// The opcodes are run on a core of their own, which reads from the same sequence as the Halkun core
+typedef tMCUTracedBus< tMCUReplayBus > tVerifyBus;
+typedef tMCUCore< tVerifyBus > tVerifyCore;
+
+tMCURegisters traceRegisters( const tTraceState& rTrace )
+{
+    tMCURegisters registers;
+
+    registers.regA = rTrace.regA;
+    registers.regX = rTrace.regX;
+    registers.regY = rTrace.regY;
+    registers.regP = rTrace.regP;
+    registers.regPC = rTrace.regPC;
+    registers.regSP = rTrace.regSP;
+
+    return registers;
+}
+
+tTraceState registersTrace( const tMCURegisters& rRegisters )
+{
+    tTraceState trace;
+
+    trace.regA = rRegisters.regA;
+    trace.regX = rRegisters.regX;
+    trace.regY = rRegisters.regY;
+    trace.regP = rRegisters.regP;
+    trace.regPC = rRegisters.regPC;
+    trace.regSP = rRegisters.regSP;
+
+    return trace;
+}
+
+void resetMemTraces( tVerifyBus& rBus )
 {
-    while( !mcu.m_memTrace.empty() )
-        mcu.m_memTrace.pop();
+    while( !rBus.m_trace.empty() )
+        rBus.m_trace.pop();
 
     while( !getMemoryTraceQueue().empty() )
         getMemoryTraceQueue().pop();
@@ -655,7 +1926,7 @@ void verifyBehaviour( tMCUState& mcu )
     for( unsigned opCode = 0; opCode < 256; ++opCode )
     {
         std::string opCodeName = mcu.decodeOpcodeDirect( opCode );
-        if( opCodeName == "ADC" || opCodeName == "SBC" || opCodeName == "BRK" )
+        if( opCodeName == "ADC" || opCodeName == "SBC" )
         {
             std::cout << "Skipping " << opCodeName << std::endl;
         }
@@ -672,8 +1943,11 @@ void verifyBehaviour( tMCUState& mcu )
 
 void verifyBehaviour( tMCUState& mcu, uint8_t opCodeUnderTest )
 {
+    tMCUReplayBus replayBus;
+    tVerifyBus bus( replayBus );
+
     // Step 1 - Reset the traces
-    resetMemTraces( mcu );
+    resetMemTraces( bus );
 
     // Step 2 - For this opcode, determine how many memory accesses there are
     uint8_t pReadSequence[256];
@@ -682,20 +1956,23 @@ void verifyBehaviour( tMCUState& mcu, uint8_t opCodeUnderTest )
 /*    for( unsigned i = 1; i < 10; ++i )
         pReadSequence[i] = i * 6;*/
 
-    mcu.m_pReadSequence = pReadSequence;
-    mcu.pcExecute();
+    replayBus.m_pReadSequence = pReadSequence;
+    {
+        tVerifyCore core( bus, mcu );
+        mcuExecuteInstruction( core );
+        static_cast< tMCURegisters& >( mcu ) = core.getRegisters();
+    }
 
     // Step 3 - Count how many read/writes
     unsigned readCount = 0;
     unsigned writeCount = 0;
     unsigned lastRead = 0;
-    unsigned lastWrite = 0;
     unsigned accessIndex = 0;
 
-    while( !mcu.m_memTrace.empty() )
+    while( !bus.m_trace.empty() )
     {
-        tMemoryTrace memTrace = mcu.m_memTrace.front();
-        mcu.m_memTrace.pop();
+        tMemoryTrace memTrace = bus.m_trace.front();
+        bus.m_trace.pop();
 
         if( memTrace.m_isRead )
         {
@@ -705,14 +1982,11 @@ void verifyBehaviour( tMCUState& mcu, uint8_t opCodeUnderTest )
         else
         {
             ++writeCount;
-            lastWrite = accessIndex;
         }
 
         ++accessIndex;
     }
 
-    unsigned totalCount = readCount + writeCount;
-
     // Step 4 - Initialise registers to known values
     tTraceState traceState;
     traceState.regA = 0;
@@ -728,28 +2002,31 @@ void verifyBehaviour( tMCUState& mcu, uint8_t opCodeUnderTest )
     while( !complete )
     {
         // Step 5 - Set the states to both state machines to be the same
-        mcu.setTraceState( traceState );
+        tVerifyCore core( bus, traceRegisters( traceState ) );
         setTraceState( traceState );
 
-        mcu.m_pReadSequence = pReadSequence;
-        mcu.m_lastWriteResult = 0;
+        replayBus.m_pReadSequence = pReadSequence;
+        replayBus.m_lastWriteResult = 0;
 
         setReadSequence( pReadSequence );
         resetLastWrite();
 
         // Step 6 - Execute!
-        mcu.pcExecute();
+        mcuExecuteInstruction( core );
         execute();
 
         // Step 7 - Get the new states
         tTraceState mcuState, halkunState;
-        mcuState = mcu.getTraceState();
+        static_cast< tMCURegisters& >( mcu ) = core.getRegisters();
+        mcuState = registersTrace( mcu );
         halkunState = getTraceState();
 
-        if( memcmp( &mcuState, &halkunState, sizeof(tTraceState) ) != 0 || mcu.m_lastWriteResult != getLastWrite() )
+        if( memcmp( &mcuState, &halkunState, sizeof(tTraceState) ) != 0 || replayBus.m_lastWriteResult != getLastWrite() )
         {
-            mcu.m_pReadSequence = pReadSequence;
-            std::cout << "Opcode: " << mcu.decodeFullOpcode( 0 );
+            // The instruction is decoded from a copy of the sequence
+            static uint8_t decodeMemory[65536];
+            memcpy( decodeMemory, pReadSequence, 256 );
+            std::cout << "Opcode: " << tMCUState( decodeMemory ).decodeFullOpcode( 0 );
 
             std::cout << "\nState match difference:\nInitial state:\n  ";
             displayTrace( traceState );
@@ -761,7 +2038,7 @@ void verifyBehaviour( tMCUState& mcu, uint8_t opCodeUnderTest )
 
             std::cout << "\n\nMCU state:\n  ";
             displayTrace( mcuState );
-            std::cout << "Last write: " << tHexFormat(mcu.m_lastWriteResult);
+            std::cout << "Last write: " << tHexFormat(replayBus.m_lastWriteResult);
             std::cout << "\nHalkun core:\n  ";
             displayTrace( halkunState );
             std::cout << "Last write: " << tHexFormat(getLastWrite()) << std::endl;
@@ -797,11 +2074,9 @@ void verifyBehaviour( tMCUState& mcu, uint8_t opCodeUnderTest )
         }
 
         // Reset states (cleanup)
-        resetMemTraces( mcu );
+        resetMemTraces( bus );
     }
 
     if( success )
         std::cout << "Success\n";
 }
-
-#endif
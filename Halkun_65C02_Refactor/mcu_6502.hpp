@@ -109,6 +109,8 @@ DEFINE_INSTRUCTION( ADC )
     {
         // Decimal mode - based on http://www.6502.org/tutorials/decimal_mode.html#A
         // to also give same results when invalid data is passed in
+        rState.addCycles( 1 ); // The 65c02 takes an extra cycle in decimal mode
+
         uint16_t tmp = (rState.regA & 0xF) + (addressedByte & 0xF);
         if( rState.isFlagSet( flag_C ) )
             ++tmp;
@@ -172,6 +174,8 @@ DEFINE_INSTRUCTION( SBC )
         // Decimal mode - based on http://www.6502.org/tutorials/decimal_mode.html#A
         // to also give same results when invalid data is passed in
         //   This is based on sequence 4, for 65c02 emulation
+        rState.addCycles( 1 ); // The 65c02 takes an extra cycle in decimal mode
+
         int16_t tmp = (rState.regA & 0xF) - (addressedByte & 0xF);
         int16_t result = rState.regA - addressedByte;
 
@@ -373,9 +377,15 @@ DEFINE_INSTRUCTION( JMP )
     if( opCode == 0x4C )
         rState.regPC = memData.m_memAddr;
     else if( opCode == 0x6C )
+    {
         rState.regPC = rState.memReadWord( memData.m_memAddr );
+        rState.m_rObserver.indirectJump( rState.regPC );
+    }
     else if( opCode == 0x7C )
+    {
         rState.regPC = rState.memReadWord( memData.m_memAddr ); // 65c02 specific jump
+        rState.m_rObserver.indirectJump( rState.regPC );
+    }
     else
     {
         assert( false );
@@ -421,50 +431,42 @@ DECLARE_INSTRUCTION( 0xF0, BEQ, am_Relative );
 
 DEFINE_INSTRUCTION( BPL )
 {
-    if( !rState.isFlagSet( flag_N ) )
-        rState.pcBranchOffset( memData );
+    rState.conditionalBranch( !rState.isFlagSet( flag_N ), memData );
 }
 
 DEFINE_INSTRUCTION( BMI )
 {
-    if( rState.isFlagSet( flag_N ) )
-        rState.pcBranchOffset( memData );
+    rState.conditionalBranch( rState.isFlagSet( flag_N ), memData );
 }
 
 DEFINE_INSTRUCTION( BVC )
 {
-    if( !rState.isFlagSet( flag_V ) )
-        rState.pcBranchOffset( memData );
+    rState.conditionalBranch( !rState.isFlagSet( flag_V ), memData );
 }
 
 DEFINE_INSTRUCTION( BVS )
 {
-    if( rState.isFlagSet( flag_V ) )
-        rState.pcBranchOffset( memData );
+    rState.conditionalBranch( rState.isFlagSet( flag_V ), memData );
 }
 
 DEFINE_INSTRUCTION( BCC )
 {
-    if( !rState.isFlagSet( flag_C ) )
-        rState.pcBranchOffset( memData );
+    rState.conditionalBranch( !rState.isFlagSet( flag_C ), memData );
 }
 
 DEFINE_INSTRUCTION( BCS )
 {
-    if( rState.isFlagSet( flag_C ) )
-        rState.pcBranchOffset( memData );
+    rState.conditionalBranch( rState.isFlagSet( flag_C ), memData );
 }
 
 DEFINE_INSTRUCTION( BNE )
 {
-    if( !rState.isFlagSet( flag_Z ) )
-        rState.pcBranchOffset( memData );
+    rState.conditionalBranch( !rState.isFlagSet( flag_Z ), memData );
 }
 
 DEFINE_INSTRUCTION( BEQ )
 {
-    if( rState.isFlagSet( flag_Z ) )
-        rState.pcBranchOffset( memData );
+    rState.conditionalBranch( rState.isFlagSet( flag_Z ), memData );
 }
 
 DECLARE_INSTRUCTION( 0x00, BRK, am_Implied );
@@ -472,27 +474,42 @@ DECLARE_INSTRUCTION( 0x20, JSR, am_Absolute );
 DECLARE_INSTRUCTION( 0x40, RTI, am_Implied );
 DECLARE_INSTRUCTION( 0x60, RTS, am_Implied );
 
+// As in the Halkun core, BRK does nothing while I is set, and doesn't set I itself.  The pushed PC is the
+// address after the BRK opcode.
 DEFINE_INSTRUCTION( BRK )
 {
-    rState.regP |= flag_B;
+    if( rState.getRegP() & flag_I )
+    {
+        rState.m_rObserver.breakInstruction( false, rState.regPC, rState.regPC );
+        return;
+    }
+
+    uint16_t returnAddress = rState.regPC;
+    rState.stackPushWord( returnAddress );
+    rState.stackPushByte( rState.getRegP() | flag_B );
+    rState.setRegP( rState.getRegP() & ~flag_B );
+    rState.regPC = rState.memReadWord( tMCUState::cIRQVector );
+    rState.m_rObserver.breakInstruction( true, returnAddress, rState.regPC );
 }
 
 DEFINE_INSTRUCTION( JSR )
 {
     rState.stackPushWord( rState.regPC - 1 );
+    rState.m_rObserver.subroutineCall( memData.m_memAddr, rState.regPC );
     rState.regPC = memData.m_memAddr;
 }
 
 DEFINE_INSTRUCTION( RTI )
 {
-    // TODO - correct flags? - reference code has break bit set
-    rState.regP = rState.stackPopByte();
+    rState.setRegP( rState.stackPopByte() | flag_X );
     rState.regPC = rState.stackPopWord();
+    rState.m_rObserver.interruptReturn( rState.regPC );
 }
 
 DEFINE_INSTRUCTION( RTS )
 {
     rState.regPC = rState.stackPopWord() + 1;
+    rState.m_rObserver.subroutineReturn( rState.regPC );
 }
 
 DECLARE_INSTRUCTION( 0x08, PHP, am_Implied );
@@ -518,14 +535,15 @@ DECLARE_INSTRUCTION( 0xBA, TSX, am_Implied );
 DECLARE_INSTRUCTION( 0xCA, DEX, am_Implied );
 DECLARE_INSTRUCTION( 0xEA, NOP, am_Implied );
 
+// B and the unused bit always read as set from the stack, as in the Halkun core
 DEFINE_INSTRUCTION( PHP )
 {
-    rState.stackPushByte( rState.regP );
+    rState.stackPushByte( rState.getRegP() | flag_B | flag_X );
 }
 
 DEFINE_INSTRUCTION( PLP )
 {
-    rState.regP = rState.stackPopByte();
+    rState.setRegP( rState.stackPopByte() | flag_B | flag_X );
 }
 
 DEFINE_INSTRUCTION( PHA )
@@ -48,6 +48,9 @@ DECLARE_INSTRUCTION( 0x7A, PLY, am_Implied );
 DECLARE_INSTRUCTION( 0xDA, PHX, am_Implied );
 DECLARE_INSTRUCTION( 0xFA, PLX, am_Implied );
 
+DECLARE_INSTRUCTION( 0xCB, WAI, am_Implied );
+DECLARE_INSTRUCTION( 0xDB, STP, am_Implied );
+
 DEFINE_INSTRUCTION( STZ )
 {
     memData = 0;
@@ -98,4 +101,14 @@ DEFINE_INSTRUCTION( PLX )
     rState.testNegativeZero( rState.regX );
 }
 
+// The run loops return run_Wait/run_Stop straight after these, and tMCUState::run() won't carry on until
+// there's something to wake up for (or for STP, until a reset)
+DEFINE_INSTRUCTION( WAI )
+{
+}
+
+DEFINE_INSTRUCTION( STP )
+{
+}
+
 #endif
@@ -0,0 +1,217 @@
+#include "mcu_aot.hpp"
+#include "mcu_blockcache.hpp"
+
+#include <iomanip>
+#include <map>
+#include <set>
+#include <vector>
+
+// Instructions that write to memory, other than through the accumulator.  Translated code checks
+// tMCUAot::exitRequested() after each one.
+static bool writesMemory( tMCUState& rState, uint16_t address )
+{
+    std::string name = rState.decodeOpcode( address );
+
+    if( name == "STA" || name == "STX" || name == "STY" || name == "STZ" || name == "TSB" || name == "TRB" ||
+        name == "PHA" || name == "PHP" || name == "PHX" || name == "PHY" || name == "JSR" )
+        return true;
+
+    if( name == "ASL" || name == "LSR" || name == "ROL" || name == "ROR" || name == "INC" || name == "DEC" )
+        return rState.decodeAddressingLength( address ) > 0; // Not the accumulator form
+
+    return false;
+}
+
+static std::ostream& hex16( std::ostream& rOut, unsigned value )
+{
+    return rOut << "0x" << std::hex << std::uppercase << std::setw( 4 ) << std::setfill( '0' ) << (value & 0xFFFF) << std::dec;
+}
+
+static std::ostream& hex8( std::ostream& rOut, unsigned value )
+{
+    return rOut << "0x" << std::hex << std::uppercase << std::setw( 2 ) << std::setfill( '0' ) << (value & 0xFF) << std::dec;
+}
+
+uint32_t tMCUAot::checksum( const uint8_t *pMemory, uint16_t firstAddress, uint16_t lastAddress )
+{
+    uint32_t hash = 2166136261u;
+
+    for( unsigned address = firstAddress; address <= lastAddress; ++address )
+    {
+        hash ^= pMemory[address];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+unsigned tMCUAot::generate( tMCUState& rState, uint16_t firstAddress, uint16_t lastAddress, std::ostream& rOut )
+{
+    struct tInstruction
+    {
+        uint16_t m_address;
+        uint8_t m_opCode;
+        uint16_t m_operand;
+        uint8_t m_length;
+    };
+
+    const uint8_t *pMemory = rState.m_pMemory;
+    std::map< uint16_t, std::vector< tInstruction > > blocks; // Sorted by starting address, for the table
+    std::set< uint16_t > queued;
+    std::vector< uint16_t > workList;
+
+    const uint16_t vectors[] = { tMCUState::cResetVector, tMCUState::cIRQVector };
+    for( unsigned vectorIndex = 0; vectorIndex < sizeof(vectors) / sizeof(vectors[0]); ++vectorIndex )
+    {
+        uint16_t target = pMemory[vectors[vectorIndex]] | (pMemory[vectors[vectorIndex] + 1] << 8);
+        if( queued.insert( target ).second )
+            workList.push_back( target );
+    }
+
+    while( !workList.empty() )
+    {
+        uint16_t startPC = workList.back();
+        workList.pop_back();
+
+        std::vector< uint16_t > successors;
+        std::vector< tInstruction > instructions;
+        unsigned pc = startPC;
+
+        // A block stops before anything that must be left to the interpreter - BRK, WAI and STP (which return
+        // to the host), unimplemented opcodes, and bytes outside the range
+        while( pc >= firstAddress && pc <= lastAddress )
+        {
+            tInstruction instruction;
+            instruction.m_address = static_cast<uint16_t>(pc);
+            instruction.m_opCode = pMemory[pc];
+
+            if( instruction.m_opCode == 0x00 || instruction.m_opCode == 0xCB || instruction.m_opCode == 0xDB ||
+                rState.decodeOpcode( instruction.m_address ) == "??" )
+                break;
+
+            instruction.m_length = rState.decodeFullOpcodeLength( instruction.m_address );
+            if( pc + instruction.m_length - 1 > lastAddress )
+                break;
+
+            instruction.m_operand = 0;
+            if( instruction.m_length > 1 )
+                instruction.m_operand = pMemory[pc + 1];
+            if( instruction.m_length > 2 )
+                instruction.m_operand |= pMemory[pc + 2] << 8;
+
+            instructions.push_back( instruction );
+            pc += instruction.m_length;
+
+            if( tMCUBlockCache::endsBlock( instruction.m_opCode ) )
+            {
+                // Follow everything that can be found without running the code.  RTS and RTI aren't followed -
+                // wherever they end up is found from the JSR or interrupted block instead.
+                uint8_t opCode = instruction.m_opCode;
+
+                if( (opCode & 0x1F) == 0x10 || opCode == 0x80 ) // Branches
+                    successors.push_back( static_cast<uint16_t>(pc + static_cast<int8_t>(instruction.m_operand)) );
+                if( (opCode & 0x1F) == 0x10 || opCode == 0x20 ) // Conditional branches and JSR carry on afterwards
+                    successors.push_back( static_cast<uint16_t>(pc) );
+                if( opCode == 0x20 || opCode == 0x4C ) // JSR/JMP absolute
+                    successors.push_back( instruction.m_operand );
+
+                //   JMP (abs,X) into the range is taken to be a jump table, which runs until the first entry that
+                // points outside the range.  Guessing wrong only costs space - a block is exactly what the
+                // interpreter would have done from its start, and is only ever run from there.
+                for( unsigned entry = instruction.m_operand; opCode == 0x7C && entry < instruction.m_operand + 256u && entry + 1 <= lastAddress && entry >= firstAddress; entry += 2 )
+                {
+                    uint16_t target = pMemory[entry] | (pMemory[entry + 1] << 8);
+                    if( target < firstAddress || target > lastAddress )
+                        break;
+
+                    successors.push_back( target );
+                }
+                break;
+            }
+        }
+
+        if( !instructions.empty() && !tMCUBlockCache::endsBlock( instructions.back().m_opCode ) )
+            successors.push_back( static_cast<uint16_t>(pc) );
+
+        if( !instructions.empty() )
+            blocks[startPC] = instructions;
+
+        for( unsigned successorIndex = 0; successorIndex < successors.size(); ++successorIndex )
+        {
+            if( queued.insert( successors[successorIndex] ).second )
+                workList.push_back( successors[successorIndex] );
+        }
+    }
+
+    if( blocks.empty() )
+        return 0;
+
+    rOut << "/*\n"
+            "\n"
+            "  mcu_rom_aot.cpp - The monitor ROM, translated by tMCUAot::generate() (main -g) - do not edit\n"
+            "\n"
+            "*/\n"
+            "\n"
+            "#include \"mcu_aot.hpp\"\n"
+            "#include \"mcu_instr.hpp\"\n"
+            "\n"
+            "#include \"mcu_6502.hpp\"\n"
+            "#include \"mcu_65c02.hpp\"\n";
+
+    for( std::map< uint16_t, std::vector< tInstruction > >::const_iterator block = blocks.begin(); block != blocks.end(); ++block )
+    {
+        const std::vector< tInstruction >& rInstructions = block->second;
+        unsigned cycles = 0;
+
+        rOut << "\nstatic tAotResult aotBlock_" << std::hex << std::uppercase << std::setw( 4 ) << std::setfill( '0' ) << block->first << std::dec
+             << "( tMCUState::tCore& rCore )\n{\n";
+
+        for( unsigned index = 0; index < rInstructions.size(); ++index )
+        {
+            const tInstruction& rInstruction = rInstructions[index];
+            uint16_t nextPC = static_cast<uint16_t>(rInstruction.m_address + rInstruction.m_length);
+            bool isLast = index + 1 == rInstructions.size();
+
+            cycles += tMCUState::opCodeCycles( rInstruction.m_opCode );
+
+            // Relative branches and JSR work from PC, and everything else leaves it alone
+            if( isLast )
+                hex16( rOut << "    rCore.regPC = ", nextPC ) << ";\n";
+
+            hex8( rOut << "    mcuInstructionExecuteDecoded< ", rInstruction.m_opCode ) << " >( rCore, ";
+            hex16( rOut, rInstruction.m_operand ) << " ); // ";
+            hex16( rOut, rInstruction.m_address ).write( ": ", 2 ) << rState.decodeFullOpcode( rInstruction.m_address ) << "\n";
+
+            if( !isLast && writesMemory( rState, rInstruction.m_address ) )
+            {
+                hex16( rOut << "    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = ", nextPC )
+                    << "; return tAotResult( " << (index + 1) << ", " << cycles << " ); }\n";
+            }
+        }
+
+        rOut << "    return tAotResult( " << rInstructions.size() << ", " << cycles << " );\n}\n";
+    }
+
+    rOut << "\nconst tAotBlock g_romAotBlocks[] =\n{\n";
+
+    for( std::map< uint16_t, std::vector< tInstruction > >::const_iterator block = blocks.begin(); block != blocks.end(); ++block )
+    {
+        const std::vector< tInstruction >& rInstructions = block->second;
+        const tInstruction& rLast = rInstructions.back();
+        uint16_t lastPC = static_cast<uint16_t>(rLast.m_address + rLast.m_length - 1);
+        unsigned cycles = 0;
+
+        for( unsigned index = 0; index < rInstructions.size(); ++index )
+            cycles += tMCUState::opCodeCycles( rInstructions[index].m_opCode );
+
+        hex16( rOut << "    { ", block->first ) << ", ";
+        hex16( rOut, lastPC ) << ", 0x" << std::hex << std::uppercase << std::setw( 8 ) << std::setfill( '0' )
+            << checksum( pMemory, block->first, lastPC ) << std::dec << ", "
+            << rInstructions.size() << ", " << cycles << ", &aotBlock_"
+            << std::hex << std::uppercase << std::setw( 4 ) << std::setfill( '0' ) << block->first << std::dec << " },\n";
+    }
+
+    rOut << "};\n\nconst unsigned g_romAotBlockCount = sizeof(g_romAotBlocks) / sizeof(g_romAotBlocks[0]);\n";
+
+    return static_cast<unsigned>(blocks.size());
+}
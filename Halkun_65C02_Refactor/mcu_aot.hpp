@@ -0,0 +1,64 @@
+/*
+
+  mcu_aot.hpp - Ahead of time translation of a ROM image into C++
+
+*/
+
+#ifndef MCU_AOT_HPP
+#define MCU_AOT_HPP
+
+#include <cstdint>
+#include <ostream>
+
+#include "mcu_core.hpp"
+
+// What a translated block managed to execute before returning
+struct tAotResult
+{
+    uint32_t m_instructions;
+    uint32_t m_cycles;
+
+    tAotResult( uint32_t instructions, uint32_t cycles ) : m_instructions( instructions ), m_cycles( cycles ) {}
+};
+
+// One basic block of the ROM, translated into a function that calls the instruction templates directly (with
+// the opcode, and so the addressing mode, known at compile time).  The function leaves PC at the next
+// instruction to run.
+struct tAotBlock
+{
+    typedef tAotResult (*tFunction)( tMCUState::tCore& rCore );
+
+    uint16_t m_startPC;
+    uint16_t m_lastPC; // Address of the last byte used by the block
+    uint32_t m_checksum; // tMCUAot::checksum() of the bytes the block was translated from
+    uint32_t m_instructions; // Number of instructions in the block
+    uint32_t m_cycles; // Base cycles of all of them
+    tFunction m_pFunction;
+};
+
+// The ROM loaded by main.cpp, as translated into mcu_rom_aot.cpp
+extern const tAotBlock g_romAotBlocks[];
+extern const unsigned g_romAotBlockCount;
+
+class tMCUAot
+{
+public:
+    //   Walks the control flow from the reset and IRQ vectors, and writes C++ for every block found between
+    // firstAddress and lastAddress to rOut, along with g_romAotBlocks.  Anything outside the range (e.g. code
+    // copied into RAM) and anything only reached through an indirect jump is left to the interpreter.
+    //   Returns the number of blocks written.
+    static unsigned generate( tMCUState& rState, uint16_t firstAddress, uint16_t lastAddress, std::ostream& rOut );
+
+    // FNV-1a over memory from firstAddress to lastAddress inclusive
+    static uint32_t checksum( const uint8_t *pMemory, uint16_t firstAddress, uint16_t lastAddress );
+
+    // Called by translated code after each instruction that writes memory - true if the run loop has to be
+    // returned to, either for serial output or because the write has changed translated code
+    static bool exitRequested( tMCUState::tCore& rCore )
+    { return rCore.m_rBus.m_runExitRequest || rCore.m_rBus.m_codeModified; }
+
+private:
+    tMCUAot(); // Disallowed - static functions only
+};
+
+#endif
@@ -0,0 +1,164 @@
+#include "mcu_blockcache.hpp"
+#include "mcu_instr.hpp"
+
+#include "mcu_6502.hpp"
+#include "mcu_65c02.hpp"
+
+#include <algorithm>
+
+#define DECODED_HANDLER_ADDRESS( opCode ) &mcuInstructionExecuteDecoded< (opCode), tMCUState::tCore >,
+
+static const tDecodedInstruction::tHandler s_decodedHandlers[256] = { EACH_OPCODE_256( DECODED_HANDLER_ADDRESS ) };
+
+#undef DECODED_HANDLER_ADDRESS
+
+bool tMCUBlockCache::endsBlock( uint8_t opCode )
+{
+    switch( opCode )
+    {
+    case 0x00:  // BRK
+    case 0x10: case 0x30: case 0x50: case 0x70: case 0x90: case 0xB0: case 0xD0: case 0xF0: case 0x80: // Branches
+    case 0x20:  // JSR
+    case 0x40:  // RTI
+    case 0x60:  // RTS
+    case 0x4C: case 0x6C: case 0x7C: // JMP
+    case 0xCB: case 0xDB: // WAI, STP
+        return true;
+    }
+
+    return false;
+}
+
+tMCUBlockCache::tMCUBlockCache( tMCUState& rState )
+    : m_rState( rState )
+{
+    memset( m_pBlocks, 0, sizeof(m_pBlocks) );
+}
+
+tMCUBlockCache::~tMCUBlockCache()
+{
+    releaseRetired();
+
+    for( unsigned address = 0; address < 65536; ++address )
+        delete m_pBlocks[address];
+
+    for( unsigned page = 0; page < 256; ++page )
+        m_rState.m_codePages[page] &= ~tMCUState::cCodePageBlocks;
+}
+
+tDecodedBlock *tMCUBlockCache::decodeBlock( uint16_t address )
+{
+    tDecodedBlock *pBlock = new tDecodedBlock;
+    pBlock->m_startPC = address;
+    pBlock->m_lastPC = address;
+    pBlock->m_executions = 0;
+    pBlock->m_pNative = 0;
+
+    unsigned pc = address;
+
+    while( pBlock->m_instructions.size() < cMaxBlockInstructions && !isDeviceAddress( pc ) )
+    {
+        uint8_t opCode = m_rState.m_pMemory[pc];
+        unsigned length = 1 + m_rState.decodeAddressingLength( pc );
+
+        // Operands must not wrap around the top of memory, or touch devices either
+        if( pc + length > 0x10000 || (length > 1 && isDeviceAddress( pc + 1 )) || (length > 2 && isDeviceAddress( pc + 2 )) )
+            break;
+
+        tDecodedInstruction instruction;
+        instruction.m_pHandler = s_decodedHandlers[opCode];
+        instruction.m_operand = 0;
+        if( length > 1 )
+            instruction.m_operand = m_rState.m_pMemory[pc + 1];
+        if( length > 2 )
+            instruction.m_operand |= m_rState.m_pMemory[pc + 2] << 8;
+        instruction.m_nextPC = static_cast<uint16_t>(pc + length);
+        instruction.m_opCode = opCode;
+        instruction.m_cycles = tMCUState::opCodeCycles( opCode );
+
+        pBlock->m_instructions.push_back( instruction );
+        pBlock->m_lastPC = static_cast<uint16_t>(pc + length - 1);
+        pc += length;
+
+        if( endsBlock( opCode ) || pc > 0xFFFF )
+            break;
+    }
+
+    if( pBlock->m_instructions.empty() )
+    {
+        // Nothing here can be predecoded (e.g. PC is on a device's page) - hand it to the interpreter whenever
+        // it's reached.  This doesn't depend on memory contents, so it isn't registered with any page.
+        tDecodedInstruction instruction;
+        instruction.m_pHandler = &tMCUState::executeInterpreted;
+        instruction.m_operand = address;
+        instruction.m_nextPC = address;
+        instruction.m_opCode = 0xEA; // Unknown until executed - timed as a NOP
+        instruction.m_cycles = tMCUState::opCodeCycles( instruction.m_opCode );
+
+        pBlock->m_instructions.push_back( instruction );
+    }
+    else
+    {
+        for( unsigned page = pBlock->m_startPC >> 8; page <= unsigned(pBlock->m_lastPC >> 8); ++page )
+        {
+            m_pageBlocks[page].push_back( pBlock );
+            m_rState.m_codePages[page] |= tMCUState::cCodePageBlocks;
+        }
+    }
+
+    m_pBlocks[address] = pBlock;
+
+    return pBlock;
+}
+
+void tMCUBlockCache::invalidatePage( uint8_t page )
+{
+    std::vector< tDecodedBlock* > pageBlocks;
+    pageBlocks.swap( m_pageBlocks[page] );
+    m_rState.m_codePages[page] &= ~tMCUState::cCodePageBlocks;
+
+    for( unsigned blockIndex = 0; blockIndex < pageBlocks.size(); ++blockIndex )
+    {
+        tDecodedBlock *pBlock = pageBlocks[blockIndex];
+
+        // A block can straddle two pages - make sure that the other page forgets about it too
+        for( unsigned otherPage = pBlock->m_startPC >> 8; otherPage <= unsigned(pBlock->m_lastPC >> 8); ++otherPage )
+        {
+            if( otherPage != page )
+                removeFromPage( static_cast<uint8_t>(otherPage), pBlock );
+        }
+
+        m_pBlocks[pBlock->m_startPC] = 0;
+        if( pBlock->m_pNative )
+            m_rState.m_pJit->blockRetired( pBlock->m_startPC );
+
+        // The run loop may be part way through this block, so it can't be freed yet
+        m_retiredBlocks.push_back( pBlock );
+    }
+}
+
+void tMCUBlockCache::invalidateAll()
+{
+    for( unsigned page = 0; page < 256; ++page )
+    {
+        if( !m_pageBlocks[page].empty() )
+            invalidatePage( static_cast<uint8_t>(page) );
+    }
+}
+
+void tMCUBlockCache::releaseRetired()
+{
+    for( unsigned blockIndex = 0; blockIndex < m_retiredBlocks.size(); ++blockIndex )
+        delete m_retiredBlocks[blockIndex];
+
+    m_retiredBlocks.clear();
+}
+
+void tMCUBlockCache::removeFromPage( uint8_t page, tDecodedBlock *pBlock )
+{
+    std::vector< tDecodedBlock* >& rPageBlocks = m_pageBlocks[page];
+    rPageBlocks.erase( std::remove( rPageBlocks.begin(), rPageBlocks.end(), pBlock ), rPageBlocks.end() );
+
+    if( rPageBlocks.empty() )
+        m_rState.m_codePages[page] &= ~tMCUState::cCodePageBlocks;
+}
@@ -0,0 +1,85 @@
+/*
+
+  mcu_blockcache.hpp - Cache of predecoded basic blocks
+
+*/
+
+#ifndef MCU_BLOCKCACHE_HPP
+#define MCU_BLOCKCACHE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "mcu_core.hpp"
+#include "mcu_jit.hpp"
+
+// One predecoded instruction - running it doesn't need the opcode or operand to be fetched again
+struct tDecodedInstruction
+{
+    typedef void (*tHandler)( tMCUState::tCore&, uint16_t operand );
+
+    tHandler m_pHandler;
+    uint16_t m_operand; // Operand bytes (little endian)
+    uint16_t m_nextPC;  // Address of the instruction after this one
+    uint8_t m_opCode;
+    uint8_t m_cycles;
+};
+
+// A run of instructions with a single entry point, ending at the first instruction that can change the flow of control
+struct tDecodedBlock
+{
+    uint16_t m_startPC;
+    uint16_t m_lastPC; // Address of the last byte used by the block
+    std::vector< tDecodedInstruction > m_instructions;
+
+    // Used by engine_Jit - see tMCUJit
+    unsigned m_executions; // Counts up to tMCUJit::cHotThreshold
+    tNativeBlock m_pNative; // Translated code for the block's leading run of instructions, if any
+};
+
+//   Blocks are keyed by the PC they start at.  Every page that a block was decoded from is flagged in
+// tMCUState::m_codePages, so that memWriteByte() can invalidate the blocks on a page as soon as it's written to.
+// This keeps self-modifying code (e.g. the ROM's move routine, which is copied to $0280 and patched before being
+// run) correct.
+class tMCUBlockCache
+{
+public:
+    static const unsigned cMaxBlockInstructions = 64;
+
+    tMCUBlockCache( tMCUState& rState );
+    ~tMCUBlockCache();
+
+    // Returns the block starting at address, decoding it if it isn't already cached
+    tDecodedBlock *lookup( uint16_t address )
+    {
+        tDecodedBlock *pBlock = m_pBlocks[address];
+        return pBlock ? pBlock : decodeBlock( address );
+    }
+
+    // Invalidates every block that uses bytes from the page
+    void invalidatePage( uint8_t page );
+    void invalidateAll();
+
+    // Frees blocks that were invalidated while they may still have been executing
+    void releaseRetired();
+
+    // Instructions that can send PC somewhere other than the next instruction, and so end a block
+    static bool endsBlock( uint8_t opCode );
+
+private:
+    tMCUBlockCache( const tMCUBlockCache& ); // Disallowed
+
+    tDecodedBlock *decodeBlock( uint16_t address );
+    void removeFromPage( uint8_t page, tDecodedBlock *pBlock );
+
+    // Reading a device has side effects, so nothing on a page with a device in it is ever predecoded
+    bool isDeviceAddress( unsigned address ) const
+    { return (m_rState.m_codePages[address >> 8] & tMCUState::cCodePageDevice) != 0; }
+
+    tMCUState&                      m_rState;
+    tDecodedBlock                  *m_pBlocks[65536]; // Indexed by starting PC
+    std::vector< tDecodedBlock* >   m_pageBlocks[256]; // Blocks that use bytes from each page
+    std::vector< tDecodedBlock* >   m_retiredBlocks;
+};
+
+#endif
@@ -0,0 +1,422 @@
+#include "mcu_branchtrace.hpp"
+#include "mcu_instr.hpp"
+
+#include <cstring>
+
+tMCUBranchTrace::tMCUBranchTrace( tMCUState& rState )
+    : m_rState( rState )
+    , m_pWrite( 0 )
+    , m_pFlushAt( 0 )
+    , m_bytesWritten( 0 )
+    , m_bits( 0 )
+    , m_bitCount( 0 )
+    , m_lastTarget( 0 )
+    , m_callTop( 0 )
+    , m_callDepth( 0 )
+    , m_startCount( 0 )
+    , m_lastInterrupt( 0 )
+    , m_writeFailed( false )
+{
+    memset( m_callStack, 0, sizeof(m_callStack) );
+}
+
+tMCUBranchTrace::~tMCUBranchTrace()
+{
+    close();
+}
+
+bool tMCUBranchTrace::open( const char *pFileName )
+{
+    close();
+
+    m_file.open( pFileName, std::ios::binary | std::ios::trunc );
+    if( !m_file )
+        return false;
+
+    tBranchTraceFileHeader header;
+    memcpy( header.m_magic, "HK65BRTR", sizeof(header.m_magic) );
+    header.m_version = tBranchTraceFileHeader::cVersion;
+    header.m_startPC = m_rState.regPC;
+    header.m_reserved = 0;
+    m_file.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+    m_file.write( reinterpret_cast<const char*>(m_rState.m_pMemory), 65536 );
+
+    m_buffer.resize( cBufferSize );
+    m_pWrite = &m_buffer[0];
+    m_pFlushAt = m_pWrite + cBufferSize - cMaxPacketLength;
+    m_bytesWritten = 0;
+    m_bits = 0;
+    m_bitCount = 0;
+    m_lastTarget = 0;
+    m_callTop = 0;
+    m_callDepth = 0;
+    m_startCount = m_rState.getInstructionCount();
+    m_lastInterrupt = 0;
+    m_writeFailed = false;
+
+    return true;
+}
+
+bool tMCUBranchTrace::close()
+{
+    if( !m_pWrite )
+        return true;
+
+    if( m_bitCount > 0 )
+        flushBits();
+
+    *m_pWrite++ = packet_End;
+    putNumber( getInstructionCount() );
+
+    flush();
+    m_pWrite = m_pFlushAt = 0;
+    m_file.close();
+
+    return !m_writeFailed && !m_file.fail();
+}
+
+void tMCUBranchTrace::flush()
+{
+    m_file.write( reinterpret_cast<const char*>(&m_buffer[0]), m_pWrite - &m_buffer[0] );
+    m_writeFailed = m_writeFailed || !m_file;
+    m_bytesWritten += m_pWrite - &m_buffer[0];
+    m_pWrite = &m_buffer[0];
+}
+
+void tMCUBranchTrace::putNumber( uint64_t value )
+{
+    while( value >= 0x80 )
+    {
+        *m_pWrite++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+
+    *m_pWrite++ = static_cast<uint8_t>(value);
+}
+
+// The bits so far go first, so that the decoder has used them all by the time it gets to this
+void tMCUBranchTrace::addTarget( uint16_t target )
+{
+    if( m_bitCount > 0 )
+        flushBits();
+
+    if( (target ^ m_lastTarget) & 0xFF00 )
+    {
+        *m_pWrite++ = packet_Target;
+        *m_pWrite++ = static_cast<uint8_t>(target);
+        *m_pWrite++ = static_cast<uint8_t>(target >> 8);
+    }
+    else
+    {
+        *m_pWrite++ = packet_TargetLow;
+        *m_pWrite++ = static_cast<uint8_t>(target);
+    }
+
+    m_lastTarget = target;
+
+    if( m_pWrite >= m_pFlushAt )
+        flush();
+}
+
+void tMCUBranchTrace::recordInterrupt( uint64_t instructionCount, uint16_t returnAddress, uint16_t target )
+{
+    if( m_bitCount > 0 )
+        flushBits();
+
+    uint64_t index = instructionCount - m_startCount;
+
+    *m_pWrite++ = packet_Interrupt;
+    putNumber( index - m_lastInterrupt );
+    *m_pWrite++ = static_cast<uint8_t>(target);
+    *m_pWrite++ = static_cast<uint8_t>(target >> 8);
+    m_lastInterrupt = index;
+
+    pushReturn( returnAddress );
+
+    if( m_pWrite >= m_pFlushAt )
+        flush();
+}
+
+tMCUBranchTraceDecoder::tMCUBranchTraceDecoder()
+    : m_memory( 65536 )
+    , m_state( &m_memory[0] )
+    , m_bufferPos( 0 )
+    , m_bufferEnd( 0 )
+    , m_packet( packet_End )
+    , m_packetBits( 0 )
+    , m_packetBitCount( 0 )
+    , m_packetTarget( 0 )
+    , m_packetCount( 0 )
+    , m_lastTarget( 0 )
+    , m_callTop( 0 )
+    , m_callDepth( 0 )
+    , m_pc( 0 )
+    , m_index( 0 )
+    , m_started( false )
+    , m_ended( true )
+    , m_broken( false )
+{
+    memset( m_callStack, 0, sizeof(m_callStack) );
+
+    for( unsigned opCode = 0; opCode < 256; ++opCode )
+    {
+        unsigned mode = m_state.decodeAddressingModeDirect( static_cast<uint8_t>(opCode) );
+        m_lengths[opCode] = static_cast<uint8_t>(1 + (mode < cAddressingModeAccum ? m_state.decodeLength( static_cast<eAddressingMode_Mem>(mode) ) : 0));
+
+        switch( opCode )
+        {
+        case 0x10: case 0x30: case 0x50: case 0x70: case 0x90: case 0xB0: case 0xD0: case 0xF0:
+                    m_kinds[opCode] = kind_Branch; break;
+        case 0x80:  m_kinds[opCode] = kind_Always; break;
+        case 0x4C:  m_kinds[opCode] = kind_Jump; break;
+        case 0x20:  m_kinds[opCode] = kind_Call; break;
+        case 0x6C: case 0x7C:
+                    m_kinds[opCode] = kind_Indirect; break;
+        case 0x40: case 0x60:
+                    m_kinds[opCode] = kind_Return; break;
+        case 0x00:  m_kinds[opCode] = kind_Break; break;
+        default:    m_kinds[opCode] = kind_Next; break;
+        }
+    }
+}
+
+bool tMCUBranchTraceDecoder::open( const char *pFileName )
+{
+    m_file.close();
+    m_file.clear();
+    m_file.open( pFileName, std::ios::binary );
+
+    tBranchTraceFileHeader header;
+    m_file.read( reinterpret_cast<char*>(&header), sizeof(header) );
+    m_file.read( reinterpret_cast<char*>(&m_memory[0]), 65536 );
+    if( !m_file || memcmp( header.m_magic, "HK65BRTR", sizeof(header.m_magic) ) != 0 || header.m_version != tBranchTraceFileHeader::cVersion )
+        return false;
+
+    m_buffer.resize( 1 << 16 );
+    m_bufferPos = m_bufferEnd = 0;
+    m_lastTarget = 0;
+    m_callTop = 0;
+    m_callDepth = 0;
+    m_pc = header.m_startPC;
+    m_index = 0;
+    m_packetCount = 0;
+    m_started = false;
+    m_ended = false;
+    m_broken = false;
+
+    readPacket();
+
+    return true;
+}
+
+bool tMCUBranchTraceDecoder::next( uint16_t& rPC )
+{
+    if( m_ended )
+        return false;
+
+    if( m_started )
+    {
+        step();
+        ++m_index;
+    }
+
+    m_started = true;
+
+    // Interrupts and the end come after the bits for the instructions before them
+    while( m_packet == packet_Interrupt && m_packetCount == m_index && !m_broken )
+    {
+        m_callTop = (m_callTop + 1) & (tMCUBranchTrace::cCallStackSize - 1);
+        m_callStack[m_callTop] = m_pc;
+        m_callDepth += m_callDepth < tMCUBranchTrace::cCallStackSize;
+        m_pc = m_packetTarget;
+        readPacket();
+    }
+
+    if( (m_packet == packet_End && m_index >= m_packetCount) || m_broken )
+    {
+        m_ended = true;
+        return false;
+    }
+
+    rPC = m_pc;
+    return true;
+}
+
+void tMCUBranchTraceDecoder::step()
+{
+    uint8_t opCode = m_memory[m_pc];
+    uint16_t nextPC = static_cast<uint16_t>(m_pc + m_lengths[opCode]);
+    uint16_t operand = static_cast<uint16_t>(m_memory[uint16_t(m_pc + 1)] | (m_memory[uint16_t(m_pc + 2)] << 8));
+
+    switch( m_kinds[opCode] )
+    {
+    case kind_Next:
+        m_pc = nextPC;
+        break;
+
+    case kind_Branch:
+        m_pc = takeBit() ? static_cast<uint16_t>(nextPC + int8_t(operand)) : nextPC;
+        break;
+
+    case kind_Always:
+        m_pc = static_cast<uint16_t>(nextPC + int8_t(operand));
+        break;
+
+    case kind_Jump:
+        m_pc = operand;
+        break;
+
+    case kind_Call:
+        m_callTop = (m_callTop + 1) & (tMCUBranchTrace::cCallStackSize - 1);
+        m_callStack[m_callTop] = nextPC;
+        m_callDepth += m_callDepth < tMCUBranchTrace::cCallStackSize;
+        m_pc = operand;
+        break;
+
+    case kind_Indirect:
+        m_pc = takeTarget();
+        break;
+
+    case kind_Return:
+        {
+            uint16_t predicted = 0;
+            bool hasPrediction = m_callDepth > 0;
+            if( hasPrediction )
+            {
+                predicted = m_callStack[m_callTop];
+                m_callTop = (m_callTop - 1) & (tMCUBranchTrace::cCallStackSize - 1);
+                --m_callDepth;
+            }
+
+            bool wasPredicted = takeBit();
+            m_broken = m_broken || (wasPredicted && !hasPrediction);
+            m_pc = wasPredicted ? predicted : takeTarget();
+        }
+        break;
+
+    case kind_Break:
+        if( takeBit() )
+        {
+            m_callTop = (m_callTop + 1) & (tMCUBranchTrace::cCallStackSize - 1);
+            m_callStack[m_callTop] = nextPC;
+            m_callDepth += m_callDepth < tMCUBranchTrace::cCallStackSize;
+            m_pc = takeTarget();
+        }
+        else
+            m_pc = nextPC;
+        break;
+    }
+}
+
+bool tMCUBranchTraceDecoder::takeBit()
+{
+    if( m_packet != 0 || m_broken )
+    {
+        m_broken = true;
+        return false;
+    }
+
+    bool bit = (m_packetBits >> --m_packetBitCount) & 1;
+    if( m_packetBitCount == 0 )
+        readPacket();
+
+    return bit;
+}
+
+uint16_t tMCUBranchTraceDecoder::takeTarget()
+{
+    if( (m_packet != packet_Target && m_packet != packet_TargetLow) || m_broken )
+    {
+        m_broken = true;
+        return 0;
+    }
+
+    uint16_t target = m_packetTarget;
+    readPacket();
+
+    return target;
+}
+
+void tMCUBranchTraceDecoder::readPacket()
+{
+    uint8_t header;
+    if( !readByte( header ) )
+    {
+        // Cut off - it ends here
+        m_packet = packet_End;
+        m_packetCount = 0;
+        return;
+    }
+
+    if( (header & 1) == 0 )
+    {
+        m_packet = 0;
+        m_packetBitCount = 0;
+        for( unsigned bits = header >> 1; bits > 1; bits >>= 1 )
+            ++m_packetBitCount;
+        m_packetBits = static_cast<uint8_t>((header >> 1) & ((1 << m_packetBitCount) - 1));
+        m_broken = m_broken || m_packetBitCount == 0;
+        return;
+    }
+
+    m_packet = header;
+
+    uint8_t low = 0, high = 0;
+    switch( header )
+    {
+    case packet_Target:
+        readByte( low );
+        readByte( high );
+        m_packetTarget = m_lastTarget = static_cast<uint16_t>(low | (high << 8));
+        break;
+
+    case packet_TargetLow:
+        readByte( low );
+        m_packetTarget = m_lastTarget = static_cast<uint16_t>((m_lastTarget & 0xFF00) | low);
+        break;
+
+    case packet_Interrupt:
+        m_packetCount += readNumber();
+        readByte( low );
+        readByte( high );
+        m_packetTarget = static_cast<uint16_t>(low | (high << 8));
+        break;
+
+    case packet_End:
+        m_packetCount = readNumber();
+        break;
+
+    default:
+        m_broken = true;
+        break;
+    }
+}
+
+bool tMCUBranchTraceDecoder::readByte( uint8_t& rByte )
+{
+    if( m_bufferPos == m_bufferEnd )
+    {
+        m_file.read( reinterpret_cast<char*>(&m_buffer[0]), m_buffer.size() );
+        m_bufferPos = 0;
+        m_bufferEnd = static_cast<size_t>(m_file.gcount());
+        if( m_bufferEnd == 0 )
+            return false;
+    }
+
+    rByte = m_buffer[m_bufferPos++];
+    return true;
+}
+
+uint64_t tMCUBranchTraceDecoder::readNumber()
+{
+    uint64_t value = 0;
+    uint8_t byte = 0;
+    for( unsigned shift = 0; shift < 64 && readByte( byte ); shift += 7 )
+    {
+        value |= uint64_t(byte & 0x7F) << shift;
+        if( !(byte & 0x80) )
+            break;
+    }
+
+    return value;
+}
@@ -0,0 +1,230 @@
+/*
+
+  mcu_branchtrace.hpp - Compressed control flow trace, and a decoder that rebuilds the instruction stream from it
+
+*/
+
+#ifndef MCU_BRANCHTRACE_HPP
+#define MCU_BRANCHTRACE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <fstream>
+
+#include "mcu_core.hpp"
+
+//   A branch trace file is a tBranchTraceFileHeader, then the 64k of memory as the trace started, and then packets.
+// Only what can't be worked out from the code is in the packets:
+//   - A bit for each conditional branch (taken or not), for each RTS and RTI (whether it went back to where the
+//     call stack says it should), and for each BRK (whether it was vectored, as it isn't with I set)
+//   - The target of each JMP ($nnnn) and JMP ($nnnn,X), RTS or RTI that went somewhere else, and vectored BRK
+//   - Each interrupt, with the instruction it came before and where it went
+// Up to 6 of the bits go in a byte, so the monitor ROM's code takes well under a bit an instruction.  The call
+// stack is kept the same way by both ends - JSR, BRK and interrupts push their return address on to it, and RTS
+// and RTI pop it again.
+struct tBranchTraceFileHeader
+{
+    static const uint32_t cVersion = 1;
+
+    char m_magic[8]; // "HK65BRTR"
+    uint32_t m_version;
+    uint16_t m_startPC;
+    uint16_t m_reserved;
+};
+
+// The packets.  A byte with bit 0 clear holds bits - the highest set bit marks where they start, oldest first.
+enum eBranchTracePacket
+{
+    packet_Target       = 0x01, // Followed by the target, little endian
+    packet_TargetLow    = 0x03, // Followed by the bottom byte of the target, which is in the same page as the last one
+    packet_Interrupt    = 0x05, // Followed by the instructions since the last interrupt (or the start) as a LEB128 number, then the target
+    packet_End          = 0x07, // Followed by the number of instructions in the trace, as a LEB128 number
+};
+
+//   Records a branch trace of everything the MCU runs, once it's attached with tMCUState::setBranchTrace().  This is
+// an observer (see tMCUNullObserver) that run() gives a core of its own to, so the hooks are inlined into the
+// interpreter and only the instructions that change the flow of control do anything at all.
+//   The packets go into a buffer that's written out whenever it's nearly full, and the trace is finished off by
+// close().  Code that the MCU writes to memory and then runs can't be decoded, as the decoder only has memory as
+// it was at the start - and neither can the host changing PC (e.g. with cpuReset()) or stepping back with
+// tMCURewind, so the trace should be closed and opened again around those.
+class tMCUBranchTrace : public tMCUNullObserver
+{
+public:
+    static const size_t cBufferSize     = 1 << 16;
+    static const unsigned cCallStackSize = 64; // Deeper calls than this lose their oldest return addresses - a power of 2
+
+    tMCUBranchTrace( tMCUState& rState );
+    ~tMCUBranchTrace(); // Closes the file
+
+    // Starts a new trace in the file, from the MCU's memory and PC as they are now.  Returns false if it can't be created.
+    bool open( const char *pFileName );
+
+    // Finishes the trace off, and writes out what's left.  Returns false if anything couldn't be written.
+    bool close();
+
+    bool isOpen() const { return m_pWrite != 0; }
+
+    // Instructions run since open(), and the size of their packets
+    uint64_t getInstructionCount() const { return m_rState.getInstructionCount() - m_startCount; }
+    uint64_t getPacketBytes() const { return m_bytesWritten + (m_pWrite ? m_pWrite - &m_buffer[0] : 0); }
+
+    // The hooks, which only run while it's attached to the MCU
+    void conditionalBranch( bool taken ) { addBit( taken ); }
+    void indirectJump( uint16_t target ) { addTarget( target ); }
+    void subroutineCall( uint16_t, uint16_t returnAddress ) { pushReturn( returnAddress ); }
+    void subroutineReturn( uint16_t returnAddress ) { popReturn( returnAddress ); }
+    void interruptReturn( uint16_t returnAddress ) { popReturn( returnAddress ); }
+    void breakInstruction( bool vectored, uint16_t returnAddress, uint16_t target )
+    {
+        addBit( vectored );
+        if( vectored )
+        {
+            pushReturn( returnAddress );
+            addTarget( target );
+        }
+    }
+
+    // Called by tMCUState as it takes an interrupt, before the instruction that instructionCount is up to
+    void recordInterrupt( uint64_t instructionCount, uint16_t returnAddress, uint16_t target );
+
+private:
+    static const unsigned cBitsPerPacket    = 6;
+    static const size_t cMaxPacketLength    = 16;
+
+    tMCUBranchTrace( const tMCUBranchTrace& ); // Disallowed
+
+    void addBit( bool bit )
+    {
+        m_bits = static_cast<uint8_t>((m_bits << 1) | (bit ? 1 : 0));
+        if( ++m_bitCount == cBitsPerPacket )
+            flushBits();
+    }
+
+    void flushBits()
+    {
+        *m_pWrite++ = static_cast<uint8_t>(((1 << m_bitCount) | m_bits) << 1);
+        m_bits = 0;
+        m_bitCount = 0;
+
+        if( m_pWrite >= m_pFlushAt )
+            flush();
+    }
+
+    void addTarget( uint16_t target );
+
+    void pushReturn( uint16_t returnAddress )
+    {
+        m_callTop = (m_callTop + 1) & (cCallStackSize - 1);
+        m_callStack[m_callTop] = returnAddress;
+        m_callDepth += m_callDepth < cCallStackSize;
+    }
+
+    // A bit for whether it went back to where the call stack said, and the target if it didn't
+    void popReturn( uint16_t returnAddress )
+    {
+        bool predicted = false;
+        if( m_callDepth > 0 )
+        {
+            predicted = m_callStack[m_callTop] == returnAddress;
+            m_callTop = (m_callTop - 1) & (cCallStackSize - 1);
+            --m_callDepth;
+        }
+
+        addBit( predicted );
+        if( !predicted )
+            addTarget( returnAddress );
+    }
+
+    void putNumber( uint64_t value ); // LEB128
+    void flush();
+
+    tMCUState&          m_rState;
+    std::vector< uint8_t > m_buffer;
+    uint8_t            *m_pWrite; // Where the next packet goes, or 0 when there's no file open
+    uint8_t            *m_pFlushAt; // Once m_pWrite gets here, another packet might not fit
+    uint64_t            m_bytesWritten; // Packets written out to the file so far
+    uint8_t             m_bits; // Bits not yet in a packet, oldest highest
+    unsigned            m_bitCount;
+    uint16_t            m_lastTarget;
+    uint16_t            m_callStack[cCallStackSize]; // A ring
+    unsigned            m_callTop;
+    unsigned            m_callDepth;
+    uint64_t            m_startCount; // The MCU's instruction count at open()
+    uint64_t            m_lastInterrupt; // Instructions into the trace that the last interrupt was at
+    bool                m_writeFailed;
+    std::ofstream       m_file;
+};
+
+//   Reads a branch trace back, and steps through the instructions that were run, following the code in the memory
+// that was saved at the start of the trace.  A trace that was cut off (say the MCU was never stopped) ends at the
+// last packet.
+class tMCUBranchTraceDecoder
+{
+public:
+    tMCUBranchTraceDecoder();
+
+    // Returns false if the file can't be read or isn't a branch trace
+    bool open( const char *pFileName );
+
+    //   Moves on to the next instruction - the first one, the first time - and returns its PC in rPC.  Returns false
+    // at the end of the trace, or if the trace and the code don't agree (see isBroken()).
+    bool next( uint16_t& rPC );
+
+    // Instructions that next() has returned
+    uint64_t getInstructionCount() const { return m_index; }
+
+    // The trace asked for something the code didn't (e.g. a target where the instruction was a conditional branch)
+    bool isBroken() const { return m_broken; }
+
+    // Memory as it was when the trace started, e.g. for disassembling the instructions
+    tMCUState& getState() { return m_state; }
+
+private:
+    enum eKind
+    {
+        kind_Next,          // Carries on with the next instruction
+        kind_Branch,        // Conditional branch
+        kind_Always,        // BRA
+        kind_Jump,          // JMP $nnnn
+        kind_Call,          // JSR
+        kind_Indirect,      // JMP ($nnnn) and JMP ($nnnn,X)
+        kind_Return,        // RTS and RTI
+        kind_Break,         // BRK
+    };
+
+    tMCUBranchTraceDecoder( const tMCUBranchTraceDecoder& ); // Disallowed
+
+    void step(); // Moves m_pc past the instruction there
+    bool takeBit();
+    uint16_t takeTarget();
+    void readPacket(); // The next packet into m_packet... - packet_End when the data runs out
+    bool readByte( uint8_t& rByte );
+    uint64_t readNumber();
+
+    std::vector< uint8_t >  m_memory;
+    tMCUState               m_state; // On m_memory
+    uint8_t                 m_kinds[256]; // eKind
+    uint8_t                 m_lengths[256];
+    std::ifstream           m_file;
+    std::vector< uint8_t >  m_buffer;
+    size_t                  m_bufferPos;
+    size_t                  m_bufferEnd;
+    uint8_t                 m_packet; // eBranchTracePacket, or 0 for bits
+    uint8_t                 m_packetBits;
+    unsigned                m_packetBitCount;
+    uint16_t                m_packetTarget;
+    uint64_t                m_packetCount; // The instruction that a packet_Interrupt or packet_End is at
+    uint16_t                m_lastTarget;
+    uint16_t                m_callStack[tMCUBranchTrace::cCallStackSize];
+    unsigned                m_callTop;
+    unsigned                m_callDepth;
+    uint16_t                m_pc;
+    uint64_t                m_index;
+    bool                    m_started;
+    bool                    m_ended;
+    bool                    m_broken;
+};
+
+#endif
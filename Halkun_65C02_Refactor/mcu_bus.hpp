@@ -0,0 +1,201 @@
+/*
+
+  mcu_bus.hpp - Memory buses for tMCUCore, other than tMCUState's own
+
+*/
+
+#ifndef MCU_BUS_HPP
+#define MCU_BUS_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#include "mcu_trace.hpp"
+
+//   A bus provides memReadByte() and memWriteByte(), plus memFetchByte() for code and memReadDirect()/
+// memWriteDirect() for zero page and the stack (which never have devices, so can skip looking for them).
+// tMCUCore is templated on it, so each bus gets its own instantiation of the instruction templates, with the
+// accesses inlined - there are no virtual calls.
+//   tMCUState is the production bus (memory through a page table, plus devices).  These are for running
+// instructions elsewhere, e.g. with mcuExecuteInstruction() from mcu_execute.hpp.
+
+// 64k of memory, with no devices
+struct tMCUFlatBus
+{
+    uint8_t *m_pMemory;
+
+    tMCUFlatBus( uint8_t *pMemory ) : m_pMemory( pMemory ) {}
+
+    uint8_t memReadByte( uint16_t address ) { return m_pMemory[address]; }
+    void memWriteByte( uint16_t address, uint8_t data ) { m_pMemory[address] = data; }
+    uint8_t memFetchByte( uint16_t address ) { return m_pMemory[address]; }
+    uint8_t memReadDirect( uint16_t address ) { return m_pMemory[address]; }
+    void memWriteDirect( uint16_t address, uint8_t data ) { m_pMemory[address] = data; }
+};
+
+//   The Halkun board's memory map - the bottom 32k is always bank 0, and the top 32k is a window on to whichever
+// bank was last written to cBankSelect.  Bank 1 (which has the reset vector) is selected to start with.  Selecting
+// a bank that hasn't been given to setBank() leaves the window where it is.
+struct tMCUBankedBus
+{
+    static const uint16_t cBankSelect   = 0x0308;
+    static const uint16_t cWindowStart  = 0x8000;
+    static const unsigned cBankSize     = 0x8000;
+
+    tMCUBankedBus( uint8_t *pBank0 ) : m_pBank0( pBank0 ), m_pWindow( 0 ), m_bank( 1 )
+    { memset( m_pBanks, 0, sizeof(m_pBanks) ); }
+
+    // pBank is cBankSize bytes, and isn't owned
+    void setBank( uint8_t bank, uint8_t *pBank )
+    {
+        m_pBanks[bank] = pBank;
+        if( bank == m_bank )
+            m_pWindow = pBank;
+    }
+
+    uint8_t getBank() const { return m_bank; }
+
+    uint8_t memReadByte( uint16_t address )
+    {
+        if( address < cWindowStart )
+            return m_pBank0[address];
+
+        return m_pWindow ? m_pWindow[address - cWindowStart] : 0;
+    }
+
+    void memWriteByte( uint16_t address, uint8_t data )
+    {
+        if( address >= cWindowStart )
+        {
+            if( m_pWindow )
+                m_pWindow[address - cWindowStart] = data;
+            return;
+        }
+
+        m_pBank0[address] = data;
+
+        if( address == cBankSelect && m_pBanks[data] )
+        {
+            m_bank = data;
+            m_pWindow = m_pBanks[data];
+        }
+    }
+
+    uint8_t memFetchByte( uint16_t address ) { return memReadByte( address ); }
+    uint8_t memReadDirect( uint16_t address ) { return m_pBank0[address]; }
+    void memWriteDirect( uint16_t address, uint8_t data ) { m_pBank0[address] = data; }
+
+private:
+    uint8_t *m_pBank0;
+    uint8_t *m_pWindow; // m_pBanks[m_bank]
+    uint8_t *m_pBanks[256];
+    uint8_t m_bank;
+};
+
+// Reads come from a sequence instead of memory, and writes only go as far as m_lastWriteResult.  Used to drive
+// single instructions with known operands (see verifyBehaviour() in main.cpp).
+struct tMCUReplayBus
+{
+    const uint8_t *m_pReadSequence; // Next byte to be read - reads return 0 if this is null
+    uint8_t m_lastWriteResult;
+
+    tMCUReplayBus() : m_pReadSequence( 0 ), m_lastWriteResult( 0 ) {}
+
+    uint8_t memReadByte( uint16_t )
+    { return m_pReadSequence ? *m_pReadSequence++ : 0; }
+
+    void memWriteByte( uint16_t, uint8_t data )
+    { m_lastWriteResult = data; }
+
+    uint8_t memFetchByte( uint16_t address ) { return memReadByte( address ); }
+    uint8_t memReadDirect( uint16_t address ) { return memReadByte( address ); }
+    void memWriteDirect( uint16_t address, uint8_t data ) { memWriteByte( address, data ); }
+};
+
+// Records every access made through another bus in m_trace
+template< typename tBus >
+struct tMCUTracedBus
+{
+    tBus& m_rBus;
+    tMemoryTraceQueue m_trace;
+
+    tMCUTracedBus( tBus& rBus ) : m_rBus( rBus ) {}
+
+    uint8_t memReadByte( uint16_t address )
+    {
+        uint8_t readValue = m_rBus.memReadByte( address );
+        m_trace.push( tMemoryTrace( address, readValue, true ) );
+        return readValue;
+    }
+
+    void memWriteByte( uint16_t address, uint8_t data )
+    {
+        m_trace.push( tMemoryTrace( address, data, false ) );
+        m_rBus.memWriteByte( address, data );
+    }
+
+    uint8_t memFetchByte( uint16_t address )
+    {
+        uint8_t readValue = m_rBus.memFetchByte( address );
+        m_trace.push( tMemoryTrace( address, readValue, true ) );
+        return readValue;
+    }
+
+    uint8_t memReadDirect( uint16_t address )
+    {
+        uint8_t readValue = m_rBus.memReadDirect( address );
+        m_trace.push( tMemoryTrace( address, readValue, true ) );
+        return readValue;
+    }
+
+    void memWriteDirect( uint16_t address, uint8_t data )
+    {
+        m_trace.push( tMemoryTrace( address, data, false ) );
+        m_rBus.memWriteDirect( address, data );
+    }
+};
+
+// Streams every access made through another bus into a tMCUTraceWriter, which has to be open
+template< typename tBus >
+struct tMCUTraceFileBus
+{
+    tBus& m_rBus;
+    tMCUTraceWriter& m_rWriter;
+
+    tMCUTraceFileBus( tBus& rBus, tMCUTraceWriter& rWriter ) : m_rBus( rBus ), m_rWriter( rWriter ) {}
+
+    uint8_t memReadByte( uint16_t address )
+    {
+        uint8_t readValue = m_rBus.memReadByte( address );
+        m_rWriter.record( address, readValue, access_Read );
+        return readValue;
+    }
+
+    void memWriteByte( uint16_t address, uint8_t data )
+    {
+        m_rWriter.record( address, data, access_Write );
+        m_rBus.memWriteByte( address, data );
+    }
+
+    uint8_t memFetchByte( uint16_t address )
+    {
+        uint8_t readValue = m_rBus.memFetchByte( address );
+        m_rWriter.record( address, readValue, access_Fetch );
+        return readValue;
+    }
+
+    uint8_t memReadDirect( uint16_t address )
+    {
+        uint8_t readValue = m_rBus.memReadDirect( address );
+        m_rWriter.record( address, readValue, access_Read );
+        return readValue;
+    }
+
+    void memWriteDirect( uint16_t address, uint8_t data )
+    {
+        m_rWriter.record( address, data, access_Write );
+        m_rBus.memWriteDirect( address, data );
+    }
+};
+
+#endif
@@ -1,50 +1,1156 @@
 #include "mcu_core.hpp"
-#include "mcu_instr.hpp"
-
-#include "mcu_6502.hpp"
-#include "mcu_65c02.hpp"
+#include "mcu_execute.hpp"
+#include "mcu_blockcache.hpp"
+#include "mcu_jit.hpp"
+#include "mcu_aot.hpp"
+#include "mcu_rewind.hpp"
+#include "mcu_bus.hpp"
+#include "mcu_branchtrace.hpp"
 
 #include <sstream>
 #include <iomanip>
+#include <chrono>
+#include <algorithm>
+
+// GCC and clang support taking the address of a label, which lets each handler jump straight to the next
+#if defined(__GNUC__)
+#define MCU_COMPUTED_GOTO
+#endif
 
-// These macros are used to help construct a 256 element switch statement going from 0 to 255.
-// Typed out, it would look something like:
-// switch( opCode )
-// {
-// case 0: return mcuInstructionExecute< 0 >( *this );
-// case 1: return mcuInstructionExecute< 1 >( *this );
-// case 2: return mcuInstructionExecute< 2 >( *this );
-// ...
-// case 255: return mcuInstructionExecute< 255 >( *this );
-// }
-// However, I'm much too lazy to generate all that, so I use these macros to get the preprocessor
-// to generate the statements for me.
-
-#define EXEC_OPCODE( opCode, templateFuncName )  case (opCode): return templateFuncName< (opCode) >( *this );
-#define EXEC_OPCODE_8( opCode, templateFuncName )  \
-    EXEC_OPCODE( (opCode), templateFuncName );     EXEC_OPCODE( (opCode) + 1, templateFuncName ); \
-    EXEC_OPCODE( (opCode) + 2, templateFuncName ); EXEC_OPCODE( (opCode) + 3, templateFuncName ); \
-    EXEC_OPCODE( (opCode) + 4, templateFuncName ); EXEC_OPCODE( (opCode) + 5, templateFuncName ); \
-    EXEC_OPCODE( (opCode) + 6, templateFuncName ); EXEC_OPCODE( (opCode) + 7, templateFuncName );
-#define EXEC_OPCODE_64( opCode, templateFuncName )  \
-    EXEC_OPCODE_8( (opCode), templateFuncName );         EXEC_OPCODE_8( (opCode) + 1 * 8, templateFuncName ); \
-    EXEC_OPCODE_8( (opCode) + 2 * 8, templateFuncName ); EXEC_OPCODE_8( (opCode) + 3 * 8, templateFuncName ); \
-    EXEC_OPCODE_8( (opCode) + 4 * 8, templateFuncName ); EXEC_OPCODE_8( (opCode) + 5 * 8, templateFuncName ); \
-    EXEC_OPCODE_8( (opCode) + 6 * 8, templateFuncName ); EXEC_OPCODE_8( (opCode) + 7 * 8, templateFuncName );
-
-void tMCUState::pcExecute()
-{
-    uint8_t opCode = pcReadByte();
+// Base number of cycles taken by each opcode on the 65C02.  Unimplemented opcodes are given their NOP timings.
+//   Page crossings, taken branches (including BRA, which is listed here as not taken) and decimal mode ADC/SBC
+// cost extra, which the instructions add to tMCUCore::m_cycles on top of these as they run.
+static const uint8_t s_opCodeCycles[256] =
+{
+//  0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F
+    7, 6, 2, 1, 5, 3, 5, 5, 3, 2, 2, 1, 6, 4, 6, 5, // 0
+    2, 5, 5, 1, 5, 4, 6, 5, 2, 4, 2, 1, 6, 4, 6, 5, // 1
+    6, 6, 2, 1, 3, 3, 5, 5, 4, 2, 2, 1, 4, 4, 6, 5, // 2
+    2, 5, 5, 1, 4, 4, 6, 5, 2, 4, 2, 1, 4, 4, 6, 5, // 3
+    6, 6, 2, 1, 3, 3, 5, 5, 3, 2, 2, 1, 3, 4, 6, 5, // 4
+    2, 5, 5, 1, 4, 4, 6, 5, 2, 4, 3, 1, 8, 4, 6, 5, // 5
+    6, 6, 2, 1, 3, 3, 5, 5, 4, 2, 2, 1, 6, 4, 6, 5, // 6
+    2, 5, 5, 1, 4, 4, 6, 5, 2, 4, 4, 1, 6, 4, 6, 5, // 7
+    2, 6, 2, 1, 3, 3, 3, 5, 2, 2, 2, 1, 4, 4, 4, 5, // 8
+    2, 6, 5, 1, 4, 4, 4, 5, 2, 5, 2, 1, 4, 5, 5, 5, // 9
+    2, 6, 2, 1, 3, 3, 3, 5, 2, 2, 2, 1, 4, 4, 4, 5, // A
+    2, 5, 5, 1, 4, 4, 4, 5, 2, 4, 2, 1, 4, 4, 4, 5, // B
+    2, 6, 2, 1, 3, 3, 5, 5, 2, 2, 2, 3, 4, 4, 6, 5, // C
+    2, 5, 5, 1, 4, 4, 6, 5, 2, 4, 3, 3, 4, 4, 7, 5, // D
+    2, 6, 2, 1, 3, 3, 5, 5, 2, 2, 2, 1, 4, 4, 6, 5, // E
+    2, 5, 5, 1, 4, 4, 6, 5, 2, 4, 4, 1, 4, 4, 7, 5, // F
+};
 
+// Why runInstructions()/runCycles() stop after an opcode, or run_Budget if they carry on
+static inline eRunExit opCodeExit( uint8_t opCode )
+{
     switch( opCode )
     {
-    EXEC_OPCODE_64( 0, mcuInstructionExecute );
-    EXEC_OPCODE_64( 1 * 64, mcuInstructionExecute );
-    EXEC_OPCODE_64( 2 * 64, mcuInstructionExecute );
-    EXEC_OPCODE_64( 3 * 64, mcuInstructionExecute );
+    case 0x00:  return run_Break;   // BRK
+    case 0xCB:  return run_Wait;    // WAI
+    case 0xDB:  return run_Stop;    // STP
+    }
+
+    return run_Budget;
+}
+
+// More than any instruction can take, even with all its extra cycles and an interrupt taken before it
+static const uint64_t cMaxInstructionCycles = 16;
+
+// Most instructions or cycles that translated code is let run for in one go - keeps tJitContext's counts well
+// inside 32 bits
+static const uint64_t cMaxNativeRun = 1 << 24;
+
+//   Budget policies for the run loops - what the budget passed to run() is counting.  minCycles()/maxCycles() are
+// the fewest and most cycles that a budget can take, which is what run() needs to stop at events, and
+// maxInstructions() the most instructions (for translated code).  No instruction takes less than a cycle.
+struct tInstructionBudget
+{
+    static inline uint64_t used( uint64_t instructions, uint64_t ) { return instructions; }
+    static inline uint64_t maxInstructions( uint64_t budget ) { return budget; }
+    static inline uint64_t minCycles( uint64_t budget ) { return budget; }
+    static inline uint64_t maxCycles( uint64_t budget )
+    { return budget < UINT64_MAX / cMaxInstructionCycles ? budget * cMaxInstructionCycles : UINT64_MAX; }
+};
+
+struct tCycleBudget
+{
+    static inline uint64_t used( uint64_t, uint64_t cycles ) { return cycles; }
+    static inline uint64_t maxInstructions( uint64_t budget ) { return budget; }
+    static inline uint64_t minCycles( uint64_t budget ) { return budget; }
+    static inline uint64_t maxCycles( uint64_t budget ) { return budget; }
+};
+
+tMCUState::~tMCUState()
+{
+    for( size_t rangeIndex = 0; rangeIndex < m_devices.size(); ++rangeIndex )
+        delete m_devices[rangeIndex].m_pJitShadowDevice;
+
+    delete m_pJitShadow;
+    delete [] m_pJitShadowMemory;
+    delete m_pJit;
+    delete m_pBlockCache;
+    delete [] m_pAotBlocks;
+}
+
+uint8_t tMCUState::opCodeCycles( uint8_t opCode )
+{
+    return s_opCodeCycles[opCode];
+}
+
+unsigned tMCUState::pcExecute()
+{
+    if( m_pRewind && m_pRewind->isCheckpointDue( m_instructionCount ) )
+        m_pRewind->checkpoint( *this, *this );
+
+    unsigned cycles;
+    if( m_pObserver )
+    {
+        tObservedCore core( *this, *this, *m_pObserver );
+        cycles = executeOn( core );
+    }
+    else if( m_pBranchTrace )
+    {
+        tBranchTracedCore core( *this, *this, *m_pBranchTrace );
+        cycles = executeOn( core );
+    }
+    else
+    {
+        tCore core( *this, *this );
+        cycles = executeOn( core );
+    }
+
+    m_cycleCount += cycles;
+    ++m_instructionCount;
+
+    if( m_nextEventCycle <= m_cycleCount )
+        fireEvents();
+
+    return cycles;
+}
+
+unsigned tMCUState::pcExecuteTraced( tMCUTraceWriter& rWriter )
+{
+    if( m_pRewind && m_pRewind->isCheckpointDue( m_instructionCount ) )
+        m_pRewind->checkpoint( *this, *this );
+
+    typedef tMCUTraceFileBus< tMCUState > tTracedBus;
+    tTracedBus bus( *this, rWriter );
+    tMCUCore< tTracedBus > core( bus, *this );
+
+    uint8_t opCode = memFetchByte( regPC );
+    recordInstruction( core, regPC, opCode );
+    rWriter.beginInstruction( regPC, opCode, m_cycleCount );
+    unsigned cycles = mcuExecuteInstruction( core );
+
+    static_cast< tMCURegisters& >( *this ) = core;
+    m_cycleCount += cycles;
+    ++m_instructionCount;
+
+    if( m_nextEventCycle <= m_cycleCount )
+        fireEvents();
+
+    return cycles;
+}
+
+template< typename tRunCore >
+unsigned tMCUState::executeOn( tRunCore& rCore )
+{
+    recordInstruction( rCore, rCore.regPC, memFetchByte( rCore.regPC ) );
+    unsigned cycles = mcuExecuteInstruction( rCore );
+
+    static_cast< tMCURegisters& >( *this ) = rCore;
+
+    return cycles;
+}
+
+tRunResult tMCUState::runInstructions( uint64_t instructions )
+{
+    return run< tInstructionBudget >( instructions );
+}
+
+tRunResult tMCUState::runCycles( uint64_t cycles )
+{
+    return run< tCycleBudget >( cycles );
+}
+
+void tMCUState::invalidateCode()
+{
+    if( m_pBlockCache )
+    {
+        m_pBlockCache->invalidateAll();
+        m_codeModified = true;
+    }
+
+    // Translated blocks are kept if their bytes still match
+    if( m_pAotBlocks )
+        setAotBlocks( m_pAotTable, m_aotTableSize );
+
+    for( unsigned page = 0; page < 256; ++page )
+        m_codePages[page] &= ~cCodePageClean;
+
+    // The history can't undo changes it didn't see
+    if( m_pRewind )
+        m_pRewind->clear();
+}
+
+void tMCUState::pageWriting( uint16_t address )
+{
+    uint8_t page = static_cast<uint8_t>(address >> 8);
+
+    if( m_codePages[page] & cCodePageRecord )
+        m_pRewind->recordWrite( address, m_pMemory[address] );
+
+    m_codePages[page] &= ~cCodePageClean;
+
+    if( m_codePages[page] & cCodePageCode )
+        codeModified( page );
+}
+
+tMCURegisters tMCUState::tHistoryEntry::getRegisters() const
+{
+    tMCURegisters registers;
+    registers.regPC = getPC();
+    registers.regA = static_cast<uint8_t>(m_packed >> 24);
+    registers.regX = static_cast<uint8_t>(m_packed >> 32);
+    registers.regY = static_cast<uint8_t>(m_packed >> 40);
+    registers.regP = static_cast<uint8_t>(m_packed >> 48);
+    registers.regSP = static_cast<uint8_t>(m_packed >> 56);
+    return registers;
+}
+
+bool tMCUState::sameState( const tMCUState& rOther ) const
+{
+    return static_cast< const tMCURegisters& >( *this ) == rOther && getCycleCount() == rOther.getCycleCount()
+        && memcmp( m_pMemory, rOther.m_pMemory, 65536 ) == 0;
+}
+
+unsigned tMCUState::getHistory( tHistoryEntry *pEntries, unsigned maxEntries ) const
+{
+    unsigned entryCount = 0;
+
+    // Newest first, into the end of pEntries, then moved down
+    for( uint32_t index = m_historyEnd; index != m_historyEnd - cHistorySize && entryCount < maxEntries; --index )
+    {
+        const tHistoryEntry& rEntry = m_history[(index - 1) % cHistorySize];
+        if( rEntry.m_count > 0 )
+            pEntries[maxEntries - ++entryCount] = rEntry;
+    }
+
+    std::copy( pEntries + maxEntries - entryCount, pEntries + maxEntries, pEntries );
+
+    return entryCount;
+}
+
+void tMCUState::setHalted( bool waiting, bool stopped )
+{
+    if( m_pRewind && (waiting != m_waiting || stopped != m_stopped) )
+        m_pRewind->recordHalt( m_instructionCount, waiting, stopped );
+
+    m_waiting = waiting;
+    m_stopped = stopped;
+}
+
+void tMCUState::undoWrite( uint16_t address, uint8_t data )
+{
+    uint8_t page = static_cast<uint8_t>(address >> 8);
+
+    m_codePages[page] &= ~cCodePageClean;
+
+    if( m_codePages[page] & cCodePageCode )
+        codeModified( page );
+
+    m_pMemory[address] = data;
+}
+
+void tMCUState::setRewind( tMCURewind *pRewind )
+{
+    m_pRewind = pRewind;
+
+    for( unsigned page = 0; page < 256; ++page )
+    {
+        if( m_pRewind )
+            m_codePages[page] |= cCodePageRecord;
+        else
+            m_codePages[page] &= ~cCodePageRecord;
+    }
+
+    if( m_pRewind )
+        m_pRewind->clear();
+}
+
+void tMCUState::codeModified( uint8_t page )
+{
+    if( m_codePages[page] & cCodePageBlocks )
+        m_pBlockCache->invalidatePage( page );
+
+    if( m_codePages[page] & cCodePageAot )
+    {
+        // Translated blocks can't be rebuilt, so the interpreter takes over from here on
+        for( unsigned blockIndex = 0; blockIndex < m_aotTableSize; ++blockIndex )
+        {
+            const tAotBlock& rBlock = m_pAotTable[blockIndex];
+            if( (rBlock.m_startPC >> 8) <= page && page <= (rBlock.m_lastPC >> 8) && m_pAotBlocks[rBlock.m_startPC] == &rBlock )
+                m_pAotBlocks[rBlock.m_startPC] = 0;
+        }
+
+        m_codePages[page] &= ~cCodePageAot;
+    }
+
+    m_codeModified = true;
+}
+
+unsigned tMCUState::setAotBlocks( const tAotBlock *pBlocks, unsigned blockCount )
+{
+    if( !m_pAotBlocks )
+        m_pAotBlocks = new const tAotBlock*[65536];
+
+    memset( m_pAotBlocks, 0, 65536 * sizeof(m_pAotBlocks[0]) );
+    for( unsigned page = 0; page < 256; ++page )
+        m_codePages[page] &= ~cCodePageAot;
+
+    m_pAotTable = pBlocks;
+    m_aotTableSize = blockCount;
+
+    unsigned accepted = 0;
+
+    for( unsigned blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        const tAotBlock& rBlock = pBlocks[blockIndex];
+
+        if( rBlock.m_startPC > rBlock.m_lastPC || tMCUAot::checksum( m_pMemory, rBlock.m_startPC, rBlock.m_lastPC ) != rBlock.m_checksum )
+            continue;
+
+        bool onDevice = false;
+        for( unsigned page = rBlock.m_startPC >> 8; page <= unsigned(rBlock.m_lastPC >> 8); ++page )
+            onDevice = onDevice || (m_codePages[page] & cCodePageDevice) != 0;
+        if( onDevice )
+            continue;
+
+        m_pAotBlocks[rBlock.m_startPC] = &rBlock;
+        for( unsigned page = rBlock.m_startPC >> 8; page <= unsigned(rBlock.m_lastPC >> 8); ++page )
+            m_codePages[page] |= cCodePageAot;
+
+        ++accepted;
+    }
+
+    return accepted;
+}
+
+// Never 0, which is what tMCUState::m_snapshotId is with no snapshot
+static std::atomic< uint64_t > s_lastSnapshotId( 0 );
+
+//   Pages without cCodePageClean have been written to since the snapshot that m_snapshotId names (device pages
+// never have it, as writes to them can go around memWriteByte()'s check).  Only those need copying if rSnapshot is
+// that snapshot - otherwise it gets everything, and a new id.
+void tMCUState::saveSnapshot( tMCUSnapshot& rSnapshot )
+{
+    bool incremental = rSnapshot.m_pState == this && m_snapshotId != 0 && rSnapshot.m_id == m_snapshotId;
+    if( !incremental )
+    {
+        rSnapshot.m_pState = this;
+        rSnapshot.m_id = ++s_lastSnapshotId;
+    }
+
+    for( unsigned page = 0; page < 256; ++page )
+    {
+        if( !incremental || !(m_codePages[page] & cCodePageClean) )
+            memcpy( rSnapshot.m_memory + (page << 8), m_pMemory + (page << 8), 256 );
+
+        if( !(m_codePages[page] & cCodePageDevice) )
+            m_codePages[page] |= cCodePageClean;
+    }
+
+    m_snapshotId = rSnapshot.m_id;
+
+    rSnapshot.m_registers = *this;
+    rSnapshot.m_cycleCount = m_cycleCount;
+    rSnapshot.m_events = m_events;
+    rSnapshot.m_irqLines = m_irqLines;
+    rSnapshot.m_nmiLine = m_nmiLine;
+    rSnapshot.m_nmiPending = m_nmiPending;
+    rSnapshot.m_waiting = m_waiting;
+    rSnapshot.m_stopped = m_stopped;
+    m_via.saveState( rSnapshot.m_via );
+
+    {
+        std::lock_guard< std::mutex > lock( m_serialMutex );
+        rSnapshot.m_serialToMCUFIFO = m_serialToMCUFIFO;
+    }
+    rSnapshot.m_serialFromMCUFIFO = m_serialFromMCUFIFO;
+}
+
+void tMCUState::restoreSnapshot( const tMCUSnapshot& rSnapshot )
+{
+    assert( rSnapshot.m_pState == this );
+
+    bool incremental = rSnapshot.m_id == m_snapshotId;
+
+    for( unsigned page = 0; page < 256; ++page )
+    {
+        if( incremental && (m_codePages[page] & cCodePageClean) )
+            continue;
+
+        uint8_t *pPage = m_pMemory + (page << 8);
+        const uint8_t *pSaved = rSnapshot.m_memory + (page << 8);
+
+        // Code on pages that come back unchanged is still good (translated blocks in particular can't be rebuilt)
+        if( (m_codePages[page] & cCodePageCode) && memcmp( pPage, pSaved, 256 ) != 0 )
+            codeModified( static_cast<uint8_t>(page) );
+
+        memcpy( pPage, pSaved, 256 );
+
+        if( !(m_codePages[page] & cCodePageDevice) )
+            m_codePages[page] |= cCodePageClean;
+    }
+
+    m_snapshotId = rSnapshot.m_id;
+
+    static_cast< tMCURegisters& >( *this ) = rSnapshot.m_registers;
+    m_cycleCount = rSnapshot.m_cycleCount;
+    m_events = rSnapshot.m_events;
+    eventsChanged();
+    m_irqLines = rSnapshot.m_irqLines;
+    m_nmiLine = rSnapshot.m_nmiLine;
+    m_nmiPending = rSnapshot.m_nmiPending;
+    m_waiting = rSnapshot.m_waiting;
+    m_stopped = rSnapshot.m_stopped;
+    m_via.restoreState( rSnapshot.m_via, false );
+
+    {
+        std::lock_guard< std::mutex > lock( m_serialMutex );
+        m_serialToMCUFIFO = rSnapshot.m_serialToMCUFIFO;
+        m_serialToMCUCount = m_serialToMCUFIFO.size();
+    }
+    m_serialFromMCUFIFO = rSnapshot.m_serialFromMCUFIFO;
+
+    if( m_pRewind )
+        m_pRewind->clear();
+}
+
+void tMCUState::addDevice( uint16_t firstAddress, uint16_t lastAddress, tMCUDevice *pDevice )
+{
+    assert( firstAddress <= lastAddress && firstAddress >= 0x0200 && pDevice );
+
+    tDeviceRange range;
+    range.m_firstAddress = firstAddress;
+    range.m_lastAddress = lastAddress;
+    range.m_pDevice = pDevice;
+    range.m_pJitShadowDevice = 0;
+    m_devices.push_back( range );
+
+    if( m_pJitShadow )
+        addJitShadowDevice( m_devices.back() );
+
+    for( unsigned page = firstAddress >> 8; page <= unsigned(lastAddress >> 8); ++page )
+    {
+        m_pPages[page] = 0;
+        m_codePages[page] |= cCodePageDevice;
+    }
+
+    // Anything already decoded or translated from those pages, or with direct accesses to them, is now wrong
+    invalidateCode();
+}
+
+tMCUDevice *tMCUState::findDevice( uint16_t address ) const
+{
+    for( unsigned rangeIndex = unsigned(m_devices.size()); rangeIndex > 0; --rangeIndex )
+    {
+        const tDeviceRange& rRange = m_devices[rangeIndex - 1];
+        if( rRange.m_firstAddress <= address && address <= rRange.m_lastAddress )
+            return rRange.m_pDevice;
+    }
+
+    return 0;
+}
+
+// Gives engine_JitVerify's shadow a clone of the range's device - it has a serial port and VIA of its own
+void tMCUState::addJitShadowDevice( tDeviceRange& rRange )
+{
+    if( rRange.m_pDevice == &m_serialDevice || rRange.m_pDevice == &m_via )
+        return;
+
+    rRange.m_pJitShadowDevice = rRange.m_pDevice->clone();
+    if( rRange.m_pJitShadowDevice )
+        m_pJitShadow->addDevice( rRange.m_firstAddress, rRange.m_lastAddress, rRange.m_pJitShadowDevice );
+}
+
+uint8_t tMCUState::deviceReadByte( uint16_t address )
+{
+    tMCUDevice *pDevice = findDevice( address );
+    if( pDevice )
+        return pDevice->read( address );
+
+    return m_pMemory[address];
+}
+
+void tMCUState::deviceWriteByte( uint16_t address, uint8_t data )
+{
+    tMCUDevice *pDevice = findDevice( address );
+    if( pDevice )
+    {
+        pDevice->write( address, data );
+        return;
+    }
+
+    // Device pages always have m_codePages bits
+    pageWriting( address );
+    m_pMemory[address] = data;
+}
+
+void tMCUState::executeInterpreted( tCore& rCore, uint16_t address )
+{
+    rCore.regPC = address;
+    mcuExecuteOpCode( rCore, rCore.pcReadByte() );
+}
+
+void tMCUState::setBreakpoint( uint16_t address )
+{
+    if( !isBreakpoint( address ) )
+    {
+        m_breakpoints[address >> 3] |= 1 << (address & 7);
+        ++m_breakpointCount;
+    }
+}
+
+void tMCUState::clearBreakpoint( uint16_t address )
+{
+    if( isBreakpoint( address ) )
+    {
+        m_breakpoints[address >> 3] &= ~(1 << (address & 7));
+        --m_breakpointCount;
+    }
+}
+
+// Copies the registers into a local core, runs it, and only writes them back once the loop has finished.
+//   The engine is stopped and started again to take interrupts, to fire scheduled events, and (with idle detection
+// on) to look at what the MCU is doing when it reads the empty serial port.
+template< typename tBudget >
+tRunResult tMCUState::run( uint64_t budget )
+{
+    tRunResult result;
+
+    // Before the WAI below is woken up - a checkpoint from then has to show the MCU still waiting
+    if( m_pRewind && m_pRewind->isCheckpointDue( m_instructionCount ) )
+        m_pRewind->checkpoint( *this, *this );
+
+    // Halted - a WAI only finishes once there's serial input or an interrupt (or, for STP, never)
+    if( m_stopped )
+    {
+        result.m_exit = run_Stop;
+        return result;
+    }
+
+    if( m_waiting )
+    {
+        // Nothing runs, but time skips ahead to each scheduled event in turn (as far as the budget could have
+        // taken it), in case one of them wakes the MCU up
+        uint64_t idleCycles = tBudget::maxCycles( budget );
+
+        while( serialToMCUEmpty() && m_irqLines == 0 && !m_nmiPending )
+        {
+            if( m_events.empty() || result.m_cycles >= idleCycles )
+            {
+                result.m_exit = run_Wait;
+                return result;
+            }
+
+            uint64_t skip = m_nextEventCycle > m_cycleCount ? m_nextEventCycle - m_cycleCount : 0;
+            if( skip > idleCycles - result.m_cycles )
+                skip = idleCycles - result.m_cycles;
+
+            result.m_cycles += skip;
+            m_cycleCount += skip;
+            if( m_pRewind )
+                m_pRewind->recordIdle( m_instructionCount, skip );
+            fireEvents();
+        }
+
+        setHalted( false, false );
+    }
+
+    tCore core( *this, *this );
+
+    while( true )
+    {
+        if( m_pRewind && m_pRewind->isCheckpointDue( m_instructionCount ) )
+            m_pRewind->checkpoint( *this, core );
+
+        if( m_nextEventCycle <= m_cycleCount )
+            fireEvents();
+
+        // The lines are looked at directly rather than through m_runExitRequest, which only says they've changed
+        if( interruptPending( core ) )
+            takeInterrupt( core );
+
+        //   The engine is only ever run as far as the next event.  An instruction budget that might get there is run
+        // as cycles instead - no more of them than there are instructions left.
+        uint64_t budgetLeft = budget - tBudget::used( result.m_instructions, result.m_cycles );
+        uint64_t cyclesToEvent = m_nextEventCycle - m_cycleCount;
+
+        // Back round here for the next checkpoint no more than an interval later
+        if( m_pRewind )
+            cyclesToEvent = std::min( cyclesToEvent, m_pRewind->getCheckpointInterval() );
+
+        tRunResult engineResult;
+        m_pRunCycles = &core.m_cycles;
+
+        if( cyclesToEvent >= tBudget::maxCycles( budgetLeft ) )
+            runEngine< tBudget >( core, budgetLeft, engineResult );
+        else
+            runEngine< tCycleBudget >( core, std::min( cyclesToEvent, tBudget::minCycles( budgetLeft ) ), engineResult );
+
+        m_pRunCycles = 0;
+
+        result.m_exit = engineResult.m_exit;
+        result.m_instructions += engineResult.m_instructions;
+        result.m_cycles += engineResult.m_cycles;
+        m_cycleCount += engineResult.m_cycles;
+        m_instructionCount += engineResult.m_instructions;
+        core.m_cycles = 0;
+
+        // Stopped for an event rather than at the end of the budget
+        if( engineResult.m_exit == run_Budget && tBudget::used( result.m_instructions, result.m_cycles ) < budget )
+            continue;
+
+        // The engines return run_SerialOutput for any exit request - only serial output is passed on as that
+        if( engineResult.m_exit != run_SerialOutput )
+            break;
+
+        //   Not an exchange, to keep locked instructions out of every return for serial output.  An interrupt
+        // asserted by another thread right now can have its request wiped out, but run() still sees the line itself
+        // the next time round, or the next time it's called.
+        uint8_t exitRequest = m_runExitRequest.load( std::memory_order_relaxed );
+        m_runExitRequest.store( 0, std::memory_order_relaxed );
+
+        if( exitRequest & cRunExitSerialOutput )
+            break;
+
+        // Not idle while an event is still to come, which only gets any nearer as the MCU runs
+        if( (exitRequest & cRunExitSerialPoll) && m_events.empty() && !interruptPending( core ) && isIdleLoop( core ) )
+        {
+            result.m_exit = run_Idle;
+            break;
+        }
+
+        if( tBudget::used( result.m_instructions, result.m_cycles ) >= budget )
+        {
+            result.m_exit = run_Budget;
+            break;
+        }
+    }
+
+    setHalted( result.m_exit == run_Wait, result.m_exit == run_Stop );
+
+    static_cast< tMCURegisters& >( *this ) = core;
+
+    return result;
+}
+
+// Interprets on a core of rObserver's own, with its hooks
+template< typename tBudget, typename tObserver >
+void tMCUState::runObserved( tCore& rCore, tObserver& rObserver, uint64_t budget, tRunResult& rResult )
+{
+    tMCUCore< tMCUState, false, tObserver > observedCore( *this, rCore, rObserver );
+    observedCore.m_cycles = rCore.m_cycles;
+    m_pRunCycles = &observedCore.m_cycles;
+
+    runInterpreter< tBudget >( observedCore, budget, rResult );
+
+    static_cast< tMCURegisters& >( rCore ) = observedCore;
+    rCore.m_cycles = observedCore.m_cycles;
+    m_pRunCycles = &rCore.m_cycles;
+}
+
+//   Runs the selected engine.  The per-instruction checks (breakpoints, and I being cleared while an IRQ is
+// asserted) are compiled out entirely when they aren't needed, and so are the observer's hooks.
+template< typename tBudget >
+void tMCUState::runEngine( tCore& rCore, uint64_t budget, tRunResult& rResult )
+{
+    if( m_pObserver )
+        runObserved< tBudget >( rCore, *m_pObserver, budget, rResult );
+    else if( m_pBranchTrace )
+        runObserved< tBudget >( rCore, *m_pBranchTrace, budget, rResult );
+    else if( m_execEngine == engine_BlockCache || m_execEngine == engine_Jit || m_execEngine == engine_JitVerify )
+    {
+        if( !m_pBlockCache )
+            m_pBlockCache = new tMCUBlockCache( *this );
+
+        // Translated code doesn't check for breakpoints, so it's only used while there aren't any
+        if( needsInstructionChecks( rCore ) )
+            runBlocks< tBudget, true, jit_Off >( rCore, budget, rResult );
+        else if( m_execEngine == engine_BlockCache || !tMCUJit::isSupported() )
+            runBlocks< tBudget, false, jit_Off >( rCore, budget, rResult );
+        else
+        {
+            if( !m_pJit )
+                m_pJit = new tMCUJit( *this );
+
+            if( m_execEngine == engine_JitVerify )
+            {
+                if( !m_pJitShadow )
+                {
+                    m_pJitShadowMemory = new uint8_t[65536];
+                    memcpy( m_pJitShadowMemory, m_pMemory, 65536 );
+                    m_pJitShadow = new tMCUState( m_pJitShadowMemory );
+
+                    for( size_t rangeIndex = 0; rangeIndex < m_devices.size(); ++rangeIndex )
+                        addJitShadowDevice( m_devices[rangeIndex] );
+                }
+
+                runBlocks< tBudget, false, jit_Verify >( rCore, budget, rResult );
+            }
+            else
+                runBlocks< tBudget, false, jit_Run >( rCore, budget, rResult );
+        }
+    }
+    else if( m_execEngine == engine_Aot && m_pAotBlocks && !needsInstructionChecks( rCore ) )
+        runAot< tBudget >( rCore, budget, rResult );
+    else if( m_lazyFlags && (m_execEngine == engine_Switch || m_execEngine == engine_Threaded) )
+    {
+        tLazyCore lazyCore( *this, rCore );
+        lazyCore.m_cycles = rCore.m_cycles;
+        m_pRunCycles = &lazyCore.m_cycles;
+
+        runInterpreter< tBudget >( lazyCore, budget, rResult );
+
+        static_cast< tMCURegisters& >( rCore ) = lazyCore.getRegisters();
+        rCore.m_cycles = lazyCore.m_cycles;
+        m_pRunCycles = &rCore.m_cycles;
+    }
+    else
+        runInterpreter< tBudget >( rCore, budget, rResult );
+}
+
+// Runs engine_Threaded, or engine_Switch for everything else, on either sort of core
+template< typename tBudget, typename tRunCore >
+void tMCUState::runInterpreter( tRunCore& rCore, uint64_t budget, tRunResult& rResult )
+{
+    if( m_execEngine == engine_Threaded )
+    {
+        if( needsInstructionChecks( rCore ) )
+            runThreaded< tBudget, true >( rCore, budget, rResult );
+        else
+            runThreaded< tBudget, false >( rCore, budget, rResult );
+    }
+    else
+    {
+        if( needsInstructionChecks( rCore ) )
+            runSwitch< tBudget, true >( rCore, budget, rResult );
+        else
+            runSwitch< tBudget, false >( rCore, budget, rResult );
     }
 }
 
+template< typename tBudget, bool checkEach, typename tRunCore >
+void tMCUState::runSwitch( tRunCore& rCore, uint64_t budget, tRunResult& rResult )
+{
+    uint64_t instructions = 0;
+    eRunExit exitReason = run_Budget;
+
+    while( tBudget::used( instructions, rCore.m_cycles ) < budget )
+    {
+        if( checkEach && instructions > 0 && isBreakpoint( rCore.regPC ) )
+        {
+            exitReason = run_Breakpoint;
+            break;
+        }
+
+        if( checkEach && instructions > 0 && interruptPending( rCore ) )
+        {
+            exitReason = run_SerialOutput;
+            break;
+        }
+
+        uint16_t pc = rCore.regPC;
+        uint8_t opCode = rCore.pcReadByte();
+        recordInstruction( rCore, pc, opCode );
+        rCore.observeInstructionBegin( pc, opCode );
+        uint64_t startCycles = rCore.m_cycles;
+        mcuExecuteOpCode( rCore, opCode );
+
+        ++instructions;
+        rCore.m_cycles += s_opCodeCycles[opCode];
+        rCore.m_rObserver.instructionEnd( rCore.getRegisters(), static_cast<unsigned>(rCore.m_cycles - startCycles) );
+
+        if( opCodeExit( opCode ) != run_Budget )
+        {
+            exitReason = opCodeExit( opCode );
+            break;
+        }
+
+        if( m_runExitRequest )
+        {
+            exitReason = run_SerialOutput;
+            break;
+        }
+    }
+
+    rResult.m_exit = exitReason;
+    rResult.m_instructions = instructions;
+    rResult.m_cycles = rCore.m_cycles;
+}
+
+// Runs translated blocks where there are any, and interprets one instruction at a time everywhere else (e.g. code
+// in RAM).  Translated code returns early if it writes to the serial port or to translated code, so that the exit
+// is taken or the stale block is dropped straight away.
+//   Breakpoints aren't checked inside translated blocks, so run() falls back to runSwitch() while any are set (or
+// while a masked IRQ is waiting for I to be cleared).
+template< typename tBudget >
+void tMCUState::runAot( tCore& rCore, uint64_t budget, tRunResult& rResult )
+{
+    uint64_t instructions = 0;
+    eRunExit exitReason = run_Budget;
+
+    while( tBudget::used( instructions, rCore.m_cycles ) < budget )
+    {
+        const tAotBlock *pBlock = m_pAotBlocks[rCore.regPC];
+
+        if( pBlock && tBudget::used( instructions + pBlock->m_instructions, rCore.m_cycles + pBlock->m_cycles ) <= budget )
+        {
+            tHistoryEntry& rHistory = recordTranslated( rCore, rCore.regPC, m_pMemory[rCore.regPC] );
+            tAotResult executed = pBlock->m_pFunction( rCore );
+            addHistoryCount( rHistory, executed.m_instructions );
+
+            instructions += executed.m_instructions;
+            rCore.m_cycles += executed.m_cycles;
+            m_codeModified = false;
+        }
+        else
+        {
+            uint16_t pc = rCore.regPC;
+            uint8_t opCode = rCore.pcReadByte();
+            recordInstruction( rCore, pc, opCode );
+            mcuExecuteOpCode( rCore, opCode );
+
+            ++instructions;
+            rCore.m_cycles += s_opCodeCycles[opCode];
+
+            if( opCodeExit( opCode ) != run_Budget )
+            {
+                exitReason = opCodeExit( opCode );
+                break;
+            }
+        }
+
+        if( m_runExitRequest )
+        {
+            exitReason = run_SerialOutput;
+            break;
+        }
+    }
+
+    rResult.m_exit = exitReason;
+    rResult.m_instructions = instructions;
+    rResult.m_cycles = rCore.m_cycles;
+}
+
+// Runs predecoded blocks, so that the opcode fetch and operand decoding are only done once per block rather
+// than on every pass through a loop.  A write to a page holding predecoded code sets m_codeModified, which
+// makes this leave the current block straight away and look the next one up again.
+//   With the JIT enabled, blocks that have run tMCUJit::cHotThreshold times are translated, and from then on
+// their translated code is run instead whenever there's enough budget left for all of it.  Translated code goes
+// on into any translated blocks it reaches, and only comes back here at one that isn't translated.
+template< typename tBudget, bool checkEach, tMCUState::eJitMode jitMode >
+void tMCUState::runBlocks( tCore& rCore, uint64_t budget, tRunResult& rResult )
+{
+    uint64_t instructions = 0;
+    eRunExit exitReason = run_Budget;
+    bool running = true;
+
+    m_codeModified = false;
+
+    while( running && tBudget::used( instructions, rCore.m_cycles ) < budget )
+    {
+        tDecodedBlock *pBlock = m_pBlockCache->lookup( rCore.regPC );
+
+        if( jitMode != jit_Off )
+        {
+            if( !pBlock->m_pNative && pBlock->m_executions < tMCUJit::cHotThreshold && ++pBlock->m_executions == tMCUJit::cHotThreshold )
+                m_pJit->translate( *pBlock );
+
+            if( pBlock->m_pNative )
+            {
+                // Translated code runs on through other translated blocks for as long as the budget allows
+                uint64_t budgetLeft = budget - tBudget::used( instructions, rCore.m_cycles );
+
+                tJitContext context;
+                context.m_instructionsLeft = static_cast<int32_t>(std::min( tBudget::maxInstructions( budgetLeft ), cMaxNativeRun ));
+                context.m_cyclesLeft = static_cast<int32_t>(std::min( tBudget::maxCycles( budgetLeft ), cMaxNativeRun ));
+
+                tHistoryEntry& rHistory = recordTranslated( rCore, rCore.regPC, pBlock->m_instructions[0].m_opCode );
+                bool verified = runNative( rCore, *pBlock, jitMode == jit_Verify, context );
+
+                uint32_t executed = context.m_instructionLimit - context.m_instructionsLeft;
+                addHistoryCount( rHistory, executed );
+                instructions += executed;
+                rCore.m_cycles += context.m_cycleLimit - context.m_cyclesLeft;
+
+                if( !verified )
+                {
+                    exitReason = run_VerifyFailed;
+                    break;
+                }
+
+                if( m_runExitRequest )
+                {
+                    exitReason = run_SerialOutput;
+                    break;
+                }
+
+                if( m_codeModified )
+                {
+                    m_codeModified = false;
+                    m_pBlockCache->releaseRetired();
+                    continue;
+                }
+
+                //   Otherwise it only gives up without executing anything when the first instruction needs the
+                // interpreter (e.g. ADC in decimal mode), or there isn't the budget for all of the block - run the
+                // block's handlers instead
+                if( executed > 0 )
+                    continue;
+            }
+        }
+
+        const tDecodedInstruction *pInstruction = &pBlock->m_instructions[0];
+        const tDecodedInstruction *pBlockEnd = pInstruction + pBlock->m_instructions.size();
+
+        for( ; pInstruction != pBlockEnd; ++pInstruction )
+        {
+            if( tBudget::used( instructions, rCore.m_cycles ) >= budget )
+            {
+                running = false;
+                break;
+            }
+
+            if( checkEach && instructions > 0 && isBreakpoint( rCore.regPC ) )
+            {
+                exitReason = run_Breakpoint;
+                running = false;
+                break;
+            }
+
+            if( checkEach && instructions > 0 && interruptPending( rCore ) )
+            {
+                exitReason = run_SerialOutput;
+                running = false;
+                break;
+            }
+
+            recordInstruction( rCore, rCore.regPC, pInstruction->m_opCode );
+            rCore.regPC = pInstruction->m_nextPC;
+            pInstruction->m_pHandler( rCore, pInstruction->m_operand );
+
+            ++instructions;
+            rCore.m_cycles += pInstruction->m_cycles;
+
+            if( opCodeExit( pInstruction->m_opCode ) != run_Budget )
+            {
+                exitReason = opCodeExit( pInstruction->m_opCode );
+                running = false;
+                break;
+            }
+
+            if( m_runExitRequest )
+            {
+                exitReason = run_SerialOutput;
+                running = false;
+                break;
+            }
+
+            if( m_codeModified )
+            {
+                // pBlock may have just been retired - don't touch it again
+                m_codeModified = false;
+                m_pBlockCache->releaseRetired();
+                break;
+            }
+        }
+    }
+
+    m_pBlockCache->releaseRetired();
+
+    rResult.m_exit = exitReason;
+    rResult.m_instructions = instructions;
+    rResult.m_cycles = rCore.m_cycles;
+}
+
+//   When verifying, the shadow state is brought into line with this one (memory, registers, cycle count, devices,
+// interrupt lines and serial FIFOs), and the interpreter then runs the same number of instructions that the
+// translated code did.  Everything has to match afterwards, cycle count included.  Slow, but it catches translation
+// bugs at the call into translated code they happen in.
+bool tMCUState::runNative( tCore& rCore, tDecodedBlock& rBlock, bool verify, tJitContext& rContext )
+{
+    if( verify )
+    {
+        memcpy( m_pJitShadow->m_pMemory, m_pMemory, 65536 );
+        static_cast< tMCURegisters& >( *m_pJitShadow ) = rCore;
+        m_pJitShadow->m_cycleCount = getCycleCount();
+
+        tMCUVia::tSavedState via;
+        m_via.saveState( via );
+        m_pJitShadow->m_via.restoreState( via, true );
+
+        for( size_t rangeIndex = 0; rangeIndex < m_devices.size(); ++rangeIndex )
+        {
+            if( m_devices[rangeIndex].m_pJitShadowDevice )
+                m_devices[rangeIndex].m_pDevice->copyTo( *m_devices[rangeIndex].m_pJitShadowDevice );
+        }
+
+        m_pJitShadow->m_irqLines = m_irqLines.load();
+        m_pJitShadow->m_nmiLine = m_nmiLine.load();
+        m_pJitShadow->m_nmiPending = m_nmiPending.load();
+
+        m_pJitShadow->m_serialToMCUFIFO = m_serialToMCUFIFO;
+        m_pJitShadow->m_serialToMCUCount = m_serialToMCUCount.load();
+        m_pJitShadow->m_serialFromMCUFIFO = m_serialFromMCUFIFO;
+    }
+
+    rContext.m_pRegisters = &rCore;
+    rContext.m_pMemory = m_pMemory;
+    rContext.m_pCodePages = m_codePages;
+    rContext.m_pState = this;
+    rContext.m_pRunExitRequest = &m_runExitRequest;
+    rContext.m_instructionLimit = rContext.m_instructionsLeft;
+    rContext.m_cycleLimit = rContext.m_cyclesLeft;
+    rContext.m_pRunCycles = &rCore.m_cycles;
+    rContext.m_accessCycles = 0;
+
+    rBlock.m_pNative( &rContext );
+
+    if( !verify )
+        return true;
+
+    uint64_t remaining = rContext.m_instructionLimit - rContext.m_instructionsLeft;
+    uint64_t cycles = getCycleCount() + (rContext.m_cycleLimit - rContext.m_cyclesLeft);
+
+    // A shadow that gets nowhere (halted, say) has gone its own way
+    while( remaining > 0 )
+    {
+        uint64_t executed = m_pJitShadow->runInstructions( remaining ).m_instructions;
+        if( executed == 0 )
+            break;
+
+        remaining -= executed;
+    }
+
+    bool sameDevices = true;
+    for( size_t rangeIndex = 0; rangeIndex < m_devices.size(); ++rangeIndex )
+    {
+        const tDeviceRange& rRange = m_devices[rangeIndex];
+        sameDevices = sameDevices && (!rRange.m_pJitShadowDevice || rRange.m_pDevice->sameAs( *rRange.m_pJitShadowDevice ));
+    }
+
+    if( remaining == 0 && sameDevices
+        && static_cast< const tMCURegisters& >( *m_pJitShadow ) == rCore
+        && m_pJitShadow->getCycleCount() == cycles
+        && memcmp( m_pJitShadow->m_pMemory, m_pMemory, 65536 ) == 0
+        && m_pJitShadow->m_irqLines == m_irqLines
+        && m_pJitShadow->m_serialToMCUFIFO == m_serialToMCUFIFO
+        && m_pJitShadow->m_serialFromMCUFIFO == m_serialFromMCUFIFO )
+        return true;
+
+    m_verifyFailPC = rBlock.m_startPC;
+    return false;
+}
+
+// Rather than returning to a shared switch after every instruction, each handler finishes with its own
+// copy of the dispatch.  The host branch predictor then gets a separate history for "what follows opcode N",
+// which suits the short repetitive loops of the monitor ROM far better than a single indirect branch.
+template< typename tBudget, bool checkEach, typename tRunCore >
+void tMCUState::runThreaded( tRunCore& rCore, uint64_t budget, tRunResult& rResult )
+{
+    uint64_t instructions = 0;
+    uint64_t startCycles = 0; // Only for the observer
+    eRunExit exitReason = run_Budget;
+
+#ifdef MCU_COMPUTED_GOTO
+
+#define THREAD_LABEL_ADDRESS( opCode ) &&threadedOp_ ## opCode,
+#define THREAD_DISPATCH() \
+    if( m_runExitRequest ) { exitReason = run_SerialOutput; goto threadedExit; } \
+    if( tBudget::used( instructions, rCore.m_cycles ) >= budget ) goto threadedExit; \
+    if( checkEach && instructions > 0 && isBreakpoint( rCore.regPC ) ) { exitReason = run_Breakpoint; goto threadedExit; } \
+    if( checkEach && instructions > 0 && interruptPending( rCore ) ) { exitReason = run_SerialOutput; goto threadedExit; } \
+    goto *s_dispatchTable[ rCore.pcReadByte() ];
+#define THREAD_HANDLER( opCode ) \
+    threadedOp_ ## opCode: \
+    recordInstruction( rCore, static_cast<uint16_t>(rCore.regPC - 1), (opCode) ); \
+    rCore.observeInstructionBegin( static_cast<uint16_t>(rCore.regPC - 1), (opCode) ); \
+    startCycles = rCore.m_cycles; \
+    mcuInstructionExecute< (opCode) >( rCore ); \
+    ++instructions; \
+    rCore.m_cycles += s_opCodeCycles[ (opCode) ]; \
+    rCore.m_rObserver.instructionEnd( rCore.getRegisters(), static_cast<unsigned>(rCore.m_cycles - startCycles) ); \
+    if( opCodeExit( opCode ) != run_Budget ) { exitReason = opCodeExit( opCode ); goto threadedExit; } \
+    THREAD_DISPATCH();
+
+    static void * const s_dispatchTable[256] = { EACH_OPCODE_256( THREAD_LABEL_ADDRESS ) };
+
+    THREAD_DISPATCH();
+    EACH_OPCODE_256( THREAD_HANDLER );
+
+threadedExit:
+
+#undef THREAD_HANDLER
+#undef THREAD_DISPATCH
+#undef THREAD_LABEL_ADDRESS
+
+#else
+
+    // No computed goto (e.g. MSVC) - fall back to a handler table, which still avoids the switch's bounds check
+#define THREAD_HANDLER_ADDRESS( opCode ) &mcuInstructionExecute< (opCode), tRunCore >,
+
+    static void (* const s_handlerTable[256])( tRunCore& ) = { EACH_OPCODE_256( THREAD_HANDLER_ADDRESS ) };
+
+    while( tBudget::used( instructions, rCore.m_cycles ) < budget )
+    {
+        if( checkEach && instructions > 0 && isBreakpoint( rCore.regPC ) )
+        {
+            exitReason = run_Breakpoint;
+            break;
+        }
+
+        if( checkEach && instructions > 0 && interruptPending( rCore ) )
+        {
+            exitReason = run_SerialOutput;
+            break;
+        }
+
+        uint16_t pc = rCore.regPC;
+        uint8_t opCode = rCore.pcReadByte();
+        recordInstruction( rCore, pc, opCode );
+        rCore.observeInstructionBegin( pc, opCode );
+        startCycles = rCore.m_cycles;
+        s_handlerTable[opCode]( rCore );
+
+        ++instructions;
+        rCore.m_cycles += s_opCodeCycles[opCode];
+        rCore.m_rObserver.instructionEnd( rCore.getRegisters(), static_cast<unsigned>(rCore.m_cycles - startCycles) );
+
+        if( opCodeExit( opCode ) != run_Budget )
+        {
+            exitReason = opCodeExit( opCode );
+            break;
+        }
+
+        if( m_runExitRequest )
+        {
+            exitReason = run_SerialOutput;
+            break;
+        }
+    }
+
+#undef THREAD_HANDLER_ADDRESS
+
+#endif
+
+    rResult.m_exit = exitReason;
+    rResult.m_instructions = instructions;
+    rResult.m_cycles = rCore.m_cycles;
+}
+
 // Decodes the current instruction into a human readable string
 std::string tMCUState::decodeFullOpcode( uint16_t memPos )
 {
@@ -73,10 +1179,10 @@ uint8_t tMCUState::decodeAddressingLength( uint16_t memPos )
 
     switch( opCode )
     {
-    EXEC_OPCODE_64( 0, mcuInstructionDecodeLength );
-    EXEC_OPCODE_64( 1 * 64, mcuInstructionDecodeLength );
-    EXEC_OPCODE_64( 2 * 64, mcuInstructionDecodeLength );
-    EXEC_OPCODE_64( 3 * 64, mcuInstructionDecodeLength );
+    EXEC_OPCODE_64( 0, mcuInstructionDecodeLength, *this );
+    EXEC_OPCODE_64( 1 * 64, mcuInstructionDecodeLength, *this );
+    EXEC_OPCODE_64( 2 * 64, mcuInstructionDecodeLength, *this );
+    EXEC_OPCODE_64( 3 * 64, mcuInstructionDecodeLength, *this );
     }
 
     return 0;
@@ -94,15 +1200,28 @@ std::string tMCUState::decodeOpcodeDirect( uint8_t opCode )
 {
     switch( opCode )
     {
-    EXEC_OPCODE_64( 0, mcuInstructionName );
-    EXEC_OPCODE_64( 1 * 64, mcuInstructionName );
-    EXEC_OPCODE_64( 2 * 64, mcuInstructionName );
-    EXEC_OPCODE_64( 3 * 64, mcuInstructionName );
+    EXEC_OPCODE_64( 0, mcuInstructionName, *this );
+    EXEC_OPCODE_64( 1 * 64, mcuInstructionName, *this );
+    EXEC_OPCODE_64( 2 * 64, mcuInstructionName, *this );
+    EXEC_OPCODE_64( 3 * 64, mcuInstructionName, *this );
     }
 
     return "??";
 }
 
+unsigned tMCUState::decodeAddressingModeDirect( uint8_t opCode )
+{
+    switch( opCode )
+    {
+    EXEC_OPCODE_64( 0, mcuInstructionAddressingMode, *this );
+    EXEC_OPCODE_64( 1 * 64, mcuInstructionAddressingMode, *this );
+    EXEC_OPCODE_64( 2 * 64, mcuInstructionAddressingMode, *this );
+    EXEC_OPCODE_64( 3 * 64, mcuInstructionAddressingMode, *this );
+    }
+
+    return cAddressingModeImplied;
+}
+
 std::string tMCUState::decodeAddressing( uint16_t memPos )
 {
     uint8_t opCode = memReadByte( memPos );
@@ -110,10 +1229,10 @@ std::string tMCUState::decodeAddressing( uint16_t memPos )
 
     switch( opCode )
     {
-    EXEC_OPCODE_64( 0, mcuInstructionDecodeAddressing );
-    EXEC_OPCODE_64( 1 * 64, mcuInstructionDecodeAddressing );
-    EXEC_OPCODE_64( 2 * 64, mcuInstructionDecodeAddressing );
-    EXEC_OPCODE_64( 3 * 64, mcuInstructionDecodeAddressing );
+    EXEC_OPCODE_64( 0, mcuInstructionDecodeAddressing, *this );
+    EXEC_OPCODE_64( 1 * 64, mcuInstructionDecodeAddressing, *this );
+    EXEC_OPCODE_64( 2 * 64, mcuInstructionDecodeAddressing, *this );
+    EXEC_OPCODE_64( 3 * 64, mcuInstructionDecodeAddressing, *this );
     }
 
     return "";
@@ -164,30 +1283,252 @@ std::string tMCUState::decodeAddressing( eAddressingMode_Null mode )
     return "";
 }
 
+// The mutex is only taken so that a waitForInput() can't miss the notification
+void tMCUState::setIRQLine( unsigned source, bool asserted )
+{
+    assert( source < 32 );
+
+    if( !asserted )
+    {
+        m_irqLines &= ~(1u << source);
+        return;
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( m_serialMutex );
+        m_irqLines |= 1u << source;
+    }
+
+    m_runExitRequest |= cRunExitInterrupt;
+    m_wakeUp.notify_all();
+}
+
+void tMCUState::setNMILine( bool asserted )
+{
+    if( !asserted )
+    {
+        m_nmiLine = false;
+        return;
+    }
+
+    if( m_nmiLine.exchange( true ) )
+        return;
+
+    {
+        std::lock_guard< std::mutex > lock( m_serialMutex );
+        m_nmiPending = true;
+    }
+
+    m_runExitRequest |= cRunExitInterrupt;
+    m_wakeUp.notify_all();
+}
+
+// Events due at the same cycle fire in the order they were scheduled.  Only a handful of devices ever have events
+// pending, so a sorted vector beats a heap here.
+void tMCUState::scheduleEvent( tMCUEvent *pEvent, uint64_t cycle )
+{
+    // Scheduled from inside the engine (e.g. by a device), which has to stop earlier than run() told it to
+    if( m_pRunCycles && cycle < m_nextEventCycle )
+        requestRunExit( cRunExitEvent );
+
+    cancelEvent( pEvent );
+
+    std::vector< tScheduledEvent >::iterator insertPos = m_events.begin();
+    while( insertPos != m_events.end() && insertPos->m_cycle > cycle )
+        ++insertPos;
+
+    tScheduledEvent event;
+    event.m_cycle = cycle;
+    event.m_pEvent = pEvent;
+    m_events.insert( insertPos, event );
+
+    eventsChanged();
+}
+
+void tMCUState::cancelEvent( tMCUEvent *pEvent )
+{
+    for( std::vector< tScheduledEvent >::iterator eventPos = m_events.begin(); eventPos != m_events.end(); ++eventPos )
+    {
+        if( eventPos->m_pEvent == pEvent )
+        {
+            m_events.erase( eventPos );
+            eventsChanged();
+            return;
+        }
+    }
+}
+
+bool tMCUState::isEventScheduled( const tMCUEvent *pEvent ) const
+{
+    for( size_t eventIndex = 0; eventIndex < m_events.size(); ++eventIndex )
+    {
+        if( m_events[eventIndex].m_pEvent == pEvent )
+            return true;
+    }
+
+    return false;
+}
+
+uint64_t tMCUState::getEventCycle( const tMCUEvent *pEvent ) const
+{
+    for( size_t eventIndex = 0; eventIndex < m_events.size(); ++eventIndex )
+    {
+        if( m_events[eventIndex].m_pEvent == pEvent )
+            return m_events[eventIndex].m_cycle;
+    }
+
+    return UINT64_MAX;
+}
+
+void tMCUState::fireEvents()
+{
+    while( !m_events.empty() && m_events.back().m_cycle <= m_cycleCount )
+    {
+        tScheduledEvent event = m_events.back();
+        m_events.pop_back();
+        eventsChanged();
+
+        event.m_pEvent->fire( event.m_cycle );
+    }
+}
+
+void tMCUState::takeInterrupt( tCore& rCore )
+{
+    // NMI goes first - it can't be masked
+    bool nmi = m_nmiPending.exchange( false );
+
+    if( m_pRewind )
+        m_pRewind->recordInterrupt( m_instructionCount, nmi );
+
+    uint16_t returnAddress = rCore.regPC;
+    rCore.interrupt( nmi ? cNMIVector : cIRQVector );
+    rCore.addCycles( cInterruptCycles );
+
+    if( m_pBranchTrace )
+        m_pBranchTrace->recordInterrupt( m_instructionCount, returnAddress, rCore.regPC );
+}
+
+void tMCUState::replayInterrupt( bool nmi )
+{
+    if( nmi )
+        m_nmiPending = false;
+
+    m_pRewind->recordInterrupt( m_instructionCount, nmi );
+
+    tCore core( *this, *this );
+    core.interrupt( nmi ? cNMIVector : cIRQVector );
+    core.addCycles( cInterruptCycles );
+
+    static_cast< tMCURegisters& >( *this ) = core;
+    m_cycleCount += core.m_cycles;
+}
+
 void tMCUState::serialToMCUPushByte( uint8_t byte )
 {
-    m_serialToMCUFIFO.push( byte );
+    {
+        std::lock_guard< std::mutex > lock( m_serialMutex );
+        m_serialToMCUFIFO.push( byte );
+        m_serialToMCUCount.store( m_serialToMCUFIFO.size(), std::memory_order_release );
+    }
+
+    m_wakeUp.notify_all();
 }
 
+// Only this thread pops, so the FIFO can't empty between the check and the lock
 uint8_t tMCUState::serialToMCUPopByte()
 {
-    if( m_serialToMCUFIFO.empty() )
+    if( serialToMCUEmpty() )
         return 0;
 
+    std::lock_guard< std::mutex > lock( m_serialMutex );
+
     uint8_t serialData = m_serialToMCUFIFO.front();
     m_serialToMCUFIFO.pop();
+    m_serialToMCUCount.store( m_serialToMCUFIFO.size(), std::memory_order_release );
 
     return serialData;
 }
 
 bool tMCUState::serialToMCUEmpty()
 {
-    return m_serialToMCUFIFO.empty();
+    return m_serialToMCUCount.load( std::memory_order_acquire ) == 0;
+}
+
+bool tMCUState::waitForInput( unsigned timeoutMilliseconds )
+{
+    std::unique_lock< std::mutex > lock( m_serialMutex );
+    return m_wakeUp.wait_for( lock, std::chrono::milliseconds( timeoutMilliseconds ),
+                              [this]() { return !m_serialToMCUFIFO.empty() || m_irqLines != 0 || m_nmiPending; } );
+}
+
+uint8_t tMCUState::serialReceive()
+{
+    // Going forward again after stepping back, bytes are read exactly where they were the first time
+    bool available = m_pRewind && m_pRewind->isReplaying() ? m_pRewind->isSerialReadReplayed() : !serialToMCUEmpty();
+
+    if( !available )
+    {
+        if( m_pRewind )
+            m_pRewind->recordEmptyRead();
+
+        // Have run() look at what the MCU is doing - it may be waiting for input
+        if( m_idleDetection )
+            requestRunExit( cRunExitSerialPoll );
+
+        return 0;
+    }
+
+    uint8_t serialData = serialToMCUPopByte();
+
+    if( m_pRewind )
+        m_pRewind->recordSerialRead( serialData );
+
+    return serialData;
+}
+
+//   Looks for a conditional branch back to an absolute read of cSerialRx right in front of it, that the flags
+// from the read will take.  PC is either on the branch (it's just done the read) or on the read (translated code
+// went round the loop before returning).  Reading the empty port changes nothing, so the MCU does exactly the
+// same thing until input arrives.
+bool tMCUState::isIdleLoop( const tMCURegisters& registers )
+{
+    uint16_t branchPC = registers.regPC;
+    uint8_t opCode = memFetchByte( branchPC );
+
+    if( (opCode & 0x1F) != 0x10 )
+    {
+        branchPC = static_cast<uint16_t>(branchPC + 3);
+        opCode = memFetchByte( branchPC );
+
+        if( (opCode & 0x1F) != 0x10 )
+            return false;
+    }
+
+    // Branch opcodes are xxy10000 - xx picks N/V/C/Z and y is the value that takes the branch
+    static const uint8_t cBranchFlags[4] = { flag_N, flag_V, flag_C, flag_Z };
+    bool flagSet = (registers.regP & cBranchFlags[opCode >> 6]) != 0;
+
+    if( flagSet != ((opCode & 0x20) != 0) )
+        return false;
+
+    // The branch has to go back 5 bytes, to the read
+    if( memFetchByte( static_cast<uint16_t>(branchPC + 1) ) != 0xFB )
+        return false;
+
+    uint16_t readPC = static_cast<uint16_t>(branchPC - 3);
+    uint8_t readOpCode = memFetchByte( readPC );
+
+    if( readOpCode != 0xAD && readOpCode != 0xAE && readOpCode != 0xAC && readOpCode != 0x2C ) // LDA/LDX/LDY/BIT abs
+        return false;
+
+    return memFetchByte( static_cast<uint16_t>(readPC + 1) ) == (cSerialRx & 0xFF) &&
+           memFetchByte( static_cast<uint16_t>(readPC + 2) ) == (cSerialRx >> 8);
 }
 
 void tMCUState::serialFromMCUPushByte( uint8_t byte )
 {
     m_serialFromMCUFIFO.push( byte );
+    requestRunExit( cRunExitSerialOutput );
 }
 
 uint8_t tMCUState::serialFromMCUPopByte()
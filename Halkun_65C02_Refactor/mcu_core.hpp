@@ -4,10 +4,14 @@
 #include <cstdint>
 #include <cassert>
 #include <string>
+#include <cstring>
 
 #include <queue>
-
-#include "mcu_trace.hpp"
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
 
 enum eFlags
 {
@@ -39,6 +43,24 @@ enum eAddressingMode_Mem
     am_AbsIdxIndirect, // Introduced in 65c02
 };
 
+// Selects how pcExecute( instructions ) dispatches each opcode
+enum eExecEngine
+{
+    engine_Switch,   // One call and one shared switch per instruction
+    engine_Threaded, // Dispatch copied into the end of every handler (computed goto where supported)
+    engine_BlockCache, // Runs predecoded basic blocks from a tMCUBlockCache
+    engine_Jit,      // As engine_BlockCache, but hot blocks are translated to native code (x86-64 only)
+    engine_JitVerify, // As engine_Jit, but every translated block is also run on a shadow copy by the interpreter and compared
+    engine_Aot,      // Runs blocks translated ahead of time by tMCUAot (see setAotBlocks()), and interprets everything else
+};
+
+class tMCUBlockCache;
+struct tDecodedBlock;
+class tMCUJit;
+struct tJitContext;
+class tMCUAot;
+struct tAotBlock;
+
 // This addressing mode allows direct access to the registers
 enum eAddressingMode_Register
 {
@@ -51,7 +73,39 @@ enum eAddressingMode_Null
     am_Implied,
 };
 
-struct tMCUState
+// Why runInstructions()/runCycles() returned
+enum eRunExit
+{
+    run_Budget,         // The instruction/cycle budget has been used up
+    run_SerialOutput,   // The MCU wrote to the serial port, and the byte is waiting in the FIFO
+    run_Break,          // A BRK instruction was executed - PC is now in the IRQ handler, or after the BRK if I was set
+    run_Breakpoint,     // PC reached a breakpoint - the instruction there has not been executed yet
+    run_VerifyFailed,   // engine_JitVerify found translated code disagreeing with the interpreter - see getVerifyFailPC()
+    run_Idle,           // With idle detection on, the MCU is spinning on an empty serial port - see waitForInput()
+    run_Wait,           // The MCU is waiting in a WAI instruction - running again does nothing until there's serial input or an interrupt
+    run_Stop,           // The MCU has executed STP - running again does nothing until cpuReset()
+};
+
+struct tRunResult
+{
+    eRunExit m_exit;
+    uint64_t m_instructions;    // Number of instructions executed
+    uint64_t m_cycles;          // Number of cycles used by those instructions
+
+    tRunResult() : m_exit( run_Budget ), m_instructions( 0 ), m_cycles( 0 ) {}
+};
+
+// For the accessors - their tests of the addressing mode only fold away once they're inlined into an instruction
+#if defined(__GNUC__)
+#define MCU_FORCE_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define MCU_FORCE_INLINE __forceinline
+#else
+#define MCU_FORCE_INLINE inline
+#endif
+
+// The programmer visible registers
+struct tMCURegisters
 {
     uint8_t regA; // Accumulator
     uint8_t regX; // Index register X
@@ -60,104 +114,137 @@ struct tMCUState
     uint16_t regPC; // Program counter
     uint8_t regSP; // Stack pointer
 
-    uint8_t *m_pMemory; // Pointer to memory
-
-#ifdef DO_MCU_TRACE
-    tMemoryTraceQueue m_memTrace;
-    const uint8_t *m_pReadSequence;
-    uint8_t m_lastWriteResult;
-
-    void setTraceState( const tTraceState& rTrace )
+    bool operator==( const tMCURegisters& rOther ) const
     {
-        regA = rTrace.regA;
-        regX = rTrace.regX;
-        regY = rTrace.regY;
-        regP = rTrace.regP;
-        regPC = rTrace.regPC;
-        regSP = rTrace.regSP;
+        return regA == rOther.regA && regX == rOther.regX && regY == rOther.regY && regP == rOther.regP
+            && regPC == rOther.regPC && regSP == rOther.regSP;
     }
 
-    tTraceState getTraceState()
-    {
-        tTraceState trace;
+    bool operator!=( const tMCURegisters& rOther ) const { return !(*this == rOther); }
+};
 
-        trace.regA = regA;
-        trace.regX = regX;
-        trace.regY = regY;
-        trace.regP = regP;
-        trace.regPC = regPC;
-        trace.regSP = regSP;
+//   Hooks into what the core does, for coverage, profiling, watchpoints and the like.  The observer is a template
+// parameter of tMCUCore, which calls these directly - tMCUNullObserver's do nothing, and compile away.  An
+// observer of its own derives from this and hides whichever of them it wants.
+//   instructionBegin() has the registers as the instruction starts (PC at its opcode), and instructionEnd() has
+// them as it left them, with the cycles it took.  Memory reads and writes are everything but the opcode and
+// address fetches - immediate and branch operands count as reads, and so does the stack.
+//   branchTaken() is for every branch that goes (BRA included), with PC already moved to target, and
+// conditionalBranch() says whether one of the 8 conditional branches went, before it does.  indirectJump() is
+// JMP ($nnnn) and JMP ($nnnn,X).  The return addresses are where the matching RTS or RTI goes back to:
+// subroutineCall() and breakInstruction() have the one that was pushed, and subroutineReturn() and
+// interruptReturn() the one that was popped.  A BRK with I set isn't vectored, and then its target is just
+// the next instruction.
+struct tMCUNullObserver
+{
+    void instructionBegin( const tMCURegisters& /*registers*/, uint8_t /*opCode*/ ) {}
+    void instructionEnd( const tMCURegisters& /*registers*/, unsigned /*cycles*/ ) {}
+    void memoryRead( uint16_t /*address*/, uint8_t /*data*/ ) {}
+    void memoryWrite( uint16_t /*address*/, uint8_t /*data*/ ) {}
+    void branchTaken( uint16_t /*target*/ ) {}
+    void conditionalBranch( bool /*taken*/ ) {}
+    void indirectJump( uint16_t /*target*/ ) {}
+    void subroutineCall( uint16_t /*target*/, uint16_t /*returnAddress*/ ) {}
+    void subroutineReturn( uint16_t /*returnAddress*/ ) {}
+    void breakInstruction( bool /*vectored*/, uint16_t /*returnAddress*/, uint16_t /*target*/ ) {}
+    void interruptReturn( uint16_t /*returnAddress*/ ) {}
 
-        return trace;
-    }
-#endif
+    // What tMCUCore is given when it isn't given an observer
+    static tMCUNullObserver& instance() { static tMCUNullObserver s_instance; return s_instance; }
+};
 
-    // Constants
-    static const uint16_t cResetVector  = 0xFFFC; // Address where the reset vector should be
-    static const uint16_t cIRQVector    = 0xFFFE; // Address where the IRQ vector should be
+//   The same hooks, for an observer attached at run time with tMCUState::setObserver().  While there is one, run()
+// uses an instantiation of the interpreter on a core that calls these (see tMCUState::tObservedCore), and goes
+// back to the hook-free one as soon as it's detached.
+class tMCUObserver
+{
+public:
+    virtual ~tMCUObserver() {}
+
+    virtual void instructionBegin( const tMCURegisters& /*registers*/, uint8_t /*opCode*/ ) {}
+    virtual void instructionEnd( const tMCURegisters& /*registers*/, unsigned /*cycles*/ ) {}
+    virtual void memoryRead( uint16_t /*address*/, uint8_t /*data*/ ) {}
+    virtual void memoryWrite( uint16_t /*address*/, uint8_t /*data*/ ) {}
+    virtual void branchTaken( uint16_t /*target*/ ) {}
+    virtual void conditionalBranch( bool /*taken*/ ) {}
+    virtual void indirectJump( uint16_t /*target*/ ) {}
+    virtual void subroutineCall( uint16_t /*target*/, uint16_t /*returnAddress*/ ) {}
+    virtual void subroutineReturn( uint16_t /*returnAddress*/ ) {}
+    virtual void breakInstruction( bool /*vectored*/, uint16_t /*returnAddress*/, uint16_t /*target*/ ) {}
+    virtual void interruptReturn( uint16_t /*returnAddress*/ ) {}
+};
+
+// The CPU core that the instruction templates operate on - a copy of the registers, plus the helpers the
+// instructions use.  All memory accesses go through tBus - tMCUState itself, or one of the buses in mcu_bus.hpp.
+//   The run loops keep one of these as a local, so the compiler is free to hold the registers in host
+// registers for the whole loop instead of reloading them after every store to guest memory.
+//   With lazyFlags, N, Z, C and V are kept in separate members rather than in regP.  Setting them is then a plain
+// store of the result instead of a read-modify-write of regP, and regP is only put back together by getRegP()
+// (i.e. for PHP, BRK, RTI/PLP and when the run loop hands the registers back).  The instructions have to go
+// through getRegP()/setRegP() rather than touching regP directly.
+//   Everything the instructions and run loops do is reported to tObserver (see tMCUNullObserver).
+template< typename tBus, bool lazyFlags = false, typename tObserver = tMCUNullObserver >
+struct tMCUCore : public tMCURegisters
+{
     static const uint16_t cStackOffset  = 0x0100; // Address in memory where the stack is offset
-    static const uint16_t cSerialTx     = 0x0302; // Write a byte here to transmit data over the serial port
-    static const uint16_t cSerialRx     = 0x0303; // Read a byte here to receive data over the serial port
+    static const uint8_t cLazyFlags     = flag_N | flag_Z | flag_C | flag_V;
 
-    // Constructor - pass in 64k of memory
-    tMCUState( uint8_t *pMemory )
-        : m_pMemory( pMemory )
-        , m_decodePos( 0 )
-#ifdef DO_MCU_TRACE
-        , m_pReadSequence( 0 )
-#endif
-    { cpuReset(); }
+    tBus& m_rBus;
+    tObserver& m_rObserver;
 
-    // Useful functions
-    void cpuReset()
+    //   Cycles used since the run loop last zeroed this.  The run loops add each instruction's
+    // tMCUState::opCodeCycles() once it's done, and the instructions add anything on top (page crossings, taken
+    // branches and decimal mode) as they go.
+    uint64_t m_cycles;
+
+    // Only used with lazyFlags
+    uint8_t m_flagN; // N is bit 7 of this
+    uint8_t m_flagZ; // Z is set when this is zero
+    bool m_flagC;
+    bool m_flagV;
+
+    tMCUCore( tBus& rBus, const tMCURegisters& rRegisters, tObserver& rObserver = tObserver::instance() )
+        : tMCURegisters( rRegisters ), m_rBus( rBus ), m_rObserver( rObserver ), m_cycles( 0 ), m_flagN( 0 ), m_flagZ( 1 ), m_flagC( false ), m_flagV( false )
+    { setRegP( rRegisters.regP ); }
+
+    // The registers, with regP up to date
+    tMCURegisters getRegisters() const
     {
-        regA = regX = regY = 0;
-        regP = 0;
-        regSP = UINT8_MAX;
-        regPC = memReadWord( cResetVector );
+        tMCURegisters registers( *this );
+        registers.regP = getRegP();
+        return registers;
     }
 
-    // Executes a single instruction
-    void pcExecute();
-    // Decodes the current instruction into a human readable string
-    std::string pcDecode() { return decodeFullOpcode( regPC ); }
+    uint8_t getRegP() const
+    {
+        if( !lazyFlags )
+            return regP;
 
-    std::string decodeFullOpcode( uint16_t memPos ); // Decodes both the opcode + addressing
-    uint8_t decodeFullOpcodeLength( uint16_t memPos ); // Returns number of bytes used in the opcode + addressing @memPos
+        return static_cast<uint8_t>((regP & ~cLazyFlags) | (m_flagN & flag_N) | (m_flagZ == 0 ? flag_Z : 0) |
+                                    (m_flagC ? flag_C : 0) | (m_flagV ? flag_V : 0));
+    }
 
-    std::string decodeOpcode( uint16_t memPos ); // Returns a human readable string for the opcode @memPos
-    std::string decodeOpcodeDirect( uint8_t opCode ); // Returns a human readable string for the opcode with value opcode
-    std::string decodeAddressing( uint16_t memPos ); // Returns a human readable string for the addressing of the opcode @memPos
-    uint8_t decodeAddressingLength( uint16_t memPos ); // Returns number of bytes used in the addressing @memPos
+    void setRegP( uint8_t value )
+    {
+        regP = value;
 
-    // Called to treat the next few bytes as specific addressing modes
-    std::string decodeAddressing( eAddressingMode_Mem mode );
-    std::string decodeAddressing( eAddressingMode_Register mode );
-    std::string decodeAddressing( eAddressingMode_Null mode );
+        if( lazyFlags )
+        {
+            m_flagN = value;
+            m_flagZ = (value & flag_Z) ? 0 : 1;
+            m_flagC = (value & flag_C) != 0;
+            m_flagV = (value & flag_V) != 0;
+        }
+    }
 
     // =====
     // Useful actions
 
-    // @TODO: Allow access to special memory locations
     uint8_t memReadByte( uint16_t address )
     {
-        uint8_t readValue = 0;
-
-#ifdef DO_MCU_TRACE
-        if( m_pReadSequence )
-        {
-            readValue = *m_pReadSequence;
-            ++m_pReadSequence;
-        }
-        m_memTrace.push( tMemoryTrace( address, readValue, true ) );
-#else
-        if( address == cSerialRx )
-            readValue = serialToMCUPopByte();
-        else
-            readValue = m_pMemory[address];
-#endif
-
-        return readValue;
+        uint8_t data = m_rBus.memReadByte( address );
+        m_rObserver.memoryRead( address, data );
+        return data;
     }
 
     uint16_t memReadWord( uint16_t address )
@@ -170,44 +257,43 @@ struct tMCUState
 
     void memWriteByte( uint16_t address, uint8_t data )
     {
-#ifdef DO_MCU_TRACE
-        m_memTrace.push( tMemoryTrace( address, data, false ) );
-        m_lastWriteResult = data;
-#endif
-
-        if( address == cSerialTx )
-            serialFromMCUPushByte( data );
-        else
-            m_pMemory[address] = data;
+        m_rBus.memWriteByte( address, data );
+        m_rObserver.memoryWrite( address, data );
     }
 
-    void stackPushByte( uint8_t value ) // Pushes a byte on to the stack
+    // Zero page and the stack ($0000-$01FF) never have devices, so they have a path of their own on the bus
+    uint8_t directReadByte( uint16_t address )
     {
-        assert( regSP > 0 );
+        uint8_t data = m_rBus.memReadDirect( address );
+        m_rObserver.memoryRead( address, data );
+        return data;
+    }
 
-        if( regSP > 0 )
-        {
-            memWriteByte( cStackOffset + regSP, value );
-            --regSP;
-        }
-        else
-        {
-            // Stack overflow!  Should this be logged or something?
-        }
+    void directWriteByte( uint16_t address, uint8_t data )
+    {
+        m_rBus.memWriteDirect( address, data );
+        m_rObserver.memoryWrite( address, data );
     }
 
-    uint8_t stackPopByte() // Pops a byte from the stack
+    // Reads the (non-wrapping) word at a zero page address, e.g. the pointer for an indirect addressing mode
+    uint16_t directReadWord( uint16_t address )
     {
-        assert( regSP < UINT8_MAX );
+        uint16_t finalWord = directReadByte( address );
+        finalWord |= directReadByte( address + 1 ) << 8;
+        return finalWord;
+    }
 
-        if( regSP < UINT8_MAX )
-        {
-            ++regSP;
-            return memReadByte( cStackOffset + regSP );
-        }
+    // The stack wraps round within page 1, as on the real thing
+    void stackPushByte( uint8_t value ) // Pushes a byte on to the stack
+    {
+        directWriteByte( cStackOffset + regSP, value );
+        --regSP;
+    }
 
-        // Stack underflow!
-        return 0;
+    uint8_t stackPopByte() // Pops a byte from the stack
+    {
+        ++regSP;
+        return directReadByte( cStackOffset + regSP );
     }
 
     void stackPushWord( uint16_t value )
@@ -223,38 +309,89 @@ struct tMCUState
         return result;
     }
 
+    // Takes an IRQ or NMI - pushes PC and P (with B clear), then disables interrupts and leaves decimal mode as
+    // the 65C02 does
+    void interrupt( uint16_t vector )
+    {
+        stackPushWord( regPC );
+        stackPushByte( static_cast<uint8_t>((getRegP() & ~flag_B) | flag_X) );
+        setRegP( static_cast<uint8_t>((getRegP() | flag_I) & ~flag_D) );
+        regPC = memReadWord( vector );
+    }
+
+    // Code fetches skip device decoding - reading code never has side effects
     uint8_t pcReadByte() // Reads a byte from where PC is, and increments PC
     {
-        return memReadByte( regPC++ );
+        return m_rBus.memFetchByte( regPC++ );
     }
 
     uint16_t pcReadWord() // Reads a word from where PC is, and adds 2 to PC
     {
-        uint16_t retVal = memReadWord( regPC );
-        regPC += 2;
+        uint16_t retVal = pcReadByte();
+        retVal |= pcReadByte() << 8;
         return retVal;
     }
 
+    // Only called for a branch that's taken, which costs a cycle, plus another if it lands on a different page
     void pcBranchOffset( uint8_t offset )
     {
         int8_t signedOffset = static_cast<int8_t>(offset);
-        regPC += signedOffset;
+        uint16_t target = regPC + signedOffset;
+        m_cycles += 1 + (((target ^ regPC) & 0xFF00) != 0);
+        regPC = target;
+        m_rObserver.branchTaken( target );
+    }
+
+    // For the run loops - the instruction at pc is starting, and PC has already been moved past its opcode
+    void observeInstructionBegin( uint16_t pc, uint8_t opCode )
+    {
+        tMCURegisters registers = getRegisters();
+        registers.regPC = pc;
+        m_rObserver.instructionBegin( registers, opCode );
+    }
+
+    // One of the conditional branches - the offset is only read if it's taken
+    template< typename tAccessor >
+    void conditionalBranch( bool taken, tAccessor offset )
+    {
+        m_rObserver.conditionalBranch( taken );
+        if( taken )
+            pcBranchOffset( offset );
+    }
+
+    void addCycles( unsigned cycles )
+    { m_cycles += cycles; }
+
+    // Adds index to base, and charges a cycle for crossing into the next page if pageCrossPenalty
+    uint16_t indexAddress( uint16_t base, uint8_t index, bool pageCrossPenalty )
+    {
+        uint16_t address = base + index;
+        m_cycles += pageCrossPenalty && ((address ^ base) & 0xFF00) != 0;
+        return address;
     }
 
     // =====
     // Memory accessors used for instruction set templating
 
+    // isDirect is set for the zero page modes.  The mode is always known at compile time, so the test folds away.
     class tMemoryAccessor
     {
-        tMCUState& m_rState;
+        tMCUCore& m_rCore;
+        bool m_isDirect;
     public:
         uint16_t m_memAddr;
 
-        tMemoryAccessor( tMCUState& rState, uint16_t memAddr ) : m_rState( rState ), m_memAddr( memAddr ) {}
-        uint8_t operator=( uint8_t writeValue )
-        { m_rState.memWriteByte( m_memAddr, writeValue ); return writeValue; }
-        operator uint8_t() const
-        { return m_rState.memReadByte( m_memAddr ); }
+        tMemoryAccessor( tMCUCore& rCore, uint16_t memAddr, bool isDirect = false ) : m_rCore( rCore ), m_isDirect( isDirect ), m_memAddr( memAddr ) {}
+        MCU_FORCE_INLINE uint8_t operator=( uint8_t writeValue )
+        {
+            if( m_isDirect )
+                m_rCore.directWriteByte( m_memAddr, writeValue );
+            else
+                m_rCore.memWriteByte( m_memAddr, writeValue );
+            return writeValue;
+        }
+        MCU_FORCE_INLINE operator uint8_t() const
+        { return m_isDirect ? m_rCore.directReadByte( m_memAddr ) : m_rCore.memReadByte( m_memAddr ); }
     };
 
     class tRegisterAccessor
@@ -273,22 +410,24 @@ struct tMCUState
         // Empty class - does nothing - will cause an error if an attempt is made to read/write to it
     };
 
-    inline tMemoryAccessor makeAccessor( eAddressingMode_Mem mode )
+    // pageCrossPenalty is whether the instruction takes an extra cycle when an indexed address crosses a page
+    // (see mcuPageCrossPenalty())
+    MCU_FORCE_INLINE tMemoryAccessor makeAccessor( eAddressingMode_Mem mode, bool pageCrossPenalty )
     {
         switch( mode )
         {
         case am_Immediate:      return tMemoryAccessor( *this, regPC++ );
-        case am_ZeroPage:       return tMemoryAccessor( *this, pcReadByte() );
-        case am_ZeroPage_X:     return tMemoryAccessor( *this, (pcReadByte() + regX) & UINT8_MAX );
-        case am_ZeroPage_Y:     return tMemoryAccessor( *this, (pcReadByte() + regY) & UINT8_MAX );
+        case am_ZeroPage:       return tMemoryAccessor( *this, pcReadByte(), true );
+        case am_ZeroPage_X:     return tMemoryAccessor( *this, (pcReadByte() + regX) & UINT8_MAX, true );
+        case am_ZeroPage_Y:     return tMemoryAccessor( *this, (pcReadByte() + regY) & UINT8_MAX, true );
         case am_Relative:       return tMemoryAccessor( *this, regPC++ );
         case am_Absolute:       return tMemoryAccessor( *this, pcReadWord() );
-        case am_Absolute_X:     return tMemoryAccessor( *this, pcReadWord() + regX );
-        case am_Absolute_Y:     return tMemoryAccessor( *this, pcReadWord() + regY );
+        case am_Absolute_X:     return tMemoryAccessor( *this, indexAddress( pcReadWord(), regX, pageCrossPenalty ) );
+        case am_Absolute_Y:     return tMemoryAccessor( *this, indexAddress( pcReadWord(), regY, pageCrossPenalty ) );
         case am_Indirect:       return tMemoryAccessor( *this, pcReadWord() );
-        case am_Indirect_X:     return tMemoryAccessor( *this, memReadWord( (pcReadByte() + regX) & UINT8_MAX ) );
-        case am_Indirect_Y:     return tMemoryAccessor( *this, memReadWord( pcReadByte() ) + regY );
-        case am_Indirect_ZP:    return tMemoryAccessor( *this, memReadWord( pcReadByte() ) );
+        case am_Indirect_X:     return tMemoryAccessor( *this, directReadWord( (pcReadByte() + regX) & UINT8_MAX ) );
+        case am_Indirect_Y:     return tMemoryAccessor( *this, indexAddress( directReadWord( pcReadByte() ), regY, pageCrossPenalty ) );
+        case am_Indirect_ZP:    return tMemoryAccessor( *this, directReadWord( pcReadByte() ) );
         case am_AbsIdxIndirect: return tMemoryAccessor( *this, pcReadWord() + regX );
         default:                assert( false );
         }
@@ -296,7 +435,7 @@ struct tMCUState
         return tMemoryAccessor( *this, 0 );
     }
 
-    inline tRegisterAccessor makeAccessor( eAddressingMode_Register mode )
+    inline tRegisterAccessor makeAccessor( eAddressingMode_Register mode, bool = false )
     {
         switch( mode )
         {
@@ -308,9 +447,544 @@ struct tMCUState
         return tRegisterAccessor( regA );
     }
 
-    inline tNullAccessor makeAccessor( eAddressingMode_Null )
+    inline tNullAccessor makeAccessor( eAddressingMode_Null, bool = false )
     { return tNullAccessor(); }
 
+    // Accessor for a predecoded instruction (see tMCUBlockCache).  The operand bytes have already been fetched,
+    // so immediate and relative operands are handed over directly instead of being read from memory again.
+    class tDecodedAccessor
+    {
+        tMCUCore& m_rCore;
+        bool m_isOperand;
+        bool m_isDirect;
+        uint8_t m_operand;
+    public:
+        uint16_t m_memAddr;
+
+        tDecodedAccessor( tMCUCore& rCore, uint16_t memAddr, bool isDirect ) : m_rCore( rCore ), m_isOperand( false ), m_isDirect( isDirect ), m_operand( 0 ), m_memAddr( memAddr ) {}
+        tDecodedAccessor( tMCUCore& rCore, uint8_t operand ) : m_rCore( rCore ), m_isOperand( true ), m_isDirect( false ), m_operand( operand ), m_memAddr( 0 ) {}
+        MCU_FORCE_INLINE uint8_t operator=( uint8_t writeValue )
+        {
+            if( m_isDirect )
+                m_rCore.directWriteByte( m_memAddr, writeValue );
+            else
+                m_rCore.memWriteByte( m_memAddr, writeValue );
+            return writeValue;
+        }
+        MCU_FORCE_INLINE operator uint8_t() const
+        {
+            if( m_isOperand )
+                return m_operand;
+            return m_isDirect ? m_rCore.directReadByte( m_memAddr ) : m_rCore.memReadByte( m_memAddr );
+        }
+    };
+
+    // As makeAccessor(), but for an instruction whose operand bytes have already been fetched (and PC already moved past)
+    MCU_FORCE_INLINE tDecodedAccessor makeDecodedAccessor( eAddressingMode_Mem mode, uint16_t operand, bool pageCrossPenalty )
+    {
+        switch( mode )
+        {
+        case am_Immediate:      return tDecodedAccessor( *this, static_cast<uint8_t>(operand) );
+        case am_ZeroPage:       return tDecodedAccessor( *this, operand, true );
+        case am_ZeroPage_X:     return tDecodedAccessor( *this, (operand + regX) & UINT8_MAX, true );
+        case am_ZeroPage_Y:     return tDecodedAccessor( *this, (operand + regY) & UINT8_MAX, true );
+        case am_Relative:       return tDecodedAccessor( *this, static_cast<uint8_t>(operand) );
+        case am_Absolute:       return tDecodedAccessor( *this, operand, false );
+        case am_Absolute_X:     return tDecodedAccessor( *this, indexAddress( operand, regX, pageCrossPenalty ), false );
+        case am_Absolute_Y:     return tDecodedAccessor( *this, indexAddress( operand, regY, pageCrossPenalty ), false );
+        case am_Indirect:       return tDecodedAccessor( *this, operand, false );
+        case am_Indirect_X:     return tDecodedAccessor( *this, directReadWord( (operand + regX) & UINT8_MAX ), false );
+        case am_Indirect_Y:     return tDecodedAccessor( *this, indexAddress( directReadWord( operand ), regY, pageCrossPenalty ), false );
+        case am_Indirect_ZP:    return tDecodedAccessor( *this, directReadWord( operand ), false );
+        case am_AbsIdxIndirect: return tDecodedAccessor( *this, operand + regX, false );
+        default:                assert( false );
+        }
+
+        return tDecodedAccessor( *this, 0, false );
+    }
+
+    inline tRegisterAccessor makeDecodedAccessor( eAddressingMode_Register mode, uint16_t, bool )
+    { return makeAccessor( mode ); }
+
+    inline tNullAccessor makeDecodedAccessor( eAddressingMode_Null mode, uint16_t, bool )
+    { return makeAccessor( mode ); }
+
+    // =====
+    // Flag interaction convenience functions
+    inline void modifyFlag( bool setFlag, eFlags flags )
+    {
+        if( lazyFlags )
+        {
+            switch( flags )
+            {
+            case flag_N:    m_flagN = setFlag ? 0x80 : 0; return;
+            case flag_Z:    m_flagZ = setFlag ? 0 : 1; return;
+            case flag_C:    m_flagC = setFlag; return;
+            case flag_V:    m_flagV = setFlag; return;
+            default:        break;
+            }
+        }
+
+        uint8_t flagMask = static_cast<uint8_t>(flags);
+
+        if( setFlag )
+            regP |= flagMask;
+        else
+            regP &= ~flagMask;
+    }
+
+    inline bool isFlagSet( eFlags flag )
+    {
+        if( lazyFlags )
+        {
+            switch( flag )
+            {
+            case flag_N:    return (m_flagN & 0x80) != 0;
+            case flag_Z:    return m_flagZ == 0;
+            case flag_C:    return m_flagC;
+            case flag_V:    return m_flagV;
+            default:        break;
+            }
+        }
+
+        return (regP & flag) != 0;
+    }
+
+    inline void testNegative( const uint8_t& rValue )
+    {
+        if( lazyFlags )
+            m_flagN = rValue;
+        else
+            modifyFlag( (rValue & 0x80) != 0, flag_N );
+    }
+
+    inline void testZero( const uint8_t& rValue )
+    {
+        if( lazyFlags )
+            m_flagZ = rValue;
+        else
+            modifyFlag( (rValue == 0), flag_Z );
+    }
+
+    inline void testNegativeZero( const uint8_t& rValue ) { testNegative( rValue ); testZero( rValue ); }
+
+    // Returns whether or not two bytes have the same sign
+    inline static bool sameSign( uint8_t value1, uint8_t value2 )
+    { return ((value1 ^ value2) & 0x80) == 0; }
+};
+
+// A memory mapped device, registered with tMCUState::addDevice().  Gets every read and write to the addresses
+// it was registered over.
+class tMCUDevice
+{
+public:
+    virtual ~tMCUDevice() {}
+
+    virtual uint8_t read( uint16_t address ) = 0;
+    virtual void write( uint16_t address, uint8_t data ) = 0;
+
+    //   For engine_JitVerify, whose shadow interpreter has copies of the devices.  clone() makes one (or returns 0
+    // if it can't - the shadow then has plain memory there), copyTo() brings it back into line with this device
+    // before each translated block, and sameAs() compares them afterwards.
+    virtual tMCUDevice *clone() const { return 0; }
+    virtual void copyTo( tMCUDevice& ) const {}
+    virtual bool sameAs( const tMCUDevice& ) const { return true; }
+};
+
+// Something that has to happen at a given guest cycle (e.g. a timer running out), registered with
+// tMCUState::scheduleEvent().  Devices schedule these rather than looking at the cycle count on every access.
+class tMCUEvent
+{
+public:
+    virtual ~tMCUEvent() {}
+
+    // Called between instructions once the cycle count has reached the cycle the event was scheduled for, which
+    // is passed in - the MCU can be up to an instruction past it.  It may schedule itself (or anything else) again.
+    virtual void fire( uint64_t cycle ) = 0;
+};
+
+struct tMCUState;
+class tMCUSnapshot;
+class tMCURewind;
+class tMCUTraceWriter;
+class tMCUBranchTrace;
+
+//   The two timers of a 6522 VIA, which tMCUState maps at cViaFirst..cViaLast with the registers at the 6522's
+// offsets (the ports aren't connected to anything, and read as 0).  Nothing is ticked - a counter is worked out
+// from the cycle count when it's read, and running out is a scheduled event.
+//   Counting from N, a timer reads N, N-1 ... 0, $FFFF, and sets its flag in IFR as it reaches $FFFF, N + 1 cycles
+// after it was started.  Timer 1 in free running mode (ACR bit 6) then reloads from its latch, for an interrupt
+// every latch + 2 cycles.  Otherwise it carries on down from $FFFF without interrupting again.  Timer 2 is
+// one-shot only.  Timers count from the cycle the instruction that started them began at.
+class tMCUVia : public tMCUDevice
+{
+public:
+    // Register offsets
+    static const uint8_t cT1CounterLow  = 0x04; // Read: counter, and clears the T1 flag - write: latch
+    static const uint8_t cT1CounterHigh = 0x05; // Read: counter - write: latch, and starts timer 1 from the latch
+    static const uint8_t cT1LatchLow    = 0x06;
+    static const uint8_t cT1LatchHigh   = 0x07; // Writing clears the T1 flag
+    static const uint8_t cT2CounterLow  = 0x08; // Read: counter, and clears the T2 flag - write: latch
+    static const uint8_t cT2CounterHigh = 0x09; // Read: counter - write: starts timer 2 from this and the latch
+    static const uint8_t cAuxControl    = 0x0B; // ACR
+    static const uint8_t cInterruptFlags = 0x0D; // IFR - writing 1s clears flags
+    static const uint8_t cInterruptEnable = 0x0E; // IER - a write sets the flags given if bit 7 is set, otherwise clears them
+
+    static const uint8_t cFlagT2        = 0x20;
+    static const uint8_t cFlagT1        = 0x40;
+    static const uint8_t cFlagIRQ       = 0x80; // In IFR, set if any enabled flag is
+    static const uint8_t cAuxT1FreeRun  = 0x40;
+
+    // Drives rState's IRQ line through irqSource
+    tMCUVia( tMCUState& rState, unsigned irqSource );
+
+    virtual uint8_t read( uint16_t address );
+    virtual void write( uint16_t address, uint8_t data );
+
+    // Clears ACR, IFR and IER like the 6522's reset line, which leaves the timers running but unable to interrupt
+    void reset();
+
+    struct tSavedState
+    {
+        uint16_t m_latch[2];
+        uint16_t m_startValue[2];
+        uint64_t m_startCycle[2];
+        uint64_t m_eventCycle[2]; // When each timer's event is due, or UINT64_MAX if it isn't scheduled
+        uint8_t m_auxControl;
+        uint8_t m_interruptFlags;
+        uint8_t m_interruptEnable;
+        bool m_irqAsserted;
+    };
+
+    void saveState( tSavedState& rSaved ) const;
+    //   Doesn't touch the IRQ line, which tMCUState restores itself - or the timers' events unless scheduleEvents
+    // (tMCUState::restoreSnapshot() puts back all the events at once)
+    void restoreState( const tSavedState& rSaved, bool scheduleEvents );
+
+private:
+    struct tTimer : public tMCUEvent
+    {
+        tMCUVia *m_pVia;
+        uint8_t m_flag; // cFlagT1 or cFlagT2
+        uint16_t m_latch;
+        uint16_t m_startValue;
+        uint64_t m_startCycle;
+
+        tTimer() : m_pVia( 0 ), m_flag( 0 ), m_latch( 0 ), m_startValue( 0 ), m_startCycle( 0 ) {}
+
+        virtual void fire( uint64_t cycle ) { m_pVia->timerExpired( *this, cycle ); }
+    };
+
+    tMCUVia( const tMCUVia& ); // Disallowed
+
+    uint16_t counter( const tTimer& rTimer ) const;
+    void startTimer( tTimer& rTimer, uint16_t value );
+    void timerExpired( tTimer& rTimer, uint64_t cycle );
+    void setFlags( uint8_t flags ) { m_interruptFlags |= flags; updateIRQ(); }
+    void clearFlags( uint8_t flags ) { m_interruptFlags &= ~flags; updateIRQ(); }
+    void updateIRQ();
+
+    tMCUState&  m_rState;
+    unsigned    m_irqSource;
+    tTimer      m_timer1;
+    tTimer      m_timer2;
+    uint8_t     m_auxControl;
+    uint8_t     m_interruptFlags; // Without cFlagIRQ
+    uint8_t     m_interruptEnable;
+    bool        m_irqAsserted;
+};
+
+struct tMCUState : public tMCURegisters
+{
+    typedef tMCUCore< tMCUState > tCore;
+    typedef tMCUCore< tMCUState, true > tLazyCore;
+    typedef tMCUCore< tMCUState, false, tMCUObserver > tObservedCore; // Only used while there's an observer attached
+    typedef tMCUCore< tMCUState, false, tMCUBranchTrace > tBranchTracedCore; // ...or a branch trace
+
+    static const unsigned cHistorySize = 256; // Entries kept by the instruction history - a power of 2
+
+    //   An instruction from the history, with the registers as it started.  The same instruction run over and over
+    // with the same registers (e.g. a JMP to itself) shares an entry.  Translated code only has an entry for where
+    // it was entered, with m_count being all of the instructions it ran from there (in the JIT's case, on through
+    // any other translated blocks it reached).
+    struct tHistoryEntry
+    {
+        uint64_t m_packed; // PC | opcode << 16 | A << 24 | X << 32 | Y << 40 | P << 48 | S << 56
+        uint32_t m_count; // Instructions run - stops at UINT32_MAX
+        bool m_translated;
+
+        uint16_t getPC() const { return static_cast<uint16_t>(m_packed); }
+        uint8_t getOpCode() const { return static_cast<uint8_t>(m_packed >> 16); }
+        tMCURegisters getRegisters() const;
+    };
+
+    uint8_t *m_pMemory; // Pointer to memory
+
+    // Constants
+    static const uint16_t cResetVector  = 0xFFFC; // Address where the reset vector should be
+    static const uint16_t cIRQVector    = 0xFFFE; // Address where the IRQ vector should be
+    static const uint16_t cNMIVector    = 0xFFFA; // Address where the NMI vector should be
+    static const unsigned cInterruptCycles = 7; // Cycles taken to push the state and jump through the vector
+    static const uint16_t cSerialTx     = 0x0302; // Write a byte here to transmit data over the serial port
+    static const uint16_t cSerialRx     = 0x0303; // Read a byte here to receive data over the serial port
+    static const uint16_t cViaFirst     = 0x0310; // The timer VIA's registers - see tMCUVia
+    static const uint16_t cViaLast      = 0x031F;
+    static const unsigned cViaIRQSource = 31; // setIRQLine() source that the VIA drives
+
+    // Constructor - pass in 64k of memory
+    tMCUState( uint8_t *pMemory )
+        : m_pMemory( pMemory )
+        , m_execEngine( engine_Switch )
+        , m_lazyFlags( false )
+        , m_cycleCount( 0 )
+        , m_pRunCycles( 0 )
+        , m_nextEventCycle( UINT64_MAX )
+        , m_runExitRequest( 0 )
+        , m_idleDetection( false )
+        , m_irqLines( 0 )
+        , m_nmiLine( false )
+        , m_nmiPending( false )
+        , m_waiting( false )
+        , m_stopped( false )
+        , m_breakpointCount( 0 )
+        , m_pBlockCache( 0 )
+        , m_pJit( 0 )
+        , m_pJitShadow( 0 )
+        , m_pJitShadowMemory( 0 )
+        , m_verifyFailPC( 0 )
+        , m_pAotTable( 0 )
+        , m_aotTableSize( 0 )
+        , m_pAotBlocks( 0 )
+        , m_codeModified( false )
+        , m_snapshotId( 0 )
+        , m_pRewind( 0 )
+        , m_pObserver( 0 )
+        , m_pBranchTrace( 0 )
+        , m_instructionCount( 0 )
+        , m_historyEnd( 0 )
+        , m_decodePos( 0 )
+        , m_serialDevice( *this )
+        , m_via( *this, cViaIRQSource )
+        , m_serialToMCUCount( 0 )
+    {
+        memset( m_breakpoints, 0, sizeof(m_breakpoints) );
+        memset( m_codePages, 0, sizeof(m_codePages) );
+        memset( m_history, 0, sizeof(m_history) );
+
+        for( unsigned page = 0; page < 256; ++page )
+            m_pPages[page] = m_pMemory + (page << 8);
+
+        addDevice( cSerialTx, cSerialRx, &m_serialDevice );
+        addDevice( cViaFirst, cViaLast, &m_via );
+        cpuReset();
+    }
+
+    ~tMCUState();
+
+    // Useful functions
+    void cpuReset()
+    {
+        regA = regX = regY = 0;
+        regP = 0;
+        regSP = UINT8_MAX;
+        regPC = memReadWord( cResetVector );
+        m_waiting = false;
+        m_stopped = false;
+        m_nmiPending = false;
+        m_via.reset();
+    }
+
+    // Executes a single instruction, and returns the number of cycles it took
+    unsigned pcExecute();
+
+    // pcExecute(), with each of the instruction's memory accesses streamed into rWriter (which has to be open)
+    unsigned pcExecuteTraced( tMCUTraceWriter& rWriter );
+
+    // Runs with the registers held in locals until the budget is used up or something needs the host's attention.
+    // The first instruction is always executed, even if there is a breakpoint on it, so that it's possible to
+    // continue on from a breakpoint - unless the MCU is halted by WAI or STP, when nothing is run at all (although
+    // time still passes in a WAI if there are events scheduled).  runCycles() can overrun its budget by part of the
+    // last instruction.
+    tRunResult runInstructions( uint64_t instructions );
+    tRunResult runCycles( uint64_t cycles );
+
+    // Base number of cycles taken by an opcode
+    static uint8_t opCodeCycles( uint8_t opCode );
+
+    //   Cycles executed since construction.  Devices can call this while the MCU is running - it's then the count
+    // the interpreter has at the access: the cycle the current instruction started at, plus any page crossing
+    // cycle it has already taken.  engine_Jit's translated code works out the same count, but engine_Aot's blocks
+    // only give the cycle the block started at (plus page crossing cycles since).  Scheduled events are against
+    // this count, and don't move with it.
+    uint64_t getCycleCount() const { return m_pRunCycles ? m_cycleCount + *m_pRunCycles : m_cycleCount; }
+    void setCycleCount( uint64_t cycles ) { m_cycleCount = cycles; }
+
+    //   Calls pEvent->fire() once the cycle count reaches cycle.  run() never runs an engine past the earliest
+    // event, so nothing is checked per instruction for them - it fires at the first instruction boundary at or
+    // after its cycle (translated blocks can overrun by the page crossing cycles in them).  A WAI skips straight
+    // to the next event.  Scheduling an event that's already pending moves it.  Events aren't owned, and these
+    // are only for the MCU's own thread (devices, events and the host between runs).
+    void scheduleEvent( tMCUEvent *pEvent, uint64_t cycle );
+    void cancelEvent( tMCUEvent *pEvent );
+    bool isEventScheduled( const tMCUEvent *pEvent ) const;
+    uint64_t getEventCycle( const tMCUEvent *pEvent ) const; // UINT64_MAX if it isn't scheduled
+    bool hasScheduledEvents() const { return !m_events.empty(); }
+
+    void setExecEngine( eExecEngine engine ) { m_execEngine = engine; }
+    eExecEngine getExecEngine() const { return m_execEngine; }
+
+    // Runs engine_Switch and engine_Threaded on tLazyCore.  The other engines always use eager flags.
+    void setLazyFlags( bool lazyFlags ) { m_lazyFlags = lazyFlags; }
+    bool getLazyFlags() const { return m_lazyFlags; }
+
+    //   Makes runInstructions()/runCycles() return run_Idle when the MCU is polling the empty serial port in a
+    // tight loop (e.g. LDA cSerialRx / BEQ back to it), which it will keep doing until input arrives.  Every
+    // read of the empty port returns to run() to check for the loop, so it's off by default.  It's never idle
+    // while events are scheduled (e.g. a VIA timer running), as they only come due if the MCU keeps running.
+    void setIdleDetection( bool idleDetection ) { m_idleDetection = idleDetection; }
+    bool getIdleDetection() const { return m_idleDetection; }
+
+    //   Interrupt lines - devices and host code (on any thread) drive these.  IRQ is level triggered, and is the OR
+    // of up to 32 sources so that each device can hold its own; it's taken between instructions for as long as
+    // any source is asserted and I is clear.  NMI is edge triggered, and is taken once each time the line goes
+    // from released to asserted.  Either one wakes up a WAI, even if I is set.
+    void setIRQLine( unsigned source, bool asserted );
+    void setNMILine( bool asserted );
+    bool isIRQAsserted() const { return m_irqLines != 0; }
+
+    // Whether the MCU is halted by WAI or STP.  pcExecute() ignores these, so the debugger can still step.
+    bool isWaiting() const { return m_waiting; }
+    bool isStopped() const { return m_stopped; }
+
+    // Start of the translated block that engine_JitVerify last found a mismatch in
+    uint16_t getVerifyFailPC() const { return m_verifyFailPC; }
+
+    void setBreakpoint( uint16_t address );
+    void clearBreakpoint( uint16_t address );
+    bool isBreakpoint( uint16_t address ) const
+    { return (m_breakpoints[address >> 3] & (1 << (address & 7))) != 0; }
+
+    //   Throws away all predecoded code, and counts every page as written since the last snapshot - call this after
+    // changing m_pMemory directly rather than through memWriteByte()
+    void invalidateCode();
+
+    //   Saves the registers, memory, cycle count, serial FIFOs, VIA, interrupt lines and scheduled events, for
+    // restoring into this state later.  Devices added with addDevice() have to save their own state (their scheduled
+    // events are included, though).
+    //   From then on the first write to each page marks it dirty, and restoring the snapshot - or saving over it
+    // again - only copies the dirty pages.  With a few pages of RAM in use, that takes microseconds rather than a
+    // 64k copy.  Other snapshots are copied in full, and take over the dirty tracking.
+    void saveSnapshot( tMCUSnapshot& rSnapshot );
+    void restoreSnapshot( const tMCUSnapshot& rSnapshot );
+
+    //   Records history into pRewind from now on, so that the MCU can be stepped backwards (0 stops recording).  It
+    // isn't owned.  Every write then goes through memWriteByte()'s slow path - translated code included.
+    void setRewind( tMCURewind *pRewind );
+    tMCURewind *getRewind() const { return m_pRewind; }
+
+    //   Reports everything the MCU does to pObserver from now on (0 detaches it).  It isn't owned.  Translated code
+    // has no hooks, so every engine interprets while there's one - engine_Threaded with its own dispatch, and the
+    // rest as engine_Switch - and flags are always eager.  With none attached, nothing is spent on observing.
+    void setObserver( tMCUObserver *pObserver ) { assert( !pObserver || !m_pBranchTrace ); m_pObserver = pObserver; }
+    tMCUObserver *getObserver() const { return m_pObserver; }
+
+    //   Records a branch trace into pBranchTrace from now on (0 stops recording) - see mcu_branchtrace.hpp.  It isn't
+    // owned, and it can't be attached at the same time as an observer.  Every engine interprets while it's
+    // attached, as with an observer, but its hooks are compiled into an interpreter of its own.
+    void setBranchTrace( tMCUBranchTrace *pBranchTrace ) { assert( !pBranchTrace || !m_pObserver ); m_pBranchTrace = pBranchTrace; }
+    tMCUBranchTrace *getBranchTrace() const { return m_pBranchTrace; }
+
+    //   Whether the registers, cycle count and all 64k of memory are the same as rOther's - for checking that two
+    // ways of running the same program agree
+    bool sameState( const tMCUState& rOther ) const;
+
+    // Instructions executed since construction, by pcExecute() and the run loops
+    uint64_t getInstructionCount() const { return m_instructionCount; }
+
+    //   Copies up to maxEntries of the most recent history into pEntries, oldest first, and returns how many there
+    // were.  Every engine keeps the last cHistorySize entries, always.
+    unsigned getHistory( tHistoryEntry *pEntries, unsigned maxEntries ) const;
+
+    //   Hands engine_Aot a table of blocks translated ahead of time (e.g. g_romAotBlocks).  Only blocks whose
+    // bytes still match memory are used, and a block is dropped for good as soon as any page it came from is
+    // written to.  Returns the number of blocks accepted.
+    unsigned setAotBlocks( const tAotBlock *pBlocks, unsigned blockCount );
+
+    //   Maps pDevice over firstAddress to lastAddress inclusive, in front of any device already there.  The device
+    // isn't owned, and has to outlive the state.  The serial port is always mapped at cSerialTx/cSerialRx, and the
+    // timer VIA at cViaFirst..cViaLast.  Zero page and the stack can't have devices.
+    //   Pages with a device anywhere in them are taken out of the page table, so only accesses to those pages pay
+    // for finding the device - addresses in them that no device claims still reach memory.
+    void addDevice( uint16_t firstAddress, uint16_t lastAddress, tMCUDevice *pDevice );
+
+    // Decodes the current instruction into a human readable string
+    std::string pcDecode() { return decodeFullOpcode( regPC ); }
+
+    std::string decodeFullOpcode( uint16_t memPos ); // Decodes both the opcode + addressing
+    uint8_t decodeFullOpcodeLength( uint16_t memPos ); // Returns number of bytes used in the opcode + addressing @memPos
+
+    std::string decodeOpcode( uint16_t memPos ); // Returns a human readable string for the opcode @memPos
+    std::string decodeOpcodeDirect( uint8_t opCode ); // Returns a human readable string for the opcode with value opcode
+    std::string decodeAddressing( uint16_t memPos ); // Returns a human readable string for the addressing of the opcode @memPos
+    uint8_t decodeAddressingLength( uint16_t memPos ); // Returns number of bytes used in the addressing @memPos
+    unsigned decodeAddressingModeDirect( uint8_t opCode ); // Returns the addressing mode of the opcode with value opcode, as mcuAddressingModeNumber()
+
+    // Called to treat the next few bytes as specific addressing modes
+    std::string decodeAddressing( eAddressingMode_Mem mode );
+    std::string decodeAddressing( eAddressingMode_Register mode );
+    std::string decodeAddressing( eAddressingMode_Null mode );
+
+    // =====
+    // Memory bus
+
+    // Plain memory pages are one load from the page table - device pages go through deviceReadByte()
+    uint8_t memReadByte( uint16_t address )
+    {
+        const uint8_t *pPage = m_pPages[address >> 8];
+        if( pPage )
+            return pPage[address & 0xFF];
+
+        return deviceReadByte( address );
+    }
+
+    uint16_t memReadWord( uint16_t address )
+    {
+        // Returns a 16-bit word (little endian) from address
+        uint16_t finalWord = memReadByte( address );
+        finalWord |= memReadByte( address + 1 ) << 8;
+        return finalWord;
+    }
+
+    void memWriteByte( uint16_t address, uint8_t data )
+    {
+        uint8_t *pPage = m_pPages[address >> 8];
+        if( pPage )
+        {
+            if( m_codePages[address >> 8] )
+                pageWriting( address );
+
+            pPage[address & 0xFF] = data;
+        }
+        else
+            deviceWriteByte( address, data );
+    }
+
+    // Code fetches, and zero page and stack accesses ($0000-$01FF, where addDevice() won't put a device), go
+    // straight to memory
+    uint8_t memFetchByte( uint16_t address )
+    { return m_pMemory[address]; }
+
+    uint8_t memReadDirect( uint16_t address )
+    { return m_pMemory[address]; }
+
+    void memWriteDirect( uint16_t address, uint8_t data )
+    {
+        if( m_codePages[address >> 8] )
+            pageWriting( address );
+
+        m_pMemory[address] = data;
+    }
+
     // Returns number of bytes an address mode takes, in addition to its opcode
     inline uint8_t decodeLength( eAddressingMode_Mem mode ) const
     {
@@ -341,47 +1015,263 @@ struct tMCUState
     inline uint8_t decodeLength( eAddressingMode_Null ) const
     { return 0; }
 
-    // =====
-    // Flag interaction convenience functions
-    inline void modifyFlag( bool setFlag, eFlags flags )
-    {
-        uint8_t flagMask = static_cast<uint8_t>(flags);
-
-        if( setFlag )
-            regP |= flagMask;
-        else
-            regP &= ~flagMask;
-    }
-
-    inline bool isFlagSet( eFlags flag )
+    inline bool isFlagSet( eFlags flag ) const
     {
         return (regP & flag) != 0;
     }
 
-    inline void testNegative( const uint8_t& rValue ) { modifyFlag( (rValue & 0x80) != 0, flag_N ); }
-    inline void testZero( const uint8_t& rValue ) { modifyFlag( (rValue == 0), flag_Z ); }
-    inline void testNegativeZero( const uint8_t& rValue ) { testNegative( rValue ); testZero( rValue ); }
-
-    // Returns whether or not two bytes have the same sign
-    inline static bool sameSign( uint8_t value1, uint8_t value2 )
-    { return ((value1 ^ value2) & 0x80) == 0; }
-
     // =====
-    // Serial interface
+    // Serial interface - the to-MCU side can be pushed to from another thread
     void serialToMCUPushByte( uint8_t byte );
     uint8_t serialToMCUPopByte();
     bool serialToMCUEmpty();
 
+    //   Blocks until there is serial input or an interrupt for the MCU, or the timeout runs out.  Returns whether
+    // there's anything.
+    bool waitForInput( unsigned timeoutMilliseconds );
+
     void serialFromMCUPushByte( uint8_t byte );
     uint8_t serialFromMCUPopByte();
     bool serialFromMCUEmpty();
 
 private:
+    friend class tMCUBlockCache;
+    friend class tMCUJit;
+    friend class tMCUAot;
+    friend class tMCUSnapshot;
+    friend class tMCUSaveState;
+    friend class tMCURewind;
+    friend class tMCULockstep;
+
+    // Bits of m_codePages - what sort of code has come from each page
+    static const uint8_t cCodePageBlocks    = 0x01; // Blocks in m_pBlockCache
+    static const uint8_t cCodePageAot       = 0x02; // Blocks in m_pAotBlocks
+    static const uint8_t cCodePageDevice    = 0x04; // Not code - a device is in the page, so it's never decoded, and translated code accesses it through memWriteByte()/memReadByte()
+    static const uint8_t cCodePageClean     = 0x08; // Not code - the page hasn't been written to since the last snapshot, so the next write has to mark it dirty
+    static const uint8_t cCodePageRecord    = 0x10; // Not code - writes are being recorded into m_pRewind (set on every page while there is one)
+    static const uint8_t cCodePageCode      = cCodePageBlocks | cCodePageAot;
+
+    // The serial port - reads from cSerialRx and writes to cSerialTx go through the FIFOs
+    class tSerialDevice : public tMCUDevice
+    {
+        tMCUState& m_rState;
+    public:
+        tSerialDevice( tMCUState& rState ) : m_rState( rState ) {}
+
+        virtual uint8_t read( uint16_t address )
+        { return address == cSerialRx ? m_rState.serialReceive() : 0; }
+        virtual void write( uint16_t address, uint8_t data )
+        { if( address == cSerialTx ) m_rState.serialFromMCUPushByte( data ); }
+    };
+
+    struct tScheduledEvent
+    {
+        uint64_t m_cycle;
+        tMCUEvent *m_pEvent;
+    };
+
+    struct tDeviceRange
+    {
+        uint16_t m_firstAddress;
+        uint16_t m_lastAddress;
+        tMCUDevice *m_pDevice;
+        tMCUDevice *m_pJitShadowDevice; // m_pDevice's clone on m_pJitShadow (owned), if it has one
+    };
+
     tMCUState(); // Disallowed - always need a pointer to memory
+    tMCUState( const tMCUState& ); // Disallowed - owns the block cache
+
+    // Accesses to pages missing from m_pPages
+    uint8_t deviceReadByte( uint16_t address );
+    void deviceWriteByte( uint16_t address, uint8_t data );
+    tMCUDevice *findDevice( uint16_t address ) const;
+    void addJitShadowDevice( tDeviceRange& rRange );
+
+    // How runBlocks() uses translated code
+    enum eJitMode
+    {
+        jit_Off,
+        jit_Run,
+        jit_Verify,
+    };
+
+    template< typename tBudget > tRunResult run( uint64_t budget );
+    template< typename tBudget > void runEngine( tCore& rCore, uint64_t budget, tRunResult& rResult );
+    template< typename tBudget, typename tRunCore > void runInterpreter( tRunCore& rCore, uint64_t budget, tRunResult& rResult );
+    template< typename tBudget, typename tObserver > void runObserved( tCore& rCore, tObserver& rObserver, uint64_t budget, tRunResult& rResult );
+    template< typename tBudget, bool checkEach, typename tRunCore > void runSwitch( tRunCore& rCore, uint64_t budget, tRunResult& rResult );
+    template< typename tBudget, bool checkEach, typename tRunCore > void runThreaded( tRunCore& rCore, uint64_t budget, tRunResult& rResult );
+    template< typename tBudget, bool checkEach, eJitMode jitMode > void runBlocks( tCore& rCore, uint64_t budget, tRunResult& rResult );
+    template< typename tBudget > void runAot( tCore& rCore, uint64_t budget, tRunResult& rResult );
+
+    // Runs a block's translated code.  Returns false if verifying, and the interpreter disagreed with it.
+    bool runNative( tCore& rCore, tDecodedBlock& rBlock, bool verify, tJitContext& rContext );
+
+    void pageWriting( uint16_t address ); // About to write to a page with m_codePages bits set
+    void codeModified( uint8_t page ); // A page holding predecoded or translated code has been written to
+    static void executeInterpreted( tCore& rCore, uint16_t address ); // Executes the instruction at address without predecoding it
+
+    uint8_t serialReceive(); // cSerialRx read by the MCU
+
+    void fireEvents(); // Fires every event due by m_cycleCount
+    void eventsChanged() { m_nextEventCycle = m_events.empty() ? UINT64_MAX : m_events.back().m_cycle; }
+
+    // Bits of m_runExitRequest - why the run loop has been asked to return
+    static const uint8_t cRunExitSerialOutput   = 0x01; // Serial data is waiting in m_serialFromMCUFIFO
+    static const uint8_t cRunExitSerialPoll     = 0x02; // cSerialRx was read with nothing in the FIFO (only with idle detection on)
+    static const uint8_t cRunExitInterrupt      = 0x04; // An interrupt line has been asserted
+    static const uint8_t cRunExitEvent          = 0x08; // An event has been scheduled before the cycle the engine was told to stop at
+
+    //   Sets a bit of m_runExitRequest from the MCU's own thread.  It runs for every serial byte, so it avoids a
+    // locked instruction - a cRunExitInterrupt set by another thread at the same moment can get lost, but then
+    // the run loop is returning anyway, and run() looks at the interrupt lines themselves.
+    void requestRunExit( uint8_t reason )
+    { m_runExitRequest.store( m_runExitRequest.load( std::memory_order_relaxed ) | reason, std::memory_order_relaxed ); }
+
+    // An interrupt that can be taken (or that should end a WAI), and taking it.  Interrupts are only ever taken by
+    // run(), between engine calls.
+    bool interruptPending( const tMCURegisters& registers ) const
+    { return m_nmiPending || (m_irqLines != 0 && (registers.regP & flag_I) == 0); }
+    void takeInterrupt( tCore& rCore );
+
+    template< typename tRunCore >
+    static uint64_t packHistory( const tRunCore& rCore, uint16_t pc, uint8_t opCode )
+    {
+        return pc | (uint64_t(opCode) << 16) | (uint64_t(rCore.regA) << 24) | (uint64_t(rCore.regX) << 32)
+            | (uint64_t(rCore.regY) << 40) | (uint64_t(rCore.getRegP()) << 48) | (uint64_t(rCore.regSP) << 56);
+    }
+
+    //   Adds the instruction at pc to the history, as it's about to be run.  A compare and a few stores - cheap
+    // enough for the interpreters' inner loops.
+    template< typename tRunCore >
+    void recordInstruction( const tRunCore& rCore, uint16_t pc, uint8_t opCode )
+    {
+        uint64_t packed = packHistory( rCore, pc, opCode );
+
+        uint32_t historyEnd = m_historyEnd;
+        tHistoryEntry& rLast = m_history[(historyEnd - 1) % cHistorySize];
+        if( rLast.m_packed == packed && !rLast.m_translated )
+        {
+            rLast.m_count += rLast.m_count != UINT32_MAX;
+            return;
+        }
 
+        tHistoryEntry& rEntry = m_history[historyEnd % cHistorySize];
+        rEntry.m_packed = packed;
+        rEntry.m_count = 1;
+        rEntry.m_translated = false;
+        m_historyEnd = historyEnd + 1;
+    }
+
+    // pcExecute() on rCore, which is a copy of the registers - they're copied back afterwards
+    template< typename tRunCore > unsigned executeOn( tRunCore& rCore );
+
+    // Adds a translated block starting at pc to the history, for the caller to add the instructions it ran to
+    template< typename tRunCore >
+    tHistoryEntry& recordTranslated( const tRunCore& rCore, uint16_t pc, uint8_t opCode )
+    {
+        uint64_t packed = packHistory( rCore, pc, opCode );
+
+        tHistoryEntry *pEntry = &m_history[(m_historyEnd - 1) % cHistorySize];
+        if( pEntry->m_packed != packed || !pEntry->m_translated )
+        {
+            pEntry = &m_history[m_historyEnd++ % cHistorySize];
+            pEntry->m_packed = packed;
+            pEntry->m_count = 0;
+            pEntry->m_translated = true;
+        }
+
+        return *pEntry;
+    }
+
+    static void addHistoryCount( tHistoryEntry& rEntry, uint64_t instructions )
+    { rEntry.m_count = static_cast<uint32_t>(std::min< uint64_t >( uint64_t(rEntry.m_count) + instructions, UINT32_MAX )); }
+
+    // Sets m_waiting and m_stopped from run(), logging any change for tMCURewind
+    void setHalted( bool waiting, bool stopped );
+
+    // For tMCURewind - puts back a byte that the MCU wrote, and takes an interrupt that was taken the first time
+    void undoWrite( uint16_t address, uint8_t data );
+    void replayInterrupt( bool nmi );
+
+    // Whether the run loops have to check every instruction - for breakpoints, or for I being cleared while
+    // an IRQ is asserted
+    bool needsInstructionChecks( const tMCURegisters& registers ) const
+    { return m_breakpointCount > 0 || (m_irqLines != 0 && (registers.regP & flag_I) != 0); }
+    bool isIdleLoop( const tMCURegisters& registers ); // Whether the MCU is stuck polling cSerialRx
+
+    eExecEngine             m_execEngine;
+    bool                    m_lazyFlags;
+    uint64_t                m_cycleCount;
+    const uint64_t         *m_pRunCycles; // m_cycles of the core that an engine is running, which m_cycleCount doesn't include yet
+    uint64_t                m_nextEventCycle; // Cycle of the earliest scheduled event, or UINT64_MAX if there aren't any
+    std::vector< tScheduledEvent > m_events; // Latest first, so the next one to fire is at the back
+    std::atomic< uint8_t >  m_runExitRequest; // cRunExit... bits - the run loops return as soon as any are set
+    bool                    m_idleDetection;
+    std::atomic< uint32_t > m_irqLines; // One bit per asserted source
+    std::atomic< bool >     m_nmiLine;
+    std::atomic< bool >     m_nmiPending; // The NMI line has gone high since the last NMI was taken
+    bool                    m_waiting; // Executed WAI, and nothing has woken it up yet
+    bool                    m_stopped; // Executed STP
+    unsigned                m_breakpointCount;
+    uint8_t                 m_breakpoints[65536 / 8]; // One bit per address
+    tMCUBlockCache         *m_pBlockCache; // Created the first time engine_BlockCache runs
+    tMCUJit                *m_pJit; // Created the first time engine_Jit runs
+    tMCUState              *m_pJitShadow; // Interpreter that engine_JitVerify checks translated code against
+    uint8_t                *m_pJitShadowMemory;
+    uint16_t                m_verifyFailPC;
+    const tAotBlock        *m_pAotTable; // As passed to setAotBlocks()
+    unsigned                m_aotTableSize;
+    const tAotBlock       **m_pAotBlocks; // Indexed by starting PC - allocated by setAotBlocks()
+    bool                    m_codeModified; // Set when a write has invalidated predecoded or translated code
+    uint8_t                 m_codePages[256]; // cCodePage... bits for each page that code has come from
+    uint64_t                m_snapshotId; // tMCUSnapshot::m_id of the snapshot that cCodePageClean is against, or 0
+    tMCURewind             *m_pRewind;
+    tMCUObserver           *m_pObserver;
+    tMCUBranchTrace        *m_pBranchTrace;
+    uint64_t                m_instructionCount;
+    tHistoryEntry           m_history[cHistorySize]; // A ring - entries with an m_count of 0 are unused
+    uint32_t                m_historyEnd; // Entries ever started - the next one goes at m_historyEnd % cHistorySize
     uint16_t                m_decodePos; // Used internally for address decoding
+    uint8_t                *m_pPages[256]; // Where each page is in m_pMemory, or 0 if it has a device in it
+    std::vector< tDeviceRange > m_devices; // Most recently added last
+    tSerialDevice           m_serialDevice;
+    tMCUVia                 m_via;
+    std::queue< uint8_t >   m_serialToMCUFIFO; // Guarded by m_serialMutex
+    std::atomic< size_t >   m_serialToMCUCount; // Size of m_serialToMCUFIFO, so the MCU can check it without locking - only stored to under m_serialMutex
+    std::mutex              m_serialMutex;
+    std::condition_variable m_wakeUp; // Notified when m_serialToMCUFIFO is pushed to, or an interrupt line is asserted
+    std::queue< uint8_t >   m_serialFromMCUFIFO;
+};
+
+// The MCU as tMCUState::saveSnapshot() left it.  Holds a copy of all 64k of memory, so it's best reused.
+class tMCUSnapshot
+{
+public:
+    tMCUSnapshot() : m_pState( 0 ), m_id( 0 ) {}
+
+    const tMCURegisters& getRegisters() const { return m_registers; }
+    uint64_t getCycleCount() const { return m_cycleCount; }
+
+private:
+    friend struct tMCUState;
+
+    tMCUSnapshot( const tMCUSnapshot& ); // Disallowed - the copy would look up to date to the dirty tracking
+
+    const tMCUState        *m_pState; // The state that saved it
+    uint64_t                m_id; // Given out afresh each time it's copied in full
+    tMCURegisters           m_registers;
+    uint64_t                m_cycleCount;
+    std::vector< tMCUState::tScheduledEvent > m_events;
+    uint32_t                m_irqLines;
+    bool                    m_nmiLine;
+    bool                    m_nmiPending;
+    bool                    m_waiting;
+    bool                    m_stopped;
+    tMCUVia::tSavedState    m_via;
     std::queue< uint8_t >   m_serialToMCUFIFO;
     std::queue< uint8_t >   m_serialFromMCUFIFO;
+    uint8_t                 m_memory[65536];
 };
 
 #endif
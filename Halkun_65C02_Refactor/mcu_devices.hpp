@@ -0,0 +1,92 @@
+/*
+
+  mcu_devices.hpp - The Halkun board's other memory mapped registers, for tMCUState::addDevice()
+
+*/
+
+#ifndef MCU_DEVICES_HPP
+#define MCU_DEVICES_HPP
+
+#include <cstdint>
+#include <queue>
+
+#include "mcu_core.hpp"
+
+// Character LCD - bytes written to $0300 are queued for the host to display
+class tMCULcd : public tMCUDevice
+{
+public:
+    static const uint16_t cAddress = 0x0300;
+
+    virtual uint8_t read( uint16_t ) { return 0; }
+    virtual void write( uint16_t, uint8_t data ) { m_fromMCUFIFO.push( data ); }
+
+    virtual tMCUDevice *clone() const { return new tMCULcd( *this ); }
+    virtual void copyTo( tMCUDevice& rClone ) const { static_cast< tMCULcd& >( rClone ) = *this; }
+    virtual bool sameAs( const tMCUDevice& rClone ) const { return static_cast< const tMCULcd& >( rClone ).m_fromMCUFIFO == m_fromMCUFIFO; }
+
+    bool empty() const { return m_fromMCUFIFO.empty(); }
+    uint8_t popByte()
+    {
+        if( m_fromMCUFIFO.empty() )
+            return 0;
+
+        uint8_t data = m_fromMCUFIFO.front();
+        m_fromMCUFIFO.pop();
+        return data;
+    }
+
+private:
+    std::queue< uint8_t > m_fromMCUFIFO;
+};
+
+// Keypad - reading $0301 returns the next key pushed by the host, or 0 if there isn't one
+class tMCUKeypad : public tMCUDevice
+{
+public:
+    static const uint16_t cAddress = 0x0301;
+
+    virtual uint8_t read( uint16_t )
+    {
+        if( m_toMCUFIFO.empty() )
+            return 0;
+
+        uint8_t key = m_toMCUFIFO.front();
+        m_toMCUFIFO.pop();
+        return key;
+    }
+    virtual void write( uint16_t, uint8_t ) {}
+
+    virtual tMCUDevice *clone() const { return new tMCUKeypad( *this ); }
+    virtual void copyTo( tMCUDevice& rClone ) const { static_cast< tMCUKeypad& >( rClone ) = *this; }
+    virtual bool sameAs( const tMCUDevice& rClone ) const { return static_cast< const tMCUKeypad& >( rClone ).m_toMCUFIFO == m_toMCUFIFO; }
+
+    void pushKey( uint8_t key ) { m_toMCUFIFO.push( key ); }
+
+private:
+    std::queue< uint8_t > m_toMCUFIFO;
+};
+
+//   Bank select - the bank written to $0308 is latched, and reads back.  As in mcu_halkun.cpp's banksel(),
+// memory itself isn't switched (tMCUBankedBus does that) - bank 1 (the ROM) is selected on reset.
+class tMCUBankSelect : public tMCUDevice
+{
+public:
+    static const uint16_t cAddress = 0x0308;
+
+    tMCUBankSelect() : m_bank( 1 ) {}
+
+    virtual uint8_t read( uint16_t ) { return m_bank; }
+    virtual void write( uint16_t, uint8_t data ) { m_bank = data; }
+
+    virtual tMCUDevice *clone() const { return new tMCUBankSelect( *this ); }
+    virtual void copyTo( tMCUDevice& rClone ) const { static_cast< tMCUBankSelect& >( rClone ) = *this; }
+    virtual bool sameAs( const tMCUDevice& rClone ) const { return static_cast< const tMCUBankSelect& >( rClone ).m_bank == m_bank; }
+
+    uint8_t getBank() const { return m_bank; }
+
+private:
+    uint8_t m_bank;
+};
+
+#endif
@@ -0,0 +1,72 @@
+/*
+
+  mcu_execute.hpp - Executes instructions on a tMCUCore, whatever bus it's on
+
+*/
+
+#ifndef MCU_EXECUTE_HPP
+#define MCU_EXECUTE_HPP
+
+#include <cstdint>
+
+#include "mcu_core.hpp"
+#include "mcu_instr.hpp"
+
+#include "mcu_6502.hpp"
+#include "mcu_65c02.hpp"
+
+// These macros are used to help construct a 256 element switch statement going from 0 to 255.
+// Typed out, it would look something like:
+// switch( opCode )
+// {
+// case 0: return mcuInstructionExecute< 0 >( *this );
+// case 1: return mcuInstructionExecute< 1 >( *this );
+// case 2: return mcuInstructionExecute< 2 >( *this );
+// ...
+// case 255: return mcuInstructionExecute< 255 >( *this );
+// }
+// However, I'm much too lazy to generate all that, so I use these macros to get the preprocessor
+// to generate the statements for me.  'target' is what gets passed to each template function.
+
+#define EXEC_OPCODE( opCode, templateFuncName, target )  case (opCode): return templateFuncName< (opCode) >( target );
+#define EXEC_OPCODE_8( opCode, templateFuncName, target )  \
+    EXEC_OPCODE( (opCode), templateFuncName, target );     EXEC_OPCODE( (opCode) + 1, templateFuncName, target ); \
+    EXEC_OPCODE( (opCode) + 2, templateFuncName, target ); EXEC_OPCODE( (opCode) + 3, templateFuncName, target ); \
+    EXEC_OPCODE( (opCode) + 4, templateFuncName, target ); EXEC_OPCODE( (opCode) + 5, templateFuncName, target ); \
+    EXEC_OPCODE( (opCode) + 6, templateFuncName, target ); EXEC_OPCODE( (opCode) + 7, templateFuncName, target );
+#define EXEC_OPCODE_64( opCode, templateFuncName, target )  \
+    EXEC_OPCODE_8( (opCode), templateFuncName, target );         EXEC_OPCODE_8( (opCode) + 1 * 8, templateFuncName, target ); \
+    EXEC_OPCODE_8( (opCode) + 2 * 8, templateFuncName, target ); EXEC_OPCODE_8( (opCode) + 3 * 8, templateFuncName, target ); \
+    EXEC_OPCODE_8( (opCode) + 4 * 8, templateFuncName, target ); EXEC_OPCODE_8( (opCode) + 5 * 8, templateFuncName, target ); \
+    EXEC_OPCODE_8( (opCode) + 6 * 8, templateFuncName, target ); EXEC_OPCODE_8( (opCode) + 7 * 8, templateFuncName, target );
+
+template< typename tCore >
+inline void mcuExecuteOpCode( tCore& rCore, uint8_t opCode )
+{
+    switch( opCode )
+    {
+    EXEC_OPCODE_64( 0, mcuInstructionExecute, rCore );
+    EXEC_OPCODE_64( 1 * 64, mcuInstructionExecute, rCore );
+    EXEC_OPCODE_64( 2 * 64, mcuInstructionExecute, rCore );
+    EXEC_OPCODE_64( 3 * 64, mcuInstructionExecute, rCore );
+    }
+}
+
+// Fetches and executes the instruction at PC, and returns the number of cycles it took
+template< typename tCore >
+inline unsigned mcuExecuteInstruction( tCore& rCore )
+{
+    uint64_t extraCycles = rCore.m_cycles;
+
+    uint16_t pc = rCore.regPC;
+    uint8_t opCode = rCore.pcReadByte();
+    rCore.observeInstructionBegin( pc, opCode );
+    mcuExecuteOpCode( rCore, opCode );
+
+    unsigned cycles = static_cast<unsigned>(tMCUState::opCodeCycles( opCode ) + rCore.m_cycles - extraCycles);
+    rCore.m_rObserver.instructionEnd( rCore.getRegisters(), cycles );
+
+    return cycles;
+}
+
+#endif
@@ -0,0 +1,193 @@
+#include "mcu_fleet.hpp"
+
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+// An instruction budget also ends once this many cycles per instruction have gone by, so that an instance waiting
+// in WAI for an event that never wakes it still finishes
+static const uint64_t cMaxCyclesPerInstruction = 16;
+
+tMCUFleet::tMCUFleet( unsigned threadCount )
+    : m_threadCount( threadCount )
+    , m_quantum( 100000 )
+    , m_quantumCycles( false )
+    , m_instancesLeft( 0 )
+{
+    if( m_threadCount == 0 )
+        m_threadCount = std::thread::hardware_concurrency();
+    if( m_threadCount == 0 )
+        m_threadCount = 1;
+
+    for( unsigned worker = 0; worker < m_threadCount; ++worker )
+        m_queues.push_back( new tWorkQueue );
+}
+
+tMCUFleet::~tMCUFleet()
+{
+    for( size_t instanceIndex = 0; instanceIndex < m_instances.size(); ++instanceIndex )
+    {
+        delete m_instances[instanceIndex]->m_pState;
+        delete [] m_instances[instanceIndex]->m_pMemory;
+        delete m_instances[instanceIndex];
+    }
+
+    for( size_t worker = 0; worker < m_queues.size(); ++worker )
+        delete m_queues[worker];
+}
+
+unsigned tMCUFleet::addInstance( const uint8_t *pImage, uint64_t budget, const std::string& serialInput, bool repeatInput )
+{
+    tInstance *pInstance = new tInstance;
+    pInstance->m_pMemory = new uint8_t[65536];
+    memcpy( pInstance->m_pMemory, pImage, 65536 );
+    pInstance->m_pState = new tMCUState( pInstance->m_pMemory );
+    pInstance->m_budget = budget;
+    pInstance->m_serialInput = serialInput;
+    pInstance->m_inputPos = 0;
+    pInstance->m_repeatInput = repeatInput;
+    pInstance->m_keepOutput = false;
+    pInstance->m_stats.m_instructions = 0;
+    pInstance->m_stats.m_cycles = 0;
+    pInstance->m_stats.m_seconds = 0;
+    pInstance->m_stats.m_lastExit = run_Budget;
+
+    m_instances.push_back( pInstance );
+    return unsigned(m_instances.size() - 1);
+}
+
+double tMCUFleet::run()
+{
+    // Dealt out round robin, so every worker starts with a share
+    for( unsigned instanceIndex = 0; instanceIndex < m_instances.size(); ++instanceIndex )
+        m_queues[instanceIndex % m_threadCount]->m_instances.push_back( instanceIndex );
+
+    m_instancesLeft = unsigned(m_instances.size());
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    // This thread is worker 0
+    std::vector< std::thread > threads;
+    for( unsigned worker = 1; worker < m_threadCount; ++worker )
+        threads.push_back( std::thread( &tMCUFleet::workerThread, this, worker ) );
+
+    workerThread( 0 );
+
+    for( size_t threadIndex = 0; threadIndex < threads.size(); ++threadIndex )
+        threads[threadIndex].join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    return elapsed.count();
+}
+
+void tMCUFleet::workerThread( unsigned worker )
+{
+    while( m_instancesLeft > 0 )
+    {
+        unsigned instanceIndex;
+        if( !takeWork( worker, instanceIndex ) )
+        {
+            // Everything left is being run by other workers
+            std::this_thread::yield();
+            continue;
+        }
+
+        if( runQuantum( *m_instances[instanceIndex] ) )
+        {
+            std::lock_guard< std::mutex > lock( m_queues[worker]->m_mutex );
+            m_queues[worker]->m_instances.push_back( instanceIndex );
+        }
+        else
+            --m_instancesLeft;
+    }
+}
+
+bool tMCUFleet::takeWork( unsigned worker, unsigned& rInstance )
+{
+    {
+        tWorkQueue& rOwn = *m_queues[worker];
+        std::lock_guard< std::mutex > lock( rOwn.m_mutex );
+        if( !rOwn.m_instances.empty() )
+        {
+            rInstance = rOwn.m_instances.front();
+            rOwn.m_instances.pop_front();
+            return true;
+        }
+    }
+
+    // Starting with the next worker along, so that thieves don't all pick on the same one
+    for( unsigned offset = 1; offset < m_threadCount; ++offset )
+    {
+        tWorkQueue& rVictim = *m_queues[(worker + offset) % m_threadCount];
+        std::lock_guard< std::mutex > lock( rVictim.m_mutex );
+        if( !rVictim.m_instances.empty() )
+        {
+            rInstance = rVictim.m_instances.back();
+            rVictim.m_instances.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool tMCUFleet::runQuantum( tInstance& rInstance )
+{
+    tMCUState& rState = *rInstance.m_pState;
+    tInstanceStats& rStats = rInstance.m_stats;
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    uint64_t used = m_quantumCycles ? rStats.m_cycles : rStats.m_instructions;
+    uint64_t quantumLeft = std::min( m_quantum, rInstance.m_budget - used );
+    bool halted = false;
+
+    while( quantumLeft > 0 )
+    {
+        if( rState.serialToMCUEmpty() && rInstance.m_inputPos < rInstance.m_serialInput.size() )
+        {
+            rState.serialToMCUPushByte( static_cast<uint8_t>(rInstance.m_serialInput[rInstance.m_inputPos++]) );
+            if( rInstance.m_repeatInput && rInstance.m_inputPos == rInstance.m_serialInput.size() )
+                rInstance.m_inputPos = 0;
+        }
+
+        tRunResult result = m_quantumCycles ? rState.runCycles( quantumLeft ) : rState.runInstructions( quantumLeft );
+        uint64_t resultUsed = m_quantumCycles ? result.m_cycles : result.m_instructions;
+
+        rStats.m_instructions += result.m_instructions;
+        rStats.m_cycles += result.m_cycles;
+        rStats.m_lastExit = result.m_exit;
+        quantumLeft -= std::min( quantumLeft, resultUsed );
+
+        while( !rState.serialFromMCUEmpty() )
+        {
+            uint8_t data = rState.serialFromMCUPopByte();
+            if( rInstance.m_keepOutput )
+                rInstance.m_serialOutput += static_cast<char>(data);
+        }
+
+        // Halted for good - a WAI only comes back if there's input still to type, or an event that might wake it
+        bool noInput = rState.serialToMCUEmpty() && rInstance.m_inputPos >= rInstance.m_serialInput.size();
+        if( result.m_exit == run_Stop || result.m_exit == run_VerifyFailed || (result.m_exit == run_Wait && noInput && !rState.hasScheduledEvents()) )
+        {
+            halted = true;
+            break;
+        }
+
+        // Otherwise time has gone by without using up an instruction budget - give the other instances a turn
+        if( result.m_exit == run_Wait )
+            break;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    rStats.m_seconds += elapsed.count();
+
+    if( halted )
+        return false;
+
+    if( m_quantumCycles )
+        return rStats.m_cycles < rInstance.m_budget;
+
+    return rStats.m_instructions < rInstance.m_budget
+        && rStats.m_cycles / cMaxCyclesPerInstruction < rInstance.m_budget;
+}
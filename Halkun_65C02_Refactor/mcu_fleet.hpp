@@ -0,0 +1,99 @@
+/*
+
+  mcu_fleet.hpp - Runs many independent MCUs across all of the host's cores
+
+*/
+
+#ifndef MCU_FLEET_HPP
+#define MCU_FLEET_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+
+#include "mcu_core.hpp"
+
+//   A set of boards, each with its own memory, tMCUState and serial streams, run by a pool of worker threads.
+// Each instance runs for a fixed quantum of instructions or cycles at a time, and then goes to the back of its
+// worker's queue.  A worker that runs out of instances steals from the other end of another worker's queue, so the
+// load evens out even when instances finish at different times.
+//   Instances only ever run on one thread at a time, but may move between threads from one quantum to the next -
+// tMCUState has no shared mutable state, so nothing else is needed.
+class tMCUFleet
+{
+public:
+    struct tInstanceStats
+    {
+        uint64_t m_instructions;
+        uint64_t m_cycles;
+        double m_seconds; // Time spent running this instance, on whichever threads
+        eRunExit m_lastExit;
+    };
+
+    // threadCount 0 uses one thread per host core
+    explicit tMCUFleet( unsigned threadCount = 0 );
+    ~tMCUFleet();
+
+    //   Adds an instance starting from a copy of the 64k pImage, and returns its index.  serialInput is typed in a
+    // byte at a time whenever the MCU's FIFO is empty - over and over again if repeatInput.  The instance is done
+    // once it has used budget instructions (or cycles, see setQuantum()), or executes STP, or waits in WAI with
+    // nothing left to wake it.  An instruction budget also runs out after 16 cycles per instruction, in case the
+    // instance spends it in a WAI.
+    unsigned addInstance( const uint8_t *pImage, uint64_t budget, const std::string& serialInput, bool repeatInput );
+
+    // The instance's MCU, for setting the engine and so on before run()
+    tMCUState& getState( unsigned index ) { return *m_instances[index]->m_pState; }
+
+    // Keeps what the instance sends over the serial port - otherwise it's thrown away
+    void setKeepOutput( unsigned index, bool keepOutput ) { m_instances[index]->m_keepOutput = keepOutput; }
+    const std::string& getSerialOutput( unsigned index ) const { return m_instances[index]->m_serialOutput; }
+
+    // Instructions (or, with cycles, cycles) that an instance runs before another one gets a turn
+    void setQuantum( uint64_t quantum, bool cycles ) { m_quantum = quantum; m_quantumCycles = cycles; }
+
+    // Runs every instance to the end of its budget, and returns the time that took
+    double run();
+
+    unsigned getInstanceCount() const { return unsigned(m_instances.size()); }
+    unsigned getThreadCount() const { return m_threadCount; }
+    const tInstanceStats& getStats( unsigned index ) const { return m_instances[index]->m_stats; }
+
+private:
+    struct tInstance
+    {
+        uint8_t *m_pMemory;
+        tMCUState *m_pState;
+        uint64_t m_budget;
+        std::string m_serialInput;
+        size_t m_inputPos;
+        bool m_repeatInput;
+        bool m_keepOutput;
+        std::string m_serialOutput;
+        tInstanceStats m_stats;
+    };
+
+    // One worker's instances - the owner takes from the front, and thieves from the back
+    struct tWorkQueue
+    {
+        std::mutex m_mutex;
+        std::deque< unsigned > m_instances;
+    };
+
+    tMCUFleet( const tMCUFleet& ); // Disallowed
+
+    void workerThread( unsigned worker );
+    bool takeWork( unsigned worker, unsigned& rInstance );
+    bool runQuantum( tInstance& rInstance ); // Returns false once the instance is done
+
+    unsigned                m_threadCount;
+    uint64_t                m_quantum;
+    bool                    m_quantumCycles;
+    std::vector< tInstance* > m_instances;
+    std::vector< tWorkQueue* > m_queues; // One per worker
+    std::atomic< unsigned > m_instancesLeft; // Not done yet - workers stop when this gets to 0
+};
+
+#endif
@@ -45,7 +45,7 @@ void banksel( byte )
     // Do nothing
 }
 
-#ifdef DO_MCU_TRACE
+// Replaying reads for verifyBehaviour() (main -v) while g_pReadSequence is set
 
 tMemoryTraceQueue g_traceQueue;
 const uint8_t *g_pReadSequence = 0;
@@ -95,14 +95,13 @@ tMemoryTraceQueue& getMemoryTraceQueue()
     return g_traceQueue;
 }
 
-void memStoreByte(int addr, byte value )
+static void traceStoreByte(int addr, byte value )
 {
     g_traceQueue.push( tMemoryTrace( addr, value, false ) );
     g_lastWriteResult = value;
 }
 
-// memReadByte() - Peek a byte, don't touch any registers
-byte memReadByte(int addr ) 
+static byte traceReadByte(int addr ) 
 { 
     byte readValue = *g_pReadSequence;
     g_traceQueue.push( tMemoryTrace( addr, readValue, true ) );
@@ -112,13 +111,17 @@ byte memReadByte(int addr )
     return readValue;
 }
 
-#else
-
 uint8_t     g_pMemory[65536];
 
 // memStoreByte() - Poke a byte, don't touch any registers
 void memStoreByte(int addr,byte value )
 {
+    if( g_pReadSequence )
+    {
+        traceStoreByte( addr, value );
+        return;
+    }
+
 	// Write registers
 /*	if(addr==0x0302) {Serial.write(value& 0xff);}  
 	else
@@ -144,6 +147,8 @@ void memStoreByte(int addr,byte value )
 // memReadByte() - Peek a byte, don't touch any registers
 byte memReadByte(int addr ) 
 {  
+    if( g_pReadSequence )
+        return traceReadByte( addr );
 
 /*	if(addr==0x0303)  {return (serial_read());}	
 	else
@@ -166,8 +171,6 @@ byte memReadByte(int addr )
 	}
 }
 
-#endif
-
 
 // CPUreset() - Resets CPU to startup state
 void CPUreset() {
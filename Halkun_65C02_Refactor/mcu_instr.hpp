@@ -14,7 +14,17 @@
 #include "mcu_core.hpp"
 
 // Generic template for all instructions acts as a NOP in release mode, but asserts in debug
-template <uint8_t opCodeNumber> inline void mcuInstructionExecute( tMCUState& rState ) { assert( false ); }
+//   This is a class so that DECLARE_INSTRUCTION can specialise it per opcode while still leaving the core type
+// (see tMCUCore) as a template parameter.
+template <uint8_t opCodeNumber> struct tMCUInstruction
+{
+    template<typename tCore> static inline void execute( tCore& ) { assert( false ); }
+    template<typename tCore> static inline void executeDecoded( tCore&, uint16_t ) { assert( false ); }
+};
+// Executes opcode opCodeNumber on the given core
+template <uint8_t opCodeNumber, typename tCore> inline void mcuInstructionExecute( tCore& rCore ) { tMCUInstruction< opCodeNumber >::execute( rCore ); }
+// Executes opcode opCodeNumber with operand bytes that have already been fetched - PC must already point at the next instruction
+template <uint8_t opCodeNumber, typename tCore> inline void mcuInstructionExecuteDecoded( tCore& rCore, uint16_t operand ) { tMCUInstruction< opCodeNumber >::executeDecoded( rCore, operand ); }
 // Generic template for uninstantiated instructions returns an empty string as its name
 template <uint8_t opCodeNumber> inline std::string mcuInstructionName( tMCUState& ) { return "??"; }
 // Returns a human friendly string that describes how the address will be decoded for this opcode
@@ -22,18 +32,59 @@ template <uint8_t opCodeNumber> inline std::string mcuInstructionDecodeAddressin
 // Number of bytes (not counting the opcode) used to hold addressing information
 template <uint8_t opCodeNumber> inline uint8_t mcuInstructionDecodeLength( tMCUState& ) { return 0; }
 
+//   The three kinds of addressing mode as one number, for tables that are indexed by it: the eAddressingMode_Mem
+// values, then am_Accum, then am_Implied
+static const unsigned cAddressingModeAccum      = am_AbsIdxIndirect + 1;
+static const unsigned cAddressingModeImplied    = am_AbsIdxIndirect + 2;
+inline unsigned mcuAddressingModeNumber( eAddressingMode_Mem mode ) { return mode; }
+inline unsigned mcuAddressingModeNumber( eAddressingMode_Register ) { return cAddressingModeAccum; }
+inline unsigned mcuAddressingModeNumber( eAddressingMode_Null ) { return cAddressingModeImplied; }
+// The opcode's addressing mode, as mcuAddressingModeNumber()
+template <uint8_t opCodeNumber> inline unsigned mcuInstructionAddressingMode( tMCUState& ) { return cAddressingModeImplied; }
+
+// Whether an opcode takes an extra cycle when its indexed address crosses a page.  Reads (and the 65c02's
+// shifts/rotates) do - stores and INC/DEC abs,X always take the extra cycle, so it's in their base timing.
+inline bool mcuPageCrossPenalty( uint8_t opCode )
+{
+    switch( opCode )
+    {
+    case 0x91: case 0x99: case 0x9D: // STA (zp),Y / abs,Y / abs,X
+    case 0x9E: // STZ abs,X
+    case 0xDE: case 0xFE: // DEC/INC abs,X
+        return false;
+    }
+
+    return true;
+}
+
+// Some tables need the opcode as a literal (e.g. so that it can be pasted into a label name), so these macros
+// count through 0x00 to 0xFF by hex digit, calling opCodeMacro( 0xNN ) for each.
+#define EACH_OPCODE_16( hiNibble, opCodeMacro ) \
+    opCodeMacro( hiNibble ## 0 ) opCodeMacro( hiNibble ## 1 ) opCodeMacro( hiNibble ## 2 ) opCodeMacro( hiNibble ## 3 ) \
+    opCodeMacro( hiNibble ## 4 ) opCodeMacro( hiNibble ## 5 ) opCodeMacro( hiNibble ## 6 ) opCodeMacro( hiNibble ## 7 ) \
+    opCodeMacro( hiNibble ## 8 ) opCodeMacro( hiNibble ## 9 ) opCodeMacro( hiNibble ## A ) opCodeMacro( hiNibble ## B ) \
+    opCodeMacro( hiNibble ## C ) opCodeMacro( hiNibble ## D ) opCodeMacro( hiNibble ## E ) opCodeMacro( hiNibble ## F )
+#define EACH_OPCODE_256( opCodeMacro ) \
+    EACH_OPCODE_16( 0x0, opCodeMacro ) EACH_OPCODE_16( 0x1, opCodeMacro ) EACH_OPCODE_16( 0x2, opCodeMacro ) EACH_OPCODE_16( 0x3, opCodeMacro ) \
+    EACH_OPCODE_16( 0x4, opCodeMacro ) EACH_OPCODE_16( 0x5, opCodeMacro ) EACH_OPCODE_16( 0x6, opCodeMacro ) EACH_OPCODE_16( 0x7, opCodeMacro ) \
+    EACH_OPCODE_16( 0x8, opCodeMacro ) EACH_OPCODE_16( 0x9, opCodeMacro ) EACH_OPCODE_16( 0xA, opCodeMacro ) EACH_OPCODE_16( 0xB, opCodeMacro ) \
+    EACH_OPCODE_16( 0xC, opCodeMacro ) EACH_OPCODE_16( 0xD, opCodeMacro ) EACH_OPCODE_16( 0xE, opCodeMacro ) EACH_OPCODE_16( 0xF, opCodeMacro )
+
 // Use this to declare the instruction to exist by declaring its opcode, mnemonic, and addressing mode
 // DECLARE_INSTRUCTION( 0, BRK, am_ZeroPage );
 //   This will declare:
 // 1.) mcuInstruction_BRK() to exist (so that other functions can call the instruction by its name), and
-// 2.) mcuInstructionExecute<0> to exist, and for it to inline mcuInstruction_BRK() with zero page addressing mode, and
-// 3.) mcuInstructionName<0> to return "BRK".
+// 2.) tMCUInstruction<0>::execute (and executeDecoded) to exist, and for it to inline mcuInstruction_BRK() with zero page addressing mode, and
+// 3.) mcuInstructionName<0> to return "BRK" (and the other decoding functions above to describe zero page addressing).
 #define DECLARE_INSTRUCTION( instrOpCode, instrName, addressingMode ) \
-    template<typename tAccessor> inline void mcuInstruction_ ## instrName( tMCUState&, tAccessor, uint8_t ); \
-    template<> inline void mcuInstructionExecute< instrOpCode >( tMCUState& rState ) { mcuInstruction_ ## instrName( rState, rState.makeAccessor( addressingMode ), instrOpCode ); } \
+    template<typename tCore, typename tAccessor> inline void mcuInstruction_ ## instrName( tCore&, tAccessor, uint8_t ); \
+    template<> struct tMCUInstruction< instrOpCode > \
+    { template<typename tCore> static inline void execute( tCore& rState ) { mcuInstruction_ ## instrName( rState, rState.makeAccessor( addressingMode, mcuPageCrossPenalty( instrOpCode ) ), instrOpCode ); } \
+      template<typename tCore> static inline void executeDecoded( tCore& rState, uint16_t operand ) { mcuInstruction_ ## instrName( rState, rState.makeDecodedAccessor( addressingMode, operand, mcuPageCrossPenalty( instrOpCode ) ), instrOpCode ); } }; \
     template<> inline std::string mcuInstructionName< instrOpCode >( tMCUState& ) { return #instrName; } \
     template<> inline std::string mcuInstructionDecodeAddressing< instrOpCode >( tMCUState& rState ) { return rState.decodeAddressing( addressingMode ); } \
-    template<> inline uint8_t mcuInstructionDecodeLength< instrOpCode >( tMCUState& rState ) { return rState.decodeLength( addressingMode ); }
+    template<> inline uint8_t mcuInstructionDecodeLength< instrOpCode >( tMCUState& rState ) { return rState.decodeLength( addressingMode ); } \
+    template<> inline unsigned mcuInstructionAddressingMode< instrOpCode >( tMCUState& ) { return mcuAddressingModeNumber( addressingMode ); }
 
 
 // Use this to actually instantiate the instruction
@@ -44,10 +95,10 @@ template <uint8_t opCodeNumber> inline uint8_t mcuInstructionDecodeLength( tMCUS
 //   This will actually instantiate mcuInstruction_BRK(), so that you do not need to type
 // the opcode again.  Any typos will cause a link error.
 //   The arguments that can be used are:
-// 1.) rState - the main mcu state
+// 1.) rState - the core (registers + helpers) being executed on
 // 2.) memData - an accessor to the data in question, if any
 // 3.) opCode - the numeric opcode
 #define DEFINE_INSTRUCTION( instrName ) \
-    template<typename tAccessor> inline void mcuInstruction_ ## instrName( tMCUState& rState, tAccessor memData, uint8_t opCode )
+    template<typename tCore, typename tAccessor> inline void mcuInstruction_ ## instrName( tCore& rState, tAccessor memData, uint8_t opCode )
 
 #endif
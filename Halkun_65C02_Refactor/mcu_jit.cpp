@@ -0,0 +1,1257 @@
+#include "mcu_jit.hpp"
+#include "mcu_blockcache.hpp"
+
+#include <cstddef>
+
+// Native code is only generated for x86-64
+#if defined(__x86_64__) || defined(_M_X64)
+#define MCU_JIT_X64
+#endif
+
+#ifdef MCU_JIT_X64
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#endif
+
+enum eHostRegister
+{
+    host_AX, host_CX, host_DX, host_BX, host_SP, host_BP, host_SI, host_DI,
+    host_R8, host_R9, host_R10, host_R11, host_R12, host_R13, host_R14, host_R15,
+};
+
+// Where the guest lives while translated code runs.  These are callee saved in both the System V and Windows
+// ABIs, so they survive calls back into tMCUState.  AX, CX, DX, R10 and R11 are free for scratch.
+static const int cHostA         = host_BX;
+static const int cHostX         = host_R12;
+static const int cHostY         = host_R13;
+static const int cHostP         = host_R14;
+static const int cHostContext   = host_R15;
+static const int cHostMemory    = host_BP;
+
+#if defined(_WIN32)
+static const int cHostArg0      = host_CX;
+static const int cHostArg1      = host_DX;
+static const int cHostArg2      = host_R8;
+static const uint8_t cStackReserve = 40; // Shadow space, plus keeping calls 16 byte aligned
+#else
+static const int cHostArg0      = host_DI;
+static const int cHostArg1      = host_SI;
+static const int cHostArg2      = host_DX;
+static const uint8_t cStackReserve = 8; // Keeps calls 16 byte aligned
+#endif
+
+// x86 condition codes
+enum eHostCondition
+{
+    cc_B    = 0x2,
+    cc_AE   = 0x3,
+    cc_E    = 0x4,
+    cc_NE   = 0x5,
+    cc_A    = 0x7,
+    cc_L    = 0xC,
+};
+
+// ALU opcodes in their "r/m32, r32" form, and the /digit of their immediate forms
+enum eHostAlu
+{
+    alu_Add     = 0x01,
+    alu_Or      = 0x09,
+    alu_And     = 0x21,
+    alu_Sub     = 0x29,
+    alu_Xor     = 0x31,
+    alu_Cmp     = 0x39,
+    alu_Test    = 0x85,
+};
+
+enum eHostAluImm
+{
+    aluImm_Add  = 0,
+    aluImm_Or   = 1,
+    aluImm_And  = 4,
+    aluImm_Sub  = 5,
+    aluImm_Xor  = 6,
+    aluImm_Cmp  = 7,
+};
+
+enum eHostShift
+{
+    shift_Left  = 4,
+    shift_Right = 5,
+};
+
+// What a guest opcode does, as far as the translator is concerned
+enum eJitOperation
+{
+    jit_LDA, jit_LDX, jit_LDY, jit_STA, jit_STX, jit_STY, jit_STZ,
+    jit_ORA, jit_AND, jit_EOR, jit_ADC, jit_SBC, jit_CMP, jit_CPX, jit_CPY, jit_BIT,
+    jit_INC, jit_DEC, jit_ASL, jit_LSR, jit_ROL, jit_ROR,
+    jit_INX, jit_INY, jit_DEX, jit_DEY,
+    jit_TAX, jit_TAY, jit_TXA, jit_TYA, jit_TSX, jit_TXS,
+    jit_PHA, jit_PHX, jit_PHY, jit_PHP, jit_PLA, jit_PLX, jit_PLY, jit_PLP,
+    jit_CLC, jit_SEC, jit_CLI, jit_SEI, jit_CLD, jit_SED, jit_CLV, jit_NOP,
+    jit_BPL, jit_BMI, jit_BVC, jit_BVS, jit_BCC, jit_BCS, jit_BNE, jit_BEQ, jit_BRA,
+    jit_JMP, jit_JSR, jit_RTS,
+};
+
+// Addressing modes that aren't in eAddressingMode_Mem
+static const int cModeImplied   = -1;
+static const int cModeAccum     = -2;
+
+// Looks up how to translate an opcode.  Returns false for anything that's left to the interpreter.
+static bool jitOpCode( uint8_t opCode, eJitOperation& rOperation, int& rMode )
+{
+#define JIT_OPCODE( opCodeValue, operation, mode ) case (opCodeValue): rOperation = (operation); rMode = (mode); return true;
+
+    switch( opCode )
+    {
+    JIT_OPCODE( 0xA9, jit_LDA, am_Immediate ) JIT_OPCODE( 0xA5, jit_LDA, am_ZeroPage ) JIT_OPCODE( 0xB5, jit_LDA, am_ZeroPage_X )
+    JIT_OPCODE( 0xAD, jit_LDA, am_Absolute ) JIT_OPCODE( 0xBD, jit_LDA, am_Absolute_X ) JIT_OPCODE( 0xB9, jit_LDA, am_Absolute_Y )
+    JIT_OPCODE( 0xA1, jit_LDA, am_Indirect_X ) JIT_OPCODE( 0xB1, jit_LDA, am_Indirect_Y ) JIT_OPCODE( 0xB2, jit_LDA, am_Indirect_ZP )
+
+    JIT_OPCODE( 0xA2, jit_LDX, am_Immediate ) JIT_OPCODE( 0xA6, jit_LDX, am_ZeroPage ) JIT_OPCODE( 0xB6, jit_LDX, am_ZeroPage_Y )
+    JIT_OPCODE( 0xAE, jit_LDX, am_Absolute ) JIT_OPCODE( 0xBE, jit_LDX, am_Absolute_Y )
+
+    JIT_OPCODE( 0xA0, jit_LDY, am_Immediate ) JIT_OPCODE( 0xA4, jit_LDY, am_ZeroPage ) JIT_OPCODE( 0xB4, jit_LDY, am_ZeroPage_X )
+    JIT_OPCODE( 0xAC, jit_LDY, am_Absolute ) JIT_OPCODE( 0xBC, jit_LDY, am_Absolute_X )
+
+    JIT_OPCODE( 0x85, jit_STA, am_ZeroPage ) JIT_OPCODE( 0x95, jit_STA, am_ZeroPage_X ) JIT_OPCODE( 0x8D, jit_STA, am_Absolute )
+    JIT_OPCODE( 0x9D, jit_STA, am_Absolute_X ) JIT_OPCODE( 0x99, jit_STA, am_Absolute_Y ) JIT_OPCODE( 0x81, jit_STA, am_Indirect_X )
+    JIT_OPCODE( 0x91, jit_STA, am_Indirect_Y ) JIT_OPCODE( 0x92, jit_STA, am_Indirect_ZP )
+
+    JIT_OPCODE( 0x86, jit_STX, am_ZeroPage ) JIT_OPCODE( 0x96, jit_STX, am_ZeroPage_Y ) JIT_OPCODE( 0x8E, jit_STX, am_Absolute )
+    JIT_OPCODE( 0x84, jit_STY, am_ZeroPage ) JIT_OPCODE( 0x94, jit_STY, am_ZeroPage_X ) JIT_OPCODE( 0x8C, jit_STY, am_Absolute )
+    JIT_OPCODE( 0x64, jit_STZ, am_ZeroPage ) JIT_OPCODE( 0x74, jit_STZ, am_ZeroPage_X ) JIT_OPCODE( 0x9C, jit_STZ, am_Absolute )
+    JIT_OPCODE( 0x9E, jit_STZ, am_Absolute_X )
+
+    JIT_OPCODE( 0x09, jit_ORA, am_Immediate ) JIT_OPCODE( 0x05, jit_ORA, am_ZeroPage ) JIT_OPCODE( 0x15, jit_ORA, am_ZeroPage_X )
+    JIT_OPCODE( 0x0D, jit_ORA, am_Absolute ) JIT_OPCODE( 0x1D, jit_ORA, am_Absolute_X ) JIT_OPCODE( 0x19, jit_ORA, am_Absolute_Y )
+    JIT_OPCODE( 0x01, jit_ORA, am_Indirect_X ) JIT_OPCODE( 0x11, jit_ORA, am_Indirect_Y ) JIT_OPCODE( 0x12, jit_ORA, am_Indirect_ZP )
+
+    JIT_OPCODE( 0x29, jit_AND, am_Immediate ) JIT_OPCODE( 0x25, jit_AND, am_ZeroPage ) JIT_OPCODE( 0x35, jit_AND, am_ZeroPage_X )
+    JIT_OPCODE( 0x2D, jit_AND, am_Absolute ) JIT_OPCODE( 0x3D, jit_AND, am_Absolute_X ) JIT_OPCODE( 0x39, jit_AND, am_Absolute_Y )
+    JIT_OPCODE( 0x21, jit_AND, am_Indirect_X ) JIT_OPCODE( 0x31, jit_AND, am_Indirect_Y ) JIT_OPCODE( 0x32, jit_AND, am_Indirect_ZP )
+
+    JIT_OPCODE( 0x49, jit_EOR, am_Immediate ) JIT_OPCODE( 0x45, jit_EOR, am_ZeroPage ) JIT_OPCODE( 0x55, jit_EOR, am_ZeroPage_X )
+    JIT_OPCODE( 0x4D, jit_EOR, am_Absolute ) JIT_OPCODE( 0x5D, jit_EOR, am_Absolute_X ) JIT_OPCODE( 0x59, jit_EOR, am_Absolute_Y )
+    JIT_OPCODE( 0x41, jit_EOR, am_Indirect_X ) JIT_OPCODE( 0x51, jit_EOR, am_Indirect_Y ) JIT_OPCODE( 0x52, jit_EOR, am_Indirect_ZP )
+
+    JIT_OPCODE( 0x69, jit_ADC, am_Immediate ) JIT_OPCODE( 0x65, jit_ADC, am_ZeroPage ) JIT_OPCODE( 0x75, jit_ADC, am_ZeroPage_X )
+    JIT_OPCODE( 0x6D, jit_ADC, am_Absolute ) JIT_OPCODE( 0x7D, jit_ADC, am_Absolute_X ) JIT_OPCODE( 0x79, jit_ADC, am_Absolute_Y )
+    JIT_OPCODE( 0x61, jit_ADC, am_Indirect_X ) JIT_OPCODE( 0x71, jit_ADC, am_Indirect_Y ) JIT_OPCODE( 0x72, jit_ADC, am_Indirect_ZP )
+
+    JIT_OPCODE( 0xE9, jit_SBC, am_Immediate ) JIT_OPCODE( 0xE5, jit_SBC, am_ZeroPage ) JIT_OPCODE( 0xF5, jit_SBC, am_ZeroPage_X )
+    JIT_OPCODE( 0xED, jit_SBC, am_Absolute ) JIT_OPCODE( 0xFD, jit_SBC, am_Absolute_X ) JIT_OPCODE( 0xF9, jit_SBC, am_Absolute_Y )
+    JIT_OPCODE( 0xE1, jit_SBC, am_Indirect_X ) JIT_OPCODE( 0xF1, jit_SBC, am_Indirect_Y ) JIT_OPCODE( 0xF2, jit_SBC, am_Indirect_ZP )
+
+    JIT_OPCODE( 0xC9, jit_CMP, am_Immediate ) JIT_OPCODE( 0xC5, jit_CMP, am_ZeroPage ) JIT_OPCODE( 0xD5, jit_CMP, am_ZeroPage_X )
+    JIT_OPCODE( 0xCD, jit_CMP, am_Absolute ) JIT_OPCODE( 0xDD, jit_CMP, am_Absolute_X ) JIT_OPCODE( 0xD9, jit_CMP, am_Absolute_Y )
+    JIT_OPCODE( 0xC1, jit_CMP, am_Indirect_X ) JIT_OPCODE( 0xD1, jit_CMP, am_Indirect_Y ) JIT_OPCODE( 0xD2, jit_CMP, am_Indirect_ZP )
+
+    JIT_OPCODE( 0xE0, jit_CPX, am_Immediate ) JIT_OPCODE( 0xE4, jit_CPX, am_ZeroPage ) JIT_OPCODE( 0xEC, jit_CPX, am_Absolute )
+    JIT_OPCODE( 0xC0, jit_CPY, am_Immediate ) JIT_OPCODE( 0xC4, jit_CPY, am_ZeroPage ) JIT_OPCODE( 0xCC, jit_CPY, am_Absolute )
+
+    JIT_OPCODE( 0x89, jit_BIT, am_Immediate ) JIT_OPCODE( 0x24, jit_BIT, am_ZeroPage ) JIT_OPCODE( 0x34, jit_BIT, am_ZeroPage_X )
+    JIT_OPCODE( 0x2C, jit_BIT, am_Absolute ) JIT_OPCODE( 0x3C, jit_BIT, am_Absolute_X )
+
+    // Read-modify-write instructions are only translated with fixed addresses
+    JIT_OPCODE( 0xE6, jit_INC, am_ZeroPage ) JIT_OPCODE( 0xEE, jit_INC, am_Absolute ) JIT_OPCODE( 0x1A, jit_INC, cModeAccum )
+    JIT_OPCODE( 0xC6, jit_DEC, am_ZeroPage ) JIT_OPCODE( 0xCE, jit_DEC, am_Absolute ) JIT_OPCODE( 0x3A, jit_DEC, cModeAccum )
+    JIT_OPCODE( 0x06, jit_ASL, am_ZeroPage ) JIT_OPCODE( 0x0E, jit_ASL, am_Absolute ) JIT_OPCODE( 0x0A, jit_ASL, cModeAccum )
+    JIT_OPCODE( 0x46, jit_LSR, am_ZeroPage ) JIT_OPCODE( 0x4E, jit_LSR, am_Absolute ) JIT_OPCODE( 0x4A, jit_LSR, cModeAccum )
+    JIT_OPCODE( 0x26, jit_ROL, am_ZeroPage ) JIT_OPCODE( 0x2E, jit_ROL, am_Absolute ) JIT_OPCODE( 0x2A, jit_ROL, cModeAccum )
+    JIT_OPCODE( 0x66, jit_ROR, am_ZeroPage ) JIT_OPCODE( 0x6E, jit_ROR, am_Absolute ) JIT_OPCODE( 0x6A, jit_ROR, cModeAccum )
+
+    JIT_OPCODE( 0xE8, jit_INX, cModeImplied ) JIT_OPCODE( 0xC8, jit_INY, cModeImplied )
+    JIT_OPCODE( 0xCA, jit_DEX, cModeImplied ) JIT_OPCODE( 0x88, jit_DEY, cModeImplied )
+    JIT_OPCODE( 0xAA, jit_TAX, cModeImplied ) JIT_OPCODE( 0xA8, jit_TAY, cModeImplied ) JIT_OPCODE( 0x8A, jit_TXA, cModeImplied )
+    JIT_OPCODE( 0x98, jit_TYA, cModeImplied ) JIT_OPCODE( 0xBA, jit_TSX, cModeImplied ) JIT_OPCODE( 0x9A, jit_TXS, cModeImplied )
+    JIT_OPCODE( 0x48, jit_PHA, cModeImplied ) JIT_OPCODE( 0xDA, jit_PHX, cModeImplied ) JIT_OPCODE( 0x5A, jit_PHY, cModeImplied )
+    JIT_OPCODE( 0x08, jit_PHP, cModeImplied ) JIT_OPCODE( 0x68, jit_PLA, cModeImplied ) JIT_OPCODE( 0xFA, jit_PLX, cModeImplied )
+    JIT_OPCODE( 0x7A, jit_PLY, cModeImplied ) JIT_OPCODE( 0x28, jit_PLP, cModeImplied )
+    JIT_OPCODE( 0x18, jit_CLC, cModeImplied ) JIT_OPCODE( 0x38, jit_SEC, cModeImplied ) JIT_OPCODE( 0x58, jit_CLI, cModeImplied )
+    JIT_OPCODE( 0x78, jit_SEI, cModeImplied ) JIT_OPCODE( 0xD8, jit_CLD, cModeImplied ) JIT_OPCODE( 0xF8, jit_SED, cModeImplied )
+    JIT_OPCODE( 0xB8, jit_CLV, cModeImplied ) JIT_OPCODE( 0xEA, jit_NOP, cModeImplied )
+
+    JIT_OPCODE( 0x10, jit_BPL, am_Relative ) JIT_OPCODE( 0x30, jit_BMI, am_Relative ) JIT_OPCODE( 0x50, jit_BVC, am_Relative )
+    JIT_OPCODE( 0x70, jit_BVS, am_Relative ) JIT_OPCODE( 0x90, jit_BCC, am_Relative ) JIT_OPCODE( 0xB0, jit_BCS, am_Relative )
+    JIT_OPCODE( 0xD0, jit_BNE, am_Relative ) JIT_OPCODE( 0xF0, jit_BEQ, am_Relative ) JIT_OPCODE( 0x80, jit_BRA, am_Relative )
+    JIT_OPCODE( 0x4C, jit_JMP, am_Absolute ) JIT_OPCODE( 0x20, jit_JSR, am_Absolute ) JIT_OPCODE( 0x60, jit_RTS, cModeImplied )
+    }
+
+#undef JIT_OPCODE
+
+    return false;
+}
+
+static bool isFixedAddressMode( int mode )
+{
+    return mode == am_ZeroPage || mode == am_Absolute;
+}
+
+// Extra cycles for taking a branch - see tMCUCore::pcBranchOffset()
+static uint8_t branchTakenCycles( uint16_t nextPC, uint16_t target )
+{
+    return ((nextPC ^ target) & 0xFF00) != 0 ? 2 : 1;
+}
+
+tMCUJit::tMCUJit( tMCUState& rState )
+    : m_rState( rState )
+    , m_pCodeBuffer( 0 )
+    , m_codeBufferUsed( 0 )
+    , m_epilogueLabel( -1 )
+    , m_entryLabel( -1 )
+    , m_chainLabel( -1 )
+    , m_doneInstructions( 0 )
+    , m_doneCycles( 0 )
+    , m_doneMaxExtraCycles( 0 )
+{
+    memset( m_chainEntries, 0, sizeof(m_chainEntries) );
+
+#ifdef MCU_JIT_X64
+#if defined(_WIN32)
+    m_pCodeBuffer = static_cast<uint8_t*>(VirtualAlloc( 0, cCodeBufferSize, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE ));
+#else
+    void *pBuffer = mmap( 0, cCodeBufferSize, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( pBuffer != MAP_FAILED )
+        m_pCodeBuffer = static_cast<uint8_t*>(pBuffer);
+#endif
+#endif
+}
+
+tMCUJit::~tMCUJit()
+{
+#ifdef MCU_JIT_X64
+    if( m_pCodeBuffer )
+    {
+#if defined(_WIN32)
+        VirtualFree( m_pCodeBuffer, 0, MEM_RELEASE );
+#else
+        munmap( m_pCodeBuffer, cCodeBufferSize );
+#endif
+    }
+#endif
+}
+
+bool tMCUJit::isSupported()
+{
+#ifdef MCU_JIT_X64
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Cycles since translated code was entered that a device access happens at - those of the blocks already run, the
+// extra cycles of this one so far, and the base cycles of the instructions before this one
+static uint64_t accessCycles( const tJitContext& rContext )
+{
+    return uint64_t(rContext.m_cycleLimit - rContext.m_cyclesLeft) + rContext.m_accessCycles;
+}
+
+uint32_t tMCUJit::hostReadByte( tJitContext *pContext, uint32_t address )
+{
+    uint64_t cycles = accessCycles( *pContext );
+
+    *pContext->m_pRunCycles += cycles;
+    uint32_t data = pContext->m_pState->memReadByte( static_cast<uint16_t>(address) );
+    *pContext->m_pRunCycles -= cycles;
+
+    return data;
+}
+
+uint32_t tMCUJit::hostWriteByte( tJitContext *pContext, uint32_t address, uint32_t data )
+{
+    tMCUState *pState = pContext->m_pState;
+    uint64_t cycles = accessCycles( *pContext );
+
+    *pContext->m_pRunCycles += cycles;
+    pState->memWriteByte( static_cast<uint16_t>(address), static_cast<uint8_t>(data) );
+    *pContext->m_pRunCycles -= cycles;
+
+    // Translated code has to return to the run loop if the write has sent serial data or invalidated code
+    return pState->m_runExitRequest || pState->m_codeModified;
+}
+
+void tMCUJit::hostPushByte( tJitContext *pContext, uint32_t data )
+{
+    tMCURegisters& rRegisters = *pContext->m_pRegisters;
+
+    pContext->m_pState->memWriteDirect( tMCUState::tCore::cStackOffset + rRegisters.regSP, static_cast<uint8_t>(data) );
+    --rRegisters.regSP;
+}
+
+void tMCUJit::translate( tDecodedBlock& rBlock )
+{
+    if( !m_pCodeBuffer )
+        return;
+
+    m_code.clear();
+    m_labels.clear();
+    m_labelFixups.clear();
+    m_exitStubs.clear();
+    m_doneInstructions = 0;
+    m_doneCycles = 0;
+    m_doneMaxExtraCycles = 2; // A taken branch
+    m_epilogueLabel = newLabel();
+    m_entryLabel = newLabel();
+    m_chainLabel = newLabel();
+
+    // Prologue - save the callee saved registers, and load the guest registers into them
+    const int savedRegisters[] = { host_BX, host_BP, host_R12, host_R13, host_R14, host_R15 };
+    for( unsigned regIndex = 0; regIndex < sizeof(savedRegisters) / sizeof(savedRegisters[0]); ++regIndex )
+    {
+        emitRex( false, 0, -1, savedRegisters[regIndex] );
+        emitByte( 0x50 + (savedRegisters[regIndex] & 7) );
+    }
+
+    emitByte( 0x48 ); emitByte( 0x83 ); emitByte( 0xEC ); emitByte( cStackReserve ); // sub rsp, cStackReserve
+    emitMovRegReg( cHostContext, cHostArg0, true );
+    emitLoadPointer( cHostMemory, cHostContext, offsetof(tJitContext, m_pMemory) );
+    emitLoadPointer( host_AX, cHostContext, offsetof(tJitContext, m_pRegisters) );
+    emitLoadByte( cHostA, host_AX, -1, offsetof(tMCURegisters, regA) );
+    emitLoadByte( cHostX, host_AX, -1, offsetof(tMCURegisters, regX) );
+    emitLoadByte( cHostY, host_AX, -1, offsetof(tMCURegisters, regY) );
+    emitLoadByte( cHostP, host_AX, -1, offsetof(tMCURegisters, regP) );
+
+    // Entry from the prologue, and from other blocks - leave without doing anything if the budget can't cover all
+    // of the block.  The amounts are filled in once the body has been translated.
+    bindLabel( m_entryLabel );
+    int bailLabel = exitLabel( rBlock.m_startPC, 0, 0 );
+    unsigned instructionsCheck = emitCmpDwordImmLater( cHostContext, offsetof(tJitContext, m_instructionsLeft) );
+    emitJcc( cc_L, bailLabel );
+    unsigned cyclesCheck = emitCmpDwordImmLater( cHostContext, offsetof(tJitContext, m_cyclesLeft) );
+    emitJcc( cc_L, bailLabel );
+
+    bool endsBlock = false;
+
+    for( unsigned index = 0; index < rBlock.m_instructions.size() && !endsBlock; ++index )
+    {
+        if( !emitInstruction( rBlock, index, endsBlock ) )
+            break;
+
+        ++m_doneInstructions;
+        m_doneCycles += rBlock.m_instructions[index].m_cycles;
+    }
+
+    if( m_doneInstructions == 0 )
+        return;
+
+    uint32_t maxCycles = m_doneCycles + m_doneMaxExtraCycles;
+    memcpy( &m_code[instructionsCheck], &m_doneInstructions, sizeof(m_doneInstructions) );
+    memcpy( &m_code[cyclesCheck], &maxCycles, sizeof(maxCycles) );
+
+    // Ran off the end of what could be translated - carry on from the next instruction, which only has translated
+    // code of its own if the block stopped short of a flow control instruction
+    if( !endsBlock )
+        emitJmp( exitLabel( rBlock.m_instructions[m_doneInstructions - 1].m_nextPC, m_doneInstructions, m_doneCycles,
+            m_doneInstructions == rBlock.m_instructions.size() ) );
+
+    for( unsigned stubIndex = 0; stubIndex < m_exitStubs.size(); ++stubIndex )
+    {
+        const tExitStub& rStub = m_exitStubs[stubIndex];
+
+        bindLabel( rStub.m_label );
+        if( rStub.m_instructions > 0 )
+            emitAluMemImm( aluImm_Sub, cHostContext, offsetof(tJitContext, m_instructionsLeft), rStub.m_instructions );
+        if( rStub.m_cycles > 0 )
+            emitAluMemImm( aluImm_Sub, cHostContext, offsetof(tJitContext, m_cyclesLeft), rStub.m_cycles );
+
+        // Going back round a loop doesn't need the lookup
+        if( rStub.m_chain && rStub.m_pc == rBlock.m_startPC )
+        {
+            emitJmp( m_entryLabel );
+            continue;
+        }
+
+        emitMovRegImm( host_AX, rStub.m_pc );
+        emitJmp( rStub.m_chain ? m_chainLabel : m_epilogueLabel );
+    }
+
+    // Runs on into the translated code for the PC in AX, unless there isn't any or the run loop has been asked to
+    // return
+    bindLabel( m_chainLabel );
+    emitLoadPointer( host_R10, cHostContext, offsetof(tJitContext, m_pRunExitRequest) );
+    emitCmpByteImm( host_R10, -1, 0, 0 );
+    emitJcc( cc_NE, m_epilogueLabel );
+    emitMovRegImm64( host_R10, reinterpret_cast<uint64_t>(&m_chainEntries[0]) );
+    emitLoadPointerIndexed( host_CX, host_R10, host_AX );
+    emitAluRegReg( alu_Test, host_CX, host_CX, true );
+    emitJcc( cc_E, m_epilogueLabel );
+    emitJmpReg( host_CX );
+
+    // Epilogue - expects PC in AX
+    bindLabel( m_epilogueLabel );
+    emitLoadPointer( host_CX, cHostContext, offsetof(tJitContext, m_pRegisters) );
+    emitStoreWord( host_AX, host_CX, offsetof(tMCURegisters, regPC) );
+    emitStoreByte( cHostA, host_CX, -1, offsetof(tMCURegisters, regA) );
+    emitStoreByte( cHostX, host_CX, -1, offsetof(tMCURegisters, regX) );
+    emitStoreByte( cHostY, host_CX, -1, offsetof(tMCURegisters, regY) );
+    emitStoreByte( cHostP, host_CX, -1, offsetof(tMCURegisters, regP) );
+
+    emitByte( 0x48 ); emitByte( 0x83 ); emitByte( 0xC4 ); emitByte( cStackReserve ); // add rsp, cStackReserve
+    for( unsigned regIndex = sizeof(savedRegisters) / sizeof(savedRegisters[0]); regIndex-- > 0; )
+    {
+        emitRex( false, 0, -1, savedRegisters[regIndex] );
+        emitByte( 0x58 + (savedRegisters[regIndex] & 7) );
+    }
+    emitByte( 0xC3 ); // ret
+
+    for( unsigned fixupIndex = 0; fixupIndex < m_labelFixups.size(); ++fixupIndex )
+    {
+        unsigned offset = m_labelFixups[fixupIndex].first;
+        int32_t relative = m_labels[m_labelFixups[fixupIndex].second] - static_cast<int32_t>(offset + 4);
+        memcpy( &m_code[offset], &relative, sizeof(relative) );
+    }
+
+    unsigned start = (m_codeBufferUsed + 15) & ~15u;
+
+    if( start + m_code.size() > cCodeBufferSize )
+    {
+        // Out of room - throw away everything translated so far, and let this block get hot again
+        m_rState.m_pBlockCache->invalidateAll();
+        m_codeBufferUsed = 0;
+        return;
+    }
+
+    memcpy( m_pCodeBuffer + start, &m_code[0], m_code.size() );
+    m_codeBufferUsed = start + static_cast<unsigned>(m_code.size());
+
+    rBlock.m_pNative = reinterpret_cast<tNativeBlock>(m_pCodeBuffer + start);
+    m_chainEntries[rBlock.m_startPC] = m_pCodeBuffer + start + m_labels[m_entryLabel];
+}
+
+// =====
+// Guest instructions
+
+// Updates N and Z from a register holding a byte.  Trashes R11.
+void tMCUJit::emitSetNZ( int reg )
+{
+    emitAluRegImm( aluImm_And, cHostP, static_cast<uint8_t>(~(flag_N | flag_Z)) );
+    emitMovRegReg( host_R11, reg );
+    emitAluRegImm( aluImm_And, host_R11, flag_N );
+    emitAluRegReg( alu_Or, cHostP, host_R11 );
+    emitAluRegReg( alu_Test, reg, reg );
+    emitSetCC( cc_E, host_R11 );
+    emitMovzxRegReg8( host_R11, host_R11 );
+    emitShiftImm( shift_Left, host_R11, 1 );
+    emitAluRegReg( alu_Or, cHostP, host_R11 );
+}
+
+// Sets C if the host condition holds.  Trashes R11.
+void tMCUJit::emitSetCarryFromCC( int condition )
+{
+    emitSetCC( condition, host_R11 );
+    emitMovzxRegReg8( host_R11, host_R11 );
+    emitAluRegImm( aluImm_And, cHostP, static_cast<uint8_t>(~flag_C) );
+    emitAluRegReg( alu_Or, cHostP, host_R11 );
+}
+
+// Leaves the effective address of an indexed/indirect mode in AX.  Trashes CX and DX.
+void tMCUJit::emitAddress( int mode, uint16_t operand )
+{
+    switch( mode )
+    {
+    case am_ZeroPage_X:
+    case am_ZeroPage_Y:
+        emitMovRegReg( host_AX, mode == am_ZeroPage_X ? cHostX : cHostY );
+        emitAluRegImm( aluImm_Add, host_AX, operand );
+        emitAluRegImm( aluImm_And, host_AX, UINT8_MAX );
+        break;
+
+    case am_Absolute_X:
+    case am_Absolute_Y:
+        emitMovRegReg( host_AX, mode == am_Absolute_X ? cHostX : cHostY );
+        emitAluRegImm( aluImm_Add, host_AX, operand );
+        emitAluRegImm( aluImm_And, host_AX, UINT16_MAX );
+        break;
+
+    case am_Indirect_X:
+        // The pointer itself is in zero page (or just past it), which never holds a device
+        emitMovRegReg( host_CX, cHostX );
+        emitAluRegImm( aluImm_Add, host_CX, operand );
+        emitAluRegImm( aluImm_And, host_CX, UINT8_MAX );
+        emitLoadByte( host_AX, cHostMemory, host_CX, 0 );
+        emitLoadByte( host_DX, cHostMemory, host_CX, 1 );
+        emitShiftImm( shift_Left, host_DX, 8 );
+        emitAluRegReg( alu_Or, host_AX, host_DX );
+        break;
+
+    case am_Indirect_Y:
+    case am_Indirect_ZP:
+        emitLoadByte( host_AX, cHostMemory, -1, operand );
+        emitLoadByte( host_DX, cHostMemory, -1, operand + 1 );
+        emitShiftImm( shift_Left, host_DX, 8 );
+        emitAluRegReg( alu_Or, host_AX, host_DX );
+        if( mode == am_Indirect_Y )
+        {
+            emitAluRegReg( alu_Add, host_AX, cHostY );
+            emitAluRegImm( aluImm_And, host_AX, UINT16_MAX );
+        }
+        break;
+
+    default:
+        assert( false );
+    }
+}
+
+// Leaves the byte addressed by the instruction in AX.  Trashes CX, DX, R10 and R11.
+void tMCUJit::emitRead( int mode, uint16_t operand )
+{
+    if( mode == am_Immediate )
+    {
+        emitMovRegImm( host_AX, operand & UINT8_MAX );
+        return;
+    }
+
+    int doneLabel = newLabel();
+    int deviceLabel = newLabel();
+
+    if( isFixedAddressMode( mode ) )
+    {
+        if( !isDevicePage( operand ) )
+        {
+            emitLoadByte( host_AX, cHostMemory, -1, operand );
+            return;
+        }
+
+        emitMovRegImm( host_AX, operand );
+    }
+    else
+    {
+        emitAddress( mode, operand );
+
+        // Crossing a page costs a cycle - the low byte of the address has then wrapped round to below the index
+        if( mode == am_Absolute_X || mode == am_Absolute_Y || mode == am_Indirect_Y )
+        {
+            int samePageLabel = newLabel();
+            emitMovzxRegReg8( host_CX, host_AX );
+            emitAluRegReg( alu_Cmp, host_CX, mode == am_Absolute_X ? cHostX : cHostY );
+            emitJcc( cc_AE, samePageLabel );
+            emitAluMemImm( aluImm_Sub, cHostContext, offsetof(tJitContext, m_cyclesLeft), 1 );
+            bindLabel( samePageLabel );
+            ++m_doneMaxExtraCycles;
+        }
+
+        emitLoadPointer( host_R10, cHostContext, offsetof(tJitContext, m_pCodePages) );
+        emitMovRegReg( host_CX, host_AX );
+        emitShiftImm( shift_Right, host_CX, 8 );
+        emitTestByteImm( host_R10, host_CX, 0, tMCUState::cCodePageDevice );
+        emitJcc( cc_NE, deviceLabel );
+        emitLoadByte( host_AX, cHostMemory, host_AX, 0 );
+        emitJmp( doneLabel );
+    }
+
+    bindLabel( deviceLabel );
+    emitAccessCycles();
+    emitMovRegReg( cHostArg1, host_AX );
+    emitMovRegReg( cHostArg0, cHostContext, true );
+    emitCall( reinterpret_cast<const void*>(&tMCUJit::hostReadByte) );
+
+    bindLabel( doneLabel );
+}
+
+// Tells hostReadByte()/hostWriteByte() how far into this pass the instruction being translated starts.  Trashes R10.
+void tMCUJit::emitAccessCycles()
+{
+    emitMovRegImm( host_R10, m_doneCycles );
+    emitStoreDword( host_R10, cHostContext, offsetof(tJitContext, m_accessCycles) );
+}
+
+// Writes the low byte of valueReg (or zero if valueReg is -1) to the byte addressed by the instruction.  Jumps
+// to exit if the write needs the run loop's attention.  Trashes AX, CX, DX, R10 and R11.
+void tMCUJit::emitWrite( int mode, uint16_t operand, int valueReg, int exit )
+{
+    int doneLabel = newLabel();
+    int slowLabel = newLabel();
+
+    if( isFixedAddressMode( mode ) )
+        emitMovRegImm( host_AX, operand );
+    else
+        emitAddress( mode, operand );
+
+    if( valueReg < 0 )
+        emitAluRegReg( alu_Xor, host_DX, host_DX );
+    else if( valueReg != host_DX )
+        emitMovRegReg( host_DX, valueReg );
+
+    if( !isFixedAddressMode( mode ) || !isDevicePage( operand ) )
+    {
+        // Pages holding translated/predecoded code need their blocks thrown away, and device pages need the device
+        emitLoadPointer( host_R10, cHostContext, offsetof(tJitContext, m_pCodePages) );
+        emitMovRegReg( host_CX, host_AX );
+        emitShiftImm( shift_Right, host_CX, 8 );
+        emitCmpByteImm( host_R10, host_CX, 0, 0 );
+        emitJcc( cc_NE, slowLabel );
+        emitStoreByte( host_DX, cHostMemory, host_AX, 0 );
+        emitJmp( doneLabel );
+    }
+
+    bindLabel( slowLabel );
+    emitAccessCycles();
+    if( cHostArg2 != host_DX )
+        emitMovRegReg( cHostArg2, host_DX );
+    emitMovRegReg( cHostArg1, host_AX );
+    emitMovRegReg( cHostArg0, cHostContext, true );
+    emitCall( reinterpret_cast<const void*>(&tMCUJit::hostWriteByte) );
+    emitAluRegReg( alu_Test, host_AX, host_AX );
+    emitJcc( cc_NE, exit );
+
+    bindLabel( doneLabel );
+}
+
+// Shifts/rotates the byte in reg, updating C, N and Z.  Trashes R10 and R11.
+void tMCUJit::emitShift( eShiftOperation operation, int reg )
+{
+    if( operation == shiftOp_ROL || operation == shiftOp_ROR )
+    {
+        // Old carry, moved to where it's shifted in
+        emitMovRegReg( host_R10, cHostP );
+        emitAluRegImm( aluImm_And, host_R10, flag_C );
+        if( operation == shiftOp_ROR )
+            emitShiftImm( shift_Left, host_R10, 7 );
+    }
+
+    // New carry
+    emitMovRegReg( host_R11, reg );
+    if( operation == shiftOp_ASL || operation == shiftOp_ROL )
+        emitShiftImm( shift_Right, host_R11, 7 );
+    else
+        emitAluRegImm( aluImm_And, host_R11, 1 );
+    emitAluRegImm( aluImm_And, cHostP, static_cast<uint8_t>(~flag_C) );
+    emitAluRegReg( alu_Or, cHostP, host_R11 );
+
+    if( operation == shiftOp_ASL || operation == shiftOp_ROL )
+    {
+        emitShiftImm( shift_Left, reg, 1 );
+        if( operation == shiftOp_ROL )
+            emitAluRegReg( alu_Or, reg, host_R10 );
+        emitAluRegImm( aluImm_And, reg, UINT8_MAX );
+    }
+    else
+    {
+        emitShiftImm( shift_Right, reg, 1 );
+        if( operation == shiftOp_ROR )
+            emitAluRegReg( alu_Or, reg, host_R10 );
+    }
+
+    emitSetNZ( reg );
+}
+
+// Loads SP into CX, with the pointer to the guest registers in AX.  Exits before the instruction if SP would
+// wrap round, which is left to the interpreter.
+void tMCUJit::emitLoadSP( int compare, int condition, int exit )
+{
+    emitLoadPointer( host_AX, cHostContext, offsetof(tJitContext, m_pRegisters) );
+    emitLoadByte( host_CX, host_AX, -1, offsetof(tMCURegisters, regSP) );
+    emitAluRegImm( aluImm_Cmp, host_CX, compare );
+    emitJcc( condition, exit );
+}
+
+//   Exits before the instruction if it's about to push on to a page holding code.  Otherwise goes to slow if the
+// pushes have to go through hostPushByte() - while they're being recorded for tMCURewind, say.  Trashes DX.
+void tMCUJit::emitCheckStackPage( int exit, int slow )
+{
+    emitLoadPointer( host_DX, cHostContext, offsetof(tJitContext, m_pCodePages) );
+    emitTestByteImm( host_DX, -1, tMCUState::tCore::cStackOffset >> 8, tMCUState::cCodePageCode );
+    emitJcc( cc_NE, exit );
+    emitCmpByteImm( host_DX, -1, tMCUState::tCore::cStackOffset >> 8, 0 );
+    emitJcc( cc_NE, slow );
+}
+
+// Translates one instruction.  Returns false if it has to be left to the interpreter.
+bool tMCUJit::emitInstruction( const tDecodedBlock& rBlock, unsigned index, bool& rEndsBlock )
+{
+    const tDecodedInstruction& rInstruction = rBlock.m_instructions[index];
+
+    eJitOperation operation;
+    int mode;
+
+    if( rInstruction.m_pHandler == &tMCUState::executeInterpreted || !jitOpCode( rInstruction.m_opCode, operation, mode ) )
+        return false;
+
+    if( (operation == jit_INC || operation == jit_DEC || operation == jit_ASL || operation == jit_LSR
+        || operation == jit_ROL || operation == jit_ROR) && mode != cModeAccum && !isFixedAddressMode( mode ) )
+        return false;
+
+    const uint16_t pc = index > 0 ? rBlock.m_instructions[index - 1].m_nextPC : rBlock.m_startPC;
+    const uint16_t nextPC = rInstruction.m_nextPC;
+    const uint16_t operand = rInstruction.m_operand;
+    const uint32_t instructions = m_doneInstructions + 1;
+    const uint32_t cycles = m_doneCycles + rInstruction.m_cycles;
+
+    switch( operation )
+    {
+    case jit_LDA: case jit_LDX: case jit_LDY:
+        {
+            int reg = operation == jit_LDA ? cHostA : (operation == jit_LDX ? cHostX : cHostY);
+            emitRead( mode, operand );
+            emitMovRegReg( reg, host_AX );
+            emitSetNZ( reg );
+        }
+        break;
+
+    case jit_STA: case jit_STX: case jit_STY: case jit_STZ:
+        {
+            int reg = operation == jit_STA ? cHostA : (operation == jit_STX ? cHostX : (operation == jit_STY ? cHostY : -1));
+            emitWrite( mode, operand, reg, exitLabel( nextPC, instructions, cycles ) );
+        }
+        break;
+
+    case jit_ORA: case jit_AND: case jit_EOR:
+        emitRead( mode, operand );
+        emitAluRegReg( operation == jit_ORA ? alu_Or : (operation == jit_AND ? alu_And : alu_Xor), cHostA, host_AX );
+        emitSetNZ( cHostA );
+        break;
+
+    case jit_ADC: case jit_SBC:
+        // Decimal mode is left to the interpreter
+        emitTestRegImm( cHostP, flag_D );
+        emitJcc( cc_NE, exitLabel( pc, m_doneInstructions, m_doneCycles ) );
+
+        emitRead( mode, operand );
+        emitMovRegReg( host_CX, cHostP );
+        emitAluRegImm( aluImm_And, host_CX, flag_C );
+        emitMovRegReg( host_DX, cHostA );
+
+        if( operation == jit_ADC )
+        {
+            // DX = A + M + C, V = ~(A ^ M) & (A ^ result) & 0x80
+            emitAluRegReg( alu_Add, host_DX, host_AX );
+            emitAluRegReg( alu_Add, host_DX, host_CX );
+            emitMovRegReg( host_R10, cHostA );
+            emitAluRegReg( alu_Xor, host_R10, host_AX );
+            emitAluRegImm( aluImm_Xor, host_R10, UINT8_MAX );
+            emitMovRegReg( host_R11, host_DX );
+            emitShiftImm( shift_Right, host_R11, 8 ); // C = result > 255
+        }
+        else
+        {
+            // DX = A - M - !C, V = (A ^ M) & (A ^ result) & 0x80
+            emitAluRegImm( aluImm_Xor, host_CX, flag_C );
+            emitAluRegReg( alu_Sub, host_DX, host_AX );
+            emitAluRegReg( alu_Sub, host_DX, host_CX );
+            emitMovRegReg( host_R10, cHostA );
+            emitAluRegReg( alu_Xor, host_R10, host_AX );
+            emitMovRegReg( host_R11, host_DX );
+            emitShiftImm( shift_Right, host_R11, 31 );
+            emitAluRegImm( aluImm_Xor, host_R11, 1 ); // C = no borrow
+        }
+
+        emitMovRegReg( host_CX, cHostA );
+        emitAluRegReg( alu_Xor, host_CX, host_DX );
+        emitAluRegReg( alu_And, host_R10, host_CX );
+        emitAluRegImm( aluImm_And, host_R10, 0x80 );
+        emitShiftImm( shift_Right, host_R10, 1 );
+
+        emitAluRegImm( aluImm_And, cHostP, static_cast<uint8_t>(~(flag_C | flag_V)) );
+        emitAluRegReg( alu_Or, cHostP, host_R10 );
+        emitAluRegReg( alu_Or, cHostP, host_R11 );
+        emitMovRegReg( cHostA, host_DX );
+        emitAluRegImm( aluImm_And, cHostA, UINT8_MAX );
+        emitSetNZ( cHostA );
+        break;
+
+    case jit_CMP: case jit_CPX: case jit_CPY:
+        {
+            int reg = operation == jit_CMP ? cHostA : (operation == jit_CPX ? cHostX : cHostY);
+            emitRead( mode, operand );
+            emitAluRegReg( alu_Cmp, reg, host_AX );
+            emitSetCarryFromCC( cc_AE );
+            emitMovRegReg( host_CX, reg );
+            emitAluRegReg( alu_Sub, host_CX, host_AX );
+            emitAluRegImm( aluImm_And, host_CX, UINT8_MAX );
+            emitSetNZ( host_CX );
+        }
+        break;
+
+    case jit_BIT:
+        emitRead( mode, operand );
+        emitAluRegImm( aluImm_And, cHostP, static_cast<uint8_t>(~(flag_N | flag_V | flag_Z)) );
+        emitMovRegReg( host_R11, host_AX );
+        emitAluRegImm( aluImm_And, host_R11, flag_N | flag_V );
+        emitAluRegReg( alu_Or, cHostP, host_R11 );
+        emitAluRegReg( alu_Test, host_AX, cHostA );
+        emitSetCC( cc_E, host_R11 );
+        emitMovzxRegReg8( host_R11, host_R11 );
+        emitShiftImm( shift_Left, host_R11, 1 );
+        emitAluRegReg( alu_Or, cHostP, host_R11 );
+        break;
+
+    case jit_INC: case jit_DEC: case jit_ASL: case jit_LSR: case jit_ROL: case jit_ROR:
+        {
+            int reg = mode == cModeAccum ? cHostA : host_AX;
+
+            if( mode != cModeAccum )
+                emitRead( mode, operand );
+
+            if( operation == jit_INC || operation == jit_DEC )
+            {
+                emitAluRegImm( operation == jit_INC ? aluImm_Add : aluImm_Sub, reg, 1 );
+                emitAluRegImm( aluImm_And, reg, UINT8_MAX );
+                emitSetNZ( reg );
+            }
+            else
+            {
+                emitShift( operation == jit_ASL ? shiftOp_ASL : (operation == jit_LSR ? shiftOp_LSR : (operation == jit_ROL ? shiftOp_ROL : shiftOp_ROR)), reg );
+            }
+
+            // Flags are already up to date, in case the write leaves translated code
+            if( mode != cModeAccum )
+            {
+                emitMovRegReg( host_DX, host_AX );
+                emitWrite( mode, operand, host_DX, exitLabel( nextPC, instructions, cycles ) );
+            }
+        }
+        break;
+
+    case jit_INX: case jit_INY: case jit_DEX: case jit_DEY:
+        {
+            int reg = (operation == jit_INX || operation == jit_DEX) ? cHostX : cHostY;
+            emitAluRegImm( (operation == jit_INX || operation == jit_INY) ? aluImm_Add : aluImm_Sub, reg, 1 );
+            emitAluRegImm( aluImm_And, reg, UINT8_MAX );
+            emitSetNZ( reg );
+        }
+        break;
+
+    case jit_TAX: emitMovRegReg( cHostX, cHostA ); emitSetNZ( cHostX ); break;
+    case jit_TAY: emitMovRegReg( cHostY, cHostA ); emitSetNZ( cHostY ); break;
+    case jit_TXA: emitMovRegReg( cHostA, cHostX ); emitSetNZ( cHostA ); break;
+    case jit_TYA: emitMovRegReg( cHostA, cHostY ); emitSetNZ( cHostA ); break;
+
+    case jit_TSX:
+        emitLoadPointer( host_AX, cHostContext, offsetof(tJitContext, m_pRegisters) );
+        emitLoadByte( cHostX, host_AX, -1, offsetof(tMCURegisters, regSP) );
+        emitSetNZ( cHostX );
+        break;
+
+    case jit_TXS:
+        emitLoadPointer( host_AX, cHostContext, offsetof(tJitContext, m_pRegisters) );
+        emitStoreByte( cHostX, host_AX, -1, offsetof(tMCURegisters, regSP) );
+        break;
+
+    case jit_PHA: case jit_PHX: case jit_PHY: case jit_PHP:
+        {
+            int reg = operation == jit_PHA ? cHostA : (operation == jit_PHX ? cHostX : (operation == jit_PHY ? cHostY : cHostP));
+            int before = exitLabel( pc, m_doneInstructions, m_doneCycles );
+            int slowLabel = newLabel();
+            int doneLabel = newLabel();
+            if( operation == jit_PHP )
+            {
+                // B and the unused bit are always pushed as set
+                emitMovRegReg( host_R10, cHostP );
+                emitAluRegImm( aluImm_Or, host_R10, flag_B | flag_X );
+                reg = host_R10;
+            }
+            emitLoadSP( 1, cc_B, before );
+            emitCheckStackPage( before, slowLabel );
+            emitStoreByte( reg, cHostMemory, host_CX, tMCUState::tCore::cStackOffset );
+            emitAluRegImm( aluImm_Sub, host_CX, 1 );
+            emitStoreByte( host_CX, host_AX, -1, offsetof(tMCURegisters, regSP) );
+            emitJmp( doneLabel );
+
+            bindLabel( slowLabel );
+            emitMovRegReg( cHostArg1, reg );
+            emitMovRegReg( cHostArg0, cHostContext, true );
+            emitCall( reinterpret_cast<const void*>(&tMCUJit::hostPushByte) );
+            bindLabel( doneLabel );
+        }
+        break;
+
+    case jit_PLA: case jit_PLX: case jit_PLY: case jit_PLP:
+        {
+            int reg = operation == jit_PLA ? cHostA : (operation == jit_PLX ? cHostX : (operation == jit_PLY ? cHostY : cHostP));
+            emitLoadSP( UINT8_MAX, cc_AE, exitLabel( pc, m_doneInstructions, m_doneCycles ) );
+            emitAluRegImm( aluImm_Add, host_CX, 1 );
+            emitStoreByte( host_CX, host_AX, -1, offsetof(tMCURegisters, regSP) );
+            emitLoadByte( reg, cHostMemory, host_CX, tMCUState::tCore::cStackOffset );
+            if( operation != jit_PLP )
+                emitSetNZ( reg );
+            else
+                emitAluRegImm( aluImm_Or, cHostP, flag_B | flag_X );
+        }
+        break;
+
+    case jit_CLC: emitAluRegImm( aluImm_And, cHostP, static_cast<uint8_t>(~flag_C) ); break;
+    case jit_SEC: emitAluRegImm( aluImm_Or, cHostP, flag_C ); break;
+    case jit_CLI: emitAluRegImm( aluImm_And, cHostP, static_cast<uint8_t>(~flag_I) ); break;
+    case jit_SEI: emitAluRegImm( aluImm_Or, cHostP, flag_I ); break;
+    case jit_CLD: emitAluRegImm( aluImm_And, cHostP, static_cast<uint8_t>(~flag_D) ); break;
+    case jit_SED: emitAluRegImm( aluImm_Or, cHostP, flag_D ); break;
+    case jit_CLV: emitAluRegImm( aluImm_And, cHostP, static_cast<uint8_t>(~flag_V) ); break;
+    case jit_NOP: break;
+
+    case jit_BPL: case jit_BMI: case jit_BVC: case jit_BVS: case jit_BCC: case jit_BCS: case jit_BNE: case jit_BEQ:
+        {
+            static const uint8_t branchFlags[] = { flag_N, flag_N, flag_V, flag_V, flag_C, flag_C, flag_Z, flag_Z };
+            unsigned branchIndex = operation - jit_BPL;
+            uint16_t target = static_cast<uint16_t>(nextPC + static_cast<int8_t>(operand));
+
+            // Odd entries branch when the flag is set, even ones when it's clear
+            emitTestRegImm( cHostP, branchFlags[branchIndex] );
+            emitJcc( (branchIndex & 1) ? cc_NE : cc_E, exitLabel( target, instructions, cycles + branchTakenCycles( nextPC, target ), true ) );
+            emitJmp( exitLabel( nextPC, instructions, cycles, true ) );
+            rEndsBlock = true;
+        }
+        break;
+
+    case jit_BRA:
+        {
+            uint16_t target = static_cast<uint16_t>(nextPC + static_cast<int8_t>(operand));
+            emitJmp( exitLabel( target, instructions, cycles + branchTakenCycles( nextPC, target ), true ) );
+        }
+        rEndsBlock = true;
+        break;
+
+    case jit_JMP:
+        emitJmp( exitLabel( operand, instructions, cycles, true ) );
+        rEndsBlock = true;
+        break;
+
+    case jit_JSR:
+        {
+            uint16_t returnAddress = nextPC - 1;
+            int before = exitLabel( pc, m_doneInstructions, m_doneCycles );
+            int exit = exitLabel( operand, instructions, cycles, true );
+            int slowLabel = newLabel();
+            emitLoadSP( 2, cc_B, before );
+            emitCheckStackPage( before, slowLabel );
+            emitStoreByteImm( returnAddress >> 8, cHostMemory, host_CX, tMCUState::tCore::cStackOffset );
+            emitStoreByteImm( returnAddress & UINT8_MAX, cHostMemory, host_CX, tMCUState::tCore::cStackOffset - 1 );
+            emitAluRegImm( aluImm_Sub, host_CX, 2 );
+            emitStoreByte( host_CX, host_AX, -1, offsetof(tMCURegisters, regSP) );
+            emitJmp( exit );
+
+            bindLabel( slowLabel );
+            for( unsigned byteIndex = 0; byteIndex < 2; ++byteIndex )
+            {
+                emitMovRegImm( cHostArg1, byteIndex == 0 ? returnAddress >> 8 : returnAddress & UINT8_MAX );
+                emitMovRegReg( cHostArg0, cHostContext, true );
+                emitCall( reinterpret_cast<const void*>(&tMCUJit::hostPushByte) );
+            }
+            emitJmp( exit );
+            rEndsBlock = true;
+        }
+        break;
+
+    case jit_RTS:
+        emitLoadSP( UINT8_MAX - 1, cc_AE, exitLabel( pc, m_doneInstructions, m_doneCycles ) );
+        emitLoadByte( host_DX, cHostMemory, host_CX, tMCUState::tCore::cStackOffset + 1 );
+        emitLoadByte( host_R10, cHostMemory, host_CX, tMCUState::tCore::cStackOffset + 2 );
+        emitShiftImm( shift_Left, host_R10, 8 );
+        emitAluRegReg( alu_Or, host_DX, host_R10 );
+        emitAluRegImm( aluImm_Add, host_DX, 1 );
+        emitAluRegImm( aluImm_And, host_DX, UINT16_MAX );
+        emitAluRegImm( aluImm_Add, host_CX, 2 );
+        emitStoreByte( host_CX, host_AX, -1, offsetof(tMCURegisters, regSP) );
+
+        // PC isn't known until now, so this can't go through an exit stub
+        emitAluMemImm( aluImm_Sub, cHostContext, offsetof(tJitContext, m_instructionsLeft), instructions );
+        emitAluMemImm( aluImm_Sub, cHostContext, offsetof(tJitContext, m_cyclesLeft), cycles );
+        emitMovRegReg( host_AX, host_DX );
+        emitJmp( m_chainLabel );
+        rEndsBlock = true;
+        break;
+    }
+
+    return true;
+}
+
+// =====
+// x86-64 encoding
+
+void tMCUJit::emitDword( uint32_t value )
+{
+    for( unsigned byteIndex = 0; byteIndex < 4; ++byteIndex )
+        emitByte( static_cast<uint8_t>(value >> (byteIndex * 8)) );
+}
+
+void tMCUJit::emitQword( uint64_t value )
+{
+    emitDword( static_cast<uint32_t>(value) );
+    emitDword( static_cast<uint32_t>(value >> 32) );
+}
+
+// force is needed to get at SPL/BPL/SIL/DIL rather than AH/CH/DH/BH
+void tMCUJit::emitRex( bool wide, int reg, int index, int base, bool force )
+{
+    uint8_t rex = 0x40;
+    if( wide ) rex |= 0x08;
+    if( reg & 8 ) rex |= 0x04;
+    if( index >= 0 && (index & 8) ) rex |= 0x02;
+    if( base & 8 ) rex |= 0x01;
+
+    if( rex != 0x40 || force )
+        emitByte( rex );
+}
+
+void tMCUJit::emitModRMReg( int reg, int rm )
+{
+    emitByte( static_cast<uint8_t>(0xC0 | ((reg & 7) << 3) | (rm & 7)) );
+}
+
+// Always uses a 32-bit displacement - simpler, and the code isn't size sensitive
+void tMCUJit::emitModRMMem( int reg, int base, int index, int32_t displacement )
+{
+    if( index < 0 && (base & 7) != host_SP )
+    {
+        emitByte( static_cast<uint8_t>(0x80 | ((reg & 7) << 3) | (base & 7)) );
+    }
+    else
+    {
+        emitByte( static_cast<uint8_t>(0x80 | ((reg & 7) << 3) | host_SP) );
+        emitByte( static_cast<uint8_t>((((index < 0 ? host_SP : index) & 7) << 3) | (base & 7)) );
+    }
+
+    emitDword( static_cast<uint32_t>(displacement) );
+}
+
+void tMCUJit::emitMovRegReg( int dst, int src, bool wide )
+{
+    emitRex( wide, src, -1, dst );
+    emitByte( 0x89 );
+    emitModRMReg( src, dst );
+}
+
+void tMCUJit::emitMovRegImm( int dst, uint32_t value )
+{
+    emitRex( false, 0, -1, dst );
+    emitByte( static_cast<uint8_t>(0xB8 + (dst & 7)) );
+    emitDword( value );
+}
+
+void tMCUJit::emitMovRegImm64( int dst, uint64_t value )
+{
+    emitRex( true, 0, -1, dst );
+    emitByte( static_cast<uint8_t>(0xB8 + (dst & 7)) );
+    emitQword( value );
+}
+
+void tMCUJit::emitMovzxRegReg8( int dst, int src )
+{
+    emitRex( false, dst, -1, src, src >= host_SP );
+    emitByte( 0x0F ); emitByte( 0xB6 );
+    emitModRMReg( dst, src );
+}
+
+void tMCUJit::emitAluRegReg( uint8_t opCode, int dst, int src, bool wide )
+{
+    emitRex( wide, src, -1, dst );
+    emitByte( opCode );
+    emitModRMReg( src, dst );
+}
+
+void tMCUJit::emitAluRegImm( int extension, int dst, uint32_t value )
+{
+    int32_t signedValue = static_cast<int32_t>(value);
+
+    emitRex( false, 0, -1, dst );
+
+    if( signedValue >= INT8_MIN && signedValue <= INT8_MAX )
+    {
+        emitByte( 0x83 );
+        emitModRMReg( extension, dst );
+        emitByte( static_cast<uint8_t>(value) );
+    }
+    else
+    {
+        emitByte( 0x81 );
+        emitModRMReg( extension, dst );
+        emitDword( value );
+    }
+}
+
+void tMCUJit::emitTestRegImm( int dst, uint32_t value )
+{
+    emitRex( false, 0, -1, dst );
+    emitByte( 0xF7 );
+    emitModRMReg( 0, dst );
+    emitDword( value );
+}
+
+void tMCUJit::emitShiftImm( int extension, int dst, uint8_t count )
+{
+    emitRex( false, 0, -1, dst );
+
+    if( count == 1 )
+    {
+        emitByte( 0xD1 );
+        emitModRMReg( extension, dst );
+    }
+    else
+    {
+        emitByte( 0xC1 );
+        emitModRMReg( extension, dst );
+        emitByte( count );
+    }
+}
+
+// movzx dst, byte [base + index + displacement]
+void tMCUJit::emitLoadByte( int dst, int base, int index, int32_t displacement )
+{
+    emitRex( false, dst, index, base );
+    emitByte( 0x0F ); emitByte( 0xB6 );
+    emitModRMMem( dst, base, index, displacement );
+}
+
+void tMCUJit::emitStoreByte( int src, int base, int index, int32_t displacement )
+{
+    emitRex( false, src, index, base, src >= host_SP && src < host_R8 );
+    emitByte( 0x88 );
+    emitModRMMem( src, base, index, displacement );
+}
+
+void tMCUJit::emitStoreByteImm( uint8_t value, int base, int index, int32_t displacement )
+{
+    emitRex( false, 0, index, base );
+    emitByte( 0xC6 );
+    emitModRMMem( 0, base, index, displacement );
+    emitByte( value );
+}
+
+void tMCUJit::emitStoreWord( int src, int base, int32_t displacement )
+{
+    emitByte( 0x66 );
+    emitRex( false, src, -1, base );
+    emitByte( 0x89 );
+    emitModRMMem( src, base, -1, displacement );
+}
+
+void tMCUJit::emitStoreDword( int src, int base, int32_t displacement )
+{
+    emitRex( false, src, -1, base );
+    emitByte( 0x89 );
+    emitModRMMem( src, base, -1, displacement );
+}
+
+void tMCUJit::emitLoadPointer( int dst, int base, int32_t displacement )
+{
+    emitRex( true, dst, -1, base );
+    emitByte( 0x8B );
+    emitModRMMem( dst, base, -1, displacement );
+}
+
+// mov dst, qword [base + index * 8]
+void tMCUJit::emitLoadPointerIndexed( int dst, int base, int index )
+{
+    assert( (base & 7) != host_BP ); // That would need a displacement
+
+    emitRex( true, dst, index, base );
+    emitByte( 0x8B );
+    emitByte( static_cast<uint8_t>(((dst & 7) << 3) | host_SP) );
+    emitByte( static_cast<uint8_t>(0xC0 | ((index & 7) << 3) | (base & 7)) );
+}
+
+// op dword [base + displacement], imm
+void tMCUJit::emitAluMemImm( int extension, int base, int32_t displacement, int32_t value )
+{
+    emitRex( false, 0, -1, base );
+
+    if( value >= INT8_MIN && value <= INT8_MAX )
+    {
+        emitByte( 0x83 );
+        emitModRMMem( extension, base, -1, displacement );
+        emitByte( static_cast<uint8_t>(value) );
+    }
+    else
+    {
+        emitByte( 0x81 );
+        emitModRMMem( extension, base, -1, displacement );
+        emitDword( static_cast<uint32_t>(value) );
+    }
+}
+
+// cmp dword [base + displacement], imm32 - returns the offset of the imm32, for it to be filled in later
+unsigned tMCUJit::emitCmpDwordImmLater( int base, int32_t displacement )
+{
+    emitRex( false, 0, -1, base );
+    emitByte( 0x81 );
+    emitModRMMem( aluImm_Cmp, base, -1, displacement );
+
+    unsigned offset = static_cast<unsigned>(m_code.size());
+    emitDword( 0 );
+    return offset;
+}
+
+void tMCUJit::emitCmpByteImm( int base, int index, int32_t displacement, uint8_t value )
+{
+    emitRex( false, 0, index, base );
+    emitByte( 0x80 );
+    emitModRMMem( aluImm_Cmp, base, index, displacement );
+    emitByte( value );
+}
+
+void tMCUJit::emitTestByteImm( int base, int index, int32_t displacement, uint8_t value )
+{
+    emitRex( false, 0, index, base );
+    emitByte( 0xF6 );
+    emitModRMMem( 0, base, index, displacement );
+    emitByte( value );
+}
+
+void tMCUJit::emitSetCC( int condition, int dst )
+{
+    emitRex( false, 0, -1, dst, dst >= host_SP );
+    emitByte( 0x0F ); emitByte( static_cast<uint8_t>(0x90 + condition) );
+    emitModRMReg( 0, dst );
+}
+
+// Goes through RAX, as the target is almost certainly more than 2GB away from the code buffer
+void tMCUJit::emitCall( const void *pFunction )
+{
+    emitByte( 0x48 ); emitByte( 0xB8 ); // mov rax, imm64
+    emitQword( reinterpret_cast<uint64_t>(pFunction) );
+    emitByte( 0xFF ); emitByte( 0xD0 ); // call rax
+}
+
+void tMCUJit::emitJmpReg( int reg )
+{
+    emitRex( false, 0, -1, reg );
+    emitByte( 0xFF );
+    emitModRMReg( 4, reg );
+}
+
+int tMCUJit::newLabel()
+{
+    m_labels.push_back( -1 );
+    return static_cast<int>(m_labels.size() - 1);
+}
+
+void tMCUJit::bindLabel( int label )
+{
+    m_labels[label] = static_cast<int>(m_code.size());
+}
+
+void tMCUJit::emitJcc( int condition, int label )
+{
+    emitByte( 0x0F ); emitByte( static_cast<uint8_t>(0x80 + condition) );
+    m_labelFixups.push_back( std::make_pair( static_cast<unsigned>(m_code.size()), label ) );
+    emitDword( 0 );
+}
+
+void tMCUJit::emitJmp( int label )
+{
+    emitByte( 0xE9 );
+    m_labelFixups.push_back( std::make_pair( static_cast<unsigned>(m_code.size()), label ) );
+    emitDword( 0 );
+}
+
+//   Label for leaving the block with PC set to pc, having run the given number of instructions and cycles.  The
+// code for it goes after the body of the block.
+//   Only chain where the instruction at pc hasn't already been found to need the interpreter, or to need the run
+// loop's attention first - so that running on into translated code always gets something done.
+int tMCUJit::exitLabel( uint16_t pc, uint32_t instructions, uint32_t cycles, bool chain )
+{
+    tExitStub stub;
+    stub.m_label = newLabel();
+    stub.m_pc = pc;
+    stub.m_instructions = instructions;
+    stub.m_cycles = cycles;
+    stub.m_chain = chain;
+
+    m_exitStubs.push_back( stub );
+
+    return stub.m_label;
+}
@@ -0,0 +1,164 @@
+/*
+
+  mcu_jit.hpp - Translates hot predecoded blocks into native x86-64 code
+
+*/
+
+#ifndef MCU_JIT_HPP
+#define MCU_JIT_HPP
+
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+#include "mcu_core.hpp"
+
+struct tDecodedBlock;
+
+// Handed to translated code.  Translated code keeps A/X/Y/P in host registers, and only writes them back to
+// m_pRegisters when it returns.
+struct tJitContext
+{
+    tMCURegisters *m_pRegisters;
+    uint8_t *m_pMemory;
+    const uint8_t *m_pCodePages;
+    tMCUState *m_pState;
+    const void *m_pRunExitRequest; // tMCUState::m_runExitRequest, which is looked at before running on into another block
+
+    // Counted down as translated code runs - a block is only entered while there's enough left for all of it
+    int32_t m_instructionsLeft;
+    int32_t m_cyclesLeft;
+    int32_t m_instructionLimit; // m_instructionsLeft on entry
+    int32_t m_cycleLimit; // m_cyclesLeft on entry
+
+    // So that a device sees the cycle count the interpreter would have given it
+    uint64_t *m_pRunCycles; // The running core's m_cycles, as it was on entry
+    uint32_t m_accessCycles; // Base cycles of the block's instructions before the one accessing the device
+};
+
+typedef void (*tNativeBlock)( tJitContext *pContext );
+
+//   Only a block's leading run of supported instructions is translated - execution falls back to the
+// predecoded/interpreted path from the first instruction that isn't.  Memory is accessed directly, except for
+// pages with devices in them (reads and writes) and pages holding predecoded code or having their writes recorded
+// (writes), which go through tMCUState::memReadByte()/memWriteByte().  Translated code therefore gets thrown away
+// along with its block when guest code is overwritten.
+//   A block that ends in a branch, jump, JSR or RTS runs straight on into the translated code of the block it goes
+// to, if there is any.  The guest registers stay in host registers, and the run loop only gets control back when
+// the budget runs out or a block isn't translated (or needs the run loop's attention).
+//   Only ADC/SBC in binary mode are translated - if D is set, translated code exits before the instruction.
+class tMCUJit
+{
+public:
+    static const unsigned cHotThreshold     = 32; // Times a block runs before it's translated
+    static const unsigned cCodeBufferSize   = 4 * 1024 * 1024;
+
+    tMCUJit( tMCUState& rState );
+    ~tMCUJit();
+
+    // Whether this build can generate native code at all
+    static bool isSupported();
+
+    // Fills in the block's m_pNative if any of it can be translated
+    void translate( tDecodedBlock& rBlock );
+
+    // Stops other translated code running on into the block, which tMCUBlockCache is throwing away
+    void blockRetired( uint16_t startPC ) { m_chainEntries[startPC] = 0; }
+
+private:
+    tMCUJit( const tMCUJit& ); // Disallowed
+
+    // =====
+    // Code emission
+    struct tExitStub
+    {
+        int m_label;
+        uint16_t m_pc;
+        uint32_t m_instructions;
+        uint32_t m_cycles;
+        bool m_chain; // Runs on into the translated code at m_pc if there is any, rather than returning
+    };
+
+    void emitByte( uint8_t value ) { m_code.push_back( value ); }
+    void emitDword( uint32_t value );
+    void emitQword( uint64_t value );
+    void emitRex( bool wide, int reg, int index, int base, bool force = false );
+    void emitModRMReg( int reg, int rm );
+    void emitModRMMem( int reg, int base, int index, int32_t displacement );
+
+    void emitMovRegReg( int dst, int src, bool wide = false );
+    void emitMovRegImm( int dst, uint32_t value );
+    void emitMovRegImm64( int dst, uint64_t value );
+    void emitMovzxRegReg8( int dst, int src );
+    void emitAluRegReg( uint8_t opCode, int dst, int src, bool wide = false );
+    void emitAluRegImm( int extension, int dst, uint32_t value );
+    void emitTestRegImm( int dst, uint32_t value );
+    void emitShiftImm( int extension, int dst, uint8_t count );
+    void emitLoadByte( int dst, int base, int index, int32_t displacement );
+    void emitStoreByte( int src, int base, int index, int32_t displacement );
+    void emitStoreByteImm( uint8_t value, int base, int index, int32_t displacement );
+    void emitStoreWord( int src, int base, int32_t displacement );
+    void emitStoreDword( int src, int base, int32_t displacement );
+    void emitLoadPointer( int dst, int base, int32_t displacement );
+    void emitLoadPointerIndexed( int dst, int base, int index );
+    void emitCmpByteImm( int base, int index, int32_t displacement, uint8_t value );
+    void emitTestByteImm( int base, int index, int32_t displacement, uint8_t value );
+    void emitAluMemImm( int extension, int base, int32_t displacement, int32_t value );
+    unsigned emitCmpDwordImmLater( int base, int32_t displacement );
+    void emitSetCC( int condition, int dst );
+    void emitCall( const void *pFunction );
+    void emitJmpReg( int reg );
+
+    int newLabel();
+    void bindLabel( int label );
+    void emitJcc( int condition, int label );
+    void emitJmp( int label );
+    int exitLabel( uint16_t pc, uint32_t instructions, uint32_t cycles, bool chain = false );
+
+    // =====
+    // Guest helpers
+    enum eShiftOperation
+    {
+        shiftOp_ASL,
+        shiftOp_LSR,
+        shiftOp_ROL,
+        shiftOp_ROR,
+    };
+
+    void emitSetNZ( int reg );
+    void emitSetCarryFromCC( int condition );
+    void emitAddress( int mode, uint16_t operand );
+    bool isDevicePage( uint16_t address ) const
+    { return (m_rState.m_codePages[address >> 8] & tMCUState::cCodePageDevice) != 0; }
+    void emitRead( int mode, uint16_t operand );
+    void emitWrite( int mode, uint16_t operand, int valueReg, int exit );
+    void emitShift( eShiftOperation operation, int reg );
+    void emitLoadSP( int compare, int condition, int exit );
+    void emitCheckStackPage( int exit, int slow );
+    bool emitInstruction( const tDecodedBlock& rBlock, unsigned index, bool& rEndsBlock );
+
+    // Called from translated code for accesses that may hit a device or predecoded code
+    static uint32_t hostReadByte( tJitContext *pContext, uint32_t address );
+    static uint32_t hostWriteByte( tJitContext *pContext, uint32_t address, uint32_t data );
+    static void hostPushByte( tJitContext *pContext, uint32_t data ); // Decrements SP in m_pRegisters too
+    void emitAccessCycles();
+
+    tMCUState&              m_rState;
+    uint8_t                *m_pCodeBuffer;
+    unsigned                m_codeBufferUsed;
+
+    std::vector< uint8_t >  m_code; // Block being translated
+    std::vector< int >      m_labels; // Offset of each label in m_code, or -1 if not yet bound
+    std::vector< std::pair< unsigned, int > > m_labelFixups; // rel32 offsets in m_code that refer to a label
+    std::vector< tExitStub > m_exitStubs;
+    int                     m_epilogueLabel;
+    int                     m_entryLabel; // Checks the budget, then runs the first instruction
+    int                     m_chainLabel; // Runs on into the translated code for the PC in AX
+    uint32_t                m_doneInstructions; // Instructions of the block already translated
+    uint32_t                m_doneCycles;
+    uint32_t                m_doneMaxExtraCycles; // Most extra cycles the instructions translated so far can take
+
+    const uint8_t          *m_chainEntries[65536]; // Each translated block's m_entryLabel, by starting PC
+};
+
+#endif
@@ -0,0 +1,988 @@
+#include "mcu_lockstep.hpp"
+#include "mcu_execute.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+//   tLaneVector is the widest vector the host does all the kernels' byte operations in - an AVX2 register with
+// -mavx2, or an SSE2 one by default (GCC splits anything wider up a byte at a time for some operations, e.g.
+// comparisons).  Elsewhere it's a single byte, and the vector helpers below are plain byte operations.
+#if defined(__GNUC__)
+
+#if defined(__AVX2__)
+static const unsigned cLaneVectorSize = 32;
+#else
+static const unsigned cLaneVectorSize = 16;
+#endif
+
+typedef uint8_t tLaneVector __attribute__((vector_size(cLaneVectorSize)));
+
+// Other views of the same bits, for the operations that SSE2/AVX2 only have for signed bytes or for words
+typedef int8_t tLaneSignedVector __attribute__((vector_size(cLaneVectorSize)));
+typedef uint16_t tLaneWordVector __attribute__((vector_size(cLaneVectorSize)));
+
+static MCU_FORCE_INLINE tLaneVector vectorSet( uint8_t value )
+{
+    tLaneVector result = {};
+    return result + value;
+}
+
+// 0xFF in the bytes where the comparison holds, 0x00 elsewhere.  Flipping the top bits turns the unsigned comparison
+// into a signed one.
+static MCU_FORCE_INLINE tLaneVector vectorLess( const tLaneVector& value1, const tLaneVector& value2 )
+{ return (tLaneVector)((tLaneSignedVector)(value1 ^ 0x80) < (tLaneSignedVector)(value2 ^ 0x80)); }
+
+static MCU_FORCE_INLINE tLaneVector vectorEqual( const tLaneVector& value1, const tLaneVector& value2 )
+{ return (tLaneVector)(value1 == value2); }
+
+// Each byte shifted right by one - as words, with the bit that would cross into the byte below cleared first
+static MCU_FORCE_INLINE tLaneVector vectorShiftRight( const tLaneVector& value )
+{ return (tLaneVector)((tLaneWordVector)(value & 0xFE) >> 1); }
+
+// The smaller of each pair of bytes, and one bit per byte (from its top bit) - x86 has instructions for both
+#if defined(__AVX2__)
+
+static MCU_FORCE_INLINE tLaneVector vectorMin( const tLaneVector& value1, const tLaneVector& value2 )
+{ return (tLaneVector)_mm256_min_epu8( (__m256i)value1, (__m256i)value2 ); }
+
+static MCU_FORCE_INLINE uint32_t vectorBits( const tLaneVector& value )
+{ return static_cast<uint32_t>(_mm256_movemask_epi8( (__m256i)value )); }
+
+#elif defined(__SSE2__)
+
+static MCU_FORCE_INLINE tLaneVector vectorMin( const tLaneVector& value1, const tLaneVector& value2 )
+{ return (tLaneVector)_mm_min_epu8( (__m128i)value1, (__m128i)value2 ); }
+
+static MCU_FORCE_INLINE uint32_t vectorBits( const tLaneVector& value )
+{ return static_cast<uint32_t>(_mm_movemask_epi8( (__m128i)value )); }
+
+#else
+
+static MCU_FORCE_INLINE tLaneVector vectorMin( const tLaneVector& value1, const tLaneVector& value2 )
+{
+    tLaneVector less = vectorLess( value1, value2 );
+    return (value1 & less) | (value2 & ~less);
+}
+
+static MCU_FORCE_INLINE uint32_t vectorBits( const tLaneVector& value )
+{
+    uint32_t bits = 0;
+    for( unsigned lane = 0; lane < cLaneVectorSize; ++lane )
+        bits |= static_cast<uint32_t>(value[lane] >> 7) << lane;
+    return bits;
+}
+
+#endif
+
+typedef uint32_t tLaneDwordVector __attribute__((vector_size(cLaneVectorSize)));
+typedef uint64_t tLaneQwordVector __attribute__((vector_size(cLaneVectorSize)));
+
+//   The smallest byte in value.  The top half of each word, then dword, then quadword is shifted down over the
+// bottom half, so that the low byte of each ends up with the smallest of the bytes in it.
+static MCU_FORCE_INLINE uint8_t vectorLowest( tLaneVector value )
+{
+    value = vectorMin( value, (tLaneVector)((tLaneWordVector)value >> 8) );
+    value = vectorMin( value, (tLaneVector)((tLaneDwordVector)value >> 16) );
+    tLaneQwordVector quads = (tLaneQwordVector)vectorMin( value, (tLaneVector)((tLaneQwordVector)value >> 32) );
+
+    uint8_t lowest = UINT8_MAX;
+    for( unsigned quad = 0; quad < cLaneVectorSize / sizeof(uint64_t); ++quad )
+        lowest = std::min( lowest, static_cast<uint8_t>(quads[quad]) );
+    return lowest;
+}
+
+#else
+
+static const unsigned cLaneVectorSize = 1;
+typedef uint8_t tLaneVector;
+
+static inline tLaneVector vectorSet( uint8_t value ) { return value; }
+static inline tLaneVector vectorLess( tLaneVector value1, tLaneVector value2 ) { return value1 < value2 ? 0xFF : 0; }
+static inline tLaneVector vectorEqual( tLaneVector value1, tLaneVector value2 ) { return value1 == value2 ? 0xFF : 0; }
+static inline tLaneVector vectorShiftRight( tLaneVector value ) { return static_cast<uint8_t>(value >> 1); }
+static inline tLaneVector vectorMin( tLaneVector value1, tLaneVector value2 ) { return std::min( value1, value2 ); }
+static inline uint8_t vectorLowest( tLaneVector value ) { return value; }
+static inline uint32_t vectorBits( tLaneVector value ) { return value >> 7; }
+
+#endif
+
+static const unsigned cLaneVectors = tMCULockstep::cMaxLanes / cLaneVectorSize;
+
+// One byte per lane, for all of the lanes
+struct tLaneBytes
+{
+    tLaneVector m_vector[cLaneVectors];
+};
+
+#define LANE_OPERATION( operation ) \
+    { tLaneBytes result; for( unsigned vector = 0; vector < cLaneVectors; ++vector ) result.m_vector[vector] = static_cast<tLaneVector>(operation); return result; }
+#define LANE_OPERATOR( op ) \
+    static MCU_FORCE_INLINE tLaneBytes operator op( const tLaneBytes& value1, const tLaneBytes& value2 ) \
+    LANE_OPERATION( value1.m_vector[vector] op value2.m_vector[vector] )
+
+LANE_OPERATOR( + )
+LANE_OPERATOR( - )
+LANE_OPERATOR( & )
+LANE_OPERATOR( | )
+LANE_OPERATOR( ^ )
+
+static MCU_FORCE_INLINE tLaneBytes operator~( const tLaneBytes& value )
+LANE_OPERATION( ~value.m_vector[vector] )
+
+static MCU_FORCE_INLINE tLaneBytes lanesSet( uint8_t value )
+LANE_OPERATION( vectorSet( value ) )
+
+static MCU_FORCE_INLINE tLaneBytes lanesLess( const tLaneBytes& value1, const tLaneBytes& value2 )
+LANE_OPERATION( vectorLess( value1.m_vector[vector], value2.m_vector[vector] ) )
+
+static MCU_FORCE_INLINE tLaneBytes lanesEqual( const tLaneBytes& value1, const tLaneBytes& value2 )
+LANE_OPERATION( vectorEqual( value1.m_vector[vector], value2.m_vector[vector] ) )
+
+static MCU_FORCE_INLINE tLaneBytes lanesShiftRight( const tLaneBytes& value )
+LANE_OPERATION( vectorShiftRight( value.m_vector[vector] ) )
+
+// The smallest of the lanes' bytes
+static MCU_FORCE_INLINE uint8_t lanesLowest( const tLaneBytes& value )
+{
+    tLaneVector lowest = value.m_vector[0];
+    for( unsigned vector = 1; vector < cLaneVectors; ++vector )
+        lowest = vectorMin( lowest, value.m_vector[vector] );
+    return vectorLowest( lowest );
+}
+
+static MCU_FORCE_INLINE tLaneBytes lanesLoad( const uint8_t *pLanes )
+{
+    tLaneBytes result;
+    memcpy( &result, pLanes, sizeof(result) );
+    return result;
+}
+
+static MCU_FORCE_INLINE void lanesStore( uint8_t *pLanes, const tLaneBytes& value )
+{ memcpy( pLanes, &value, sizeof(value) ); }
+
+// value1 in the lanes where mask is 0xFF, and value2 where it's 0x00
+static MCU_FORCE_INLINE tLaneBytes lanesSelect( const tLaneBytes& mask, const tLaneBytes& value1, const tLaneBytes& value2 )
+{ return (value1 & mask) | (value2 & ~mask); }
+
+// One bit per lane, set where mask is 0xFF
+static MCU_FORCE_INLINE uint32_t laneBits( const tLaneBytes& mask )
+{
+    uint32_t bits = 0;
+    for( unsigned vector = 0; vector < cLaneVectors; ++vector )
+        bits |= vectorBits( mask.m_vector[vector] ) << (vector * cLaneVectorSize);
+    return bits;
+}
+
+// 0xFF in the lanes where any of bits are set in value
+static MCU_FORCE_INLINE tLaneBytes lanesTest( const tLaneBytes& value, uint8_t bits )
+{ return ~lanesEqual( value & lanesSet( bits ), lanesSet( 0 ) ); }
+
+// As tMCUCore::testNegativeZero(), on regP
+static MCU_FORCE_INLINE tLaneBytes lanesNegativeZero( const tLaneBytes& regP, const tLaneBytes& value )
+{
+    return (regP & lanesSet( static_cast<uint8_t>(~(flag_N | flag_Z)) )) | (value & lanesSet( flag_N )) |
+           (lanesEqual( value, lanesSet( 0 ) ) & lanesSet( flag_Z ));
+}
+
+// As tMCUCore::modifyFlag(), with setFlag a mask of 0xFF or 0x00 in each lane
+static MCU_FORCE_INLINE tLaneBytes lanesModifyFlag( const tLaneBytes& regP, const tLaneBytes& setFlag, eFlags flag )
+{ return (regP & lanesSet( static_cast<uint8_t>(~flag) )) | (setFlag & lanesSet( flag )); }
+
+// Where the kernels get an instruction's operand from, in order of the instruction's length
+enum eLaneOperand
+{
+    operand_None,
+    operand_Pull, // The byte on top of the stack (and for RTS, the one above it too)
+
+    operand_Immediate,
+    operand_Relative,
+    operand_ZeroPage,
+    operand_ZeroPage_X,
+    operand_ZeroPage_Y,
+    operand_Indirect_X,
+    operand_Indirect_Y,
+    operand_Indirect_ZP,
+
+    operand_Absolute,
+    operand_Absolute_X,
+    operand_Absolute_Y,
+    operand_Jump, // JSR and JMP - the operand is the new PC, and nothing is read from it
+};
+
+//   Whether there's a kernel for opCode, and if so, what its operand is.  rStore is set for the instructions that
+// only write their operand - reading it first could have side effects on a device.
+static bool laneKernel( uint8_t opCode, eLaneOperand& rOperand, bool& rStore )
+{
+    rStore = false;
+
+    switch( opCode )
+    {
+    case 0x09: case 0x29: case 0x49: case 0x69: case 0x89: case 0xA0: case 0xA2: case 0xA9: // ORA AND EOR ADC BIT LDY LDX LDA #
+    case 0xC0: case 0xC9: case 0xE0: case 0xE9: // CPY CMP CPX SBC #
+        rOperand = operand_Immediate;
+        return true;
+
+    case 0x10: case 0x30: case 0x50: case 0x70: case 0x80: case 0x90: case 0xB0: case 0xD0: case 0xF0: // Branches
+        rOperand = operand_Relative;
+        return true;
+
+    case 0x64: case 0x84: case 0x85: case 0x86: // STZ STY STA STX zp
+        rStore = true;
+        // Fall through
+    case 0x05: case 0x25: case 0x45: case 0x65: case 0xA5: case 0xC5: case 0xE5: // ORA AND EOR ADC LDA CMP SBC zp
+    case 0x24: case 0xA4: case 0xA6: case 0xC4: case 0xE4: // BIT LDY LDX CPY CPX zp
+    case 0x06: case 0x26: case 0x46: case 0x66: case 0xC6: case 0xE6: // ASL ROL LSR ROR DEC INC zp
+        rOperand = operand_ZeroPage;
+        return true;
+
+    case 0x74: case 0x94: case 0x95: // STZ STY STA zp,X
+        rStore = true;
+        // Fall through
+    case 0x15: case 0x35: case 0x55: case 0x75: case 0xB5: case 0xD5: case 0xF5: // ORA AND EOR ADC LDA CMP SBC zp,X
+    case 0x34: case 0xB4: // BIT LDY zp,X
+    case 0x16: case 0x36: case 0x56: case 0x76: case 0xD6: case 0xF6: // ASL ROL LSR ROR DEC INC zp,X
+        rOperand = operand_ZeroPage_X;
+        return true;
+
+    case 0x96: // STX zp,Y
+        rStore = true;
+        // Fall through
+    case 0xB6: // LDX zp,Y
+        rOperand = operand_ZeroPage_Y;
+        return true;
+
+    case 0x9C: case 0x8C: case 0x8D: case 0x8E: // STZ STY STA STX abs
+        rStore = true;
+        // Fall through
+    case 0x0D: case 0x2D: case 0x4D: case 0x6D: case 0xAD: case 0xCD: case 0xED: // ORA AND EOR ADC LDA CMP SBC abs
+    case 0x2C: case 0xAC: case 0xAE: case 0xCC: case 0xEC: // BIT LDY LDX CPY CPX abs
+    case 0x0E: case 0x2E: case 0x4E: case 0x6E: case 0xCE: case 0xEE: // ASL ROL LSR ROR DEC INC abs
+        rOperand = operand_Absolute;
+        return true;
+
+    case 0x9E: case 0x9D: // STZ STA abs,X
+        rStore = true;
+        // Fall through
+    case 0x1D: case 0x3D: case 0x5D: case 0x7D: case 0xBD: case 0xDD: case 0xFD: // ORA AND EOR ADC LDA CMP SBC abs,X
+    case 0x3C: case 0xBC: // BIT LDY abs,X
+    case 0x1E: case 0x3E: case 0x5E: case 0x7E: case 0xDE: case 0xFE: // ASL ROL LSR ROR DEC INC abs,X
+        rOperand = operand_Absolute_X;
+        return true;
+
+    case 0x99: // STA abs,Y
+        rStore = true;
+        // Fall through
+    case 0x19: case 0x39: case 0x59: case 0x79: case 0xB9: case 0xD9: case 0xF9: // ORA AND EOR ADC LDA CMP SBC abs,Y
+    case 0xBE: // LDX abs,Y
+        rOperand = operand_Absolute_Y;
+        return true;
+
+    case 0x81: // STA (zp,X)
+        rStore = true;
+        // Fall through
+    case 0x01: case 0x21: case 0x41: case 0x61: case 0xA1: case 0xC1: case 0xE1: // ORA AND EOR ADC LDA CMP SBC (zp,X)
+        rOperand = operand_Indirect_X;
+        return true;
+
+    case 0x91: // STA (zp),Y
+        rStore = true;
+        // Fall through
+    case 0x11: case 0x31: case 0x51: case 0x71: case 0xB1: case 0xD1: case 0xF1: // ORA AND EOR ADC LDA CMP SBC (zp),Y
+        rOperand = operand_Indirect_Y;
+        return true;
+
+    case 0x92: // STA (zp)
+        rStore = true;
+        // Fall through
+    case 0x12: case 0x32: case 0x52: case 0x72: case 0xB2: case 0xD2: case 0xF2: // ORA AND EOR ADC LDA CMP SBC (zp)
+        rOperand = operand_Indirect_ZP;
+        return true;
+
+    case 0x20: case 0x4C: // JSR JMP abs
+        rOperand = operand_Jump;
+        return true;
+
+    case 0x68: case 0xFA: case 0x7A: case 0x28: case 0x60: // PLA PLX PLY PLP RTS
+        rOperand = operand_Pull;
+        return true;
+
+    case 0xAA: case 0xA8: case 0x8A: case 0x98: case 0xBA: case 0x9A: // TAX TAY TXA TYA TSX TXS
+    case 0xE8: case 0xC8: case 0xCA: case 0x88: case 0x1A: case 0x3A: // INX INY DEX DEY INC DEC
+    case 0x0A: case 0x2A: case 0x4A: case 0x6A: // ASL ROL LSR ROR
+    case 0x18: case 0x38: case 0x58: case 0x78: case 0xB8: case 0xD8: case 0xF8: // CLC SEC CLI SEI CLV CLD SED
+    case 0x48: case 0xDA: case 0x5A: case 0x08: // PHA PHX PHY PHP
+    case 0xEA: // NOP
+        rOperand = operand_None;
+        return true;
+    }
+
+    return false;
+}
+
+// As tMCUCore::indexAddress() - rCrossed is set to 1 if the instruction is charged a cycle for crossing a page
+static inline uint16_t laneIndexAddress( uint16_t base, uint8_t index, bool pageCrossPenalty, uint8_t& rCrossed )
+{
+    uint16_t address = static_cast<uint16_t>(base + index);
+    rCrossed = pageCrossPenalty && ((address ^ base) & 0xFF00) != 0;
+    return address;
+}
+
+// As tMCUCore::directReadWord(), on a lane's memory
+static inline uint16_t laneDirectWord( const uint8_t *pMemory, uint16_t address )
+{ return static_cast<uint16_t>(pMemory[address] | (pMemory[address + 1] << 8)); }
+
+//   The lowest PC in regPCL/regPCH of the lanes that aren't in exclude (0xFF in each lane left out, which has to
+// leave at least one), and in rLanes, 0xFF for the lanes there.  The lowest high byte is found first, and then the
+// lowest low byte of the lanes with it.
+static MCU_FORCE_INLINE uint16_t lanesLowestPC( const tLaneBytes& regPCL, const tLaneBytes& regPCH, const tLaneBytes& exclude,
+                                                tLaneBytes& rLanes )
+{
+    uint8_t pch = lanesLowest( regPCH | exclude );
+    tLaneBytes onPage = lanesEqual( regPCH, lanesSet( pch ) ) & ~exclude;
+    uint8_t pcl = lanesLowest( regPCL | ~onPage );
+    rLanes = onPage & lanesEqual( regPCL, lanesSet( pcl ) );
+    return static_cast<uint16_t>(pcl | (pch << 8));
+}
+
+// Index of the lowest set bit in lanes, which mustn't be 0 - for going through the lanes in a group
+static inline unsigned lowestLane( uint32_t lanes )
+{
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctz( lanes ));
+#else
+    unsigned lane = 0;
+    for( ; !(lanes & 1); lanes >>= 1 )
+        ++lane;
+    return lane;
+#endif
+}
+
+// Number of lanes in lanes
+static inline unsigned laneCount( uint32_t lanes )
+{
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_popcount( lanes ));
+#else
+    unsigned count = 0;
+    for( ; lanes != 0; lanes &= lanes - 1 )
+        ++count;
+    return count;
+#endif
+}
+
+//   Most steps between settle()s.  A kernel adds at most 7 cycles to a lane's m_stepCycles (an indexed
+// read-modify-write that crosses a page), so the bytes can't overflow.
+static const unsigned cSettleSteps = 255 / 7;
+
+tMCULockstep::tMCULockstep()
+    : m_laneCount( 0 )
+    , m_active( 0 )
+    , m_halted( 0 )
+    , m_stepsLeft( 0 )
+    , m_vectorInstructions( 0 )
+    , m_scalarInstructions( 0 )
+{
+    memset( m_pLanes, 0, sizeof(m_pLanes) );
+    memset( m_pMemories, 0, sizeof(m_pMemories) );
+    memset( m_idleLanes, 0xFF, sizeof(m_idleLanes) );
+    memset( m_devicePages, 0, sizeof(m_devicePages) );
+    memset( m_groupLanes, 0, sizeof(m_groupLanes) );
+    memset( m_code, 0, sizeof(m_code) );
+    memset( m_regA, 0, sizeof(m_regA) );
+    memset( m_regX, 0, sizeof(m_regX) );
+    memset( m_regY, 0, sizeof(m_regY) );
+    memset( m_regP, 0, sizeof(m_regP) );
+    memset( m_regSP, 0, sizeof(m_regSP) );
+    memset( m_regPCL, 0, sizeof(m_regPCL) );
+    memset( m_regPCH, 0, sizeof(m_regPCH) );
+    memset( m_laneCycles, 0, sizeof(m_laneCycles) );
+    memset( m_startCycles, 0, sizeof(m_startCycles) );
+    memset( m_budgetLeft, 0, sizeof(m_budgetLeft) );
+    memset( m_stepCycles, 0, sizeof(m_stepCycles) );
+    memset( m_stepInstructions, 0, sizeof(m_stepInstructions) );
+    memset( m_stats, 0, sizeof(m_stats) );
+}
+
+unsigned tMCULockstep::addLane( tMCUState& rState )
+{
+    assert( m_laneCount < cMaxLanes );
+
+    m_pLanes[m_laneCount] = &rState;
+    m_pMemories[m_laneCount] = rState.m_pMemory;
+    m_stats[m_laneCount].m_lastExit = run_Budget;
+    return m_laneCount++;
+}
+
+void tMCULockstep::runInstructions( uint64_t instructions )
+{
+    m_active = 0;
+    memset( m_devicePages, 0, sizeof(m_devicePages) );
+
+    for( unsigned lane = 0; lane < m_laneCount; ++lane )
+    {
+        const tMCUState& rState = *m_pLanes[lane];
+        m_regA[lane] = rState.regA;
+        m_regX[lane] = rState.regX;
+        m_regY[lane] = rState.regY;
+        m_regP[lane] = rState.regP;
+        m_regSP[lane] = rState.regSP;
+        m_regPCL[lane] = static_cast<uint8_t>(rState.regPC);
+        m_regPCH[lane] = static_cast<uint8_t>(rState.regPC >> 8);
+        m_laneCycles[lane] = rState.getCycleCount();
+        m_startCycles[lane] = m_laneCycles[lane];
+        m_budgetLeft[lane] = instructions;
+
+        m_idleLanes[lane] = 0xFF;
+        if( instructions > 0 && !(m_halted & (1u << lane)) )
+        {
+            m_active |= 1u << lane;
+            m_idleLanes[lane] = 0;
+        }
+
+        for( unsigned page = 0; page < 256; ++page )
+            m_devicePages[page] |= rState.m_codePages[page] & tMCUState::cCodePageDevice;
+    }
+
+    m_stepsLeft = 0;
+    while( m_active )
+    {
+        if( m_stepsLeft == 0 )
+            m_stepsLeft = settle();
+        else
+            step();
+    }
+
+    settle();
+
+    for( unsigned lane = 0; lane < m_laneCount; ++lane )
+    {
+        tMCUState& rState = *m_pLanes[lane];
+        rState.regA = m_regA[lane];
+        rState.regX = m_regX[lane];
+        rState.regY = m_regY[lane];
+        rState.regP = m_regP[lane];
+        rState.regSP = m_regSP[lane];
+        rState.regPC = static_cast<uint16_t>(m_regPCL[lane] | (m_regPCH[lane] << 8));
+        rState.setCycleCount( m_laneCycles[lane] );
+
+        m_stats[lane].m_instructions += instructions - m_budgetLeft[lane];
+        m_stats[lane].m_cycles += m_laneCycles[lane] - m_startCycles[lane];
+    }
+}
+
+unsigned tMCULockstep::settle()
+{
+    uint64_t steps = cSettleSteps;
+
+    for( unsigned lane = 0; lane < m_laneCount; ++lane )
+    {
+        m_laneCycles[lane] += m_stepCycles[lane];
+        m_budgetLeft[lane] -= m_stepInstructions[lane];
+        m_stepCycles[lane] = 0;
+        m_stepInstructions[lane] = 0;
+
+        // Each step runs at most one instruction on a lane
+        if( m_active & (1u << lane) )
+        {
+            if( m_budgetLeft[lane] == 0 )
+                deactivate( lane );
+            else
+                steps = std::min( steps, m_budgetLeft[lane] );
+        }
+    }
+
+    return static_cast<unsigned>(steps);
+}
+
+void tMCULockstep::step()
+{
+    // The lanes furthest back in the code go first...
+    const tLaneBytes idle = lanesLoad( m_idleLanes );
+    const tLaneBytes regPCL = lanesLoad( m_regPCL );
+    const tLaneBytes regPCH = lanesLoad( m_regPCH );
+
+    tLaneBytes atPC;
+    uint16_t pc = lanesLowestPC( regPCL, regPCH, idle, atPC );
+    uint32_t group = laneBits( atPC );
+
+    // ...and carry on for as long as they're still behind all the others
+    uint32_t pcLimit = 0x10000;
+    if( m_active != group )
+    {
+        tLaneBytes nextLanes;
+        pcLimit = lanesLowestPC( regPCL, regPCH, idle | atPC, nextLanes );
+    }
+
+    if( (group & (group - 1)) == 0 )
+    {
+        runAlone( lowestLane( group ), pcLimit );
+        return;
+    }
+
+    tLaneBytes groupMask = atPC;
+    for( ;; )
+    {
+        // Code fetches have no side effects, so the instruction's bytes are gathered in one go
+        uint16_t operandAddress = static_cast<uint16_t>(pc + 1);
+        uint16_t operandHighAddress = static_cast<uint16_t>(pc + 2);
+        for( uint32_t lanes = group; lanes != 0; lanes &= lanes - 1 )
+        {
+            unsigned lane = lowestLane( lanes );
+            const uint8_t *pMemory = m_pMemories[lane];
+            m_code[0][lane] = pMemory[pc];
+            m_code[1][lane] = pMemory[operandAddress];
+            m_code[2][lane] = pMemory[operandHighAddress];
+        }
+
+        // Any lanes with a different opcode get the next step to themselves
+        unsigned firstLane = lowestLane( group );
+        uint8_t opCode = m_code[0][firstLane];
+        tLaneBytes sameOpCode = groupMask & lanesEqual( lanesLoad( m_code[0] ), lanesSet( opCode ) );
+        uint32_t sameLanes = laneBits( sameOpCode );
+        if( sameLanes != group )
+        {
+            groupMask = sameOpCode;
+            group = sameLanes;
+            pcLimit = pc;
+        }
+
+        lanesStore( m_groupLanes, groupMask );
+        --m_stepsLeft;
+        if( !runVector( opCode, pc, group ) )
+        {
+            runScalar( pc, group );
+            return;
+        }
+
+        // The lanes have to have stayed together, too
+        uint8_t pcl = m_regPCL[firstLane];
+        uint8_t pch = m_regPCH[firstLane];
+        pc = static_cast<uint16_t>(pcl | (pch << 8));
+        if( pc >= pcLimit || m_stepsLeft == 0 )
+            return;
+
+        tLaneBytes together = lanesEqual( lanesLoad( m_regPCL ), lanesSet( pcl ) ) & lanesEqual( lanesLoad( m_regPCH ), lanesSet( pch ) );
+        if( laneBits( together & groupMask ) != group )
+            return;
+    }
+}
+
+//   Each kernel works out the new registers for every lane, and only the lanes in the group are then updated
+// from them.  Memory can differ from lane to lane, so it's still read and written a lane at a time, in the same way
+// as the instruction templates would - with each lane's cycle count brought up to date first on device pages, for
+// devices that look at the time.
+bool tMCULockstep::runVector( uint8_t opCode, uint16_t pc, uint32_t group )
+{
+    eLaneOperand operandType;
+    bool store;
+    if( !laneKernel( opCode, operandType, store ) )
+        return false;
+
+    // The templates read immediate and relative operands through tMCUState::memReadByte(), rather than as code
+    if( (operandType == operand_Immediate || operandType == operand_Relative) &&
+        m_devicePages[static_cast<uint16_t>(pc + 1) >> 8] )
+        return false;
+
+    const tLaneBytes groupMask = lanesLoad( m_groupLanes );
+    const tLaneBytes regP = lanesLoad( m_regP );
+
+    // Decimal mode ADC/SBC is left to the templates (bits 5 and 6 are set in both of their opcodes, as well as
+    // the usual ALU bits, or $12 for the (zp) ones)
+    if( (opCode & 0x60) == 0x60 && ((opCode & 0x03) == 0x01 || (opCode & 0x1F) == 0x12) &&
+        laneBits( lanesTest( regP, flag_D ) & groupMask ) != 0 )
+        return false;
+
+    uint8_t operands[cMaxLanes] = {};
+    uint8_t pulledHigh[cMaxLanes] = {}; // RTS's return address high byte
+    uint8_t crossed[cMaxLanes] = {}; // 1 in the lanes charged a cycle for crossing a page
+    uint16_t addresses[cMaxLanes];
+
+    if( operandType == operand_Pull )
+    {
+        for( uint32_t lanes = group; lanes != 0; lanes &= lanes - 1 )
+        {
+            unsigned lane = lowestLane( lanes );
+            const uint8_t *pMemory = m_pMemories[lane];
+            operands[lane] = pMemory[tMCUState::tCore::cStackOffset + static_cast<uint8_t>(m_regSP[lane] + 1)];
+            pulledHigh[lane] = pMemory[tMCUState::tCore::cStackOffset + static_cast<uint8_t>(m_regSP[lane] + 2)];
+        }
+    }
+    else if( operandType >= operand_ZeroPage && operandType != operand_Jump )
+    {
+        bool pageCrossPenalty = mcuPageCrossPenalty( opCode );
+
+        for( uint32_t lanes = group; lanes != 0; lanes &= lanes - 1 )
+        {
+            unsigned lane = lowestLane( lanes );
+            const uint8_t *pMemory = m_pMemories[lane];
+            uint8_t operand = m_code[1][lane];
+            uint16_t absolute = static_cast<uint16_t>(operand | (m_code[2][lane] << 8));
+
+            uint16_t address = 0;
+            switch( operandType )
+            {
+            case operand_ZeroPage:      address = operand; break;
+            case operand_ZeroPage_X:    address = static_cast<uint8_t>(operand + m_regX[lane]); break;
+            case operand_ZeroPage_Y:    address = static_cast<uint8_t>(operand + m_regY[lane]); break;
+            case operand_Indirect_X:    address = laneDirectWord( pMemory, static_cast<uint8_t>(operand + m_regX[lane]) ); break;
+            case operand_Indirect_Y:    address = laneIndexAddress( laneDirectWord( pMemory, operand ), m_regY[lane], pageCrossPenalty, crossed[lane] ); break;
+            case operand_Indirect_ZP:   address = laneDirectWord( pMemory, operand ); break;
+            case operand_Absolute:      address = absolute; break;
+            case operand_Absolute_X:    address = laneIndexAddress( absolute, m_regX[lane], pageCrossPenalty, crossed[lane] ); break;
+            case operand_Absolute_Y:    address = laneIndexAddress( absolute, m_regY[lane], pageCrossPenalty, crossed[lane] ); break;
+            default:                    assert( false );
+            }
+
+            addresses[lane] = address;
+            if( !store )
+            {
+                tMCUState& rLane = *m_pLanes[lane];
+                if( m_devicePages[address >> 8] )
+                    rLane.setCycleCount( m_laneCycles[lane] + m_stepCycles[lane] );
+                operands[lane] = rLane.memReadByte( address );
+            }
+        }
+    }
+
+    const tLaneBytes operand = lanesLoad( operandType == operand_Immediate || operandType == operand_Relative ? m_code[1] : operands );
+    const tLaneBytes regA = lanesLoad( m_regA );
+    const tLaneBytes regX = lanesLoad( m_regX );
+    const tLaneBytes regY = lanesLoad( m_regY );
+    const tLaneBytes regSP = lanesLoad( m_regSP );
+    const tLaneBytes regPCL = lanesLoad( m_regPCL );
+    const tLaneBytes regPCH = lanesLoad( m_regPCH );
+    const tLaneBytes zero = lanesSet( 0 );
+    const tLaneBytes one = lanesSet( 1 );
+    const tLaneBytes carry = regP & lanesSet( flag_C ); // 1 or 0
+
+    unsigned length = operandType < operand_Immediate ? 1 : operandType < operand_Absolute ? 2 : 3;
+    uint16_t nextPC = static_cast<uint16_t>(pc + length);
+
+    tLaneBytes newA = regA;
+    tLaneBytes newX = regX;
+    tLaneBytes newY = regY;
+    tLaneBytes newP = regP;
+    tLaneBytes newSP = regSP;
+    tLaneBytes newPCL = lanesSet( static_cast<uint8_t>(nextPC) );
+    tLaneBytes newPCH = lanesSet( static_cast<uint8_t>(nextPC >> 8) );
+    tLaneBytes cycles = lanesSet( tMCUState::opCodeCycles( opCode ) ) + lanesLoad( crossed );
+    tLaneBytes result = zero; // What's written back to memory, or pushed
+    tLaneBytes taken = zero; // Branches taken
+    bool push = false;
+
+    switch( opCode )
+    {
+    case 0x09: case 0x05: case 0x15: case 0x0D: case 0x1D: case 0x19: case 0x01: case 0x11: case 0x12: // ORA
+        newA = regA | operand;
+        newP = lanesNegativeZero( regP, newA );
+        break;
+
+    case 0x29: case 0x25: case 0x35: case 0x2D: case 0x3D: case 0x39: case 0x21: case 0x31: case 0x32: // AND
+        newA = regA & operand;
+        newP = lanesNegativeZero( regP, newA );
+        break;
+
+    case 0x49: case 0x45: case 0x55: case 0x4D: case 0x5D: case 0x59: case 0x41: case 0x51: case 0x52: // EOR
+        newA = regA ^ operand;
+        newP = lanesNegativeZero( regP, newA );
+        break;
+
+    // ADC - the carry out is from either of the two adds wrapping round
+    case 0x69: case 0x65: case 0x75: case 0x6D: case 0x7D: case 0x79: case 0x61: case 0x71: case 0x72:
+    {
+        tLaneBytes sum = regA + operand;
+        newA = sum + carry;
+        tLaneBytes carryOut = lanesLess( sum, regA ) | lanesLess( newA, sum );
+        tLaneBytes overflow = lanesTest( ~(regA ^ operand) & (newA ^ operand), 0x80 );
+        newP = lanesModifyFlag( lanesModifyFlag( regP, carryOut, flag_C ), overflow, flag_V );
+        newP = lanesNegativeZero( newP, newA );
+        break;
+    }
+
+    // SBC - as ADC, with a borrow out instead of a carry
+    case 0xE9: case 0xE5: case 0xF5: case 0xED: case 0xFD: case 0xF9: case 0xE1: case 0xF1: case 0xF2:
+    {
+        tLaneBytes borrow = carry ^ one;
+        tLaneBytes difference = regA - operand;
+        newA = difference - borrow;
+        tLaneBytes borrowOut = lanesLess( regA, operand ) | lanesLess( difference, borrow );
+        tLaneBytes overflow = lanesTest( (regA ^ operand) & ~(newA ^ operand), 0x80 );
+        newP = lanesModifyFlag( lanesModifyFlag( regP, ~borrowOut, flag_C ), overflow, flag_V );
+        newP = lanesNegativeZero( newP, newA );
+        break;
+    }
+
+    case 0xA9: case 0xA5: case 0xB5: case 0xAD: case 0xBD: case 0xB9: case 0xA1: case 0xB1: case 0xB2: // LDA
+        newA = operand;
+        newP = lanesNegativeZero( regP, newA );
+        break;
+
+    case 0xA2: case 0xA6: case 0xB6: case 0xAE: case 0xBE: // LDX
+        newX = operand;
+        newP = lanesNegativeZero( regP, newX );
+        break;
+
+    case 0xA0: case 0xA4: case 0xB4: case 0xAC: case 0xBC: // LDY
+        newY = operand;
+        newP = lanesNegativeZero( regP, newY );
+        break;
+
+    case 0xC9: case 0xC5: case 0xD5: case 0xCD: case 0xDD: case 0xD9: case 0xC1: case 0xD1: case 0xD2: // CMP
+        newP = lanesNegativeZero( lanesModifyFlag( regP, ~lanesLess( regA, operand ), flag_C ), regA - operand );
+        break;
+
+    case 0xE0: case 0xE4: case 0xEC: // CPX
+        newP = lanesNegativeZero( lanesModifyFlag( regP, ~lanesLess( regX, operand ), flag_C ), regX - operand );
+        break;
+
+    case 0xC0: case 0xC4: case 0xCC: // CPY
+        newP = lanesNegativeZero( lanesModifyFlag( regP, ~lanesLess( regY, operand ), flag_C ), regY - operand );
+        break;
+
+    case 0x89: case 0x24: case 0x34: case 0x2C: case 0x3C: // BIT
+        newP = lanesModifyFlag( regP, lanesEqual( regA & operand, zero ), flag_Z );
+        newP = (newP & lanesSet( static_cast<uint8_t>(~(flag_N | flag_V)) )) | (operand & lanesSet( flag_N | flag_V ));
+        break;
+
+    case 0x85: case 0x95: case 0x8D: case 0x9D: case 0x99: case 0x81: case 0x91: case 0x92: result = regA; break; // STA
+    case 0x86: case 0x96: case 0x8E: result = regX; break; // STX
+    case 0x84: case 0x94: case 0x8C: result = regY; break; // STY
+    case 0x64: case 0x74: case 0x9C: case 0x9E: result = zero; break; // STZ
+
+    case 0x0A: case 0x06: case 0x16: case 0x0E: case 0x1E: // ASL
+    case 0x2A: case 0x26: case 0x36: case 0x2E: case 0x3E: // ROL
+    case 0x4A: case 0x46: case 0x56: case 0x4E: case 0x5E: // LSR
+    case 0x6A: case 0x66: case 0x76: case 0x6E: case 0x7E: // ROR
+    {
+        bool accumulator = (opCode & 0x0F) == 0x0A;
+        tLaneBytes value = accumulator ? regA : operand;
+
+        if( opCode < 0x40 )
+        {
+            result = value + value;
+            if( opCode >= 0x20 )
+                result = result | carry;
+            newP = lanesModifyFlag( regP, lanesTest( value, 0x80 ), flag_C );
+        }
+        else
+        {
+            result = lanesShiftRight( value );
+            if( opCode >= 0x60 )
+                result = result | ((carry + lanesSet( 0x7F )) & lanesSet( 0x80 ));
+            newP = lanesModifyFlag( regP, lanesTest( value, 0x01 ), flag_C );
+        }
+
+        newP = lanesNegativeZero( newP, result );
+        if( accumulator )
+            newA = result;
+        else
+            store = true;
+        break;
+    }
+
+    case 0xE6: case 0xF6: case 0xEE: case 0xFE: // INC
+        result = operand + one;
+        newP = lanesNegativeZero( regP, result );
+        store = true;
+        break;
+
+    case 0xC6: case 0xD6: case 0xCE: case 0xDE: // DEC
+        result = operand - one;
+        newP = lanesNegativeZero( regP, result );
+        store = true;
+        break;
+
+    case 0xAA: newX = regA; newP = lanesNegativeZero( regP, newX ); break; // TAX
+    case 0xA8: newY = regA; newP = lanesNegativeZero( regP, newY ); break; // TAY
+    case 0x8A: newA = regX; newP = lanesNegativeZero( regP, newA ); break; // TXA
+    case 0x98: newA = regY; newP = lanesNegativeZero( regP, newA ); break; // TYA
+    case 0xBA: newX = regSP; newP = lanesNegativeZero( regP, newX ); break; // TSX
+    case 0x9A: newSP = regX; break; // TXS
+
+    case 0xE8: newX = regX + one; newP = lanesNegativeZero( regP, newX ); break; // INX
+    case 0xC8: newY = regY + one; newP = lanesNegativeZero( regP, newY ); break; // INY
+    case 0xCA: newX = regX - one; newP = lanesNegativeZero( regP, newX ); break; // DEX
+    case 0x88: newY = regY - one; newP = lanesNegativeZero( regP, newY ); break; // DEY
+    case 0x1A: newA = regA + one; newP = lanesNegativeZero( regP, newA ); break; // INC A
+    case 0x3A: newA = regA - one; newP = lanesNegativeZero( regP, newA ); break; // DEC A
+
+    case 0x18: newP = regP & lanesSet( static_cast<uint8_t>(~flag_C) ); break; // CLC
+    case 0x38: newP = regP | lanesSet( flag_C ); break; // SEC
+    case 0x58: newP = regP & lanesSet( static_cast<uint8_t>(~flag_I) ); break; // CLI
+    case 0x78: newP = regP | lanesSet( flag_I ); break; // SEI
+    case 0xB8: newP = regP & lanesSet( static_cast<uint8_t>(~flag_V) ); break; // CLV
+    case 0xD8: newP = regP & lanesSet( static_cast<uint8_t>(~flag_D) ); break; // CLD
+    case 0xF8: newP = regP | lanesSet( flag_D ); break; // SED
+    case 0xEA: break; // NOP
+
+    case 0x48: result = regA; newSP = regSP - one; push = true; break; // PHA
+    case 0xDA: result = regX; newSP = regSP - one; push = true; break; // PHX
+    case 0x5A: result = regY; newSP = regSP - one; push = true; break; // PHY
+    case 0x08: result = regP | lanesSet( flag_B | flag_X ); newSP = regSP - one; push = true; break; // PHP
+
+    case 0x68: newA = operand; newP = lanesNegativeZero( regP, newA ); newSP = regSP + one; break; // PLA
+    case 0xFA: newX = operand; newP = lanesNegativeZero( regP, newX ); newSP = regSP + one; break; // PLX
+    case 0x7A: newY = operand; newP = lanesNegativeZero( regP, newY ); newSP = regSP + one; break; // PLY
+    case 0x28: newP = operand | lanesSet( flag_B | flag_X ); newSP = regSP + one; break; // PLP
+
+    case 0x20: // JSR - pushes the address of its last byte, high byte first
+        result = lanesSet( static_cast<uint8_t>(pc + 2) );
+        newSP = regSP - one - one;
+        push = true;
+        // Fall through
+    case 0x4C: // JMP
+        newPCL = lanesLoad( m_code[1] );
+        newPCH = lanesLoad( m_code[2] );
+        break;
+
+    case 0x60: // RTS - to the byte after the pulled address
+        newPCL = operand + one;
+        newPCH = lanesLoad( pulledHigh ) + (lanesEqual( newPCL, zero ) & one);
+        newSP = regSP + one + one;
+        break;
+
+    case 0x10: taken = ~lanesTest( regP, flag_N ); break; // BPL
+    case 0x30: taken = lanesTest( regP, flag_N ); break; // BMI
+    case 0x50: taken = ~lanesTest( regP, flag_V ); break; // BVC
+    case 0x70: taken = lanesTest( regP, flag_V ); break; // BVS
+    case 0x90: taken = ~lanesTest( regP, flag_C ); break; // BCC
+    case 0xB0: taken = lanesTest( regP, flag_C ); break; // BCS
+    case 0xD0: taken = ~lanesTest( regP, flag_Z ); break; // BNE
+    case 0xF0: taken = lanesTest( regP, flag_Z ); break; // BEQ
+    case 0x80: taken = lanesSet( 0xFF ); break; // BRA
+    }
+
+    //   As tMCUCore::pcBranchOffset(), a byte at a time - the offset goes on to the low byte, and its sign and the
+    // carry out of the low byte on to the high byte, which costs a cycle more if it changes
+    if( operandType == operand_Relative )
+    {
+        tLaneBytes targetL = newPCL + operand;
+        tLaneBytes targetH = newPCH + (lanesLess( targetL, operand ) & one) + lanesTest( operand, 0x80 );
+        cycles = cycles + (taken & (one + (~lanesEqual( targetH, newPCH ) & one)));
+        newPCL = lanesSelect( taken, targetL, newPCL );
+        newPCH = lanesSelect( taken, targetH, newPCH );
+    }
+
+    if( store || push )
+    {
+        uint8_t results[cMaxLanes];
+        lanesStore( results, result );
+
+        for( uint32_t lanes = group; lanes != 0; lanes &= lanes - 1 )
+        {
+            unsigned lane = lowestLane( lanes );
+            tMCUState& rLane = *m_pLanes[lane];
+
+            if( push )
+            {
+                uint8_t regSPLane = m_regSP[lane];
+                if( opCode == 0x20 )
+                    rLane.memWriteDirect( tMCUState::tCore::cStackOffset + regSPLane--, static_cast<uint8_t>((pc + 2) >> 8) );
+                rLane.memWriteDirect( tMCUState::tCore::cStackOffset + regSPLane, results[lane] );
+            }
+            else
+            {
+                if( m_devicePages[addresses[lane] >> 8] )
+                    rLane.setCycleCount( m_laneCycles[lane] + m_stepCycles[lane] );
+                rLane.memWriteByte( addresses[lane], results[lane] );
+            }
+        }
+    }
+
+    lanesStore( m_regA, lanesSelect( groupMask, newA, regA ) );
+    lanesStore( m_regX, lanesSelect( groupMask, newX, regX ) );
+    lanesStore( m_regY, lanesSelect( groupMask, newY, regY ) );
+    lanesStore( m_regP, lanesSelect( groupMask, newP, regP ) );
+    lanesStore( m_regSP, lanesSelect( groupMask, newSP, regSP ) );
+    lanesStore( m_regPCL, lanesSelect( groupMask, newPCL, regPCL ) );
+    lanesStore( m_regPCH, lanesSelect( groupMask, newPCH, regPCH ) );
+    lanesStore( m_stepCycles, lanesLoad( m_stepCycles ) + (cycles & groupMask) );
+    lanesStore( m_stepInstructions, lanesLoad( m_stepInstructions ) + (one & groupMask) );
+
+    m_vectorInstructions += laneCount( group );
+    return true;
+}
+
+// Through the instruction templates, on a core over each lane's own tMCUState
+void tMCULockstep::runScalar( uint16_t pc, uint32_t group )
+{
+    for( uint32_t lanes = group; lanes != 0; lanes &= lanes - 1 )
+    {
+        unsigned lane = lowestLane( lanes );
+
+        tMCUState& rState = *m_pLanes[lane];
+        rState.setCycleCount( m_laneCycles[lane] + m_stepCycles[lane] ); // For devices that look at the time
+
+        tMCURegisters registers;
+        registers.regA = m_regA[lane];
+        registers.regX = m_regX[lane];
+        registers.regY = m_regY[lane];
+        registers.regP = m_regP[lane];
+        registers.regPC = pc;
+        registers.regSP = m_regSP[lane];
+
+        tMCUState::tCore core( rState, registers );
+        uint8_t opCode = core.pcReadByte();
+        mcuExecuteOpCode( core, opCode );
+
+        m_regA[lane] = core.regA;
+        m_regX[lane] = core.regX;
+        m_regY[lane] = core.regY;
+        m_regP[lane] = core.getRegP();
+        m_regSP[lane] = core.regSP;
+        m_regPCL[lane] = static_cast<uint8_t>(core.regPC);
+        m_regPCH[lane] = static_cast<uint8_t>(core.regPC >> 8);
+        m_laneCycles[lane] += tMCUState::opCodeCycles( opCode ) + core.m_cycles;
+        ++m_stepInstructions[lane];
+        ++m_scalarInstructions;
+
+        haltOn( lane, opCode );
+    }
+}
+
+void tMCULockstep::runAlone( unsigned lane, uint32_t pcLimit )
+{
+    tMCUState& rState = *m_pLanes[lane];
+    uint64_t startCycles = m_laneCycles[lane] + m_stepCycles[lane];
+    uint64_t budget = m_budgetLeft[lane] - m_stepInstructions[lane];
+
+    tMCURegisters registers;
+    registers.regA = m_regA[lane];
+    registers.regX = m_regX[lane];
+    registers.regY = m_regY[lane];
+    registers.regP = m_regP[lane];
+    registers.regPC = static_cast<uint16_t>(m_regPCL[lane] | (m_regPCH[lane] << 8));
+    registers.regSP = m_regSP[lane];
+
+    tMCUState::tCore core( rState, registers );
+    uint64_t executed = 0;
+    uint8_t opCode;
+    do
+    {
+        rState.setCycleCount( startCycles + core.m_cycles ); // For devices that look at the time
+        opCode = core.pcReadByte();
+        mcuExecuteOpCode( core, opCode );
+        core.addCycles( tMCUState::opCodeCycles( opCode ) );
+        ++executed;
+    }
+    while( executed < budget && core.regPC < pcLimit && opCode != 0xCB && opCode != 0xDB );
+
+    m_regA[lane] = core.regA;
+    m_regX[lane] = core.regX;
+    m_regY[lane] = core.regY;
+    m_regP[lane] = core.getRegP();
+    m_regSP[lane] = core.regSP;
+    m_regPCL[lane] = static_cast<uint8_t>(core.regPC);
+    m_regPCH[lane] = static_cast<uint8_t>(core.regPC >> 8);
+    m_laneCycles[lane] += core.m_cycles;
+    m_budgetLeft[lane] -= executed;
+    m_scalarInstructions += executed;
+
+    haltOn( lane, opCode );
+
+    // The lane's budget has moved on outside the steps, so settle() has to count them again
+    m_stepsLeft = 0;
+}
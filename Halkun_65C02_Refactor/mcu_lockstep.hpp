@@ -0,0 +1,123 @@
+/*
+
+  mcu_lockstep.hpp - Runs up to 32 MCUs side by side, executing the instructions they share for all of them at once
+
+*/
+
+#ifndef MCU_LOCKSTEP_HPP
+#define MCU_LOCKSTEP_HPP
+
+#include <cstdint>
+
+#include "mcu_core.hpp"
+
+//   A set of lanes - each one a tMCUState with its own memory - whose registers are held structure-of-arrays
+// style (all the As together, all the Xs together, ...).  Each step picks the lanes furthest back in the code, and
+// executes the instruction at that PC for every one of them that has the same opcode there.  Nearly all of the
+// instructions then go through vector kernels that work on all the lanes at once - only memory accesses are made a
+// lane at a time.  The rest (BRK, RTI, JMP indirect, TSB/TRB, WAI/STP and decimal mode ADC/SBC) are run one lane at
+// a time through the instruction templates.
+//   Lanes running the same code with different data (e.g. the same ROM fed different input) split up at branches
+// that go different ways, and come back together where the paths join again - running the lanes furthest back
+// first is what lets the others wait for them there.
+//   There are no interrupts or scheduled events in lockstep, although devices still see each lane's own cycle
+// count.  A lane that executes WAI or STP drops out for good (and isn't left waiting, as run() would leave it).
+// Use tMCUFleet for programs that need any of that.
+class tMCULockstep
+{
+public:
+    static const unsigned cMaxLanes = 32;
+
+    struct tLaneStats
+    {
+        uint64_t m_instructions;
+        uint64_t m_cycles;
+        eRunExit m_lastExit; // run_Budget, or run_Wait/run_Stop once the lane has dropped out
+    };
+
+    tMCULockstep();
+
+    //   Adds rState as the next lane, and returns its index.  The state isn't owned.  Its registers and cycle
+    // count are read at the start of each run, and written back at the end, so the host can change them between runs.
+    unsigned addLane( tMCUState& rState );
+
+    // Runs each lane for up to instructions more instructions
+    void runInstructions( uint64_t instructions );
+
+    unsigned getLaneCount() const { return m_laneCount; }
+    const tLaneStats& getStats( unsigned lane ) const { return m_stats[lane]; }
+
+    // Lane instructions (one per lane that executed it) that went through the vector kernels, and that didn't
+    uint64_t getVectorInstructions() const { return m_vectorInstructions; }
+    uint64_t getScalarInstructions() const { return m_scalarInstructions; }
+
+private:
+    tMCULockstep( const tMCULockstep& ); // Disallowed
+
+    // Picks the next group of lanes, and executes instructions for them for as long as they stay together and behind the rest
+    void step();
+
+    // Executes the instruction at pc for each lane in group.  runVector() returns false without doing anything if
+    // the opcode has no kernel.
+    bool runVector( uint8_t opCode, uint16_t pc, uint32_t group );
+    void runScalar( uint16_t pc, uint32_t group );
+
+    //   Runs a lane on its own through the instruction templates for as long as it's behind all the others (before
+    // pcLimit), which is what the steps would do anyway, but without picking a group for each instruction
+    void runAlone( unsigned lane, uint32_t pcLimit );
+
+    //   Adds m_stepCycles and m_stepInstructions into the lanes' totals and zeroes them, takes out the lanes that
+    // have used up their budget, and returns how many steps can go by before it has to be called again
+    unsigned settle();
+
+    // Takes a lane out of the steps
+    void deactivate( unsigned lane )
+    {
+        m_active &= ~(1u << lane);
+        m_idleLanes[lane] = 0xFF;
+    }
+
+    // Takes a lane out for good, if opCode is WAI or STP
+    void haltOn( unsigned lane, uint8_t opCode )
+    {
+        if( opCode == 0xCB || opCode == 0xDB )
+        {
+            m_stats[lane].m_lastExit = opCode == 0xCB ? run_Wait : run_Stop;
+            m_halted |= 1u << lane;
+            deactivate( lane );
+        }
+    }
+
+    unsigned            m_laneCount;
+    tMCUState          *m_pLanes[cMaxLanes];
+    uint8_t            *m_pMemories[cMaxLanes]; // Each lane's tMCUState::m_pMemory, for code fetches and zero page
+    uint32_t            m_active; // One bit per lane still running this time round
+    uint32_t            m_halted; // One bit per lane that's executed WAI or STP
+    unsigned            m_stepsLeft; // Before the next settle()
+    uint8_t             m_idleLanes[cMaxLanes]; // 0xFF for the lanes that aren't in m_active, as a mask for the kernels
+    uint8_t             m_devicePages[256]; // Non-zero for the pages that any lane has a device in
+    uint8_t             m_groupLanes[cMaxLanes]; // 0xFF for the lanes in the group being stepped
+    uint8_t             m_code[3][cMaxLanes]; // The bytes at the PC being stepped, in every lane
+
+    // The lanes' registers - one array per register, so that the kernels can load all the lanes in one go
+    uint8_t             m_regA[cMaxLanes];
+    uint8_t             m_regX[cMaxLanes];
+    uint8_t             m_regY[cMaxLanes];
+    uint8_t             m_regP[cMaxLanes];
+    uint8_t             m_regSP[cMaxLanes];
+    uint8_t             m_regPCL[cMaxLanes]; // PC a byte at a time, as the kernels work on it
+    uint8_t             m_regPCH[cMaxLanes];
+    uint64_t            m_laneCycles[cMaxLanes]; // Each lane's tMCUState::getCycleCount(), as of the last settle()
+    uint64_t            m_startCycles[cMaxLanes]; // m_laneCycles at the start of the run
+    uint64_t            m_budgetLeft[cMaxLanes]; // As of the last settle()
+
+    // Cycles and instructions since the last settle() - bytes, so that the kernels can add to all the lanes at once
+    uint8_t             m_stepCycles[cMaxLanes];
+    uint8_t             m_stepInstructions[cMaxLanes];
+
+    tLaneStats          m_stats[cMaxLanes];
+    uint64_t            m_vectorInstructions;
+    uint64_t            m_scalarInstructions;
+};
+
+#endif
@@ -0,0 +1,262 @@
+#include "mcu_rewind.hpp"
+
+tMCURewind::tMCURewind( size_t logEntries, unsigned checkpointCount, uint64_t checkpointInterval )
+    : m_logMask( 0 )
+    , m_logEnd( 0 )
+    , m_logHighWater( 0 )
+    , m_replayEnd( 0 )
+    , m_replayEmptyReads( 0 )
+    , m_emptyReadOpen( false )
+    , m_checkpointEnd( 0 )
+    , m_checkpointHighWater( 0 )
+    , m_checkpointInterval( checkpointInterval > 0 ? checkpointInterval : 1 )
+    , m_nextCheckpoint( 0 )
+{
+    size_t logSize = 1;
+    while( logSize < logEntries )
+        logSize <<= 1;
+
+    m_log.resize( logSize );
+    m_pLog = &m_log[0];
+    m_logMask = logSize - 1;
+
+    m_checkpoints.resize( checkpointCount > 0 ? checkpointCount : 1 );
+}
+
+void tMCURewind::clear()
+{
+    m_logEnd = 0;
+    m_logHighWater = 0;
+    m_replayEnd = 0;
+    m_replayEmptyReads = 0;
+    m_emptyReadOpen = false;
+    m_checkpointEnd = 0;
+    m_checkpointHighWater = 0;
+    m_nextCheckpoint = 0;
+}
+
+// A polling loop reads the empty port over and over, so reads in a row with nothing else in between share an entry
+void tMCURewind::recordEmptyRead()
+{
+    if( isReplaying() )
+    {
+        const tEntry& rEntry = m_pLog[m_logEnd & m_logMask];
+        if( rEntry.m_kind == entry_EmptyRead )
+        {
+            if( ++m_replayEmptyReads == rEntry.m_count )
+            {
+                ++m_logEnd;
+                m_replayEmptyReads = 0;
+            }
+            return;
+        }
+
+        m_replayEnd = 0;
+    }
+
+    if( m_emptyReadOpen && m_pLog[(m_logEnd - 1) & m_logMask].m_count < UINT32_MAX )
+    {
+        ++m_pLog[(m_logEnd - 1) & m_logMask].m_count;
+        return;
+    }
+
+    record( entry_EmptyRead, 0, 0, 1 );
+    m_emptyReadOpen = true;
+}
+
+void tMCURewind::recordIdle( uint64_t instructionCount, uint64_t cycles )
+{
+    static const uint32_t cMaxIdleCycles = 0xFFFFFF;
+
+    for( ; cycles > cMaxIdleCycles; cycles -= cMaxIdleCycles )
+        record( entry_Idle, 0xFFFF, 0xFF, static_cast<uint32_t>(instructionCount) );
+
+    record( entry_Idle, static_cast<uint16_t>(cycles), static_cast<uint8_t>(cycles >> 16), static_cast<uint32_t>(instructionCount) );
+}
+
+// Reuses the slot's event vector, so nothing is allocated once the ring has gone round
+void tMCURewind::checkpoint( tMCUState& rState, const tMCURegisters& registers )
+{
+    tCheckpoint& rCheckpoint = m_checkpoints[m_checkpointEnd++ % m_checkpoints.size()];
+
+    rCheckpoint.m_instructionCount = rState.m_instructionCount;
+    rCheckpoint.m_logPos = m_logEnd;
+    rCheckpoint.m_registers = registers;
+    rCheckpoint.m_cycleCount = rState.m_cycleCount;
+    rCheckpoint.m_events = rState.m_events;
+    rCheckpoint.m_irqLines = rState.m_irqLines;
+    rCheckpoint.m_nmiLine = rState.m_nmiLine;
+    rCheckpoint.m_nmiPending = rState.m_nmiPending;
+    rCheckpoint.m_waiting = rState.m_waiting;
+    rCheckpoint.m_stopped = rState.m_stopped;
+    rState.m_via.saveState( rCheckpoint.m_via );
+
+    // The entries before a checkpoint can't change after it
+    m_emptyReadOpen = false;
+    m_nextCheckpoint = rState.m_instructionCount + m_checkpointInterval;
+}
+
+const tMCURewind::tCheckpoint *tMCURewind::findCheckpoint( uint64_t instructionCount, uint64_t& rIndex ) const
+{
+    for( uint64_t index = m_checkpointEnd; index > oldestCheckpoint(); --index )
+    {
+        const tCheckpoint& rCheckpoint = m_checkpoints[(index - 1) % m_checkpoints.size()];
+
+        // Older ones have lost even more of the log
+        if( rCheckpoint.m_logPos < oldestLogPos() )
+            break;
+
+        if( rCheckpoint.m_instructionCount <= instructionCount )
+        {
+            rIndex = index - 1;
+            return &rCheckpoint;
+        }
+    }
+
+    return 0;
+}
+
+uint64_t tMCURewind::getHistoryLength( const tMCUState& rState ) const
+{
+    const tCheckpoint *pOldest = 0;
+
+    // The oldest checkpoint that still has all its log
+    for( uint64_t index = oldestCheckpoint(); index < m_checkpointEnd && !pOldest; ++index )
+    {
+        const tCheckpoint& rCheckpoint = m_checkpoints[index % m_checkpoints.size()];
+        if( rCheckpoint.m_logPos >= oldestLogPos() )
+            pOldest = &rCheckpoint;
+    }
+
+    return pOldest ? rState.m_instructionCount - pOldest->m_instructionCount : 0;
+}
+
+void tMCURewind::replayBetween( tMCUState& rState, bool wakeUp )
+{
+    while( isReplaying() )
+    {
+        const tEntry& rEntry = m_pLog[m_logEnd & m_logMask];
+        if( rEntry.m_count != static_cast<uint32_t>(rState.m_instructionCount) )
+            break;
+
+        if( rEntry.m_kind == entry_Interrupt && wakeUp )
+            rState.replayInterrupt( rEntry.m_data != 0 );
+        else if( rEntry.m_kind == entry_Idle )
+        {
+            ++m_logEnd;
+            rState.m_cycleCount += rEntry.m_address | (uint32_t(rEntry.m_data) << 16);
+            rState.fireEvents();
+        }
+        else if( rEntry.m_kind == entry_Halt && (wakeUp || rEntry.m_data != 0) )
+        {
+            ++m_logEnd;
+            rState.m_waiting = (rEntry.m_data & 1) != 0;
+            rState.m_stopped = (rEntry.m_data & 2) != 0;
+        }
+        else
+            break;
+    }
+}
+
+bool tMCURewind::stepBack( tMCUState& rState, uint64_t instructions )
+{
+    if( instructions > rState.m_instructionCount )
+        return false;
+
+    uint64_t target = rState.m_instructionCount - instructions;
+
+    uint64_t checkpointIndex;
+    const tCheckpoint *pCheckpoint = findCheckpoint( target, checkpointIndex );
+    if( !pCheckpoint )
+        return false;
+
+    // Back to the checkpoint, newest entry first.  The bytes read from the serial port go back in front of the FIFO.
+    std::vector< uint8_t > serialRead;
+    for( uint64_t logPos = m_logEnd; logPos > pCheckpoint->m_logPos; --logPos )
+    {
+        const tEntry& rEntry = m_pLog[(logPos - 1) & m_logMask];
+
+        if( rEntry.m_kind == entry_Write )
+            rState.undoWrite( rEntry.m_address, rEntry.m_data );
+        else if( rEntry.m_kind == entry_SerialRead )
+            serialRead.push_back( rEntry.m_data );
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( rState.m_serialMutex );
+
+        std::queue< uint8_t > serialToMCU;
+        for( size_t readIndex = serialRead.size(); readIndex > 0; --readIndex )
+            serialToMCU.push( serialRead[readIndex - 1] );
+        for( ; !rState.m_serialToMCUFIFO.empty(); rState.m_serialToMCUFIFO.pop() )
+            serialToMCU.push( rState.m_serialToMCUFIFO.front() );
+
+        rState.m_serialToMCUFIFO.swap( serialToMCU );
+        rState.m_serialToMCUCount = rState.m_serialToMCUFIFO.size();
+    }
+
+    static_cast< tMCURegisters& >( rState ) = pCheckpoint->m_registers;
+    rState.m_cycleCount = pCheckpoint->m_cycleCount;
+    rState.m_events = pCheckpoint->m_events;
+    rState.eventsChanged();
+    rState.m_irqLines = pCheckpoint->m_irqLines;
+    rState.m_nmiLine = pCheckpoint->m_nmiLine;
+    rState.m_nmiPending = pCheckpoint->m_nmiPending;
+    rState.m_via.restoreState( pCheckpoint->m_via, false );
+    rState.m_instructionCount = pCheckpoint->m_instructionCount;
+
+    //   No checkpoints are taken on the way forward - the ones that were taken the first time are still good up to
+    // the target, and are kept afterwards
+    uint64_t checkpointEnd = m_checkpointEnd;
+    m_logHighWater = std::max( m_logHighWater, m_logEnd );
+    m_checkpointHighWater = std::max( m_checkpointHighWater, m_checkpointEnd );
+    m_replayEnd = m_logEnd;
+    m_logEnd = pCheckpoint->m_logPos;
+    m_replayEmptyReads = 0;
+    m_checkpointEnd = checkpointIndex + 1;
+    m_nextCheckpoint = UINT64_MAX;
+
+    //   Forward again to the target, taking the interrupts and idle time logged between instructions where they
+    // were the first time
+    std::queue< uint8_t > serialFromMCU = rState.m_serialFromMCUFIFO;
+    rState.m_waiting = pCheckpoint->m_waiting;
+    rState.m_stopped = pCheckpoint->m_stopped;
+
+    while( rState.m_instructionCount < target )
+    {
+        if( rState.m_nextEventCycle <= rState.m_cycleCount )
+            rState.fireEvents();
+
+        replayBetween( rState, true );
+        rState.pcExecute();
+    }
+
+    //   Time spent waiting after the target instruction is part of it, but whatever woke the MCU up is left for run()
+    // to see again - the lines are just as they were
+    replayBetween( rState, false );
+
+    // Stopped part way through a run of empty reads - the entry is cut down to the ones done
+    if( isReplaying() && m_replayEmptyReads > 0 )
+    {
+        m_pLog[m_logEnd++ & m_logMask].m_count = m_replayEmptyReads;
+        m_emptyReadOpen = true;
+    }
+
+    m_replayEnd = 0;
+    m_replayEmptyReads = 0;
+
+    while( m_checkpointEnd < checkpointEnd )
+    {
+        const tCheckpoint& rCheckpoint = m_checkpoints[m_checkpointEnd % m_checkpoints.size()];
+        if( rCheckpoint.m_instructionCount > target || rCheckpoint.m_logPos > m_logEnd )
+            break;
+
+        ++m_checkpointEnd;
+    }
+
+    m_nextCheckpoint = m_checkpoints[(m_checkpointEnd - 1) % m_checkpoints.size()].m_instructionCount + m_checkpointInterval;
+
+    rState.m_serialFromMCUFIFO.swap( serialFromMCU );
+
+    return true;
+}
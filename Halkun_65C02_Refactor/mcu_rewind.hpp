@@ -0,0 +1,155 @@
+/*
+
+  mcu_rewind.hpp - Instruction history for stepping the MCU backwards
+
+*/
+
+#ifndef MCU_REWIND_HPP
+#define MCU_REWIND_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "mcu_core.hpp"
+
+//   Attached with tMCUState::setRewind(), this keeps a log of what memory held before each write, along with the
+// serial bytes read and the interrupts taken, and every so many instructions a checkpoint of everything else
+// (registers, cycle count, events, interrupt lines and the VIA).
+//   Going back undoes the log to the last checkpoint before the target, and then steps forward from there with
+// pcExecute() - taking the logged interrupts and serial bytes exactly where they were the first time - so it
+// costs at most a checkpoint interval of instructions however far back it goes.
+//   The log and checkpoints are rings, so the history is bounded by whichever runs out first.  Devices added with
+// addDevice() aren't rewound, and anything they return is read again from them.
+class tMCURewind
+{
+public:
+    //   Keeps the last logEntries writes, serial reads and interrupts (rounded up to a power of 2, at 8 bytes each),
+    // and the last checkpointCount checkpoints, taken every checkpointInterval instructions or so
+    tMCURewind( size_t logEntries, unsigned checkpointCount, uint64_t checkpointInterval );
+
+    //   Takes rState back instructions instructions.  Returns false, leaving it alone, if the history doesn't go
+    // back that far.  Serial output sent again on the way forward is thrown away.
+    bool stepBack( tMCUState& rState, uint64_t instructions );
+
+    // How far back stepBack() can take rState
+    uint64_t getHistoryLength( const tMCUState& rState ) const;
+
+    // Forgets everything - tMCUState calls this when its memory is changed other than by the MCU
+    void clear();
+
+private:
+    friend struct tMCUState;
+
+    enum eEntryKind
+    {
+        entry_Write,        // m_address held m_data
+        entry_SerialRead,   // The MCU read m_data from cSerialRx
+        entry_EmptyRead,    // The MCU found cSerialRx empty m_count times in a row
+        entry_Interrupt,    // An interrupt was taken before instruction m_count - NMI if m_data
+        entry_Idle,         // Before instruction m_count, m_address | m_data << 16 cycles went by in a WAI
+        entry_Halt,         // Before instruction m_count, run() left the MCU waiting if m_data & 1, and stopped if m_data & 2
+    };
+
+    struct tEntry
+    {
+        uint32_t m_count; // Instruction counts are only kept to 32 bits - the entries either side are never that far apart
+        uint16_t m_address;
+        uint8_t m_data;
+        uint8_t m_kind; // eEntryKind
+    };
+
+    struct tCheckpoint
+    {
+        uint64_t m_instructionCount;
+        uint64_t m_logPos; // m_logEnd when it was taken
+        tMCURegisters m_registers;
+        uint64_t m_cycleCount;
+        std::vector< tMCUState::tScheduledEvent > m_events;
+        uint32_t m_irqLines;
+        bool m_nmiLine;
+        bool m_nmiPending;
+        bool m_waiting;
+        bool m_stopped;
+        tMCUVia::tSavedState m_via;
+    };
+
+    tMCURewind( const tMCURewind& ); // Disallowed
+
+    // Called by tMCUState as the MCU runs
+    void recordWrite( uint16_t address, uint8_t oldData ) { record( entry_Write, address, oldData, 0 ); }
+    void recordSerialRead( uint8_t data ) { record( entry_SerialRead, 0, data, 0 ); }
+    void recordEmptyRead();
+    void recordInterrupt( uint64_t instructionCount, bool nmi ) { record( entry_Interrupt, 0, nmi ? 1 : 0, static_cast<uint32_t>(instructionCount) ); }
+    void recordIdle( uint64_t instructionCount, uint64_t cycles );
+    void recordHalt( uint64_t instructionCount, bool waiting, bool stopped ) { record( entry_Halt, 0, (waiting ? 1 : 0) | (stopped ? 2 : 0), static_cast<uint32_t>(instructionCount) ); }
+    bool isCheckpointDue( uint64_t instructionCount ) const { return instructionCount >= m_nextCheckpoint; }
+    void checkpoint( tMCUState& rState, const tMCURegisters& registers );
+    uint64_t getCheckpointInterval() const { return m_checkpointInterval; }
+
+    //   While stepBack() is going forward again, the entries are already there - recording just checks each one
+    // and moves on past it.  If the MCU does something different (say a device returns something else this
+    // time), it goes back to recording from there.
+    bool isReplaying() const { return m_logEnd < m_replayEnd; }
+
+    // While replaying, whether the MCU read a byte from cSerialRx here the first time round, rather than finding it empty
+    bool isSerialReadReplayed() const { return m_pLog[m_logEnd & m_logMask].m_kind == entry_SerialRead; }
+
+    void record( eEntryKind kind, uint16_t address, uint8_t data, uint32_t count )
+    {
+        m_emptyReadOpen = false;
+
+        if( isReplaying() )
+        {
+            if( m_pLog[m_logEnd & m_logMask].m_kind == kind )
+            {
+                ++m_logEnd;
+                return;
+            }
+
+            m_replayEnd = 0;
+        }
+
+        tEntry& rEntry = m_pLog[m_logEnd++ & m_logMask];
+        rEntry.m_count = count;
+        rEntry.m_address = address;
+        rEntry.m_data = data;
+        rEntry.m_kind = static_cast<uint8_t>(kind);
+    }
+
+    //   While replaying, takes whatever was logged between the last instruction and the next one - or, without
+    // wakeUp, only up to the MCU being woken up or taking an interrupt
+    void replayBetween( tMCUState& rState, bool wakeUp );
+
+    // The newest checkpoint at or before instructionCount whose log entries are all still there, or 0
+    const tCheckpoint *findCheckpoint( uint64_t instructionCount, uint64_t& rIndex ) const;
+    //   The oldest entry and checkpoint still in the rings.  Going back leaves newer ones in the rings past the ends,
+    // which is what the high water marks are for.
+    uint64_t oldestLogPos() const
+    {
+        uint64_t logEnd = std::max( m_logEnd, m_logHighWater );
+        return logEnd > m_logMask ? logEnd - m_logMask - 1 : 0;
+    }
+    uint64_t oldestCheckpoint() const
+    {
+        uint64_t checkpointEnd = std::max( m_checkpointEnd, m_checkpointHighWater );
+        return checkpointEnd > m_checkpoints.size() ? checkpointEnd - m_checkpoints.size() : 0;
+    }
+
+    std::vector< tEntry >       m_log;
+    tEntry                     *m_pLog; // &m_log[0]
+    uint64_t                    m_logMask; // m_log.size() - 1
+    uint64_t                    m_logEnd; // Entries ever recorded - the next one goes at m_logEnd & m_logMask
+    uint64_t                    m_logHighWater; // The furthest m_logEnd has been before going back
+    uint64_t                    m_replayEnd; // While going forward in stepBack(), m_logEnd before it went back
+    uint32_t                    m_replayEmptyReads; // Reads replayed so far from the entry_EmptyRead at m_logEnd
+    bool                        m_emptyReadOpen; // The last entry is an entry_EmptyRead that more empty reads can be added to
+    std::vector< tCheckpoint >  m_checkpoints;
+    uint64_t                    m_checkpointEnd; // Checkpoints ever taken - the next one goes at m_checkpointEnd % m_checkpoints.size()
+    uint64_t                    m_checkpointHighWater;
+    uint64_t                    m_checkpointInterval;
+    uint64_t                    m_nextCheckpoint; // Instruction count at which the next one is due
+};
+
+#endif
@@ -0,0 +1,4199 @@
+/*
+
+  mcu_rom_aot.cpp - The monitor ROM, translated by tMCUAot::generate() (main -g) - do not edit
+
+*/
+
+#include "mcu_aot.hpp"
+#include "mcu_instr.hpp"
+
+#include "mcu_6502.hpp"
+#include "mcu_65c02.hpp"
+
+static tAotResult aotBlock_E800( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE803;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE94C ); // 0xE800: JMP $e94c
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_E851( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE854;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xE851: JSR $e888
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E854( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x00FF ); // 0xE854: LDX #$ff
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x00FF ); // 0xE856: LDY #$ff
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xE858: INY
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0xE82D ); // 0xE859: LDA $e82d, Y
+    rCore.regPC = 0xE85F;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE85C: JSR $e938
+    return tAotResult( 5, 16 );
+}
+
+static tAotResult aotBlock_E858( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xE858: INY
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0xE82D ); // 0xE859: LDA $e82d, Y
+    rCore.regPC = 0xE85F;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE85C: JSR $e938
+    return tAotResult( 3, 12 );
+}
+
+static tAotResult aotBlock_E85F( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x003D ); // 0xE85F: CMP #$3d
+    rCore.regPC = 0xE863;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00F5 ); // 0xE861: BNE *-11
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E863( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xE863: INX
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0007 ); // 0xE864: CPX #$07
+    rCore.regPC = 0xE868;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x000C ); // 0xE866: BEQ *12
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_E868( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0x04E0 ); // 0xE868: LDA $04e0, X
+    rCore.regPC = 0xE86E;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE899 ); // 0xE86B: JSR $e899
+    return tAotResult( 2, 10 );
+}
+
+static tAotResult aotBlock_E86E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0000 ); // 0xE86E: CPX #$00
+    rCore.regPC = 0xE872;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00E6 ); // 0xE870: BNE *-26
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E872( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE874;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00EF ); // 0xE872: BRA *-17
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_E874( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xCA >( rCore, 0x0000 ); // 0xE874: DEX
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0x04E0 ); // 0xE875: LDA $04e0, X
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x0008 ); // 0xE878: LDX #$08
+    mcuInstructionExecuteDecoded< 0x2A >( rCore, 0x0000 ); // 0xE87A: ROL A
+    mcuInstructionExecuteDecoded< 0xA8 >( rCore, 0x0000 ); // 0xE87B: TAY
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0031 ); // 0xE87C: LDA #$31
+    rCore.regPC = 0xE880;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x0001 ); // 0xE87E: BCS *1
+    return tAotResult( 7, 16 );
+}
+
+static tAotResult aotBlock_E87A( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x2A >( rCore, 0x0000 ); // 0xE87A: ROL A
+    mcuInstructionExecuteDecoded< 0xA8 >( rCore, 0x0000 ); // 0xE87B: TAY
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0031 ); // 0xE87C: LDA #$31
+    rCore.regPC = 0xE880;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x0001 ); // 0xE87E: BCS *1
+    return tAotResult( 4, 8 );
+}
+
+static tAotResult aotBlock_E880( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x3A >( rCore, 0x0000 ); // 0xE880: DEC A
+    rCore.regPC = 0xE884;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE881: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_E881( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE884;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE881: JSR $e938
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E884( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x98 >( rCore, 0x0000 ); // 0xE884: TYA
+    mcuInstructionExecuteDecoded< 0xCA >( rCore, 0x0000 ); // 0xE885: DEX
+    rCore.regPC = 0xE888;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00F2 ); // 0xE886: BNE *-14
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_E888( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xE888: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE889; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x000D ); // 0xE889: LDA #$0d
+    rCore.regPC = 0xE88E;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE88B: JSR $e938
+    return tAotResult( 3, 11 );
+}
+
+static tAotResult aotBlock_E88E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x000A ); // 0xE88E: LDA #$0a
+    rCore.regPC = 0xE893;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE890: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_E893( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x68 >( rCore, 0x0000 ); // 0xE893: PLA
+    rCore.regPC = 0xE895;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE894: RTS
+    return tAotResult( 2, 10 );
+}
+
+static tAotResult aotBlock_E895( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE898;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE899 ); // 0xE895: JSR $e899
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E898( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xE898: TXA
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xE899: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE89A; return tAotResult( 2, 5 ); }
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xE89A: LSR A
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xE89B: LSR A
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xE89C: LSR A
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xE89D: LSR A
+    rCore.regPC = 0xE8A1;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8A2 ); // 0xE89E: JSR $e8a2
+    return tAotResult( 7, 19 );
+}
+
+static tAotResult aotBlock_E899( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xE899: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE89A; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xE89A: LSR A
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xE89B: LSR A
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xE89C: LSR A
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xE89D: LSR A
+    rCore.regPC = 0xE8A1;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8A2 ); // 0xE89E: JSR $e8a2
+    return tAotResult( 6, 17 );
+}
+
+static tAotResult aotBlock_E8A1( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x68 >( rCore, 0x0000 ); // 0xE8A1: PLA
+    mcuInstructionExecuteDecoded< 0x5A >( rCore, 0x0000 ); // 0xE8A2: PHY
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE8A3; return tAotResult( 2, 7 ); }
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x000F ); // 0xE8A3: AND #$0f
+    mcuInstructionExecuteDecoded< 0xA8 >( rCore, 0x0000 ); // 0xE8A5: TAY
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0xF014 ); // 0xE8A6: LDA $f014, Y
+    mcuInstructionExecuteDecoded< 0x7A >( rCore, 0x0000 ); // 0xE8A9: PLY
+    rCore.regPC = 0xE8AD;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE938 ); // 0xE8AA: JMP $e938
+    return tAotResult( 7, 22 );
+}
+
+static tAotResult aotBlock_E8A2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x5A >( rCore, 0x0000 ); // 0xE8A2: PHY
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE8A3; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x000F ); // 0xE8A3: AND #$0f
+    mcuInstructionExecuteDecoded< 0xA8 >( rCore, 0x0000 ); // 0xE8A5: TAY
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0xF014 ); // 0xE8A6: LDA $f014, Y
+    mcuInstructionExecuteDecoded< 0x7A >( rCore, 0x0000 ); // 0xE8A9: PLY
+    rCore.regPC = 0xE8AD;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE938 ); // 0xE8AA: JMP $e938
+    return tAotResult( 6, 18 );
+}
+
+static tAotResult aotBlock_E8AD( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE8B0;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8B9 ); // 0xE8AD: JSR $e8b9
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E8B0( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xCA >( rCore, 0x0000 ); // 0xE8B0: DEX
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0000 ); // 0xE8B1: CPX #$00
+    rCore.regPC = 0xE8B5;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00F8 ); // 0xE8B3: BNE *-8
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_E8B1( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0000 ); // 0xE8B1: CPX #$00
+    rCore.regPC = 0xE8B5;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00F8 ); // 0xE8B3: BNE *-8
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E8B5( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE8B6;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE8B5: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E8B6( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE8B9;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8B9 ); // 0xE8B6: JSR $e8b9
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E8B9( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0020 ); // 0xE8B9: LDA #$20
+    rCore.regPC = 0xE8BE;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE938 ); // 0xE8BB: JMP $e938
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_E8BE( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0021 ); // 0xE8BE: LDA #$21
+    mcuInstructionExecuteDecoded< 0x2C >( rCore, 0x3EA9 ); // 0xE8C0: BIT $3ea9
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0032 ); // 0xE8C3: STA $32
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE8C5; return tAotResult( 3, 9 ); }
+    rCore.regPC = 0xE8C8;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xE8C5: JSR $e888
+    return tAotResult( 4, 15 );
+}
+
+static tAotResult aotBlock_E8C1( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x003E ); // 0xE8C1: LDA #$3e
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0032 ); // 0xE8C3: STA $32
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE8C5; return tAotResult( 2, 5 ); }
+    rCore.regPC = 0xE8C8;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xE8C5: JSR $e888
+    return tAotResult( 3, 11 );
+}
+
+static tAotResult aotBlock_E8C5( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE8C8;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xE8C5: JSR $e888
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E8C8( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0032 ); // 0xE8C8: LDA $32
+    rCore.regPC = 0xE8CD;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE8CA: JSR $e938
+    return tAotResult( 2, 9 );
+}
+
+static tAotResult aotBlock_E8CD( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x00FF ); // 0xE8CD: LDY #$ff
+    rCore.regPC = 0xE8D2;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE92E ); // 0xE8CF: JSR $e92e
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_E8CF( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE8D2;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE92E ); // 0xE8CF: JSR $e92e
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E8D2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0020 ); // 0xE8D2: CMP #$20
+    rCore.regPC = 0xE8D6;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x003D ); // 0xE8D4: BCS *61
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E8D6( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x000D ); // 0xE8D6: CMP #$0d
+    rCore.regPC = 0xE8DA;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x004A ); // 0xE8D8: BEQ *74
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E8DA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x001B ); // 0xE8DA: CMP #$1b
+    rCore.regPC = 0xE8DE;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00E7 ); // 0xE8DC: BEQ *-25
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E8DE( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0008 ); // 0xE8DE: CMP #$08
+    rCore.regPC = 0xE8E2;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0009 ); // 0xE8E0: BEQ *9
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E8E2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0009 ); // 0xE8E2: CMP #$09
+    rCore.regPC = 0xE8E6;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x001B ); // 0xE8E4: BEQ *27
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E8E6( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0002 ); // 0xE8E6: CMP #$02
+    rCore.regPC = 0xE8EA;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00E5 ); // 0xE8E8: BNE *-27
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E8EB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC0 >( rCore, 0x00FF ); // 0xE8EB: CPY #$ff
+    rCore.regPC = 0xE8EF;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00E0 ); // 0xE8ED: BEQ *-32
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E8EF( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x88 >( rCore, 0x0000 ); // 0xE8EF: DEY
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0008 ); // 0xE8F0: LDA #$08
+    rCore.regPC = 0xE8F5;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE8F2: JSR $e938
+    return tAotResult( 3, 10 );
+}
+
+static tAotResult aotBlock_E8F5( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0020 ); // 0xE8F5: LDA #$20
+    rCore.regPC = 0xE8FA;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE8F7: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_E8FA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0008 ); // 0xE8FA: LDA #$08
+    rCore.regPC = 0xE8FF;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE8FC: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_E8FF( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE901;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00CE ); // 0xE8FF: BRA *-50
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_E901( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0020 ); // 0xE901: LDA #$20
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xE903: INY
+    rCore.regPC = 0xE906;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x001F ); // 0xE904: BMI *31
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_E906( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x99 >( rCore, 0x0400 ); // 0xE906: STA $0400, Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE909; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xE90C;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE909: JSR $e938
+    return tAotResult( 2, 11 );
+}
+
+static tAotResult aotBlock_E90C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x98 >( rCore, 0x0000 ); // 0xE90C: TYA
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x0007 ); // 0xE90D: AND #$07
+    rCore.regPC = 0xE911;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00F0 ); // 0xE90F: BNE *-16
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_E911( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE913;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00BC ); // 0xE911: BRA *-68
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_E913( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0061 ); // 0xE913: CMP #$61
+    rCore.regPC = 0xE917;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x0002 ); // 0xE915: BCC *2
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E917( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE9 >( rCore, 0x0020 ); // 0xE917: SBC #$20
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xE919: INY
+    rCore.regPC = 0xE91C;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x0009 ); // 0xE91A: BMI *9
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_E919( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xE919: INY
+    rCore.regPC = 0xE91C;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x0009 ); // 0xE91A: BMI *9
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E91C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x99 >( rCore, 0x0400 ); // 0xE91C: STA $0400, Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE91F; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xE922;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE91F: JSR $e938
+    return tAotResult( 2, 11 );
+}
+
+static tAotResult aotBlock_E922( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE924;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00AB ); // 0xE922: BRA *-85
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_E924( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xE924: INY
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x000D ); // 0xE925: LDA #$0d
+    mcuInstructionExecuteDecoded< 0x99 >( rCore, 0x0400 ); // 0xE927: STA $0400, Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE92A; return tAotResult( 3, 9 ); }
+    rCore.regPC = 0xE92D;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE92A: JSR $e938
+    return tAotResult( 4, 15 );
+}
+
+static tAotResult aotBlock_E925( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x000D ); // 0xE925: LDA #$0d
+    mcuInstructionExecuteDecoded< 0x99 >( rCore, 0x0400 ); // 0xE927: STA $0400, Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE92A; return tAotResult( 2, 7 ); }
+    rCore.regPC = 0xE92D;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE92A: JSR $e938
+    return tAotResult( 3, 13 );
+}
+
+static tAotResult aotBlock_E92D( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE92E;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE92D: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E92E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xAD >( rCore, 0x0303 ); // 0xE92E: LDA $0303
+    rCore.regPC = 0xE933;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00FB ); // 0xE931: BEQ *-5
+    return tAotResult( 2, 6 );
+}
+
+static tAotResult aotBlock_E933( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE934;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE933: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E934( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xAD >( rCore, 0x0303 ); // 0xE934: LDA $0303
+    rCore.regPC = 0xE938;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE937: RTS
+    return tAotResult( 2, 10 );
+}
+
+static tAotResult aotBlock_E938( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x8D >( rCore, 0x0302 ); // 0xE938: STA $0302
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE93B; return tAotResult( 1, 4 ); }
+    rCore.regPC = 0xE93C;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE93B: RTS
+    return tAotResult( 2, 10 );
+}
+
+static tAotResult aotBlock_E93C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0007 ); // 0xE93C: LDA #$07
+    rCore.regPC = 0xE941;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE93E: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_E941( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE942;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE941: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E94C( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE94F;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE93C ); // 0xE94C: JSR $e93c
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E94F( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE952;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE9CF ); // 0xE94F: JSR $e9cf
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E952( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x00FF ); // 0xE952: LDX #$ff
+    mcuInstructionExecuteDecoded< 0x9A >( rCore, 0x0000 ); // 0xE954: TXS
+    rCore.regPC = 0xE958;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8C1 ); // 0xE955: JSR $e8c1
+    return tAotResult( 3, 10 );
+}
+
+static tAotResult aotBlock_E958( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0000 ); // 0xE958: LDA #$00
+    mcuInstructionExecuteDecoded< 0xA8 >( rCore, 0x0000 ); // 0xE95A: TAY
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0033 ); // 0xE95B: STA $33
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE95D; return tAotResult( 3, 7 ); }
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0037 ); // 0xE95D: STA $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE95F; return tAotResult( 4, 10 ); }
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x003C ); // 0xE95F: STZ $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE961; return tAotResult( 5, 13 ); }
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x003D ); // 0xE961: STZ $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE963; return tAotResult( 6, 16 ); }
+    rCore.regPC = 0xE966;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xE963: JSR $e988
+    return tAotResult( 7, 22 );
+}
+
+static tAotResult aotBlock_E95D( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0037 ); // 0xE95D: STA $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE95F; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x003C ); // 0xE95F: STZ $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE961; return tAotResult( 2, 6 ); }
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x003D ); // 0xE961: STZ $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE963; return tAotResult( 3, 9 ); }
+    rCore.regPC = 0xE966;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xE963: JSR $e988
+    return tAotResult( 4, 15 );
+}
+
+static tAotResult aotBlock_E95F( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x003C ); // 0xE95F: STZ $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE961; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x003D ); // 0xE961: STZ $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE963; return tAotResult( 2, 6 ); }
+    rCore.regPC = 0xE966;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xE963: JSR $e988
+    return tAotResult( 3, 12 );
+}
+
+static tAotResult aotBlock_E966( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x0011 ); // 0xE966: LDX #$11
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF024 ); // 0xE968: CMP $f024, X
+    rCore.regPC = 0xE96D;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0005 ); // 0xE96B: BEQ *5
+    return tAotResult( 3, 8 );
+}
+
+static tAotResult aotBlock_E968( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF024 ); // 0xE968: CMP $f024, X
+    rCore.regPC = 0xE96D;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0005 ); // 0xE96B: BEQ *5
+    return tAotResult( 2, 6 );
+}
+
+static tAotResult aotBlock_E96D( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xCA >( rCore, 0x0000 ); // 0xE96D: DEX
+    rCore.regPC = 0xE970;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x00F8 ); // 0xE96E: BPL *-8
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E970( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE972;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00E0 ); // 0xE970: BRA *-32
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_E972( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xDA >( rCore, 0x0000 ); // 0xE972: PHX
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE973; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0x5A >( rCore, 0x0000 ); // 0xE973: PHY
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE974; return tAotResult( 2, 6 ); }
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xE974: TXA
+    mcuInstructionExecuteDecoded< 0x0A >( rCore, 0x0000 ); // 0xE975: ASL A
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xE976: TAX
+    rCore.regPC = 0xE97A;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE985 ); // 0xE977: JSR $e985
+    return tAotResult( 6, 18 );
+}
+
+static tAotResult aotBlock_E97A( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x7A >( rCore, 0x0000 ); // 0xE97A: PLY
+    mcuInstructionExecuteDecoded< 0xFA >( rCore, 0x0000 ); // 0xE97B: PLX
+    rCore.regPC = 0xE97E;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00D4 ); // 0xE97C: BEQ *-44
+    return tAotResult( 3, 10 );
+}
+
+static tAotResult aotBlock_E97E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF05A ); // 0xE97E: LDA $f05a, X
+    rCore.regPC = 0xE983;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x00DC ); // 0xE981: BMI *-36
+    return tAotResult( 2, 6 );
+}
+
+static tAotResult aotBlock_E983( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE985;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00D8 ); // 0xE983: BRA *-40
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_E985( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE988;
+    mcuInstructionExecuteDecoded< 0x7C >( rCore, 0xF036 ); // 0xE985: JMP ($f036, X)
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E988( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x0035 ); // 0xE988: STZ $35
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE98A; return tAotResult( 1, 3 ); }
+    rCore.regPC = 0xE98C;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x0016 ); // 0xE98A: BRA *22
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_E98C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xE98C: TXA
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x0004 ); // 0xE98D: LDX #$04
+    mcuInstructionExecuteDecoded< 0x06 >( rCore, 0x003C ); // 0xE98F: ASL $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE991; return tAotResult( 3, 9 ); }
+    mcuInstructionExecuteDecoded< 0x26 >( rCore, 0x003D ); // 0xE991: ROL $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE993; return tAotResult( 4, 14 ); }
+    mcuInstructionExecuteDecoded< 0xCA >( rCore, 0x0000 ); // 0xE993: DEX
+    rCore.regPC = 0xE996;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00F9 ); // 0xE994: BNE *-7
+    return tAotResult( 6, 18 );
+}
+
+static tAotResult aotBlock_E98F( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x06 >( rCore, 0x003C ); // 0xE98F: ASL $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE991; return tAotResult( 1, 5 ); }
+    mcuInstructionExecuteDecoded< 0x26 >( rCore, 0x003D ); // 0xE991: ROL $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE993; return tAotResult( 2, 10 ); }
+    mcuInstructionExecuteDecoded< 0xCA >( rCore, 0x0000 ); // 0xE993: DEX
+    rCore.regPC = 0xE996;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00F9 ); // 0xE994: BNE *-7
+    return tAotResult( 4, 14 );
+}
+
+static tAotResult aotBlock_E996( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x24 >( rCore, 0x003C ); // 0xE996: BIT $3c
+    mcuInstructionExecuteDecoded< 0x08 >( rCore, 0x0000 ); // 0xE998: PHP
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE999; return tAotResult( 2, 6 ); }
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xE999: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE99A; return tAotResult( 3, 9 ); }
+    mcuInstructionExecuteDecoded< 0x05 >( rCore, 0x003C ); // 0xE99A: ORA $3c
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003C ); // 0xE99C: STA $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE99E; return tAotResult( 5, 15 ); }
+    mcuInstructionExecuteDecoded< 0x68 >( rCore, 0x0000 ); // 0xE99E: PLA
+    mcuInstructionExecuteDecoded< 0x28 >( rCore, 0x0000 ); // 0xE99F: PLP
+    mcuInstructionExecuteDecoded< 0xC6 >( rCore, 0x0035 ); // 0xE9A0: DEC $35
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE9A2; return tAotResult( 8, 28 ); }
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0x0400 ); // 0xE9A2: LDA $0400, Y
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x000F ); // 0xE9A5: LDX #$0f
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xE9A7: INY
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF014 ); // 0xE9A8: CMP $f014, X
+    rCore.regPC = 0xE9AD;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00DF ); // 0xE9AB: BEQ *-33
+    return tAotResult( 13, 42 );
+}
+
+static tAotResult aotBlock_E9A2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0x0400 ); // 0xE9A2: LDA $0400, Y
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x000F ); // 0xE9A5: LDX #$0f
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xE9A7: INY
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF014 ); // 0xE9A8: CMP $f014, X
+    rCore.regPC = 0xE9AD;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00DF ); // 0xE9AB: BEQ *-33
+    return tAotResult( 5, 14 );
+}
+
+static tAotResult aotBlock_E9A8( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF014 ); // 0xE9A8: CMP $f014, X
+    rCore.regPC = 0xE9AD;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00DF ); // 0xE9AB: BEQ *-33
+    return tAotResult( 2, 6 );
+}
+
+static tAotResult aotBlock_E9AD( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xCA >( rCore, 0x0000 ); // 0xE9AD: DEX
+    rCore.regPC = 0xE9B0;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x00F8 ); // 0xE9AE: BPL *-8
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E9B0( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE9B1;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE9B0: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E9B1( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x008A ); // 0xE9B1: LDA #$8a
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003A ); // 0xE9B3: STA $3a
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE9B5; return tAotResult( 2, 5 ); }
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x00F3 ); // 0xE9B5: LDA #$f3
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003B ); // 0xE9B7: STA $3b
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE9B9; return tAotResult( 4, 10 ); }
+    rCore.regPC = 0xE9BB;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x000F ); // 0xE9B9: BRA *15
+    return tAotResult( 5, 12 );
+}
+
+static tAotResult aotBlock_E9BB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x007E ); // 0xE9BB: CMP #$7e
+    rCore.regPC = 0xE9BF;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0005 ); // 0xE9BD: BEQ *5
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E9BF( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE9C2;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE9BF: JSR $e938
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E9C2( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE9C4;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x0003 ); // 0xE9C2: BRA *3
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_E9C4( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE9C7;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xE9C4: JSR $e888
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E9C7( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE9CA;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEA81 ); // 0xE9C7: JSR $ea81
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E9CA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB2 >( rCore, 0x003A ); // 0xE9CA: LDA ($3a)
+    rCore.regPC = 0xE9CE;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00ED ); // 0xE9CC: BNE *-19
+    return tAotResult( 2, 7 );
+}
+
+static tAotResult aotBlock_E9CE( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE9CF;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE9CE: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E9CF( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE9D2;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xE9CF: JSR $e888
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E9D2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x00FF ); // 0xE9D2: LDX #$ff
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x000D ); // 0xE9D4: LDA #$0d
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xE9D6: INX
+    rCore.regPC = 0xE9DA;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE9D7: JSR $e938
+    return tAotResult( 4, 12 );
+}
+
+static tAotResult aotBlock_E9D6( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xE9D6: INX
+    rCore.regPC = 0xE9DA;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xE9D7: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_E9DA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF974 ); // 0xE9DA: LDA $f974, X
+    rCore.regPC = 0xE9DF;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00F7 ); // 0xE9DD: BNE *-9
+    return tAotResult( 2, 6 );
+}
+
+static tAotResult aotBlock_E9DF( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE9E0;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE9DF: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E9E0( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE9E3;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE9E9 ); // 0xE9E0: JSR $e9e9
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E9E3( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x00FF ); // 0xE9E3: LDX #$ff
+    mcuInstructionExecuteDecoded< 0x9A >( rCore, 0x0000 ); // 0xE9E5: TXS
+    rCore.regPC = 0xE9E9;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE952 ); // 0xE9E6: JMP $e952
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_E9E9( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xE9EC;
+    mcuInstructionExecuteDecoded< 0x6C >( rCore, 0x003C ); // 0xE9E9: JMP ($003c)
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_E9EC( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x003C ); // 0xE9EC: LDX $3c
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003D ); // 0xE9EE: LDA $3d
+    mcuInstructionExecuteDecoded< 0x86 >( rCore, 0x003A ); // 0xE9F0: STX $3a
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE9F2; return tAotResult( 3, 9 ); }
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003B ); // 0xE9F2: STA $3b
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE9F4; return tAotResult( 4, 12 ); }
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x0033 ); // 0xE9F4: INC $33
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xE9F6; return tAotResult( 5, 17 ); }
+    rCore.regPC = 0xE9F7;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xE9F6: RTS
+    return tAotResult( 6, 23 );
+}
+
+static tAotResult aotBlock_E9F7( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC0 >( rCore, 0x0001 ); // 0xE9F7: CPY #$01
+    rCore.regPC = 0xE9FB;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x000C ); // 0xE9F9: BNE *12
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_E9FB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003A ); // 0xE9FB: LDA $3a
+    mcuInstructionExecuteDecoded< 0x09 >( rCore, 0x000F ); // 0xE9FD: ORA #$0f
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003C ); // 0xE9FF: STA $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEA01; return tAotResult( 3, 8 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003B ); // 0xEA01: LDA $3b
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003D ); // 0xEA03: STA $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEA05; return tAotResult( 5, 14 ); }
+    rCore.regPC = 0xEA07;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x0017 ); // 0xEA05: BRA *23
+    return tAotResult( 6, 16 );
+}
+
+static tAotResult aotBlock_EA07( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0035 ); // 0xEA07: LDA $35
+    rCore.regPC = 0xEA0B;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x005A ); // 0xEA09: BEQ *90
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EA0B( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0037 ); // 0xEA0B: LDX $37
+    rCore.regPC = 0xEA0F;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x000A ); // 0xEA0D: BEQ *10
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EA0F( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xCA >( rCore, 0x0000 ); // 0xEA0F: DEX
+    rCore.regPC = 0xEA12;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x001C ); // 0xEA10: BEQ *28
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EA12( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003C ); // 0xEA12: LDA $3c
+    mcuInstructionExecuteDecoded< 0x92 >( rCore, 0x003A ); // 0xEA14: STA ($3a)
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEA16; return tAotResult( 2, 8 ); }
+    rCore.regPC = 0xEA19;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEA81 ); // 0xEA16: JMP $ea81
+    return tAotResult( 3, 11 );
+}
+
+static tAotResult aotBlock_EA19( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA1C;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE9EC ); // 0xEA19: JSR $e9ec
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EA1C( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA1E;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x0010 ); // 0xEA1C: BRA *16
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EA1E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003A ); // 0xEA1E: LDA $3a
+    mcuInstructionExecuteDecoded< 0x89 >( rCore, 0x000F ); // 0xEA20: BIT #$0f
+    rCore.regPC = 0xEA24;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x000A ); // 0xEA22: BEQ *10
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EA24( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC0 >( rCore, 0x0000 ); // 0xEA24: CPY #$00
+    rCore.regPC = 0xEA28;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0046 ); // 0xEA26: BEQ *70
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EA28( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x89 >( rCore, 0x0007 ); // 0xEA28: BIT #$07
+    rCore.regPC = 0xEA2C;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0011 ); // 0xEA2A: BEQ *17
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EA2C( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA2E;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x0019 ); // 0xEA2C: BRA *25
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EA2E( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA31;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xEA2E: JSR $e888
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EA31( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA34;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE934 ); // 0xEA31: JSR $e934
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EA34( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA36;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x002D ); // 0xEA34: BCS *45
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EA36( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003B ); // 0xEA36: LDA $3b
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x003A ); // 0xEA38: LDX $3a
+    rCore.regPC = 0xEA3D;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE895 ); // 0xEA3A: JSR $e895
+    return tAotResult( 3, 12 );
+}
+
+static tAotResult aotBlock_EA3D( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0020 ); // 0xEA3D: LDA #$20
+    rCore.regPC = 0xEA42;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEA3F: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EA42( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x002D ); // 0xEA42: LDA #$2d
+    rCore.regPC = 0xEA47;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEA44: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EA47( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0020 ); // 0xEA47: LDA #$20
+    rCore.regPC = 0xEA4C;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEA49: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EA4C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC0 >( rCore, 0x0000 ); // 0xEA4C: CPY #$00
+    rCore.regPC = 0xEA50;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x001E ); // 0xEA4E: BEQ *30
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EA50( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB2 >( rCore, 0x003A ); // 0xEA50: LDA ($3a)
+    rCore.regPC = 0xEA55;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE899 ); // 0xEA52: JSR $e899
+    return tAotResult( 2, 11 );
+}
+
+static tAotResult aotBlock_EA55( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEA55: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003A ); // 0xEA56: LDA $3a
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003C ); // 0xEA58: SBC $3c
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003B ); // 0xEA5A: LDA $3b
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003D ); // 0xEA5C: SBC $3d
+    rCore.regPC = 0xEA61;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEA81 ); // 0xEA5E: JSR $ea81
+    return tAotResult( 6, 20 );
+}
+
+static tAotResult aotBlock_EA61( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA63;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x00BB ); // 0xEA61: BCC *-69
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EA63( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x0037 ); // 0xEA63: STZ $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEA65; return tAotResult( 1, 3 ); }
+    rCore.regPC = 0xEA66;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEA65: RTS
+    return tAotResult( 2, 9 );
+}
+
+static tAotResult aotBlock_EA65( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA66;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEA65: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EA66( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x5A >( rCore, 0x0000 ); // 0xEA66: PHY
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEA67; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0000 ); // 0xEA67: LDY #$00
+    rCore.regPC = 0xEA6C;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEA07 ); // 0xEA69: JSR $ea07
+    return tAotResult( 3, 11 );
+}
+
+static tAotResult aotBlock_EA6C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x7A >( rCore, 0x0000 ); // 0xEA6C: PLY
+    rCore.regPC = 0xEA6E;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEA6D: RTS
+    return tAotResult( 2, 10 );
+}
+
+static tAotResult aotBlock_EA6E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB2 >( rCore, 0x003A ); // 0xEA6E: LDA ($3a)
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x007F ); // 0xEA70: AND #$7f
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x007F ); // 0xEA72: CMP #$7f
+    rCore.regPC = 0xEA76;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0004 ); // 0xEA74: BEQ *4
+    return tAotResult( 4, 11 );
+}
+
+static tAotResult aotBlock_EA76( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0020 ); // 0xEA76: CMP #$20
+    rCore.regPC = 0xEA7A;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x0002 ); // 0xEA78: BCS *2
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EA7A( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x002E ); // 0xEA7A: LDA #$2e
+    rCore.regPC = 0xEA7F;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEA7C: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EA7C( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA7F;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEA7C: JSR $e938
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EA7F( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA81;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00D4 ); // 0xEA7F: BRA *-44
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EA81( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x003A ); // 0xEA81: INC $3a
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEA83; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xEA85;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0002 ); // 0xEA83: BNE *2
+    return tAotResult( 2, 7 );
+}
+
+static tAotResult aotBlock_EA85( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x003B ); // 0xEA85: INC $3b
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEA87; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xEA88;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEA87: RTS
+    return tAotResult( 2, 11 );
+}
+
+static tAotResult aotBlock_EA87( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEA88;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEA87: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EA88( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0033 ); // 0xEA88: LDA $33
+    rCore.regPC = 0xEA8C;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x003E ); // 0xEA8A: BEQ *62
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EA8C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEA8C: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003C ); // 0xEA8D: LDA $3c
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003A ); // 0xEA8F: SBC $3a
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xEA91: TAX
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003D ); // 0xEA92: LDA $3d
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003B ); // 0xEA94: SBC $3b
+    mcuInstructionExecuteDecoded< 0xA8 >( rCore, 0x0000 ); // 0xEA96: TAY
+    rCore.regPC = 0xEA99;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x0031 ); // 0xEA97: BCC *49
+    return tAotResult( 8, 20 );
+}
+
+static tAotResult aotBlock_EA99( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x18 >( rCore, 0x0000 ); // 0xEA99: CLC
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xEA9A: TXA
+    mcuInstructionExecuteDecoded< 0x65 >( rCore, 0x003E ); // 0xEA9B: ADC $3e
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003C ); // 0xEA9D: STA $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEA9F; return tAotResult( 4, 10 ); }
+    mcuInstructionExecuteDecoded< 0x98 >( rCore, 0x0000 ); // 0xEA9F: TYA
+    mcuInstructionExecuteDecoded< 0x65 >( rCore, 0x003F ); // 0xEAA0: ADC $3f
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003D ); // 0xEAA2: STA $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAA4; return tAotResult( 7, 18 ); }
+    mcuInstructionExecuteDecoded< 0xB2 >( rCore, 0x003E ); // 0xEAA4: LDA ($3e)
+    mcuInstructionExecuteDecoded< 0x92 >( rCore, 0x003C ); // 0xEAA6: STA ($3c)
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAA8; return tAotResult( 9, 28 ); }
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x00FF ); // 0xEAA8: LDA #$ff
+    mcuInstructionExecuteDecoded< 0xC6 >( rCore, 0x003C ); // 0xEAAA: DEC $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAAC; return tAotResult( 11, 35 ); }
+    mcuInstructionExecuteDecoded< 0xC5 >( rCore, 0x003C ); // 0xEAAC: CMP $3c
+    rCore.regPC = 0xEAB0;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0002 ); // 0xEAAE: BNE *2
+    return tAotResult( 13, 40 );
+}
+
+static tAotResult aotBlock_EAA4( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB2 >( rCore, 0x003E ); // 0xEAA4: LDA ($3e)
+    mcuInstructionExecuteDecoded< 0x92 >( rCore, 0x003C ); // 0xEAA6: STA ($3c)
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAA8; return tAotResult( 2, 10 ); }
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x00FF ); // 0xEAA8: LDA #$ff
+    mcuInstructionExecuteDecoded< 0xC6 >( rCore, 0x003C ); // 0xEAAA: DEC $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAAC; return tAotResult( 4, 17 ); }
+    mcuInstructionExecuteDecoded< 0xC5 >( rCore, 0x003C ); // 0xEAAC: CMP $3c
+    rCore.regPC = 0xEAB0;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0002 ); // 0xEAAE: BNE *2
+    return tAotResult( 6, 22 );
+}
+
+static tAotResult aotBlock_EAB0( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC6 >( rCore, 0x003D ); // 0xEAB0: DEC $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAB2; return tAotResult( 1, 5 ); }
+    mcuInstructionExecuteDecoded< 0xC6 >( rCore, 0x003E ); // 0xEAB2: DEC $3e
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAB4; return tAotResult( 2, 10 ); }
+    mcuInstructionExecuteDecoded< 0xC5 >( rCore, 0x003E ); // 0xEAB4: CMP $3e
+    rCore.regPC = 0xEAB8;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0002 ); // 0xEAB6: BNE *2
+    return tAotResult( 4, 15 );
+}
+
+static tAotResult aotBlock_EAB2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC6 >( rCore, 0x003E ); // 0xEAB2: DEC $3e
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAB4; return tAotResult( 1, 5 ); }
+    mcuInstructionExecuteDecoded< 0xC5 >( rCore, 0x003E ); // 0xEAB4: CMP $3e
+    rCore.regPC = 0xEAB8;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0002 ); // 0xEAB6: BNE *2
+    return tAotResult( 3, 10 );
+}
+
+static tAotResult aotBlock_EAB8( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC6 >( rCore, 0x003F ); // 0xEAB8: DEC $3f
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEABA; return tAotResult( 1, 5 ); }
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEABA: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003E ); // 0xEABB: LDA $3e
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003A ); // 0xEABD: SBC $3a
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003F ); // 0xEABF: LDA $3f
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003B ); // 0xEAC1: SBC $3b
+    rCore.regPC = 0xEAC5;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x0005 ); // 0xEAC3: BCC *5
+    return tAotResult( 7, 21 );
+}
+
+static tAotResult aotBlock_EABA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEABA: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003E ); // 0xEABB: LDA $3e
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003A ); // 0xEABD: SBC $3a
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003F ); // 0xEABF: LDA $3f
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003B ); // 0xEAC1: SBC $3b
+    rCore.regPC = 0xEAC5;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x0005 ); // 0xEAC3: BCC *5
+    return tAotResult( 6, 16 );
+}
+
+static tAotResult aotBlock_EAC5( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEAC8;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE934 ); // 0xEAC5: JSR $e934
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EAC8( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEACA;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x00DA ); // 0xEAC8: BCC *-38
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EACA( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEACB;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEACA: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EACB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0033 ); // 0xEACB: LDA $33
+    rCore.regPC = 0xEACF;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x000D ); // 0xEACD: BNE *13
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EACF( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEAD0;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEACF: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EAD0( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x003A ); // 0xEAD0: INC $3a
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAD2; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xEAD4;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0002 ); // 0xEAD2: BNE *2
+    return tAotResult( 2, 7 );
+}
+
+static tAotResult aotBlock_EAD4( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x003B ); // 0xEAD4: INC $3b
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAD6; return tAotResult( 1, 5 ); }
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x003C ); // 0xEAD6: INC $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAD8; return tAotResult( 2, 10 ); }
+    rCore.regPC = 0xEADA;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0002 ); // 0xEAD8: BNE *2
+    return tAotResult( 3, 12 );
+}
+
+static tAotResult aotBlock_EAD6( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x003C ); // 0xEAD6: INC $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAD8; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xEADA;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0002 ); // 0xEAD8: BNE *2
+    return tAotResult( 2, 7 );
+}
+
+static tAotResult aotBlock_EADA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x003D ); // 0xEADA: INC $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEADC; return tAotResult( 1, 5 ); }
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEADC: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003E ); // 0xEADD: LDA $3e
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003A ); // 0xEADF: SBC $3a
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003F ); // 0xEAE1: LDA $3f
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003B ); // 0xEAE3: SBC $3b
+    rCore.regPC = 0xEAE7;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x00E8 ); // 0xEAE5: BCC *-24
+    return tAotResult( 7, 21 );
+}
+
+static tAotResult aotBlock_EADC( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEADC: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003E ); // 0xEADD: LDA $3e
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003A ); // 0xEADF: SBC $3a
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003F ); // 0xEAE1: LDA $3f
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003B ); // 0xEAE3: SBC $3b
+    rCore.regPC = 0xEAE7;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x00E8 ); // 0xEAE5: BCC *-24
+    return tAotResult( 6, 16 );
+}
+
+static tAotResult aotBlock_EAE7( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEAEA;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE934 ); // 0xEAE7: JSR $e934
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EAEA( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEAEC;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x00E3 ); // 0xEAEA: BCS *-29
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EAEC( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB2 >( rCore, 0x003A ); // 0xEAEC: LDA ($3a)
+    mcuInstructionExecuteDecoded< 0x92 >( rCore, 0x003C ); // 0xEAEE: STA ($3c)
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEAF0; return tAotResult( 2, 10 ); }
+    rCore.regPC = 0xEAF2;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00DE ); // 0xEAF0: BRA *-34
+    return tAotResult( 3, 12 );
+}
+
+static tAotResult aotBlock_EB32( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x003C ); // 0xEB32: LDX $3c
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003D ); // 0xEB34: LDA $3d
+    mcuInstructionExecuteDecoded< 0x86 >( rCore, 0x003E ); // 0xEB36: STX $3e
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB38; return tAotResult( 3, 9 ); }
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003F ); // 0xEB38: STA $3f
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB3A; return tAotResult( 4, 12 ); }
+    rCore.regPC = 0xEB3B;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEB3A: RTS
+    return tAotResult( 5, 18 );
+}
+
+static tAotResult aotBlock_EB3B( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0033 ); // 0xEB3B: LDA $33
+    rCore.regPC = 0xEB3F;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0029 ); // 0xEB3D: BEQ *41
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EB3F( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003A ); // 0xEB3F: LDA $3a
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x003B ); // 0xEB41: LDX $3b
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0038 ); // 0xEB43: STA $38
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB45; return tAotResult( 3, 9 ); }
+    mcuInstructionExecuteDecoded< 0x86 >( rCore, 0x0039 ); // 0xEB45: STX $39
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB47; return tAotResult( 4, 12 ); }
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEB47: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0038 ); // 0xEB48: LDA $38
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003A ); // 0xEB4A: SBC $3a
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0039 ); // 0xEB4C: LDA $39
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003B ); // 0xEB4E: SBC $3b
+    rCore.regPC = 0xEB52;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x0015 ); // 0xEB50: BCC *21
+    return tAotResult( 10, 28 );
+}
+
+static tAotResult aotBlock_EB47( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEB47: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0038 ); // 0xEB48: LDA $38
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003A ); // 0xEB4A: SBC $3a
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0039 ); // 0xEB4C: LDA $39
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003B ); // 0xEB4E: SBC $3b
+    rCore.regPC = 0xEB52;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x0015 ); // 0xEB50: BCC *21
+    return tAotResult( 6, 16 );
+}
+
+static tAotResult aotBlock_EB52( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEB55;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEB80 ); // 0xEB52: JSR $eb80
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EB55( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEB58;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE934 ); // 0xEB55: JSR $e934
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EB58( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEB5A;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x000D ); // 0xEB58: BCS *13
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EB5A( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEB5A: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003C ); // 0xEB5B: LDA $3c
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x0038 ); // 0xEB5D: SBC $38
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003D ); // 0xEB5F: LDA $3d
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x0039 ); // 0xEB61: SBC $39
+    rCore.regPC = 0xEB65;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x00E2 ); // 0xEB63: BCS *-30
+    return tAotResult( 6, 16 );
+}
+
+static tAotResult aotBlock_EB65( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x0033 ); // 0xEB65: STZ $33
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB67; return tAotResult( 1, 3 ); }
+    rCore.regPC = 0xEB68;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEB67: RTS
+    return tAotResult( 2, 9 );
+}
+
+static tAotResult aotBlock_EB67( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEB68;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEB67: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EB68( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0035 ); // 0xEB68: LDA $35
+    rCore.regPC = 0xEB6C;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0008 ); // 0xEB6A: BEQ *8
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EB6C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x003C ); // 0xEB6C: LDX $3c
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003D ); // 0xEB6E: LDA $3d
+    mcuInstructionExecuteDecoded< 0x86 >( rCore, 0x0038 ); // 0xEB70: STX $38
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB72; return tAotResult( 3, 9 ); }
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0039 ); // 0xEB72: STA $39
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB74; return tAotResult( 4, 12 ); }
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0014 ); // 0xEB74: LDA #$14
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0033 ); // 0xEB76: STA $33
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB78; return tAotResult( 6, 17 ); }
+    rCore.regPC = 0xEB7B;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEB80 ); // 0xEB78: JSR $eb80
+    return tAotResult( 7, 23 );
+}
+
+static tAotResult aotBlock_EB74( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0014 ); // 0xEB74: LDA #$14
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0033 ); // 0xEB76: STA $33
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB78; return tAotResult( 2, 5 ); }
+    rCore.regPC = 0xEB7B;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEB80 ); // 0xEB78: JSR $eb80
+    return tAotResult( 3, 11 );
+}
+
+static tAotResult aotBlock_EB78( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEB7B;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEB80 ); // 0xEB78: JSR $eb80
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EB7B( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC6 >( rCore, 0x0033 ); // 0xEB7B: DEC $33
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB7D; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xEB7F;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00F9 ); // 0xEB7D: BNE *-7
+    return tAotResult( 2, 7 );
+}
+
+static tAotResult aotBlock_EB7F( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEB80;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEB7F: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EB80( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEB83;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xEB80: JSR $e888
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EB83( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEB86;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEB92 ); // 0xEB83: JSR $eb92
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EB86( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x18 >( rCore, 0x0000 ); // 0xEB86: CLC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0038 ); // 0xEB87: LDA $38
+    mcuInstructionExecuteDecoded< 0x65 >( rCore, 0x0035 ); // 0xEB89: ADC $35
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0038 ); // 0xEB8B: STA $38
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB8D; return tAotResult( 4, 11 ); }
+    rCore.regPC = 0xEB8F;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x0002 ); // 0xEB8D: BCC *2
+    return tAotResult( 5, 13 );
+}
+
+static tAotResult aotBlock_EB8F( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x0039 ); // 0xEB8F: INC $39
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB91; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xEB92;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEB91: RTS
+    return tAotResult( 2, 11 );
+}
+
+static tAotResult aotBlock_EB91( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEB92;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEB91: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EB92( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB2 >( rCore, 0x0038 ); // 0xEB92: LDA ($38)
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xEB94: TAX
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF06C ); // 0xEB95: LDA $f06c, X
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0036 ); // 0xEB98: STA $36
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEB9A; return tAotResult( 4, 14 ); }
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF16C ); // 0xEB9A: LDA $f16c, X
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x000F ); // 0xEB9D: AND #$0f
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0034 ); // 0xEB9F: STA $34
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEBA1; return tAotResult( 7, 23 ); }
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xEBA1: TAX
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF26C ); // 0xEBA2: LDA $f26c, X
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0035 ); // 0xEBA5: STA $35
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEBA7; return tAotResult( 10, 32 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0039 ); // 0xEBA7: LDA $39
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0038 ); // 0xEBA9: LDX $38
+    rCore.regPC = 0xEBAE;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE895 ); // 0xEBAB: JSR $e895
+    return tAotResult( 13, 44 );
+}
+
+static tAotResult aotBlock_EBAE( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x002D ); // 0xEBAE: LDA #$2d
+    rCore.regPC = 0xEBB3;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEBB0: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EBB3( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEBB6;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8B6 ); // 0xEBB3: JSR $e8b6
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EBB6( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x0001 ); // 0xEBB6: LDX #$01
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0000 ); // 0xEBB8: LDY #$00
+    mcuInstructionExecuteDecoded< 0xC4 >( rCore, 0x0035 ); // 0xEBBA: CPY $35
+    rCore.regPC = 0xEBBE;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x000B ); // 0xEBBC: BCS *11
+    return tAotResult( 4, 9 );
+}
+
+static tAotResult aotBlock_EBB8( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0000 ); // 0xEBB8: LDY #$00
+    mcuInstructionExecuteDecoded< 0xC4 >( rCore, 0x0035 ); // 0xEBBA: CPY $35
+    rCore.regPC = 0xEBBE;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x000B ); // 0xEBBC: BCS *11
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EBBA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC4 >( rCore, 0x0035 ); // 0xEBBA: CPY $35
+    rCore.regPC = 0xEBBE;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x000B ); // 0xEBBC: BCS *11
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EBBE( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB1 >( rCore, 0x0038 ); // 0xEBBE: LDA ($38), Y
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0000 ); // 0xEBC0: CPX #$00
+    rCore.regPC = 0xEBC4;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x000E ); // 0xEBC2: BNE *14
+    return tAotResult( 3, 9 );
+}
+
+static tAotResult aotBlock_EBC4( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEBC7;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE899 ); // 0xEBC4: JSR $e899
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EBC7( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEBC9;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x0007 ); // 0xEBC7: BRA *7
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EBC9( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0000 ); // 0xEBC9: CPX #$00
+    rCore.regPC = 0xEBCD;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0003 ); // 0xEBCB: BNE *3
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EBCD( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEBD0;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8B6 ); // 0xEBCD: JSR $e8b6
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EBD0( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0020 ); // 0xEBD0: LDA #$20
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x007F ); // 0xEBD2: AND #$7f
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x007F ); // 0xEBD4: CMP #$7f
+    rCore.regPC = 0xEBD8;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0004 ); // 0xEBD6: BEQ *4
+    return tAotResult( 4, 8 );
+}
+
+static tAotResult aotBlock_EBD2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x007F ); // 0xEBD2: AND #$7f
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x007F ); // 0xEBD4: CMP #$7f
+    rCore.regPC = 0xEBD8;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0004 ); // 0xEBD6: BEQ *4
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_EBD8( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0020 ); // 0xEBD8: CMP #$20
+    rCore.regPC = 0xEBDC;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x0002 ); // 0xEBDA: BCS *2
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EBDC( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x002E ); // 0xEBDC: LDA #$2e
+    rCore.regPC = 0xEBE1;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEBDE: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EBDE( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEBE1;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEBDE: JSR $e938
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EBE1( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEBE1: INY
+    mcuInstructionExecuteDecoded< 0xC0 >( rCore, 0x0003 ); // 0xEBE2: CPY #$03
+    rCore.regPC = 0xEBE6;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x00D4 ); // 0xEBE4: BCC *-44
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_EBE6( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEBE9;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8B6 ); // 0xEBE6: JSR $e8b6
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EBE9( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xCA >( rCore, 0x0000 ); // 0xEBE9: DEX
+    rCore.regPC = 0xEBEC;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00CC ); // 0xEBEA: BEQ *-52
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EBEC( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0036 ); // 0xEBEC: LDA $36
+    mcuInstructionExecuteDecoded< 0x0A >( rCore, 0x0000 ); // 0xEBEE: ASL A
+    mcuInstructionExecuteDecoded< 0x65 >( rCore, 0x0036 ); // 0xEBEF: ADC $36
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xEBF1: TAX
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x00FD ); // 0xEBF2: LDY #$fd
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF2AC ); // 0xEBF4: LDA $f2ac, X
+    rCore.regPC = 0xEBFA;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEBF7: JSR $e938
+    return tAotResult( 7, 22 );
+}
+
+static tAotResult aotBlock_EBF4( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF2AC ); // 0xEBF4: LDA $f2ac, X
+    rCore.regPC = 0xEBFA;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEBF7: JSR $e938
+    return tAotResult( 2, 10 );
+}
+
+static tAotResult aotBlock_EBFA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xEBFA: INX
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEBFB: INY
+    rCore.regPC = 0xEBFE;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00F6 ); // 0xEBFC: BNE *-10
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_EBFE( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0036 ); // 0xEBFE: LDA $36
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0042 ); // 0xEC00: CMP #$42
+    rCore.regPC = 0xEC04;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x0019 ); // 0xEC02: BMI *25
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EC04( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0046 ); // 0xEC04: CMP #$46
+    rCore.regPC = 0xEC08;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x0015 ); // 0xEC06: BPL *21
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EC08( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB2 >( rCore, 0x0038 ); // 0xEC08: LDA ($38)
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xEC0A: LSR A
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xEC0B: LSR A
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xEC0C: LSR A
+    mcuInstructionExecuteDecoded< 0x4A >( rCore, 0x0000 ); // 0xEC0D: LSR A
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x0007 ); // 0xEC0E: AND #$07
+    mcuInstructionExecuteDecoded< 0x09 >( rCore, 0x0030 ); // 0xEC10: ORA #$30
+    rCore.regPC = 0xEC15;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEC12: JSR $e938
+    return tAotResult( 8, 23 );
+}
+
+static tAotResult aotBlock_EC15( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0020 ); // 0xEC15: LDA #$20
+    rCore.regPC = 0xEC1A;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEC17: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EC1A( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC1D;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEC20 ); // 0xEC1A: JMP $ec20
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_EC1D( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC20;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8B6 ); // 0xEC1D: JSR $e8b6
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC20( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0034 ); // 0xEC20: LDA $34
+    mcuInstructionExecuteDecoded< 0x0A >( rCore, 0x0000 ); // 0xEC22: ASL A
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xEC23: TAX
+    rCore.regPC = 0xEC27;
+    mcuInstructionExecuteDecoded< 0x7C >( rCore, 0xF27C ); // 0xEC24: JMP ($f27c, X)
+    return tAotResult( 4, 13 );
+}
+
+static tAotResult aotBlock_EC27( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0023 ); // 0xEC27: LDA #$23
+    rCore.regPC = 0xEC2C;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEC29: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EC2C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0024 ); // 0xEC2C: LDA #$24
+    rCore.regPC = 0xEC31;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEC2E: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EC31( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0001 ); // 0xEC31: LDY #$01
+    mcuInstructionExecuteDecoded< 0xB1 >( rCore, 0x0038 ); // 0xEC33: LDA ($38), Y
+    rCore.regPC = 0xEC38;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE899 ); // 0xEC35: JMP $e899
+    return tAotResult( 3, 10 );
+}
+
+static tAotResult aotBlock_EC33( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB1 >( rCore, 0x0038 ); // 0xEC33: LDA ($38), Y
+    rCore.regPC = 0xEC38;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE899 ); // 0xEC35: JMP $e899
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EC38( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC3B;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC2C ); // 0xEC38: JSR $ec2c
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC3B( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x002C ); // 0xEC3B: LDA #$2c
+    rCore.regPC = 0xEC40;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEC3D: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EC40( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0058 ); // 0xEC40: LDA #$58
+    rCore.regPC = 0xEC45;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE938 ); // 0xEC42: JMP $e938
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EC45( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC48;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC2C ); // 0xEC45: JSR $ec2c
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC48( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x002C ); // 0xEC48: LDA #$2c
+    rCore.regPC = 0xEC4D;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEC4A: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EC4D( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0059 ); // 0xEC4D: LDA #$59
+    rCore.regPC = 0xEC52;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE938 ); // 0xEC4F: JMP $e938
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EC52( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC55;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC98 ); // 0xEC52: JSR $ec98
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC55( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC58;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC2C ); // 0xEC55: JSR $ec2c
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC58( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0029 ); // 0xEC58: LDA #$29
+    rCore.regPC = 0xEC5D;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE938 ); // 0xEC5A: JMP $e938
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EC5D( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC60;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC98 ); // 0xEC5D: JSR $ec98
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC60( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC63;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC2C ); // 0xEC60: JSR $ec2c
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC63( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC66;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC3B ); // 0xEC63: JSR $ec3b
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC66( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC68;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00F0 ); // 0xEC66: BRA *-16
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EC68( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC6B;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC52 ); // 0xEC68: JSR $ec52
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC6B( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC6D;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00DB ); // 0xEC6B: BRA *-37
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EC6D( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0024 ); // 0xEC6D: LDA #$24
+    rCore.regPC = 0xEC72;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEC6F: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EC72( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0002 ); // 0xEC72: LDY #$02
+    rCore.regPC = 0xEC77;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC33 ); // 0xEC74: JSR $ec33
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EC77( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x88 >( rCore, 0x0000 ); // 0xEC77: DEY
+    rCore.regPC = 0xEC7A;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00B9 ); // 0xEC78: BRA *-71
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EC7A( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC7D;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC6D ); // 0xEC7A: JSR $ec6d
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC7D( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC7F;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00BC ); // 0xEC7D: BRA *-68
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EC7F( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC82;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC6D ); // 0xEC7F: JSR $ec6d
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC82( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC84;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00C4 ); // 0xEC82: BRA *-60
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EC84( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC87;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC98 ); // 0xEC84: JSR $ec98
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC87( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC8A;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC6D ); // 0xEC87: JSR $ec6d
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC8A( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC8C;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00CC ); // 0xEC8A: BRA *-52
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EC8C( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC8F;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC98 ); // 0xEC8C: JSR $ec98
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC8F( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC92;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC6D ); // 0xEC8F: JSR $ec6d
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC92( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC95;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC3B ); // 0xEC92: JSR $ec3b
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC95( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC97;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00C1 ); // 0xEC95: BRA *-63
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EC97( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEC98;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEC97: RTS
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EC98( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0028 ); // 0xEC98: LDA #$28
+    rCore.regPC = 0xEC9D;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE938 ); // 0xEC9A: JMP $e938
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EC9D( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xECA0;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEC2C ); // 0xEC9D: JSR $ec2c
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_ECA0( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x002C ); // 0xECA0: LDA #$2c
+    rCore.regPC = 0xECA5;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xECA2: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_ECA5( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0024 ); // 0xECA5: LDA #$24
+    rCore.regPC = 0xECAA;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xECA7: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_ECAA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0002 ); // 0xECAA: LDY #$02
+    mcuInstructionExecuteDecoded< 0xB1 >( rCore, 0x0038 ); // 0xECAC: LDA ($38), Y
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0037 ); // 0xECAE: STA $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xECB0; return tAotResult( 3, 10 ); }
+    mcuInstructionExecuteDecoded< 0x18 >( rCore, 0x0000 ); // 0xECB0: CLC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0038 ); // 0xECB1: LDA $38
+    mcuInstructionExecuteDecoded< 0x69 >( rCore, 0x0003 ); // 0xECB3: ADC #$03
+    rCore.regPC = 0xECB8;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xECC8 ); // 0xECB5: JMP $ecc8
+    return tAotResult( 7, 20 );
+}
+
+static tAotResult aotBlock_ECB8( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0024 ); // 0xECB8: LDA #$24
+    rCore.regPC = 0xECBD;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xECBA: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_ECBD( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0001 ); // 0xECBD: LDY #$01
+    mcuInstructionExecuteDecoded< 0xB1 >( rCore, 0x0038 ); // 0xECBF: LDA ($38), Y
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0037 ); // 0xECC1: STA $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xECC3; return tAotResult( 3, 10 ); }
+    mcuInstructionExecuteDecoded< 0x18 >( rCore, 0x0000 ); // 0xECC3: CLC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0038 ); // 0xECC4: LDA $38
+    mcuInstructionExecuteDecoded< 0x69 >( rCore, 0x0002 ); // 0xECC6: ADC #$02
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xECC8: TAX
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0039 ); // 0xECC9: LDA $39
+    mcuInstructionExecuteDecoded< 0x69 >( rCore, 0x0000 ); // 0xECCB: ADC #$00
+    mcuInstructionExecuteDecoded< 0xA8 >( rCore, 0x0000 ); // 0xECCD: TAY
+    mcuInstructionExecuteDecoded< 0x18 >( rCore, 0x0000 ); // 0xECCE: CLC
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xECCF: TXA
+    mcuInstructionExecuteDecoded< 0x65 >( rCore, 0x0037 ); // 0xECD0: ADC $37
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xECD2: TAX
+    mcuInstructionExecuteDecoded< 0x98 >( rCore, 0x0000 ); // 0xECD3: TYA
+    mcuInstructionExecuteDecoded< 0xA4 >( rCore, 0x0037 ); // 0xECD4: LDY $37
+    rCore.regPC = 0xECD8;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x0001 ); // 0xECD6: BPL *1
+    return tAotResult( 17, 42 );
+}
+
+static tAotResult aotBlock_ECC8( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xECC8: TAX
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0039 ); // 0xECC9: LDA $39
+    mcuInstructionExecuteDecoded< 0x69 >( rCore, 0x0000 ); // 0xECCB: ADC #$00
+    mcuInstructionExecuteDecoded< 0xA8 >( rCore, 0x0000 ); // 0xECCD: TAY
+    mcuInstructionExecuteDecoded< 0x18 >( rCore, 0x0000 ); // 0xECCE: CLC
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xECCF: TXA
+    mcuInstructionExecuteDecoded< 0x65 >( rCore, 0x0037 ); // 0xECD0: ADC $37
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xECD2: TAX
+    mcuInstructionExecuteDecoded< 0x98 >( rCore, 0x0000 ); // 0xECD3: TYA
+    mcuInstructionExecuteDecoded< 0xA4 >( rCore, 0x0037 ); // 0xECD4: LDY $37
+    rCore.regPC = 0xECD8;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x0001 ); // 0xECD6: BPL *1
+    return tAotResult( 11, 25 );
+}
+
+static tAotResult aotBlock_ECD8( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x3A >( rCore, 0x0000 ); // 0xECD8: DEC A
+    mcuInstructionExecuteDecoded< 0x69 >( rCore, 0x0000 ); // 0xECD9: ADC #$00
+    rCore.regPC = 0xECDE;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE895 ); // 0xECDB: JMP $e895
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_ECD9( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x69 >( rCore, 0x0000 ); // 0xECD9: ADC #$00
+    rCore.regPC = 0xECDE;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE895 ); // 0xECDB: JMP $e895
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_ECDE( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBA >( rCore, 0x0000 ); // 0xECDE: TSX
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xECDF: INX
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xECE0: INX
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xECE1: INX
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xECE2: INX
+    mcuInstructionExecuteDecoded< 0x9E >( rCore, 0x0100 ); // 0xECE3: STZ $0100, X
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xECE6; return tAotResult( 6, 15 ); }
+    rCore.regPC = 0xECE9;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE9CF ); // 0xECE6: JSR $e9cf
+    return tAotResult( 7, 21 );
+}
+
+static tAotResult aotBlock_ECE9( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xECEC;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xED0C ); // 0xECE9: JMP $ed0c
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_ECEC( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x00B6 ); // 0xECEC: LDA #$b6
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003A ); // 0xECEE: STA $3a
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xECF0; return tAotResult( 2, 5 ); }
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x00F7 ); // 0xECF0: LDA #$f7
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003B ); // 0xECF2: STA $3b
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xECF4; return tAotResult( 4, 10 ); }
+    rCore.regPC = 0xECF6;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x000F ); // 0xECF4: BRA *15
+    return tAotResult( 5, 12 );
+}
+
+static tAotResult aotBlock_ECF6( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x007E ); // 0xECF6: CMP #$7e
+    rCore.regPC = 0xECFA;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0005 ); // 0xECF8: BEQ *5
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_ECFA( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xECFD;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xECFA: JSR $e938
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_ECFD( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xECFF;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x0003 ); // 0xECFD: BRA *3
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_ECFF( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xED02;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xECFF: JSR $e888
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_ED02( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xED05;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEA81 ); // 0xED02: JSR $ea81
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_ED05( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB2 >( rCore, 0x003A ); // 0xED05: LDA ($3a)
+    rCore.regPC = 0xED09;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00ED ); // 0xED07: BNE *-19
+    return tAotResult( 2, 7 );
+}
+
+static tAotResult aotBlock_ED09( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xED0C;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEFDA ); // 0xED09: JSR $efda
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_ED0C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x00FF ); // 0xED0C: LDX #$ff
+    mcuInstructionExecuteDecoded< 0x9A >( rCore, 0x0000 ); // 0xED0E: TXS
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x0035 ); // 0xED0F: STZ $35
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xED11; return tAotResult( 3, 7 ); }
+    rCore.regPC = 0xED14;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8BE ); // 0xED11: JSR $e8be
+    return tAotResult( 4, 13 );
+}
+
+static tAotResult aotBlock_ED14( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0000 ); // 0xED14: LDY #$00
+    mcuInstructionExecuteDecoded< 0xAD >( rCore, 0x0400 ); // 0xED16: LDA $0400
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x000D ); // 0xED19: CMP #$0d
+    rCore.regPC = 0xED1D;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0003 ); // 0xED1B: BNE *3
+    return tAotResult( 4, 10 );
+}
+
+static tAotResult aotBlock_ED1D( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xED20;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xE952 ); // 0xED1D: JMP $e952
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_ED20( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x003F ); // 0xED20: CMP #$3f
+    rCore.regPC = 0xED24;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00C8 ); // 0xED22: BEQ *-56
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_ED24( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0020 ); // 0xED24: CMP #$20
+    rCore.regPC = 0xED28;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x003B ); // 0xED26: BEQ *59
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_ED28( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x003B ); // 0xED28: CMP #$3b
+    rCore.regPC = 0xED2C;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00E0 ); // 0xED2A: BEQ *-32
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_ED2C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x004C ); // 0xED2C: CMP #$4c
+    rCore.regPC = 0xED30;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x002C ); // 0xED2E: BEQ *44
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_ED30( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0024 ); // 0xED30: CMP #$24
+    rCore.regPC = 0xED34;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0001 ); // 0xED32: BNE *1
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_ED34( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xED34: INY
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x003C ); // 0xED35: STZ $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xED37; return tAotResult( 2, 5 ); }
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x003D ); // 0xED37: STZ $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xED39; return tAotResult( 3, 8 ); }
+    rCore.regPC = 0xED3C;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xED39: JSR $e988
+    return tAotResult( 4, 14 );
+}
+
+static tAotResult aotBlock_ED35( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x003C ); // 0xED35: STZ $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xED37; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x003D ); // 0xED37: STZ $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xED39; return tAotResult( 2, 6 ); }
+    rCore.regPC = 0xED3C;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xED39: JSR $e988
+    return tAotResult( 3, 12 );
+}
+
+static tAotResult aotBlock_ED3C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0035 ); // 0xED3C: LDX $35
+    rCore.regPC = 0xED40;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0008 ); // 0xED3E: BEQ *8
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_ED40( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x004C ); // 0xED40: CMP #$4c
+    rCore.regPC = 0xED44;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x001A ); // 0xED42: BEQ *26
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_ED44( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0020 ); // 0xED44: CMP #$20
+    rCore.regPC = 0xED48;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x001B ); // 0xED46: BEQ *27
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_ED48( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x98 >( rCore, 0x0000 ); // 0xED48: TYA
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xED49: TAX
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x000A ); // 0xED4A: LDA #$0a
+    rCore.regPC = 0xED4F;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xED4C: JSR $e938
+    return tAotResult( 4, 12 );
+}
+
+static tAotResult aotBlock_ED4F( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xED52;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE8B1 ); // 0xED4F: JSR $e8b1
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_ED52( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x005E ); // 0xED52: LDA #$5e
+    rCore.regPC = 0xED57;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xED54: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_ED57( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xED5A;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE93C ); // 0xED57: JSR $e93c
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_ED5A( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xED5C;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00B0 ); // 0xED5A: BRA *-80
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_ED5C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x64 >( rCore, 0x0035 ); // 0xED5C: STZ $35
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xED5E; return tAotResult( 1, 3 ); }
+    rCore.regPC = 0xED61;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEB68 ); // 0xED5E: JSR $eb68
+    return tAotResult( 2, 9 );
+}
+
+static tAotResult aotBlock_ED5E( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xED61;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEB68 ); // 0xED5E: JSR $eb68
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_ED61( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xED63;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00A9 ); // 0xED61: BRA *-87
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_ED63( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0035 ); // 0xED63: LDA $35
+    rCore.regPC = 0xED67;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x000A ); // 0xED65: BEQ *10
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_ED67( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x003C ); // 0xED67: LDX $3c
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003D ); // 0xED69: LDA $3d
+    mcuInstructionExecuteDecoded< 0x86 >( rCore, 0x003A ); // 0xED6B: STX $3a
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xED6D; return tAotResult( 3, 9 ); }
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003B ); // 0xED6D: STA $3b
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xED6F; return tAotResult( 4, 12 ); }
+    mcuInstructionExecuteDecoded< 0x88 >( rCore, 0x0000 ); // 0xED6F: DEY
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xED70: INY
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0x0400 ); // 0xED71: LDA $0400, Y
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0020 ); // 0xED74: CMP #$20
+    rCore.regPC = 0xED78;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00F8 ); // 0xED76: BEQ *-8
+    return tAotResult( 9, 24 );
+}
+
+static tAotResult aotBlock_ED70( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xED70: INY
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0x0400 ); // 0xED71: LDA $0400, Y
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0020 ); // 0xED74: CMP #$20
+    rCore.regPC = 0xED78;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00F8 ); // 0xED76: BEQ *-8
+    return tAotResult( 4, 10 );
+}
+
+static tAotResult aotBlock_ED71( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0x0400 ); // 0xED71: LDA $0400, Y
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0020 ); // 0xED74: CMP #$20
+    rCore.regPC = 0xED78;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00F8 ); // 0xED76: BEQ *-8
+    return tAotResult( 3, 8 );
+}
+
+static tAotResult aotBlock_ED78( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x000D ); // 0xED78: CMP #$0d
+    rCore.regPC = 0xED7C;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00E5 ); // 0xED7A: BEQ *-27
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_ED7C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x003B ); // 0xED7C: CMP #$3b
+    rCore.regPC = 0xED80;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00E1 ); // 0xED7E: BEQ *-31
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_ED80( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x0000 ); // 0xED80: LDX #$00
+    mcuInstructionExecuteDecoded< 0x86 >( rCore, 0x0036 ); // 0xED82: STX $36
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xED84; return tAotResult( 2, 5 ); }
+    mcuInstructionExecuteDecoded< 0x84 >( rCore, 0x0033 ); // 0xED84: STY $33
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xED86; return tAotResult( 3, 8 ); }
+    mcuInstructionExecuteDecoded< 0xA4 >( rCore, 0x0033 ); // 0xED86: LDY $33
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0036 ); // 0xED88: LDA $36
+    mcuInstructionExecuteDecoded< 0x0A >( rCore, 0x0000 ); // 0xED8A: ASL A
+    mcuInstructionExecuteDecoded< 0x65 >( rCore, 0x0036 ); // 0xED8B: ADC $36
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xED8D: TAX
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0x0400 ); // 0xED8E: LDA $0400, Y
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xED91: INY
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF2AC ); // 0xED92: CMP $f2ac, X
+    rCore.regPC = 0xED97;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0014 ); // 0xED95: BNE *20
+    return tAotResult( 12, 33 );
+}
+
+static tAotResult aotBlock_ED86( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA4 >( rCore, 0x0033 ); // 0xED86: LDY $33
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0036 ); // 0xED88: LDA $36
+    mcuInstructionExecuteDecoded< 0x0A >( rCore, 0x0000 ); // 0xED8A: ASL A
+    mcuInstructionExecuteDecoded< 0x65 >( rCore, 0x0036 ); // 0xED8B: ADC $36
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xED8D: TAX
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0x0400 ); // 0xED8E: LDA $0400, Y
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xED91: INY
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF2AC ); // 0xED92: CMP $f2ac, X
+    rCore.regPC = 0xED97;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0014 ); // 0xED95: BNE *20
+    return tAotResult( 9, 25 );
+}
+
+static tAotResult aotBlock_ED97( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0x0400 ); // 0xED97: LDA $0400, Y
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xED9A: INX
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xED9B: INY
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF2AC ); // 0xED9C: CMP $f2ac, X
+    rCore.regPC = 0xEDA1;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x000A ); // 0xED9F: BNE *10
+    return tAotResult( 5, 14 );
+}
+
+static tAotResult aotBlock_EDA1( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0x0400 ); // 0xEDA1: LDA $0400, Y
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xEDA4: INX
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEDA5: INY
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF2AC ); // 0xEDA6: CMP $f2ac, X
+    rCore.regPC = 0xEDAB;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x000C ); // 0xEDA9: BEQ *12
+    return tAotResult( 5, 14 );
+}
+
+static tAotResult aotBlock_EDAB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0036 ); // 0xEDAB: LDX $36
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xEDAD: INX
+    mcuInstructionExecuteDecoded< 0x86 >( rCore, 0x0036 ); // 0xEDAE: STX $36
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEDB0; return tAotResult( 3, 8 ); }
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x004A ); // 0xEDB0: CPX #$4a
+    rCore.regPC = 0xEDB4;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00D2 ); // 0xEDB2: BNE *-46
+    return tAotResult( 5, 12 );
+}
+
+static tAotResult aotBlock_EDB4( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEDB7;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xED48 ); // 0xEDB4: JMP $ed48
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_EDB7( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0000 ); // 0xEDB7: LDA #$00
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0034 ); // 0xEDB9: STA $34
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEDBB; return tAotResult( 2, 5 ); }
+    mcuInstructionExecuteDecoded< 0xC6 >( rCore, 0x0034 ); // 0xEDBB: DEC $34
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEDBD; return tAotResult( 3, 10 ); }
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003C ); // 0xEDBD: STA $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEDBF; return tAotResult( 4, 13 ); }
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003D ); // 0xEDBF: STA $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEDC1; return tAotResult( 5, 16 ); }
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0035 ); // 0xEDC1: STA $35
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEDC3; return tAotResult( 6, 19 ); }
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0036 ); // 0xEDC3: LDX $36
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0042 ); // 0xEDC5: CPX #$42
+    rCore.regPC = 0xEDC9;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x0018 ); // 0xEDC7: BMI *24
+    return tAotResult( 9, 26 );
+}
+
+static tAotResult aotBlock_EDC9( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0046 ); // 0xEDC9: CPX #$46
+    rCore.regPC = 0xEDCD;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x0014 ); // 0xEDCB: BPL *20
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EDCD( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xB9 >( rCore, 0x0400 ); // 0xEDCD: LDA $0400, Y
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEDD0: INY
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0038 ); // 0xEDD1: CMP #$38
+    rCore.regPC = 0xEDD5;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x00DF ); // 0xEDD3: BPL *-33
+    return tAotResult( 4, 10 );
+}
+
+static tAotResult aotBlock_EDD5( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0030 ); // 0xEDD5: CMP #$30
+    rCore.regPC = 0xEDD9;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x00DB ); // 0xEDD7: BMI *-37
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EDD9( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x0A >( rCore, 0x0000 ); // 0xEDD9: ASL A
+    mcuInstructionExecuteDecoded< 0x0A >( rCore, 0x0000 ); // 0xEDDA: ASL A
+    mcuInstructionExecuteDecoded< 0x0A >( rCore, 0x0000 ); // 0xEDDB: ASL A
+    mcuInstructionExecuteDecoded< 0x0A >( rCore, 0x0000 ); // 0xEDDC: ASL A
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0039 ); // 0xEDDD: STA $39
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEDDF; return tAotResult( 5, 11 ); }
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0080 ); // 0xEDDF: LDA #$80
+    mcuInstructionExecuteDecoded< 0xBE >( rCore, 0x0400 ); // 0xEDE1: LDX $0400, Y
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEDE4: INY
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0020 ); // 0xEDE5: CPX #$20
+    rCore.regPC = 0xEDE9;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0024 ); // 0xEDE7: BNE *36
+    return tAotResult( 10, 23 );
+}
+
+static tAotResult aotBlock_EDE1( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBE >( rCore, 0x0400 ); // 0xEDE1: LDX $0400, Y
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEDE4: INY
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0020 ); // 0xEDE5: CPX #$20
+    rCore.regPC = 0xEDE9;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0024 ); // 0xEDE7: BNE *36
+    return tAotResult( 4, 10 );
+}
+
+static tAotResult aotBlock_EDE9( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0080 ); // 0xEDE9: CMP #$80
+    rCore.regPC = 0xEDED;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x00F4 ); // 0xEDEB: BMI *-12
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EDED( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0036 ); // 0xEDED: LDX $36
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0044 ); // 0xEDEF: CPX #$44
+    rCore.regPC = 0xEDF3;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x00EE ); // 0xEDF1: BPL *-18
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EDF3( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0035 ); // 0xEDF3: LDX $35
+    rCore.regPC = 0xEDF7;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00EA ); // 0xEDF5: BEQ *-22
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EDF7( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x00D0 ); // 0xEDF7: CMP #$d0
+    rCore.regPC = 0xEDFB;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x00E6 ); // 0xEDF9: BPL *-26
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EDFB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x00C0 ); // 0xEDFB: CMP #$c0
+    rCore.regPC = 0xEDFF;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x00B5 ); // 0xEDFD: BPL *-75
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EDFF( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x003D ); // 0xEDFF: LDX $3d
+    rCore.regPC = 0xEE03;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00B1 ); // 0xEE01: BNE *-79
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EE03( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x003C ); // 0xEE03: LDX $3c
+    mcuInstructionExecuteDecoded< 0x86 >( rCore, 0x0038 ); // 0xEE05: STX $38
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEE07; return tAotResult( 2, 6 ); }
+    mcuInstructionExecuteDecoded< 0x09 >( rCore, 0x0040 ); // 0xEE07: ORA #$40
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x00F7 ); // 0xEE09: AND #$f7
+    rCore.regPC = 0xEE0D;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00D4 ); // 0xEE0B: BRA *-44
+    return tAotResult( 5, 12 );
+}
+
+static tAotResult aotBlock_EE0D( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x000D ); // 0xEE0D: CPX #$0d
+    rCore.regPC = 0xEE11;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0003 ); // 0xEE0F: BNE *3
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EE11( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEE14;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEECB ); // 0xEE11: JMP $eecb
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_EE14( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x003B ); // 0xEE14: CPX #$3b
+    rCore.regPC = 0xEE18;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00F9 ); // 0xEE16: BEQ *-7
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EE18( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xEE18: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEE19; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0036 ); // 0xEE19: LDA $36
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0046 ); // 0xEE1B: CMP #$46
+    rCore.regPC = 0xEE1F;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x0044 ); // 0xEE1D: BMI *68
+    return tAotResult( 4, 10 );
+}
+
+static tAotResult aotBlock_EE1F( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEE21;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0019 ); // 0xEE1F: BNE *25
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EE21( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0024 ); // 0xEE21: CPX #$24
+    rCore.regPC = 0xEE25;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0001 ); // 0xEE23: BEQ *1
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EE25( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x88 >( rCore, 0x0000 ); // 0xEE25: DEY
+    rCore.regPC = 0xEE29;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xEE26: JSR $e988
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EE26( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEE29;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xEE26: JSR $e988
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EE29( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xFA >( rCore, 0x0000 ); // 0xEE29: PLX
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0035 ); // 0xEE2A: LDX $35
+    rCore.regPC = 0xEE2E;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0086 ); // 0xEE2C: BEQ *-122
+    return tAotResult( 3, 9 );
+}
+
+static tAotResult aotBlock_EE2E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0000 ); // 0xEE2E: LDY #$00
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0001 ); // 0xEE30: LDA #$01
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xEE32: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEE33; return tAotResult( 3, 7 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003C ); // 0xEE33: LDA $3c
+    mcuInstructionExecuteDecoded< 0x91 >( rCore, 0x003A ); // 0xEE35: STA ($3a), Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEE37; return tAotResult( 5, 16 ); }
+    rCore.regPC = 0xEE3A;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEF66 ); // 0xEE37: JMP $ef66
+    return tAotResult( 6, 19 );
+}
+
+static tAotResult aotBlock_EE3A( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0047 ); // 0xEE3A: CMP #$47
+    rCore.regPC = 0xEE3E;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x001E ); // 0xEE3C: BNE *30
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EE3E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0024 ); // 0xEE3E: CPX #$24
+    rCore.regPC = 0xEE42;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0001 ); // 0xEE40: BEQ *1
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EE42( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x88 >( rCore, 0x0000 ); // 0xEE42: DEY
+    rCore.regPC = 0xEE46;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xEE43: JSR $e988
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EE43( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEE46;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xEE43: JSR $e988
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EE46( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xFA >( rCore, 0x0000 ); // 0xEE46: PLX
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0035 ); // 0xEE47: LDX $35
+    rCore.regPC = 0xEE4B;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x007D ); // 0xEE49: BEQ *125
+    return tAotResult( 3, 9 );
+}
+
+static tAotResult aotBlock_EE4B( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0000 ); // 0xEE4B: LDY #$00
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0002 ); // 0xEE4D: LDA #$02
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xEE4F: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEE50; return tAotResult( 3, 7 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003C ); // 0xEE50: LDA $3c
+    mcuInstructionExecuteDecoded< 0x91 >( rCore, 0x003A ); // 0xEE52: STA ($3a), Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEE54; return tAotResult( 5, 16 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003D ); // 0xEE54: LDA $3d
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEE56: INY
+    mcuInstructionExecuteDecoded< 0x91 >( rCore, 0x003A ); // 0xEE57: STA ($3a), Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEE59; return tAotResult( 8, 27 ); }
+    rCore.regPC = 0xEE5C;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEF66 ); // 0xEE59: JMP $ef66
+    return tAotResult( 9, 30 );
+}
+
+static tAotResult aotBlock_EE5C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0048 ); // 0xEE5C: CMP #$48
+    rCore.regPC = 0xEE60;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0068 ); // 0xEE5E: BNE *104
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EE60( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEE63;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEFAC ); // 0xEE60: JMP $efac
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_EE63( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x68 >( rCore, 0x0000 ); // 0xEE63: PLA
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0023 ); // 0xEE64: CPX #$23
+    rCore.regPC = 0xEE68;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0005 ); // 0xEE66: BNE *5
+    return tAotResult( 3, 8 );
+}
+
+static tAotResult aotBlock_EE68( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x09 >( rCore, 0x0020 ); // 0xEE68: ORA #$20
+    rCore.regPC = 0xEE6D;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEDE1 ); // 0xEE6A: JMP $ede1
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EE6D( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0028 ); // 0xEE6D: CPX #$28
+    rCore.regPC = 0xEE71;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x000B ); // 0xEE6F: BNE *11
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EE71( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x09 >( rCore, 0x0004 ); // 0xEE71: ORA #$04
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0034 ); // 0xEE73: LDX $34
+    rCore.regPC = 0xEE77;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x0051 ); // 0xEE75: BPL *81
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EE77( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x0034 ); // 0xEE77: INC $34
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEE79; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xEE7C;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEDE1 ); // 0xEE79: JMP $ede1
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EE7C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0029 ); // 0xEE7C: CPX #$29
+    rCore.regPC = 0xEE80;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0009 ); // 0xEE7E: BNE *9
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EE80( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0034 ); // 0xEE80: LDX $34
+    rCore.regPC = 0xEE84;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0044 ); // 0xEE82: BNE *68
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EE84( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x0034 ); // 0xEE84: INC $34
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEE86; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xEE89;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEDE1 ); // 0xEE86: JMP $ede1
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EE89( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x002C ); // 0xEE89: CPX #$2c
+    rCore.regPC = 0xEE8D;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x001E ); // 0xEE8B: BNE *30
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EE8D( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBE >( rCore, 0x0400 ); // 0xEE8D: LDX $0400, Y
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0058 ); // 0xEE90: CPX #$58
+    rCore.regPC = 0xEE94;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0006 ); // 0xEE92: BNE *6
+    return tAotResult( 3, 8 );
+}
+
+static tAotResult aotBlock_EE94( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x09 >( rCore, 0x0002 ); // 0xEE94: ORA #$02
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEE96: INY
+    rCore.regPC = 0xEE9A;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEDE1 ); // 0xEE97: JMP $ede1
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EE9A( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0059 ); // 0xEE9A: CPX #$59
+    rCore.regPC = 0xEE9E;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0007 ); // 0xEE9C: BEQ *7
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EE9E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0080 ); // 0xEE9E: CMP #$80
+    rCore.regPC = 0xEEA2;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x0026 ); // 0xEEA0: BMI *38
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EEA2( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEEA5;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEDED ); // 0xEEA2: JMP $eded
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_EEA5( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x09 >( rCore, 0x0001 ); // 0xEEA5: ORA #$01
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEEA7: INY
+    rCore.regPC = 0xEEAB;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEDE1 ); // 0xEEA8: JMP $ede1
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EEAB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE0 >( rCore, 0x0024 ); // 0xEEAB: CPX #$24
+    rCore.regPC = 0xEEAF;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0001 ); // 0xEEAD: BEQ *1
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EEAF( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x88 >( rCore, 0x0000 ); // 0xEEAF: DEY
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xEEB0: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEEB1; return tAotResult( 2, 5 ); }
+    rCore.regPC = 0xEEB4;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xEEB1: JSR $e988
+    return tAotResult( 3, 11 );
+}
+
+static tAotResult aotBlock_EEB0( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xEEB0: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEEB1; return tAotResult( 1, 3 ); }
+    rCore.regPC = 0xEEB4;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE988 ); // 0xEEB1: JSR $e988
+    return tAotResult( 2, 9 );
+}
+
+static tAotResult aotBlock_EEB4( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x88 >( rCore, 0x0000 ); // 0xEEB4: DEY
+    mcuInstructionExecuteDecoded< 0x68 >( rCore, 0x0000 ); // 0xEEB5: PLA
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0035 ); // 0xEEB6: LDX $35
+    rCore.regPC = 0xEEBA;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x000E ); // 0xEEB8: BEQ *14
+    return tAotResult( 4, 11 );
+}
+
+static tAotResult aotBlock_EEBA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x003D ); // 0xEEBA: LDX $3d
+    rCore.regPC = 0xEEBE;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0005 ); // 0xEEBC: BNE *5
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EEBE( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x09 >( rCore, 0x0008 ); // 0xEEBE: ORA #$08
+    rCore.regPC = 0xEEC3;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEDE1 ); // 0xEEC0: JMP $ede1
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EEC3( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x09 >( rCore, 0x0010 ); // 0xEEC3: ORA #$10
+    rCore.regPC = 0xEEC8;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEDE1 ); // 0xEEC5: JMP $ede1
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EEC8( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEECB;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xED48 ); // 0xEEC8: JMP $ed48
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_EECB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x000F ); // 0xEECB: LDX #$0f
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF29C ); // 0xEECD: CMP $f29c, X
+    rCore.regPC = 0xEED2;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0005 ); // 0xEED0: BEQ *5
+    return tAotResult( 3, 8 );
+}
+
+static tAotResult aotBlock_EECD( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xDD >( rCore, 0xF29C ); // 0xEECD: CMP $f29c, X
+    rCore.regPC = 0xEED2;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0005 ); // 0xEED0: BEQ *5
+    return tAotResult( 2, 6 );
+}
+
+static tAotResult aotBlock_EED2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xCA >( rCore, 0x0000 ); // 0xEED2: DEX
+    rCore.regPC = 0xEED5;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x00F8 ); // 0xEED3: BPL *-8
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EED5( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEED7;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00F1 ); // 0xEED5: BRA *-15
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EED7( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x86 >( rCore, 0x0037 ); // 0xEED7: STX $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEED9; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0080 ); // 0xEED9: CMP #$80
+    rCore.regPC = 0xEEDD;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x0005 ); // 0xEEDB: BMI *5
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EEDD( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xEEDD: TXA
+    mcuInstructionExecuteDecoded< 0x05 >( rCore, 0x0039 ); // 0xEEDE: ORA $39
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0037 ); // 0xEEE0: STA $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEEE2; return tAotResult( 3, 8 ); }
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x0000 ); // 0xEEE2: LDX #$00
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF06C ); // 0xEEE4: LDA $f06c, X
+    mcuInstructionExecuteDecoded< 0xC5 >( rCore, 0x0036 ); // 0xEEE7: CMP $36
+    rCore.regPC = 0xEEEB;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0007 ); // 0xEEE9: BNE *7
+    return tAotResult( 7, 19 );
+}
+
+static tAotResult aotBlock_EEE2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x0000 ); // 0xEEE2: LDX #$00
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF06C ); // 0xEEE4: LDA $f06c, X
+    mcuInstructionExecuteDecoded< 0xC5 >( rCore, 0x0036 ); // 0xEEE7: CMP $36
+    rCore.regPC = 0xEEEB;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0007 ); // 0xEEE9: BNE *7
+    return tAotResult( 4, 11 );
+}
+
+static tAotResult aotBlock_EEE4( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF06C ); // 0xEEE4: LDA $f06c, X
+    mcuInstructionExecuteDecoded< 0xC5 >( rCore, 0x0036 ); // 0xEEE7: CMP $36
+    rCore.regPC = 0xEEEB;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0007 ); // 0xEEE9: BNE *7
+    return tAotResult( 3, 9 );
+}
+
+static tAotResult aotBlock_EEEB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF16C ); // 0xEEEB: LDA $f16c, X
+    mcuInstructionExecuteDecoded< 0xC5 >( rCore, 0x0037 ); // 0xEEEE: CMP $37
+    rCore.regPC = 0xEEF2;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x002D ); // 0xEEF0: BEQ *45
+    return tAotResult( 3, 9 );
+}
+
+static tAotResult aotBlock_EEF2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xEEF2: INX
+    rCore.regPC = 0xEEF5;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00EF ); // 0xEEF3: BNE *-17
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EEF5( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0037 ); // 0xEEF5: LDA $37
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0002 ); // 0xEEF7: CMP #$02
+    rCore.regPC = 0xEEFB;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0006 ); // 0xEEF9: BNE *6
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EEFB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0001 ); // 0xEEFB: LDA #$01
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0037 ); // 0xEEFD: STA $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEEFF; return tAotResult( 2, 5 ); }
+    rCore.regPC = 0xEF01;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00E1 ); // 0xEEFF: BRA *-31
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EF01( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0001 ); // 0xEF01: CMP #$01
+    rCore.regPC = 0xEF05;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0006 ); // 0xEF03: BNE *6
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EF05( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x000A ); // 0xEF05: LDA #$0a
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0037 ); // 0xEF07: STA $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF09; return tAotResult( 2, 5 ); }
+    rCore.regPC = 0xEF0B;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00D7 ); // 0xEF09: BRA *-41
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EF0B( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x000D ); // 0xEF0B: CMP #$0d
+    rCore.regPC = 0xEF0F;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0006 ); // 0xEF0D: BNE *6
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EF0F( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x000B ); // 0xEF0F: LDA #$0b
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0037 ); // 0xEF11: STA $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF13; return tAotResult( 2, 5 ); }
+    rCore.regPC = 0xEF15;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00CD ); // 0xEF13: BRA *-51
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EF15( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0007 ); // 0xEF15: CMP #$07
+    rCore.regPC = 0xEF19;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00AF ); // 0xEF17: BNE *-81
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EF19( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0009 ); // 0xEF19: LDA #$09
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0037 ); // 0xEF1B: STA $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF1D; return tAotResult( 2, 5 ); }
+    rCore.regPC = 0xEF1F;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00C3 ); // 0xEF1D: BRA *-61
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EF1F( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0037 ); // 0xEF1F: LDA $37
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x000F ); // 0xEF21: AND #$0f
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0037 ); // 0xEF23: STA $37
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF25; return tAotResult( 3, 8 ); }
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x000E ); // 0xEF25: CMP #$0e
+    rCore.regPC = 0xEF29;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x000B ); // 0xEF27: BNE *11
+    return tAotResult( 5, 12 );
+}
+
+static tAotResult aotBlock_EF29( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEF2C;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEF73 ); // 0xEF29: JSR $ef73
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EF2C( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003D ); // 0xEF2C: STA $3d
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF2E; return tAotResult( 1, 3 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x0038 ); // 0xEF2E: LDA $38
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003C ); // 0xEF30: STA $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF32; return tAotResult( 3, 9 ); }
+    rCore.regPC = 0xEF34;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x0007 ); // 0xEF32: BRA *7
+    return tAotResult( 4, 11 );
+}
+
+static tAotResult aotBlock_EF34( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x000A ); // 0xEF34: CMP #$0a
+    rCore.regPC = 0xEF38;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0003 ); // 0xEF36: BNE *3
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EF38( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEF3B;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEF8B ); // 0xEF38: JSR $ef8b
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EF3B( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0000 ); // 0xEF3B: LDY #$00
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xEF3D: TXA
+    mcuInstructionExecuteDecoded< 0x91 >( rCore, 0x003A ); // 0xEF3E: STA ($3a), Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF40; return tAotResult( 3, 10 ); }
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEF40: INY
+    mcuInstructionExecuteDecoded< 0xA6 >( rCore, 0x0037 ); // 0xEF41: LDX $37
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF26C ); // 0xEF43: LDA $f26c, X
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xEF46: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF47; return tAotResult( 7, 22 ); }
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0001 ); // 0xEF47: CMP #$01
+    rCore.regPC = 0xEF4B;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0010 ); // 0xEF49: BEQ *16
+    return tAotResult( 9, 26 );
+}
+
+static tAotResult aotBlock_EF4B( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003C ); // 0xEF4B: LDA $3c
+    mcuInstructionExecuteDecoded< 0x91 >( rCore, 0x003A ); // 0xEF4D: STA ($3a), Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF4F; return tAotResult( 2, 9 ); }
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEF4F: INY
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF26C ); // 0xEF50: LDA $f26c, X
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0002 ); // 0xEF53: CMP #$02
+    rCore.regPC = 0xEF57;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0004 ); // 0xEF55: BEQ *4
+    return tAotResult( 6, 19 );
+}
+
+static tAotResult aotBlock_EF57( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003D ); // 0xEF57: LDA $3d
+    mcuInstructionExecuteDecoded< 0x91 >( rCore, 0x003A ); // 0xEF59: STA ($3a), Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF5B; return tAotResult( 2, 9 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003A ); // 0xEF5B: LDA $3a
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0038 ); // 0xEF5D: STA $38
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF5F; return tAotResult( 4, 15 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003B ); // 0xEF5F: LDA $3b
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0039 ); // 0xEF61: STA $39
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF63; return tAotResult( 6, 21 ); }
+    rCore.regPC = 0xEF66;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEB92 ); // 0xEF63: JSR $eb92
+    return tAotResult( 7, 27 );
+}
+
+static tAotResult aotBlock_EF5B( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003A ); // 0xEF5B: LDA $3a
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0038 ); // 0xEF5D: STA $38
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF5F; return tAotResult( 2, 6 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003B ); // 0xEF5F: LDA $3b
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x0039 ); // 0xEF61: STA $39
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF63; return tAotResult( 4, 12 ); }
+    rCore.regPC = 0xEF66;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEB92 ); // 0xEF63: JSR $eb92
+    return tAotResult( 5, 18 );
+}
+
+static tAotResult aotBlock_EF66( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x18 >( rCore, 0x0000 ); // 0xEF66: CLC
+    mcuInstructionExecuteDecoded< 0x68 >( rCore, 0x0000 ); // 0xEF67: PLA
+    mcuInstructionExecuteDecoded< 0x65 >( rCore, 0x003A ); // 0xEF68: ADC $3a
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003A ); // 0xEF6A: STA $3a
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF6C; return tAotResult( 4, 12 ); }
+    rCore.regPC = 0xEF6E;
+    mcuInstructionExecuteDecoded< 0x90 >( rCore, 0x0002 ); // 0xEF6C: BCC *2
+    return tAotResult( 5, 14 );
+}
+
+static tAotResult aotBlock_EF6E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE6 >( rCore, 0x003B ); // 0xEF6E: INC $3b
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF70; return tAotResult( 1, 5 ); }
+    rCore.regPC = 0xEF73;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xED0C ); // 0xEF70: JMP $ed0c
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EF70( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEF73;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xED0C ); // 0xEF70: JMP $ed0c
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_EF73( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEF76;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEF7A ); // 0xEF73: JSR $ef7a
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EF76( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE9 >( rCore, 0x0003 ); // 0xEF76: SBC #$03
+    rCore.regPC = 0xEF7A;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x0016 ); // 0xEF78: BRA *22
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EF7A( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEF7A: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003C ); // 0xEF7B: LDA $3c
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003A ); // 0xEF7D: SBC $3a
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003E ); // 0xEF7F: STA $3e
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF81; return tAotResult( 4, 11 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003D ); // 0xEF81: LDA $3d
+    mcuInstructionExecuteDecoded< 0xE5 >( rCore, 0x003B ); // 0xEF83: SBC $3b
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003F ); // 0xEF85: STA $3f
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF87; return tAotResult( 7, 20 ); }
+    mcuInstructionExecuteDecoded< 0x38 >( rCore, 0x0000 ); // 0xEF87: SEC
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003E ); // 0xEF88: LDA $3e
+    rCore.regPC = 0xEF8B;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEF8A: RTS
+    return tAotResult( 10, 31 );
+}
+
+static tAotResult aotBlock_EF8B( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEF8E;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xEF7A ); // 0xEF8B: JSR $ef7a
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EF8E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE9 >( rCore, 0x0002 ); // 0xEF8E: SBC #$02
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003E ); // 0xEF90: STA $3e
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF92; return tAotResult( 2, 5 ); }
+    rCore.regPC = 0xEF94;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x0002 ); // 0xEF92: BCS *2
+    return tAotResult( 3, 7 );
+}
+
+static tAotResult aotBlock_EF90( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003E ); // 0xEF90: STA $3e
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF92; return tAotResult( 1, 3 ); }
+    rCore.regPC = 0xEF94;
+    mcuInstructionExecuteDecoded< 0xB0 >( rCore, 0x0002 ); // 0xEF92: BCS *2
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EF94( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC6 >( rCore, 0x003F ); // 0xEF94: DEC $3f
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEF96; return tAotResult( 1, 5 ); }
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003F ); // 0xEF96: LDA $3f
+    rCore.regPC = 0xEF9A;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x000B ); // 0xEF98: BEQ *11
+    return tAotResult( 3, 10 );
+}
+
+static tAotResult aotBlock_EF96( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003F ); // 0xEF96: LDA $3f
+    rCore.regPC = 0xEF9A;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x000B ); // 0xEF98: BEQ *11
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EF9A( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x00FF ); // 0xEF9A: CMP #$ff
+    rCore.regPC = 0xEF9E;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x000B ); // 0xEF9C: BNE *11
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EF9E( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003E ); // 0xEF9E: LDA $3e
+    rCore.regPC = 0xEFA2;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x0007 ); // 0xEFA0: BPL *7
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EFA2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x85 >( rCore, 0x003C ); // 0xEFA2: STA $3c
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEFA4; return tAotResult( 1, 3 ); }
+    rCore.regPC = 0xEFA5;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xEFA4: RTS
+    return tAotResult( 2, 9 );
+}
+
+static tAotResult aotBlock_EFA5( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA5 >( rCore, 0x003E ); // 0xEFA5: LDA $3e
+    rCore.regPC = 0xEFA9;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x00F9 ); // 0xEFA7: BPL *-7
+    return tAotResult( 2, 5 );
+}
+
+static tAotResult aotBlock_EFA9( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEFAC;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xED48 ); // 0xEFA9: JMP $ed48
+    return tAotResult( 1, 3 );
+}
+
+static tAotResult aotBlock_EFAC( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xFA >( rCore, 0x0000 ); // 0xEFAC: PLX
+    mcuInstructionExecuteDecoded< 0x88 >( rCore, 0x0000 ); // 0xEFAD: DEY
+    mcuInstructionExecuteDecoded< 0x98 >( rCore, 0x0000 ); // 0xEFAE: TYA
+    mcuInstructionExecuteDecoded< 0xAA >( rCore, 0x0000 ); // 0xEFAF: TAX
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x00FE ); // 0xEFB0: LDY #$fe
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEFB2: INY
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0x0400 ); // 0xEFB3: LDA $0400, X
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xEFB6: INX
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x000D ); // 0xEFB7: CMP #$0d
+    rCore.regPC = 0xEFBB;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x001A ); // 0xEFB9: BEQ *26
+    return tAotResult( 10, 24 );
+}
+
+static tAotResult aotBlock_EFB2( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC8 >( rCore, 0x0000 ); // 0xEFB2: INY
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0x0400 ); // 0xEFB3: LDA $0400, X
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xEFB6: INX
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x000D ); // 0xEFB7: CMP #$0d
+    rCore.regPC = 0xEFBB;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x001A ); // 0xEFB9: BEQ *26
+    return tAotResult( 5, 12 );
+}
+
+static tAotResult aotBlock_EFB3( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0x0400 ); // 0xEFB3: LDA $0400, X
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xEFB6: INX
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x000D ); // 0xEFB7: CMP #$0d
+    rCore.regPC = 0xEFBB;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x001A ); // 0xEFB9: BEQ *26
+    return tAotResult( 4, 10 );
+}
+
+static tAotResult aotBlock_EFBB( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0027 ); // 0xEFBB: CMP #$27
+    rCore.regPC = 0xEFBF;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0006 ); // 0xEFBD: BNE *6
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EFBF( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC0 >( rCore, 0x00FF ); // 0xEFBF: CPY #$ff
+    rCore.regPC = 0xEFC3;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0012 ); // 0xEFC1: BNE *18
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EFC3( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEFC5;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00ED ); // 0xEFC3: BRA *-19
+    return tAotResult( 1, 2 );
+}
+
+static tAotResult aotBlock_EFC5( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC0 >( rCore, 0x00FF ); // 0xEFC5: CPY #$ff
+    rCore.regPC = 0xEFC9;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x0004 ); // 0xEFC7: BEQ *4
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EFC9( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x91 >( rCore, 0x003A ); // 0xEFC9: STA ($3a), Y
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEFCB; return tAotResult( 1, 6 ); }
+    rCore.regPC = 0xEFCD;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00E5 ); // 0xEFCB: BRA *-27
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_EFCD( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC9 >( rCore, 0x0020 ); // 0xEFCD: CMP #$20
+    rCore.regPC = 0xEFD1;
+    mcuInstructionExecuteDecoded< 0xF0 >( rCore, 0x00E2 ); // 0xEFCF: BEQ *-30
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_EFD1( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xEFD1: TXA
+    mcuInstructionExecuteDecoded< 0xA8 >( rCore, 0x0000 ); // 0xEFD2: TAY
+    rCore.regPC = 0xEFD5;
+    mcuInstructionExecuteDecoded< 0x80 >( rCore, 0x00D4 ); // 0xEFD3: BRA *-44
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_EFD5( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x98 >( rCore, 0x0000 ); // 0xEFD5: TYA
+    mcuInstructionExecuteDecoded< 0x48 >( rCore, 0x0000 ); // 0xEFD6: PHA
+    if( tMCUAot::exitRequested( rCore ) ) { rCore.regPC = 0xEFD7; return tAotResult( 2, 5 ); }
+    rCore.regPC = 0xEFDA;
+    mcuInstructionExecuteDecoded< 0x4C >( rCore, 0xEF66 ); // 0xEFD7: JMP $ef66
+    return tAotResult( 3, 8 );
+}
+
+static tAotResult aotBlock_EFDA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA0 >( rCore, 0x0049 ); // 0xEFDA: LDY #$49
+    mcuInstructionExecuteDecoded< 0xA2 >( rCore, 0x0000 ); // 0xEFDC: LDX #$00
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xEFDE: TXA
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x000F ); // 0xEFDF: AND #$0f
+    rCore.regPC = 0xEFE3;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0003 ); // 0xEFE1: BNE *3
+    return tAotResult( 5, 10 );
+}
+
+static tAotResult aotBlock_EFDE( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x8A >( rCore, 0x0000 ); // 0xEFDE: TXA
+    mcuInstructionExecuteDecoded< 0x29 >( rCore, 0x000F ); // 0xEFDF: AND #$0f
+    rCore.regPC = 0xEFE3;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x0003 ); // 0xEFE1: BNE *3
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_EFE3( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xEFE6;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xEFE3: JSR $e888
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_EFE6( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF2AC ); // 0xEFE6: LDA $f2ac, X
+    rCore.regPC = 0xEFEC;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEFE9: JSR $e938
+    return tAotResult( 2, 10 );
+}
+
+static tAotResult aotBlock_EFEC( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xEFEC: INX
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF2AC ); // 0xEFED: LDA $f2ac, X
+    rCore.regPC = 0xEFF3;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEFF0: JSR $e938
+    return tAotResult( 3, 12 );
+}
+
+static tAotResult aotBlock_EFF3( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xEFF3: INX
+    mcuInstructionExecuteDecoded< 0xBD >( rCore, 0xF2AC ); // 0xEFF4: LDA $f2ac, X
+    rCore.regPC = 0xEFFA;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xEFF7: JSR $e938
+    return tAotResult( 3, 12 );
+}
+
+static tAotResult aotBlock_EFFA( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xE8 >( rCore, 0x0000 ); // 0xEFFA: INX
+    mcuInstructionExecuteDecoded< 0xC0 >( rCore, 0x0008 ); // 0xEFFB: CPY #$08
+    rCore.regPC = 0xEFFF;
+    mcuInstructionExecuteDecoded< 0x10 >( rCore, 0x0009 ); // 0xEFFD: BPL *9
+    return tAotResult( 3, 6 );
+}
+
+static tAotResult aotBlock_EFFF( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xC0 >( rCore, 0x0004 ); // 0xEFFF: CPY #$04
+    rCore.regPC = 0xF003;
+    mcuInstructionExecuteDecoded< 0x30 >( rCore, 0x0005 ); // 0xF001: BMI *5
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_F003( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0078 ); // 0xF003: LDA #$78
+    rCore.regPC = 0xF008;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xF005: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_F008( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0xA9 >( rCore, 0x0020 ); // 0xF008: LDA #$20
+    rCore.regPC = 0xF00D;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE938 ); // 0xF00A: JSR $e938
+    return tAotResult( 2, 8 );
+}
+
+static tAotResult aotBlock_F00D( tMCUState::tCore& rCore )
+{
+    mcuInstructionExecuteDecoded< 0x88 >( rCore, 0x0000 ); // 0xF00D: DEY
+    rCore.regPC = 0xF010;
+    mcuInstructionExecuteDecoded< 0xD0 >( rCore, 0x00CE ); // 0xF00E: BNE *-50
+    return tAotResult( 2, 4 );
+}
+
+static tAotResult aotBlock_F010( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xF013;
+    mcuInstructionExecuteDecoded< 0x20 >( rCore, 0xE888 ); // 0xF010: JSR $e888
+    return tAotResult( 1, 6 );
+}
+
+static tAotResult aotBlock_F013( tMCUState::tCore& rCore )
+{
+    rCore.regPC = 0xF014;
+    mcuInstructionExecuteDecoded< 0x60 >( rCore, 0x0000 ); // 0xF013: RTS
+    return tAotResult( 1, 6 );
+}
+
+const tAotBlock g_romAotBlocks[] =
+{
+    { 0xE800, 0xE802, 0x1C3316A4, 1, 3, &aotBlock_E800 },
+    { 0xE851, 0xE853, 0x60AFD307, 1, 6, &aotBlock_E851 },
+    { 0xE854, 0xE85E, 0x3ADB8080, 5, 16, &aotBlock_E854 },
+    { 0xE858, 0xE85E, 0x61C8923A, 3, 12, &aotBlock_E858 },
+    { 0xE85F, 0xE862, 0x99EDB8EC, 2, 4, &aotBlock_E85F },
+    { 0xE863, 0xE867, 0x30AE9A7A, 3, 6, &aotBlock_E863 },
+    { 0xE868, 0xE86D, 0x53CA15D5, 2, 10, &aotBlock_E868 },
+    { 0xE86E, 0xE871, 0x6BF28D73, 2, 4, &aotBlock_E86E },
+    { 0xE872, 0xE873, 0xE1391950, 1, 2, &aotBlock_E872 },
+    { 0xE874, 0xE87F, 0xA9945985, 7, 16, &aotBlock_E874 },
+    { 0xE87A, 0xE87F, 0xDAA3C4FE, 4, 8, &aotBlock_E87A },
+    { 0xE880, 0xE883, 0x7F62749C, 2, 8, &aotBlock_E880 },
+    { 0xE881, 0xE883, 0x3DFBA944, 1, 6, &aotBlock_E881 },
+    { 0xE884, 0xE887, 0xFF283A55, 3, 6, &aotBlock_E884 },
+    { 0xE888, 0xE88D, 0x15C50BD4, 3, 11, &aotBlock_E888 },
+    { 0xE88E, 0xE892, 0x198CA2E1, 2, 8, &aotBlock_E88E },
+    { 0xE893, 0xE894, 0x613AEB95, 2, 10, &aotBlock_E893 },
+    { 0xE895, 0xE897, 0x5A880E8E, 1, 6, &aotBlock_E895 },
+    { 0xE898, 0xE8A0, 0x1AC35C7F, 7, 19, &aotBlock_E898 },
+    { 0xE899, 0xE8A0, 0x50176AA7, 6, 17, &aotBlock_E899 },
+    { 0xE8A1, 0xE8AC, 0xA6370319, 7, 22, &aotBlock_E8A1 },
+    { 0xE8A2, 0xE8AC, 0x654515A7, 6, 18, &aotBlock_E8A2 },
+    { 0xE8AD, 0xE8AF, 0x5A36C9AE, 1, 6, &aotBlock_E8AD },
+    { 0xE8B0, 0xE8B4, 0x9A620455, 3, 6, &aotBlock_E8B0 },
+    { 0xE8B1, 0xE8B4, 0x89F2BCAD, 2, 4, &aotBlock_E8B1 },
+    { 0xE8B5, 0xE8B5, 0xE50C2ABF, 1, 6, &aotBlock_E8B5 },
+    { 0xE8B6, 0xE8B8, 0x5A36C9AE, 1, 6, &aotBlock_E8B6 },
+    { 0xE8B9, 0xE8BD, 0x7739E373, 2, 5, &aotBlock_E8B9 },
+    { 0xE8BE, 0xE8C7, 0x677A37DF, 4, 15, &aotBlock_E8BE },
+    { 0xE8C1, 0xE8C7, 0x7768B2F3, 3, 11, &aotBlock_E8C1 },
+    { 0xE8C5, 0xE8C7, 0x60AFD307, 1, 6, &aotBlock_E8C5 },
+    { 0xE8C8, 0xE8CC, 0xD6070025, 2, 9, &aotBlock_E8C8 },
+    { 0xE8CD, 0xE8D1, 0x40EBDC19, 2, 8, &aotBlock_E8CD },
+    { 0xE8CF, 0xE8D1, 0x3A153ADE, 1, 6, &aotBlock_E8CF },
+    { 0xE8D2, 0xE8D5, 0x72FF73EB, 2, 4, &aotBlock_E8D2 },
+    { 0xE8D6, 0xE8D9, 0xFEB8B231, 2, 4, &aotBlock_E8D6 },
+    { 0xE8DA, 0xE8DD, 0xB7692F40, 2, 4, &aotBlock_E8DA },
+    { 0xE8DE, 0xE8E1, 0xEBAA4A8F, 2, 4, &aotBlock_E8DE },
+    { 0xE8E2, 0xE8E5, 0x8CBC4C1A, 2, 4, &aotBlock_E8E2 },
+    { 0xE8E6, 0xE8E9, 0x181E1E39, 2, 4, &aotBlock_E8E6 },
+    { 0xE8EB, 0xE8EE, 0xFCBD3FF0, 2, 4, &aotBlock_E8EB },
+    { 0xE8EF, 0xE8F4, 0x2F2D1C85, 3, 10, &aotBlock_E8EF },
+    { 0xE8F5, 0xE8F9, 0xE3859507, 2, 8, &aotBlock_E8F5 },
+    { 0xE8FA, 0xE8FE, 0x6FD818EF, 2, 8, &aotBlock_E8FA },
+    { 0xE8FF, 0xE900, 0xC238E883, 1, 2, &aotBlock_E8FF },
+    { 0xE901, 0xE905, 0x6D669D91, 3, 6, &aotBlock_E901 },
+    { 0xE906, 0xE90B, 0x3BC180AB, 2, 11, &aotBlock_E906 },
+    { 0xE90C, 0xE910, 0x15B86E4F, 3, 6, &aotBlock_E90C },
+    { 0xE911, 0xE912, 0x9438A019, 1, 2, &aotBlock_E911 },
+    { 0xE913, 0xE916, 0xA7156A0D, 2, 4, &aotBlock_E913 },
+    { 0xE917, 0xE91B, 0x48EE6EA7, 3, 6, &aotBlock_E917 },
+    { 0xE919, 0xE91B, 0xFB693124, 2, 4, &aotBlock_E919 },
+    { 0xE91C, 0xE921, 0x3BC180AB, 2, 11, &aotBlock_E91C },
+    { 0xE922, 0xE923, 0xA538BADC, 1, 2, &aotBlock_E922 },
+    { 0xE924, 0xE92C, 0xD99B70FB, 4, 15, &aotBlock_E924 },
+    { 0xE925, 0xE92C, 0x491E2839, 3, 13, &aotBlock_E925 },
+    { 0xE92D, 0xE92D, 0xE50C2ABF, 1, 6, &aotBlock_E92D },
+    { 0xE92E, 0xE932, 0x2ECCAE7B, 2, 6, &aotBlock_E92E },
+    { 0xE933, 0xE933, 0xE50C2ABF, 1, 6, &aotBlock_E933 },
+    { 0xE934, 0xE937, 0xEE396DD2, 2, 10, &aotBlock_E934 },
+    { 0xE938, 0xE93B, 0x5DC5E395, 2, 10, &aotBlock_E938 },
+    { 0xE93C, 0xE940, 0xDBFA9110, 2, 8, &aotBlock_E93C },
+    { 0xE941, 0xE941, 0xE50C2ABF, 1, 6, &aotBlock_E941 },
+    { 0xE94C, 0xE94E, 0x55F2D4B0, 1, 6, &aotBlock_E94C },
+    { 0xE94F, 0xE951, 0x57023DFB, 1, 6, &aotBlock_E94F },
+    { 0xE952, 0xE957, 0xE00948C5, 3, 10, &aotBlock_E952 },
+    { 0xE958, 0xE965, 0x7D96F12E, 7, 22, &aotBlock_E958 },
+    { 0xE95D, 0xE965, 0xAFBB74D9, 4, 15, &aotBlock_E95D },
+    { 0xE95F, 0xE965, 0xD0648A29, 3, 12, &aotBlock_E95F },
+    { 0xE966, 0xE96C, 0x2393A5C8, 3, 8, &aotBlock_E966 },
+    { 0xE968, 0xE96C, 0x875C0293, 2, 6, &aotBlock_E968 },
+    { 0xE96D, 0xE96F, 0x4A846C9D, 2, 4, &aotBlock_E96D },
+    { 0xE970, 0xE971, 0xF03930ED, 1, 2, &aotBlock_E970 },
+    { 0xE972, 0xE979, 0x8889C11D, 6, 18, &aotBlock_E972 },
+    { 0xE97A, 0xE97D, 0xD2B82F51, 3, 10, &aotBlock_E97A },
+    { 0xE97E, 0xE982, 0xFDB88E0E, 2, 6, &aotBlock_E97E },
+    { 0xE983, 0xE984, 0xB838D8C5, 1, 2, &aotBlock_E983 },
+    { 0xE985, 0xE987, 0x936EAA85, 1, 6, &aotBlock_E985 },
+    { 0xE988, 0xE98B, 0xE20CA460, 2, 5, &aotBlock_E988 },
+    { 0xE98C, 0xE995, 0xCCA25831, 6, 18, &aotBlock_E98C },
+    { 0xE98F, 0xE995, 0x87431043, 4, 14, &aotBlock_E98F },
+    { 0xE996, 0xE9AC, 0x926C7BBE, 13, 42, &aotBlock_E996 },
+    { 0xE9A2, 0xE9AC, 0xC22627BD, 5, 14, &aotBlock_E9A2 },
+    { 0xE9A8, 0xE9AC, 0x9746C4D1, 2, 6, &aotBlock_E9A8 },
+    { 0xE9AD, 0xE9AF, 0x4A846C9D, 2, 4, &aotBlock_E9AD },
+    { 0xE9B0, 0xE9B0, 0xE50C2ABF, 1, 6, &aotBlock_E9B0 },
+    { 0xE9B1, 0xE9BA, 0x8DC2F504, 5, 12, &aotBlock_E9B1 },
+    { 0xE9BB, 0xE9BE, 0x526389AD, 2, 4, &aotBlock_E9BB },
+    { 0xE9BF, 0xE9C1, 0x3DFBA944, 1, 6, &aotBlock_E9BF },
+    { 0xE9C2, 0xE9C3, 0x0D395E94, 1, 2, &aotBlock_E9C2 },
+    { 0xE9C4, 0xE9C6, 0x60AFD307, 1, 6, &aotBlock_E9C4 },
+    { 0xE9C7, 0xE9C9, 0x58C10F90, 1, 6, &aotBlock_E9C7 },
+    { 0xE9CA, 0xE9CD, 0x43C2850E, 2, 7, &aotBlock_E9CA },
+    { 0xE9CE, 0xE9CE, 0xE50C2ABF, 1, 6, &aotBlock_E9CE },
+    { 0xE9CF, 0xE9D1, 0x60AFD307, 1, 6, &aotBlock_E9CF },
+    { 0xE9D2, 0xE9D9, 0x8BBC5803, 4, 12, &aotBlock_E9D2 },
+    { 0xE9D6, 0xE9D9, 0x0563D1DA, 2, 8, &aotBlock_E9D6 },
+    { 0xE9DA, 0xE9DE, 0xFBB108B6, 2, 6, &aotBlock_E9DA },
+    { 0xE9DF, 0xE9DF, 0xE50C2ABF, 1, 6, &aotBlock_E9DF },
+    { 0xE9E0, 0xE9E2, 0x3AC16A91, 1, 6, &aotBlock_E9E0 },
+    { 0xE9E3, 0xE9E8, 0xEC548D7D, 3, 7, &aotBlock_E9E3 },
+    { 0xE9E9, 0xE9EB, 0xF1E2658F, 1, 6, &aotBlock_E9E9 },
+    { 0xE9EC, 0xE9F6, 0x26CACA46, 6, 23, &aotBlock_E9EC },
+    { 0xE9F7, 0xE9FA, 0xFFF6D5D6, 2, 4, &aotBlock_E9F7 },
+    { 0xE9FB, 0xEA06, 0xEE73F2CC, 6, 16, &aotBlock_E9FB },
+    { 0xEA07, 0xEA0A, 0x6289CC95, 2, 5, &aotBlock_EA07 },
+    { 0xEA0B, 0xEA0E, 0xD8CC352C, 2, 5, &aotBlock_EA0B },
+    { 0xEA0F, 0xEA11, 0x663679D1, 2, 4, &aotBlock_EA0F },
+    { 0xEA12, 0xEA18, 0xD3DD3CD7, 3, 11, &aotBlock_EA12 },
+    { 0xEA19, 0xEA1B, 0x36B91580, 1, 6, &aotBlock_EA19 },
+    { 0xEA1C, 0xEA1D, 0x00394A1D, 1, 2, &aotBlock_EA1C },
+    { 0xEA1E, 0xEA23, 0x14D0A7E0, 3, 7, &aotBlock_EA1E },
+    { 0xEA24, 0xEA27, 0x86B8FC93, 2, 4, &aotBlock_EA24 },
+    { 0xEA28, 0xEA2B, 0x164E96AE, 2, 4, &aotBlock_EA28 },
+    { 0xEA2C, 0xEA2D, 0xF7393BF2, 1, 2, &aotBlock_EA2C },
+    { 0xEA2E, 0xEA30, 0x60AFD307, 1, 6, &aotBlock_EA2E },
+    { 0xEA31, 0xEA33, 0x5607EF68, 1, 6, &aotBlock_EA31 },
+    { 0xEA34, 0xEA35, 0x03B01026, 1, 2, &aotBlock_EA34 },
+    { 0xEA36, 0xEA3C, 0xE2D6128A, 3, 12, &aotBlock_EA36 },
+    { 0xEA3D, 0xEA41, 0xE3859507, 2, 8, &aotBlock_EA3D },
+    { 0xEA42, 0xEA46, 0x9BC23166, 2, 8, &aotBlock_EA42 },
+    { 0xEA47, 0xEA4B, 0xE3859507, 2, 8, &aotBlock_EA47 },
+    { 0xEA4C, 0xEA4F, 0xDEB9871B, 2, 4, &aotBlock_EA4C },
+    { 0xEA50, 0xEA54, 0x163878F6, 2, 11, &aotBlock_EA50 },
+    { 0xEA55, 0xEA60, 0x5318B26E, 6, 20, &aotBlock_EA55 },
+    { 0xEA61, 0xEA62, 0x15607A9C, 1, 2, &aotBlock_EA61 },
+    { 0xEA63, 0xEA65, 0xD7CBDF04, 2, 9, &aotBlock_EA63 },
+    { 0xEA65, 0xEA65, 0xE50C2ABF, 1, 6, &aotBlock_EA65 },
+    { 0xEA66, 0xEA6B, 0x26599476, 3, 11, &aotBlock_EA66 },
+    { 0xEA6C, 0xEA6D, 0x4D67EBB7, 2, 10, &aotBlock_EA6C },
+    { 0xEA6E, 0xEA75, 0x3A17DD89, 4, 11, &aotBlock_EA6E },
+    { 0xEA76, 0xEA79, 0x9FFFBAC2, 2, 4, &aotBlock_EA76 },
+    { 0xEA7A, 0xEA7E, 0x5E65E53D, 2, 8, &aotBlock_EA7A },
+    { 0xEA7C, 0xEA7E, 0x3DFBA944, 1, 6, &aotBlock_EA7C },
+    { 0xEA7F, 0xEA80, 0xBC38DF11, 1, 2, &aotBlock_EA7F },
+    { 0xEA81, 0xEA84, 0x244D324B, 2, 7, &aotBlock_EA81 },
+    { 0xEA85, 0xEA87, 0x32CA6712, 2, 11, &aotBlock_EA85 },
+    { 0xEA87, 0xEA87, 0xE50C2ABF, 1, 6, &aotBlock_EA87 },
+    { 0xEA88, 0xEA8B, 0xA06692FF, 2, 5, &aotBlock_EA88 },
+    { 0xEA8C, 0xEA98, 0x72D05C4E, 8, 20, &aotBlock_EA8C },
+    { 0xEA99, 0xEAAF, 0xDE62E33E, 13, 40, &aotBlock_EA99 },
+    { 0xEAA4, 0xEAAF, 0x64085992, 6, 22, &aotBlock_EAA4 },
+    { 0xEAB0, 0xEAB7, 0xD2D3A301, 4, 15, &aotBlock_EAB0 },
+    { 0xEAB2, 0xEAB7, 0x35948CF4, 3, 10, &aotBlock_EAB2 },
+    { 0xEAB8, 0xEAC4, 0x9BD517D1, 7, 21, &aotBlock_EAB8 },
+    { 0xEABA, 0xEAC4, 0xFA3B8104, 6, 16, &aotBlock_EABA },
+    { 0xEAC5, 0xEAC7, 0x5607EF68, 1, 6, &aotBlock_EAC5 },
+    { 0xEAC8, 0xEAC9, 0xB65FE50F, 1, 2, &aotBlock_EAC8 },
+    { 0xEACA, 0xEACA, 0xE50C2ABF, 1, 6, &aotBlock_EACA },
+    { 0xEACB, 0xEACE, 0x51B5C882, 2, 5, &aotBlock_EACB },
+    { 0xEACF, 0xEACF, 0xE50C2ABF, 1, 6, &aotBlock_EACF },
+    { 0xEAD0, 0xEAD3, 0x244D324B, 2, 7, &aotBlock_EAD0 },
+    { 0xEAD4, 0xEAD9, 0x8E7A238A, 3, 12, &aotBlock_EAD4 },
+    { 0xEAD6, 0xEAD9, 0xA61A9F2D, 2, 7, &aotBlock_EAD6 },
+    { 0xEADA, 0xEAE6, 0x93AF09D8, 7, 21, &aotBlock_EADA },
+    { 0xEADC, 0xEAE6, 0x0F3BA213, 6, 16, &aotBlock_EADC },
+    { 0xEAE7, 0xEAE9, 0x5607EF68, 1, 6, &aotBlock_EAE7 },
+    { 0xEAEA, 0xEAEB, 0xCDB14E24, 1, 2, &aotBlock_EAEA },
+    { 0xEAEC, 0xEAF1, 0x6068BF55, 3, 12, &aotBlock_EAEC },
+    { 0xEB32, 0xEB3A, 0x0CCD3F63, 5, 18, &aotBlock_EB32 },
+    { 0xEB3B, 0xEB3E, 0xAD66A776, 2, 5, &aotBlock_EB3B },
+    { 0xEB3F, 0xEB51, 0x39E1693C, 10, 28, &aotBlock_EB3F },
+    { 0xEB47, 0xEB51, 0xCC234794, 6, 16, &aotBlock_EB47 },
+    { 0xEB52, 0xEB54, 0x41C4BCF2, 1, 6, &aotBlock_EB52 },
+    { 0xEB55, 0xEB57, 0x5607EF68, 1, 6, &aotBlock_EB55 },
+    { 0xEB58, 0xEB59, 0x23B04286, 1, 2, &aotBlock_EB58 },
+    { 0xEB5A, 0xEB64, 0xEC7F7E39, 6, 16, &aotBlock_EB5A },
+    { 0xEB65, 0xEB67, 0xBFC12BE0, 2, 9, &aotBlock_EB65 },
+    { 0xEB67, 0xEB67, 0xE50C2ABF, 1, 6, &aotBlock_EB67 },
+    { 0xEB68, 0xEB6B, 0x908A14FF, 2, 5, &aotBlock_EB68 },
+    { 0xEB6C, 0xEB7A, 0x53DCE9FD, 7, 23, &aotBlock_EB6C },
+    { 0xEB74, 0xEB7A, 0x70BF096D, 3, 11, &aotBlock_EB74 },
+    { 0xEB78, 0xEB7A, 0x41C4BCF2, 1, 6, &aotBlock_EB78 },
+    { 0xEB7B, 0xEB7E, 0xC866DEA9, 2, 7, &aotBlock_EB7B },
+    { 0xEB7F, 0xEB7F, 0xE50C2ABF, 1, 6, &aotBlock_EB7F },
+    { 0xEB80, 0xEB82, 0x60AFD307, 1, 6, &aotBlock_EB80 },
+    { 0xEB83, 0xEB85, 0x619962B4, 1, 6, &aotBlock_EB83 },
+    { 0xEB86, 0xEB8E, 0x6A0CFD8F, 5, 13, &aotBlock_EB86 },
+    { 0xEB8F, 0xEB91, 0x26C44400, 2, 11, &aotBlock_EB8F },
+    { 0xEB91, 0xEB91, 0xE50C2ABF, 1, 6, &aotBlock_EB91 },
+    { 0xEB92, 0xEBAD, 0xE05DEEB0, 13, 44, &aotBlock_EB92 },
+    { 0xEBAE, 0xEBB2, 0x9BC23166, 2, 8, &aotBlock_EBAE },
+    { 0xEBB3, 0xEBB5, 0x3C3EE939, 1, 6, &aotBlock_EBB3 },
+    { 0xEBB6, 0xEBBD, 0x5CBBAA0A, 4, 9, &aotBlock_EBB6 },
+    { 0xEBB8, 0xEBBD, 0x87796E0F, 3, 7, &aotBlock_EBB8 },
+    { 0xEBBA, 0xEBBD, 0xFD39E0B7, 2, 5, &aotBlock_EBBA },
+    { 0xEBBE, 0xEBC3, 0xDEAED04E, 3, 9, &aotBlock_EBBE },
+    { 0xEBC4, 0xEBC6, 0x5A880E8E, 1, 6, &aotBlock_EBC4 },
+    { 0xEBC7, 0xEBC8, 0x09395848, 1, 2, &aotBlock_EBC7 },
+    { 0xEBC9, 0xEBCC, 0x0EF1FB0C, 2, 4, &aotBlock_EBC9 },
+    { 0xEBCD, 0xEBCF, 0x3C3EE939, 1, 6, &aotBlock_EBCD },
+    { 0xEBD0, 0xEBD7, 0x60361A00, 4, 8, &aotBlock_EBD0 },
+    { 0xEBD2, 0xEBD7, 0x64D75071, 3, 6, &aotBlock_EBD2 },
+    { 0xEBD8, 0xEBDB, 0x9FFFBAC2, 2, 4, &aotBlock_EBD8 },
+    { 0xEBDC, 0xEBE0, 0x5E65E53D, 2, 8, &aotBlock_EBDC },
+    { 0xEBDE, 0xEBE0, 0x3DFBA944, 1, 6, &aotBlock_EBDE },
+    { 0xEBE1, 0xEBE5, 0x9EB5A146, 3, 6, &aotBlock_EBE1 },
+    { 0xEBE6, 0xEBE8, 0x3C3EE939, 1, 6, &aotBlock_EBE6 },
+    { 0xEBE9, 0xEBEB, 0x36362E41, 2, 4, &aotBlock_EBE9 },
+    { 0xEBEC, 0xEBF9, 0x6386E9A4, 7, 22, &aotBlock_EBEC },
+    { 0xEBF4, 0xEBF9, 0xD67EFC71, 2, 10, &aotBlock_EBF4 },
+    { 0xEBFA, 0xEBFD, 0x03CAF583, 3, 6, &aotBlock_EBFA },
+    { 0xEBFE, 0xEC03, 0xC119B846, 3, 7, &aotBlock_EBFE },
+    { 0xEC04, 0xEC07, 0x9949F015, 2, 4, &aotBlock_EC04 },
+    { 0xEC08, 0xEC14, 0x8117150D, 8, 23, &aotBlock_EC08 },
+    { 0xEC15, 0xEC19, 0xE3859507, 2, 8, &aotBlock_EC15 },
+    { 0xEC1A, 0xEC1C, 0x384EBC07, 1, 3, &aotBlock_EC1A },
+    { 0xEC1D, 0xEC1F, 0x3C3EE939, 1, 6, &aotBlock_EC1D },
+    { 0xEC20, 0xEC26, 0x12C27986, 4, 13, &aotBlock_EC20 },
+    { 0xEC27, 0xEC2B, 0xF23190E4, 2, 8, &aotBlock_EC27 },
+    { 0xEC2C, 0xEC30, 0xD3744813, 2, 8, &aotBlock_EC2C },
+    { 0xEC31, 0xEC37, 0xDC14E154, 3, 10, &aotBlock_EC31 },
+    { 0xEC33, 0xEC37, 0x4EDD9729, 2, 8, &aotBlock_EC33 },
+    { 0xEC38, 0xEC3A, 0x3B19B99F, 1, 6, &aotBlock_EC38 },
+    { 0xEC3B, 0xEC3F, 0xC4AE4E7B, 2, 8, &aotBlock_EC3B },
+    { 0xEC40, 0xEC44, 0xAC704B3B, 2, 5, &aotBlock_EC40 },
+    { 0xEC45, 0xEC47, 0x3B19B99F, 1, 6, &aotBlock_EC45 },
+    { 0xEC48, 0xEC4C, 0xC4AE4E7B, 2, 8, &aotBlock_EC48 },
+    { 0xEC4D, 0xEC51, 0x49D4FEE6, 2, 5, &aotBlock_EC4D },
+    { 0xEC52, 0xEC54, 0x3C888AEB, 1, 6, &aotBlock_EC52 },
+    { 0xEC55, 0xEC57, 0x3B19B99F, 1, 6, &aotBlock_EC55 },
+    { 0xEC58, 0xEC5C, 0x82771316, 2, 5, &aotBlock_EC58 },
+    { 0xEC5D, 0xEC5F, 0x3C888AEB, 1, 6, &aotBlock_EC5D },
+    { 0xEC60, 0xEC62, 0x3B19B99F, 1, 6, &aotBlock_EC60 },
+    { 0xEC63, 0xEC65, 0x38F678A0, 1, 6, &aotBlock_EC63 },
+    { 0xEC66, 0xEC67, 0xE03917BD, 1, 2, &aotBlock_EC66 },
+    { 0xEC68, 0xEC6A, 0x5EBB35E1, 1, 6, &aotBlock_EC68 },
+    { 0xEC6B, 0xEC6C, 0xB538D40C, 1, 2, &aotBlock_EC6B },
+    { 0xEC6D, 0xEC71, 0xD3744813, 2, 8, &aotBlock_EC6D },
+    { 0xEC72, 0xEC76, 0x41AE21CA, 2, 8, &aotBlock_EC72 },
+    { 0xEC77, 0xEC79, 0x66CB0EC4, 2, 4, &aotBlock_EC77 },
+    { 0xEC7A, 0xEC7C, 0x5C79DFCE, 1, 6, &aotBlock_EC7A },
+    { 0xEC7D, 0xEC7E, 0x9438A019, 1, 2, &aotBlock_EC7D },
+    { 0xEC7F, 0xEC81, 0x5C79DFCE, 1, 6, &aotBlock_EC7F },
+    { 0xEC82, 0xEC83, 0xCC38F841, 1, 2, &aotBlock_EC82 },
+    { 0xEC84, 0xEC86, 0x3C888AEB, 1, 6, &aotBlock_EC84 },
+    { 0xEC87, 0xEC89, 0x5C79DFCE, 1, 6, &aotBlock_EC87 },
+    { 0xEC8A, 0xEC8B, 0xC438EBA9, 1, 2, &aotBlock_EC8A },
+    { 0xEC8C, 0xEC8E, 0x3C888AEB, 1, 6, &aotBlock_EC8C },
+    { 0xEC8F, 0xEC91, 0x5C79DFCE, 1, 6, &aotBlock_EC8F },
+    { 0xEC92, 0xEC94, 0x38F678A0, 1, 6, &aotBlock_EC92 },
+    { 0xEC95, 0xEC96, 0xCF38FCFA, 1, 2, &aotBlock_EC95 },
+    { 0xEC97, 0xEC97, 0xE50C2ABF, 1, 6, &aotBlock_EC97 },
+    { 0xEC98, 0xEC9C, 0xA3D3332B, 2, 5, &aotBlock_EC98 },
+    { 0xEC9D, 0xEC9F, 0x3B19B99F, 1, 6, &aotBlock_EC9D },
+    { 0xECA0, 0xECA4, 0xC4AE4E7B, 2, 8, &aotBlock_ECA0 },
+    { 0xECA5, 0xECA9, 0xD3744813, 2, 8, &aotBlock_ECA5 },
+    { 0xECAA, 0xECB7, 0x666C995D, 7, 20, &aotBlock_ECAA },
+    { 0xECB8, 0xECBC, 0xD3744813, 2, 8, &aotBlock_ECB8 },
+    { 0xECBD, 0xECD7, 0x715F514E, 17, 42, &aotBlock_ECBD },
+    { 0xECC8, 0xECD7, 0xC2567E3C, 11, 25, &aotBlock_ECC8 },
+    { 0xECD8, 0xECDD, 0x2CBF7CAD, 3, 7, &aotBlock_ECD8 },
+    { 0xECD9, 0xECDD, 0x6A0902E5, 2, 5, &aotBlock_ECD9 },
+    { 0xECDE, 0xECE8, 0xC77B4602, 7, 21, &aotBlock_ECDE },
+    { 0xECE9, 0xECEB, 0x1793AC98, 1, 3, &aotBlock_ECE9 },
+    { 0xECEC, 0xECF5, 0xFB5D5DC4, 5, 12, &aotBlock_ECEC },
+    { 0xECF6, 0xECF9, 0x526389AD, 2, 4, &aotBlock_ECF6 },
+    { 0xECFA, 0xECFC, 0x3DFBA944, 1, 6, &aotBlock_ECFA },
+    { 0xECFD, 0xECFE, 0x0D395E94, 1, 2, &aotBlock_ECFD },
+    { 0xECFF, 0xED01, 0x60AFD307, 1, 6, &aotBlock_ECFF },
+    { 0xED02, 0xED04, 0x58C10F90, 1, 6, &aotBlock_ED02 },
+    { 0xED05, 0xED08, 0x43C2850E, 2, 7, &aotBlock_ED05 },
+    { 0xED09, 0xED0B, 0x5CE4DDF0, 1, 6, &aotBlock_ED09 },
+    { 0xED0C, 0xED13, 0x547F202B, 4, 13, &aotBlock_ED0C },
+    { 0xED14, 0xED1C, 0x0EE75BE3, 4, 10, &aotBlock_ED14 },
+    { 0xED1D, 0xED1F, 0x385ECF56, 1, 3, &aotBlock_ED1D },
+    { 0xED20, 0xED23, 0x8C1C73F1, 2, 4, &aotBlock_ED20 },
+    { 0xED24, 0xED27, 0xF99E179D, 2, 4, &aotBlock_ED24 },
+    { 0xED28, 0xED2B, 0x236E3AE5, 2, 4, &aotBlock_ED28 },
+    { 0xED2C, 0xED2F, 0x19B22EDC, 2, 4, &aotBlock_ED2C },
+    { 0xED30, 0xED33, 0x64F16DA3, 2, 4, &aotBlock_ED30 },
+    { 0xED34, 0xED3B, 0x1D3C1C3F, 4, 14, &aotBlock_ED34 },
+    { 0xED35, 0xED3B, 0xD0648A29, 3, 12, &aotBlock_ED35 },
+    { 0xED3C, 0xED3F, 0xDD9D6BFC, 2, 5, &aotBlock_ED3C },
+    { 0xED40, 0xED43, 0xE7B1E026, 2, 4, &aotBlock_ED40 },
+    { 0xED44, 0xED47, 0x199E49FD, 2, 4, &aotBlock_ED44 },
+    { 0xED48, 0xED4E, 0xB819A0C3, 4, 12, &aotBlock_ED48 },
+    { 0xED4F, 0xED51, 0x3A4BB206, 1, 6, &aotBlock_ED4F },
+    { 0xED52, 0xED56, 0x2D53CE0D, 2, 8, &aotBlock_ED52 },
+    { 0xED57, 0xED59, 0x55F2D4B0, 1, 6, &aotBlock_ED57 },
+    { 0xED5A, 0xED5B, 0xA038B2FD, 1, 2, &aotBlock_ED5A },
+    { 0xED5C, 0xED60, 0x74B17EE3, 2, 9, &aotBlock_ED5C },
+    { 0xED5E, 0xED60, 0x5F86B07A, 1, 6, &aotBlock_ED5E },
+    { 0xED61, 0xED62, 0xA738BE02, 1, 2, &aotBlock_ED61 },
+    { 0xED63, 0xED66, 0x928A1825, 2, 5, &aotBlock_ED63 },
+    { 0xED67, 0xED77, 0x225A420D, 9, 24, &aotBlock_ED67 },
+    { 0xED70, 0xED77, 0x1EC76DFF, 4, 10, &aotBlock_ED70 },
+    { 0xED71, 0xED77, 0xB3DE3C39, 3, 8, &aotBlock_ED71 },
+    { 0xED78, 0xED7B, 0x57B7AB4C, 2, 4, &aotBlock_ED78 },
+    { 0xED7C, 0xED7F, 0x226E3952, 2, 4, &aotBlock_ED7C },
+    { 0xED80, 0xED96, 0xFD759CA5, 12, 33, &aotBlock_ED80 },
+    { 0xED86, 0xED96, 0xF523E7B0, 9, 25, &aotBlock_ED86 },
+    { 0xED97, 0xEDA0, 0x77CE0DEB, 5, 14, &aotBlock_ED97 },
+    { 0xEDA1, 0xEDAA, 0x3E1D647D, 5, 14, &aotBlock_EDA1 },
+    { 0xEDAB, 0xEDB3, 0x081FCFBF, 5, 12, &aotBlock_EDAB },
+    { 0xEDB4, 0xEDB6, 0x382A485C, 1, 3, &aotBlock_EDB4 },
+    { 0xEDB7, 0xEDC8, 0xF7BBE258, 9, 26, &aotBlock_EDB7 },
+    { 0xEDC9, 0xEDCC, 0x040B6FFF, 2, 4, &aotBlock_EDC9 },
+    { 0xEDCD, 0xEDD4, 0x5226192C, 4, 10, &aotBlock_EDCD },
+    { 0xEDD5, 0xEDD8, 0xA7BAC8AD, 2, 4, &aotBlock_EDD5 },
+    { 0xEDD9, 0xEDE8, 0x1B3D2A3C, 10, 23, &aotBlock_EDD9 },
+    { 0xEDE1, 0xEDE8, 0x609A269B, 4, 10, &aotBlock_EDE1 },
+    { 0xEDE9, 0xEDEC, 0xD419FA60, 2, 4, &aotBlock_EDE9 },
+    { 0xEDED, 0xEDF2, 0x9926489F, 3, 7, &aotBlock_EDED },
+    { 0xEDF3, 0xEDF6, 0xBF9D3CC2, 2, 5, &aotBlock_EDF3 },
+    { 0xEDF7, 0xEDFA, 0x5ADA7066, 2, 4, &aotBlock_EDF7 },
+    { 0xEDFB, 0xEDFE, 0xDBBC7653, 2, 4, &aotBlock_EDFB },
+    { 0xEDFF, 0xEE02, 0x7DDBDC1F, 2, 5, &aotBlock_EDFF },
+    { 0xEE03, 0xEE0C, 0x0A2FBD88, 5, 12, &aotBlock_EE03 },
+    { 0xEE0D, 0xEE10, 0x1C712D43, 2, 4, &aotBlock_EE0D },
+    { 0xEE11, 0xEE13, 0x17E6274A, 1, 3, &aotBlock_EE11 },
+    { 0xEE14, 0xEE17, 0x6AD75A77, 2, 4, &aotBlock_EE14 },
+    { 0xEE18, 0xEE1E, 0x223FBF53, 4, 10, &aotBlock_EE18 },
+    { 0xEE1F, 0xEE20, 0xF6C27AA2, 1, 2, &aotBlock_EE1F },
+    { 0xEE21, 0xEE24, 0xF655ABC6, 2, 4, &aotBlock_EE21 },
+    { 0xEE25, 0xEE28, 0xF252DC2A, 2, 8, &aotBlock_EE25 },
+    { 0xEE26, 0xEE28, 0x5FAFD174, 1, 6, &aotBlock_EE26 },
+    { 0xEE29, 0xEE2D, 0xCDDD07D6, 3, 9, &aotBlock_EE29 },
+    { 0xEE2E, 0xEE39, 0x9E0B194E, 6, 19, &aotBlock_EE2E },
+    { 0xEE3A, 0xEE3D, 0x8C42AAAF, 2, 4, &aotBlock_EE3A },
+    { 0xEE3E, 0xEE41, 0xF655ABC6, 2, 4, &aotBlock_EE3E },
+    { 0xEE42, 0xEE45, 0xF252DC2A, 2, 8, &aotBlock_EE42 },
+    { 0xEE43, 0xEE45, 0x5FAFD174, 1, 6, &aotBlock_EE43 },
+    { 0xEE46, 0xEE4A, 0xA4DCC74B, 3, 9, &aotBlock_EE46 },
+    { 0xEE4B, 0xEE5B, 0x307F8934, 9, 30, &aotBlock_EE4B },
+    { 0xEE5C, 0xEE5F, 0x0F705D7C, 2, 4, &aotBlock_EE5C },
+    { 0xEE60, 0xEE62, 0x1809EF5E, 1, 3, &aotBlock_EE60 },
+    { 0xEE63, 0xEE67, 0x7DBA4969, 3, 8, &aotBlock_EE63 },
+    { 0xEE68, 0xEE6C, 0x61CD4D7A, 2, 5, &aotBlock_EE68 },
+    { 0xEE6D, 0xEE70, 0x72969D9C, 2, 4, &aotBlock_EE6D },
+    { 0xEE71, 0xEE76, 0xDE068FB5, 3, 7, &aotBlock_EE71 },
+    { 0xEE77, 0xEE7B, 0xAAC06D37, 2, 8, &aotBlock_EE77 },
+    { 0xEE7C, 0xEE7F, 0x0584EDED, 2, 4, &aotBlock_EE7C },
+    { 0xEE80, 0xEE83, 0x625F8F93, 2, 5, &aotBlock_EE80 },
+    { 0xEE84, 0xEE88, 0xAAC06D37, 2, 8, &aotBlock_EE84 },
+    { 0xEE89, 0xEE8C, 0x28936EBF, 2, 4, &aotBlock_EE89 },
+    { 0xEE8D, 0xEE93, 0xA9EF475B, 3, 8, &aotBlock_EE8D },
+    { 0xEE94, 0xEE99, 0xB2025458, 3, 7, &aotBlock_EE94 },
+    { 0xEE9A, 0xEE9D, 0x9F9CDF53, 2, 4, &aotBlock_EE9A },
+    { 0xEE9E, 0xEEA1, 0xA61B44F6, 2, 4, &aotBlock_EE9E },
+    { 0xEEA2, 0xEEA4, 0x3AA5B70D, 1, 3, &aotBlock_EEA2 },
+    { 0xEEA5, 0xEEAA, 0xFBA56F99, 3, 7, &aotBlock_EEA5 },
+    { 0xEEAB, 0xEEAE, 0xF655ABC6, 2, 4, &aotBlock_EEAB },
+    { 0xEEAF, 0xEEB3, 0x691A0C8C, 3, 11, &aotBlock_EEAF },
+    { 0xEEB0, 0xEEB3, 0x7D6369EA, 2, 9, &aotBlock_EEB0 },
+    { 0xEEB4, 0xEEB9, 0x266C070E, 4, 11, &aotBlock_EEB4 },
+    { 0xEEBA, 0xEEBD, 0x29DB57E3, 2, 5, &aotBlock_EEBA },
+    { 0xEEBE, 0xEEC2, 0x44A71122, 2, 5, &aotBlock_EEBE },
+    { 0xEEC3, 0xEEC7, 0x26FEEF2A, 2, 5, &aotBlock_EEC3 },
+    { 0xEEC8, 0xEECA, 0x382A485C, 1, 3, &aotBlock_EEC8 },
+    { 0xEECB, 0xEED1, 0x11CF1C80, 3, 8, &aotBlock_EECB },
+    { 0xEECD, 0xEED1, 0x7CA08791, 2, 6, &aotBlock_EECD },
+    { 0xEED2, 0xEED4, 0x4A846C9D, 2, 4, &aotBlock_EED2 },
+    { 0xEED5, 0xEED6, 0xDF39162A, 1, 2, &aotBlock_EED5 },
+    { 0xEED7, 0xEEDC, 0x9A80F2BC, 3, 7, &aotBlock_EED7 },
+    { 0xEEDD, 0xEEEA, 0xEB09FEDE, 7, 19, &aotBlock_EEDD },
+    { 0xEEE2, 0xEEEA, 0xC370791C, 4, 11, &aotBlock_EEE2 },
+    { 0xEEE4, 0xEEEA, 0xBF468A3E, 3, 9, &aotBlock_EEE4 },
+    { 0xEEEB, 0xEEF1, 0xA1B571AC, 3, 9, &aotBlock_EEEB },
+    { 0xEEF2, 0xEEF4, 0xF4B4765E, 2, 4, &aotBlock_EEF2 },
+    { 0xEEF5, 0xEEFA, 0x1F669C30, 3, 7, &aotBlock_EEF5 },
+    { 0xEEFB, 0xEF00, 0x9A1581E0, 3, 7, &aotBlock_EEFB },
+    { 0xEF01, 0xEF04, 0xB8FA05A1, 2, 4, &aotBlock_EF01 },
+    { 0xEF05, 0xEF0A, 0x150DB997, 3, 7, &aotBlock_EF05 },
+    { 0xEF0B, 0xEF0E, 0x7A69C385, 2, 4, &aotBlock_EF0B },
+    { 0xEF0F, 0xEF14, 0x6F96902E, 3, 7, &aotBlock_EF0F },
+    { 0xEF15, 0xEF18, 0x962B9B4C, 2, 4, &aotBlock_EF15 },
+    { 0xEF19, 0xEF1E, 0x80B76EDE, 3, 7, &aotBlock_EF19 },
+    { 0xEF1F, 0xEF28, 0xC89FAEA7, 5, 12, &aotBlock_EF1F },
+    { 0xEF29, 0xEF2B, 0x3B690E51, 1, 6, &aotBlock_EF29 },
+    { 0xEF2C, 0xEF33, 0x2438C03A, 4, 11, &aotBlock_EF2C },
+    { 0xEF34, 0xEF37, 0xAF286D77, 2, 4, &aotBlock_EF34 },
+    { 0xEF38, 0xEF3A, 0x5DAAA589, 1, 6, &aotBlock_EF38 },
+    { 0xEF3B, 0xEF4A, 0x23DE789C, 9, 26, &aotBlock_EF3B },
+    { 0xEF4B, 0xEF56, 0xC2A6A405, 6, 19, &aotBlock_EF4B },
+    { 0xEF57, 0xEF65, 0x0A98B4A3, 7, 27, &aotBlock_EF57 },
+    { 0xEF5B, 0xEF65, 0x5FD9F638, 5, 18, &aotBlock_EF5B },
+    { 0xEF66, 0xEF6D, 0xF0C68ABB, 5, 14, &aotBlock_EF66 },
+    { 0xEF6E, 0xEF72, 0x3FEC2881, 2, 8, &aotBlock_EF6E },
+    { 0xEF70, 0xEF72, 0x1793AC98, 1, 3, &aotBlock_EF70 },
+    { 0xEF73, 0xEF75, 0x5B57F790, 1, 6, &aotBlock_EF73 },
+    { 0xEF76, 0xEF79, 0x069B06AB, 2, 4, &aotBlock_EF76 },
+    { 0xEF7A, 0xEF8A, 0xD39E7061, 10, 31, &aotBlock_EF7A },
+    { 0xEF8B, 0xEF8D, 0x5B57F790, 1, 6, &aotBlock_EF8B },
+    { 0xEF8E, 0xEF93, 0x2880E443, 3, 7, &aotBlock_EF8E },
+    { 0xEF90, 0xEF93, 0x3D630C54, 2, 5, &aotBlock_EF90 },
+    { 0xEF94, 0xEF99, 0x6C213393, 3, 10, &aotBlock_EF94 },
+    { 0xEF96, 0xEF99, 0x0ED58CE4, 2, 5, &aotBlock_EF96 },
+    { 0xEF9A, 0xEF9D, 0xDD02B018, 2, 4, &aotBlock_EF9A },
+    { 0xEF9E, 0xEFA1, 0xC72BFE5B, 2, 5, &aotBlock_EF9E },
+    { 0xEFA2, 0xEFA4, 0xA56AB4BC, 2, 9, &aotBlock_EFA2 },
+    { 0xEFA5, 0xEFA8, 0x952D42A5, 2, 5, &aotBlock_EFA5 },
+    { 0xEFA9, 0xEFAB, 0x382A485C, 1, 3, &aotBlock_EFA9 },
+    { 0xEFAC, 0xEFBA, 0x5CF305EC, 10, 24, &aotBlock_EFAC },
+    { 0xEFB2, 0xEFBA, 0xCDF099BE, 5, 12, &aotBlock_EFB2 },
+    { 0xEFB3, 0xEFBA, 0xE8915950, 4, 10, &aotBlock_EFB3 },
+    { 0xEFBB, 0xEFBE, 0x5FDBD2F7, 2, 4, &aotBlock_EFBB },
+    { 0xEFBF, 0xEFC2, 0x0F0D0E26, 2, 4, &aotBlock_EFBF },
+    { 0xEFC3, 0xEFC4, 0xE3391C76, 1, 2, &aotBlock_EFC3 },
+    { 0xEFC5, 0xEFC8, 0x60BDDD5C, 2, 4, &aotBlock_EFC5 },
+    { 0xEFC9, 0xEFCC, 0xC1A01BE9, 2, 8, &aotBlock_EFC9 },
+    { 0xEFCD, 0xEFD0, 0xC09F50E2, 2, 4, &aotBlock_EFCD },
+    { 0xEFD1, 0xEFD4, 0xDAECD58B, 3, 6, &aotBlock_EFD1 },
+    { 0xEFD5, 0xEFD9, 0x05462DD0, 3, 8, &aotBlock_EFD5 },
+    { 0xEFDA, 0xEFE2, 0xA6779CDB, 5, 10, &aotBlock_EFDA },
+    { 0xEFDE, 0xEFE2, 0x5C995528, 3, 6, &aotBlock_EFDE },
+    { 0xEFE3, 0xEFE5, 0x60AFD307, 1, 6, &aotBlock_EFE3 },
+    { 0xEFE6, 0xEFEB, 0xD67EFC71, 2, 10, &aotBlock_EFE6 },
+    { 0xEFEC, 0xEFF2, 0xAD19BCA7, 3, 12, &aotBlock_EFEC },
+    { 0xEFF3, 0xEFF9, 0xAD19BCA7, 3, 12, &aotBlock_EFF3 },
+    { 0xEFFA, 0xEFFE, 0x5BEC3374, 3, 6, &aotBlock_EFFA },
+    { 0xEFFF, 0xF002, 0x5242D392, 2, 4, &aotBlock_EFFF },
+    { 0xF003, 0xF007, 0xC246927F, 2, 8, &aotBlock_F003 },
+    { 0xF008, 0xF00C, 0xE3859507, 2, 8, &aotBlock_F008 },
+    { 0xF00D, 0xF00F, 0xB640B971, 2, 4, &aotBlock_F00D },
+    { 0xF010, 0xF012, 0x60AFD307, 1, 6, &aotBlock_F010 },
+    { 0xF013, 0xF013, 0xE50C2ABF, 1, 6, &aotBlock_F013 },
+};
+
+const unsigned g_romAotBlockCount = sizeof(g_romAotBlocks) / sizeof(g_romAotBlocks[0]);
@@ -0,0 +1,251 @@
+#include "mcu_savestate.hpp"
+#include "mcu_rewind.hpp"
+
+#include <fstream>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static const char cMagic[8] = { 'H', 'K', '6', '5', 'C', '0', '2', 'S' };
+
+// Bits of tHeader::m_flags
+static const uint8_t cFlagNMILine       = 0x01;
+static const uint8_t cFlagNMIPending    = 0x02;
+static const uint8_t cFlagWaiting       = 0x04;
+static const uint8_t cFlagStopped       = 0x08;
+static const uint8_t cFlagViaIRQ        = 0x10;
+
+// Followed by the serial FIFOs' bytes, to-MCU first, and then zeros up to the memory image
+struct tMCUSaveState::tHeader
+{
+    char     m_magic[8];
+    uint32_t m_version;
+    uint32_t m_headerSize; // Including the FIFO bytes
+    uint64_t m_cycleCount;
+    uint64_t m_viaStartCycle[2];
+    uint64_t m_viaEventCycle[2];
+    uint32_t m_irqLines;
+    uint32_t m_serialToMCUSize;
+    uint32_t m_serialFromMCUSize;
+    uint16_t m_regPC;
+    uint16_t m_viaLatch[2];
+    uint16_t m_viaStartValue[2];
+    uint8_t  m_regA;
+    uint8_t  m_regX;
+    uint8_t  m_regY;
+    uint8_t  m_regP;
+    uint8_t  m_regSP;
+    uint8_t  m_viaAuxControl;
+    uint8_t  m_viaInterruptFlags;
+    uint8_t  m_viaInterruptEnable;
+    uint8_t  m_flags; // cFlag... bits
+};
+
+tMCUSaveState::tMCUSaveState()
+    : m_pMapping( 0 )
+    , m_mappingSize( 0 )
+    , m_pHeader( 0 )
+    , m_pMemory( 0 )
+{
+}
+
+tMCUSaveState::~tMCUSaveState()
+{
+    unload();
+}
+
+bool tMCUSaveState::save( tMCUState& rState, const char *pFileName )
+{
+    std::vector< uint8_t > serialToMCU;
+    {
+        std::lock_guard< std::mutex > lock( rState.m_serialMutex );
+        std::queue< uint8_t > fifo = rState.m_serialToMCUFIFO;
+        for( ; !fifo.empty(); fifo.pop() )
+            serialToMCU.push_back( fifo.front() );
+    }
+
+    std::vector< uint8_t > serialFromMCU;
+    for( std::queue< uint8_t > fifo = rState.m_serialFromMCUFIFO; !fifo.empty(); fifo.pop() )
+        serialFromMCU.push_back( fifo.front() );
+
+    if( sizeof(tHeader) + serialToMCU.size() + serialFromMCU.size() > cMemoryOffset )
+        return false;
+
+    tHeader header;
+    memset( &header, 0, sizeof(header) );
+    memcpy( header.m_magic, cMagic, sizeof(cMagic) );
+    header.m_version = cVersion;
+    header.m_headerSize = uint32_t(sizeof(tHeader) + serialToMCU.size() + serialFromMCU.size());
+    header.m_cycleCount = rState.getCycleCount();
+    header.m_irqLines = rState.m_irqLines;
+    header.m_serialToMCUSize = uint32_t(serialToMCU.size());
+    header.m_serialFromMCUSize = uint32_t(serialFromMCU.size());
+    header.m_regPC = rState.regPC;
+    header.m_regA = rState.regA;
+    header.m_regX = rState.regX;
+    header.m_regY = rState.regY;
+    header.m_regP = rState.regP;
+    header.m_regSP = rState.regSP;
+    header.m_flags = (rState.m_nmiLine ? cFlagNMILine : 0) | (rState.m_nmiPending ? cFlagNMIPending : 0)
+        | (rState.m_waiting ? cFlagWaiting : 0) | (rState.m_stopped ? cFlagStopped : 0);
+
+    tMCUVia::tSavedState via;
+    rState.m_via.saveState( via );
+    for( unsigned timer = 0; timer < 2; ++timer )
+    {
+        header.m_viaStartCycle[timer] = via.m_startCycle[timer];
+        header.m_viaEventCycle[timer] = via.m_eventCycle[timer];
+        header.m_viaLatch[timer] = via.m_latch[timer];
+        header.m_viaStartValue[timer] = via.m_startValue[timer];
+    }
+    header.m_viaAuxControl = via.m_auxControl;
+    header.m_viaInterruptFlags = via.m_interruptFlags;
+    header.m_viaInterruptEnable = via.m_interruptEnable;
+    header.m_flags |= via.m_irqAsserted ? cFlagViaIRQ : 0;
+
+    std::vector< char > padding( cMemoryOffset - header.m_headerSize, 0 );
+
+    std::ofstream file( pFileName, std::ios::binary | std::ios::trunc );
+    file.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+    if( !serialToMCU.empty() )
+        file.write( reinterpret_cast<const char*>(&serialToMCU[0]), serialToMCU.size() );
+    if( !serialFromMCU.empty() )
+        file.write( reinterpret_cast<const char*>(&serialFromMCU[0]), serialFromMCU.size() );
+    file.write( &padding[0], padding.size() );
+    file.write( reinterpret_cast<const char*>(rState.m_pMemory), 65536 );
+
+    return file.good();
+}
+
+bool tMCUSaveState::load( const char *pFileName )
+{
+    unload();
+
+    size_t mappingSize = cMemoryOffset + 65536;
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA( pFileName, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0 );
+    if( file == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = 0;
+    if( GetFileSizeEx( file, &fileSize ) && uint64_t(fileSize.QuadPart) >= mappingSize )
+        mapping = CreateFileMappingA( file, 0, PAGE_WRITECOPY, 0, 0, 0 );
+    CloseHandle( file );
+    if( !mapping )
+        return false;
+
+    // The view keeps the mapping open
+    void *pMapping = MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, mappingSize );
+    CloseHandle( mapping );
+    if( !pMapping )
+        return false;
+#else
+    int file = open( pFileName, O_RDONLY );
+    if( file < 0 )
+        return false;
+
+    struct stat fileStat;
+    void *pMapping = MAP_FAILED;
+    if( fstat( file, &fileStat ) == 0 && uint64_t(fileStat.st_size) >= mappingSize )
+        pMapping = mmap( 0, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0 );
+    ::close( file );
+    if( pMapping == MAP_FAILED )
+        return false;
+#endif
+
+    m_pMapping = pMapping;
+    m_mappingSize = mappingSize;
+    m_pHeader = static_cast<const tHeader*>(pMapping);
+    m_pMemory = static_cast<uint8_t*>(pMapping) + cMemoryOffset;
+
+    if( memcmp( m_pHeader->m_magic, cMagic, sizeof(cMagic) ) != 0 || m_pHeader->m_version != cVersion
+        || m_pHeader->m_headerSize > cMemoryOffset
+        || uint64_t(m_pHeader->m_serialToMCUSize) + m_pHeader->m_serialFromMCUSize != m_pHeader->m_headerSize - sizeof(tHeader) )
+    {
+        unload();
+        return false;
+    }
+
+    return true;
+}
+
+void tMCUSaveState::unload()
+{
+    if( !m_pMapping )
+        return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile( m_pMapping );
+#else
+    munmap( m_pMapping, m_mappingSize );
+#endif
+
+    m_pMapping = 0;
+    m_mappingSize = 0;
+    m_pHeader = 0;
+    m_pMemory = 0;
+}
+
+void tMCUSaveState::apply( tMCUState& rState ) const
+{
+    assert( m_pHeader );
+    const tHeader& rHeader = *m_pHeader;
+
+    if( rState.m_pMemory != m_pMemory )
+    {
+        memcpy( rState.m_pMemory, m_pMemory, 65536 );
+        rState.invalidateCode();
+    }
+
+    rState.regA = rHeader.m_regA;
+    rState.regX = rHeader.m_regX;
+    rState.regY = rHeader.m_regY;
+    rState.regP = rHeader.m_regP;
+    rState.regSP = rHeader.m_regSP;
+    rState.regPC = rHeader.m_regPC;
+    rState.setCycleCount( rHeader.m_cycleCount );
+    rState.m_irqLines = rHeader.m_irqLines;
+    rState.m_nmiLine = (rHeader.m_flags & cFlagNMILine) != 0;
+    rState.m_nmiPending = (rHeader.m_flags & cFlagNMIPending) != 0;
+    rState.m_waiting = (rHeader.m_flags & cFlagWaiting) != 0;
+    rState.m_stopped = (rHeader.m_flags & cFlagStopped) != 0;
+
+    tMCUVia::tSavedState via;
+    for( unsigned timer = 0; timer < 2; ++timer )
+    {
+        via.m_startCycle[timer] = rHeader.m_viaStartCycle[timer];
+        via.m_eventCycle[timer] = rHeader.m_viaEventCycle[timer];
+        via.m_latch[timer] = rHeader.m_viaLatch[timer];
+        via.m_startValue[timer] = rHeader.m_viaStartValue[timer];
+    }
+    via.m_auxControl = rHeader.m_viaAuxControl;
+    via.m_interruptFlags = rHeader.m_viaInterruptFlags;
+    via.m_interruptEnable = rHeader.m_viaInterruptEnable;
+    via.m_irqAsserted = (rHeader.m_flags & cFlagViaIRQ) != 0;
+    rState.m_via.restoreState( via, true );
+
+    const uint8_t *pSerial = reinterpret_cast<const uint8_t*>(m_pHeader + 1);
+    {
+        std::lock_guard< std::mutex > lock( rState.m_serialMutex );
+        rState.m_serialToMCUFIFO = std::queue< uint8_t >();
+        for( uint32_t byteIndex = 0; byteIndex < rHeader.m_serialToMCUSize; ++byteIndex )
+            rState.m_serialToMCUFIFO.push( *pSerial++ );
+        rState.m_serialToMCUCount = rState.m_serialToMCUFIFO.size();
+    }
+
+    rState.m_serialFromMCUFIFO = std::queue< uint8_t >();
+    for( uint32_t byteIndex = 0; byteIndex < rHeader.m_serialFromMCUSize; ++byteIndex )
+        rState.m_serialFromMCUFIFO.push( *pSerial++ );
+
+    if( rState.m_pRewind )
+        rState.m_pRewind->clear();
+}
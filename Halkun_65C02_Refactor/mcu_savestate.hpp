@@ -0,0 +1,57 @@
+/*
+
+  mcu_savestate.hpp - Save state files, whose memory image is mapped straight into the MCU rather than read
+
+*/
+
+#ifndef MCU_SAVESTATE_HPP
+#define MCU_SAVESTATE_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include "mcu_core.hpp"
+
+//   A save state file is a small header - registers, cycle count, interrupt lines, the VIA and the serial FIFOs -
+// and then the 64k memory image, starting at cMemoryOffset so that it's aligned for mapping on every host.
+// Loading maps the whole file copy-on-write and checks the header, so nothing is copied: instances started from
+// the same file share its pages with the OS's file cache until they write to them.
+//   Devices added with addDevice() aren't saved, and nor are events other than the VIA's timers.  The fields are
+// in the host's byte order.
+class tMCUSaveState
+{
+public:
+    static const uint32_t cVersion = 1;
+    static const uint32_t cMemoryOffset = 65536; // Where the memory image starts - Windows maps in multiples of 64k
+
+    tMCUSaveState();
+    ~tMCUSaveState();
+
+    // Writes rState to pFileName.  Returns false if the file can't be written.
+    static bool save( tMCUState& rState, const char *pFileName );
+
+    //   Maps pFileName, unmapping whatever was loaded before.  Returns false if it can't be mapped, or isn't a save
+    // state of this version.
+    bool load( const char *pFileName );
+    void unload();
+
+    //   The memory image, for constructing the tMCUState on.  Writes go to the process's own copies of the pages,
+    // not to the file.  Only valid until unload(), so this has to outlive the state.
+    uint8_t *getMemory() const { return m_pMemory; }
+
+    //   Puts the registers and everything else in the header into rState.  If rState wasn't constructed on
+    // getMemory(), the image is copied into its memory instead.
+    void apply( tMCUState& rState ) const;
+
+private:
+    struct tHeader;
+
+    tMCUSaveState( const tMCUSaveState& ); // Disallowed - owns the mapping
+
+    void           *m_pMapping;
+    size_t          m_mappingSize;
+    const tHeader  *m_pHeader; // At the start of m_pMapping
+    uint8_t        *m_pMemory; // cMemoryOffset into m_pMapping
+};
+
+#endif
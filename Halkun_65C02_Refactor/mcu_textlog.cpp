@@ -0,0 +1,173 @@
+#include "mcu_textlog.hpp"
+#include "mcu_instr.hpp"
+
+#include <cstring>
+
+// Where each field starts, as in nestest.log
+static const size_t cBytesColumn        = 6;
+static const size_t cDisassemblyColumn  = 16;
+static const size_t cRegistersColumn    = 48;
+
+static const char s_hexDigits[] = "0123456789ABCDEF";
+
+static inline char *putHex8( char *pOut, uint8_t value )
+{
+    pOut[0] = s_hexDigits[value >> 4];
+    pOut[1] = s_hexDigits[value & 0x0F];
+    return pOut + 2;
+}
+
+static inline char *putHex16( char *pOut, uint16_t value )
+{
+    return putHex8( putHex8( pOut, static_cast<uint8_t>(value >> 8) ), static_cast<uint8_t>(value) );
+}
+
+static inline char *putText( char *pOut, const char *pText )
+{
+    while( *pText )
+        *pOut++ = *pText++;
+    return pOut;
+}
+
+static inline char *putDecimal( char *pOut, uint64_t value )
+{
+    char digits[20];
+    unsigned digitCount = 0;
+    do
+    {
+        digits[digitCount++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while( value > 0 );
+
+    while( digitCount > 0 )
+        *pOut++ = digits[--digitCount];
+    return pOut;
+}
+
+tMCUTextLog::tMCUTextLog( tMCUState& rState )
+    : m_rState( rState )
+    , m_pWrite( 0 )
+    , m_pFlushAt( 0 )
+    , m_lineCount( 0 )
+    , m_writeFailed( false )
+{
+    for( unsigned opCode = 0; opCode < 256; ++opCode )
+    {
+        std::string name = rState.decodeOpcodeDirect( static_cast<uint8_t>(opCode) );
+        memcpy( m_mnemonics[opCode], name.size() == 3 ? name.c_str() : "???", 3 );
+        m_modes[opCode] = static_cast<uint8_t>(rState.decodeAddressingModeDirect( static_cast<uint8_t>(opCode) ));
+    }
+}
+
+tMCUTextLog::~tMCUTextLog()
+{
+    close();
+}
+
+bool tMCUTextLog::open( const char *pFileName )
+{
+    close();
+
+    m_file.open( pFileName, std::ios::binary | std::ios::trunc );
+    if( !m_file )
+        return false;
+
+    m_buffer.resize( cBufferSize );
+    m_pWrite = &m_buffer[0];
+    m_pFlushAt = m_pWrite + cBufferSize - cMaxLineLength;
+    m_lineCount = 0;
+    m_writeFailed = false;
+
+    return true;
+}
+
+bool tMCUTextLog::close()
+{
+    if( !m_pWrite )
+        return true;
+
+    flush();
+    m_pWrite = m_pFlushAt = 0;
+    m_file.close();
+
+    return !m_writeFailed && !m_file.fail();
+}
+
+void tMCUTextLog::flush()
+{
+    m_file.write( &m_buffer[0], m_pWrite - &m_buffer[0] );
+    m_writeFailed = m_writeFailed || !m_file;
+    m_pWrite = &m_buffer[0];
+}
+
+void tMCUTextLog::instructionBegin( const tMCURegisters& registers, uint8_t )
+{
+    if( !m_pWrite )
+        return;
+
+    m_pWrite += formatLine( m_pWrite, registers, m_rState.getCycleCount() );
+    ++m_lineCount;
+
+    if( m_pWrite >= m_pFlushAt )
+        flush();
+}
+
+//   The bytes are fetched rather than read, so that devices don't see them - an instruction never runs from a
+// device's addresses anyway
+size_t tMCUTextLog::formatLine( char *pLine, const tMCURegisters& registers, uint64_t cycle ) const
+{
+    uint16_t pc = registers.regPC;
+    uint8_t opCode = m_rState.memFetchByte( pc );
+    unsigned mode = m_modes[opCode];
+    uint8_t operandLow = m_rState.memFetchByte( pc + 1 );
+    uint8_t operandHigh = m_rState.memFetchByte( pc + 2 );
+    uint16_t operandWord = static_cast<uint16_t>(operandLow | (operandHigh << 8));
+
+    unsigned length = 1;
+    if( mode < cAddressingModeAccum )
+        length += m_rState.decodeLength( static_cast<eAddressingMode_Mem>(mode) );
+
+    memset( pLine, ' ', cRegistersColumn );
+
+    putHex16( pLine, pc );
+    char *pOut = putHex8( pLine + cBytesColumn, opCode );
+    if( length > 1 )
+        pOut = putHex8( pOut + 1, operandLow );
+    if( length > 2 )
+        putHex8( pOut + 1, operandHigh );
+
+    pOut = pLine + cDisassemblyColumn;
+    *pOut++ = m_mnemonics[opCode][0];
+    *pOut++ = m_mnemonics[opCode][1];
+    *pOut++ = m_mnemonics[opCode][2];
+    ++pOut;
+
+    switch( mode )
+    {
+    case am_Immediate:      pOut = putHex8( putText( pOut, "#$" ), operandLow ); break;
+    case am_ZeroPage:       pOut = putHex8( putText( pOut, "$" ), operandLow ); break;
+    case am_ZeroPage_X:     pOut = putText( putHex8( putText( pOut, "$" ), operandLow ), ",X" ); break;
+    case am_ZeroPage_Y:     pOut = putText( putHex8( putText( pOut, "$" ), operandLow ), ",Y" ); break;
+    case am_Relative:       pOut = putHex16( putText( pOut, "$" ), static_cast<uint16_t>(pc + 2 + int8_t(operandLow)) ); break;
+    case am_Absolute:       pOut = putHex16( putText( pOut, "$" ), operandWord ); break;
+    case am_Absolute_X:     pOut = putText( putHex16( putText( pOut, "$" ), operandWord ), ",X" ); break;
+    case am_Absolute_Y:     pOut = putText( putHex16( putText( pOut, "$" ), operandWord ), ",Y" ); break;
+    case am_Indirect:       pOut = putText( putHex16( putText( pOut, "($" ), operandWord ), ")" ); break;
+    case am_Indirect_X:     pOut = putText( putHex8( putText( pOut, "($" ), operandLow ), ",X)" ); break;
+    case am_Indirect_Y:     pOut = putText( putHex8( putText( pOut, "($" ), operandLow ), "),Y" ); break;
+    case am_Indirect_ZP:    pOut = putText( putHex8( putText( pOut, "($" ), operandLow ), ")" ); break;
+    case am_AbsIdxIndirect: pOut = putText( putHex16( putText( pOut, "($" ), operandWord ), ",X)" ); break;
+    case cAddressingModeAccum: *pOut = 'A'; break;
+    }
+
+    pOut = pLine + cRegistersColumn;
+    pOut = putHex8( putText( pOut, "A:" ), registers.regA );
+    pOut = putHex8( putText( pOut, " X:" ), registers.regX );
+    pOut = putHex8( putText( pOut, " Y:" ), registers.regY );
+    pOut = putHex8( putText( pOut, " P:" ), registers.regP );
+    pOut = putHex8( putText( pOut, " SP:" ), registers.regSP );
+    pOut = putDecimal( putText( pOut, " CYC:" ), cycle );
+    *pOut++ = '\n';
+
+    return pOut - pLine;
+}
@@ -0,0 +1,69 @@
+/*
+
+  mcu_textlog.hpp - Writes a line of text for every instruction the MCU executes
+
+*/
+
+#ifndef MCU_TEXTLOG_HPP
+#define MCU_TEXTLOG_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <fstream>
+
+#include "mcu_core.hpp"
+
+//   Attached to a tMCUState with setObserver(), this logs each instruction as it starts, in the fixed columns of
+// the nestest logs that other emulators are checked against:
+//
+//   E800  4C 4C E9  JMP $E94C                       A:00 X:00 Y:00 P:00 SP:FF CYC:0
+//
+// Operands are in nestest's syntax (upper case hex, no spaces, branches shown with their target) without the
+// values at the addresses, as reading them could upset a device.  The registers and cycle count are from before
+// the instruction.
+//   Lines are formatted from tables straight into a buffer, which is written out whenever it's nearly full -
+// nothing is allocated once the file is open.
+class tMCUTextLog : public tMCUObserver
+{
+public:
+    static const size_t cBufferSize     = 1 << 20;
+    static const size_t cMaxLineLength  = 128; // Including the '\n'
+
+    tMCUTextLog( tMCUState& rState );
+    ~tMCUTextLog(); // Closes the file
+
+    // Starts a new log in the file.  Returns false if it can't be created.
+    bool open( const char *pFileName );
+
+    // Writes out what's left.  Returns false if anything couldn't be written.
+    bool close();
+
+    bool isOpen() const { return m_pWrite != 0; }
+
+    // Lines logged since open()
+    uint64_t getLineCount() const { return m_lineCount; }
+
+    //   Formats the line for the instruction at registers.regPC into pLine (which has room for cMaxLineLength), and
+    // returns its length
+    size_t formatLine( char *pLine, const tMCURegisters& registers, uint64_t cycle ) const;
+
+    virtual void instructionBegin( const tMCURegisters& registers, uint8_t opCode );
+
+private:
+    tMCUTextLog( const tMCUTextLog& ); // Disallowed
+
+    void flush();
+
+    tMCUState&          m_rState;
+    char                m_mnemonics[256][3]; // "???" for the opcodes that aren't implemented
+    uint8_t             m_modes[256]; // As mcuAddressingModeNumber()
+    std::vector< char > m_buffer;
+    char               *m_pWrite; // Where the next line goes, or 0 when there's no file open
+    char               *m_pFlushAt; // Once m_pWrite gets here, another line might not fit
+    uint64_t            m_lineCount;
+    bool                m_writeFailed;
+    std::ofstream       m_file;
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include "mcu_trace.hpp"
+
+#include <cstring>
+
+tMCUTraceWriter::tMCUTraceWriter()
+    : m_filtered( false )
+    , m_pWrite( 0 )
+    , m_pWriteEnd( 0 )
+    , m_currentBuffer( 0 )
+    , m_recordsWritten( 0 )
+    , m_stalls( 0 )
+    , m_closing( false )
+    , m_writeFailed( false )
+{
+    memset( m_filter, 0xFF, sizeof(m_filter) );
+    memset( &m_current, 0, sizeof(m_current) );
+    memset( m_fullRecords, 0, sizeof(m_fullRecords) );
+}
+
+tMCUTraceWriter::~tMCUTraceWriter()
+{
+    close();
+}
+
+void tMCUTraceWriter::addFilter( uint16_t firstAddress, uint16_t lastAddress )
+{
+    if( !m_filtered )
+    {
+        memset( m_filter, 0, sizeof(m_filter) );
+        m_filtered = true;
+    }
+
+    for( unsigned address = firstAddress; address <= lastAddress; ++address )
+        m_filter[address >> 3] |= 1 << (address & 7);
+}
+
+void tMCUTraceWriter::clearFilters()
+{
+    memset( m_filter, 0xFF, sizeof(m_filter) );
+    m_filtered = false;
+}
+
+bool tMCUTraceWriter::open( const char *pFileName )
+{
+    close();
+
+    m_file.open( pFileName, std::ios::binary | std::ios::trunc );
+    if( !m_file )
+        return false;
+
+    tTraceFileHeader header;
+    memcpy( header.m_magic, "HK65TRCE", sizeof(header.m_magic) );
+    header.m_version = tTraceFileHeader::cVersion;
+    header.m_recordSize = sizeof(tTraceRecord);
+    m_file.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+
+    // Allocated up front, so recording never has to
+    for( unsigned buffer = 0; buffer < cBufferCount; ++buffer )
+    {
+        m_buffers[buffer].resize( cBufferRecords );
+        if( buffer > 0 )
+            m_free.push_back( buffer );
+    }
+
+    m_currentBuffer = 0;
+    m_pWrite = &m_buffers[0][0];
+    m_pWriteEnd = m_pWrite + cBufferRecords;
+    m_recordsWritten = 0;
+    m_stalls = 0;
+    m_closing = false;
+    m_writeFailed = false;
+
+    m_thread = std::thread( &tMCUTraceWriter::writerThread, this );
+
+    return true;
+}
+
+bool tMCUTraceWriter::close()
+{
+    if( !m_pWrite )
+        return true;
+
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+
+        m_fullRecords[m_currentBuffer] = m_pWrite - &m_buffers[m_currentBuffer][0];
+        m_full.push( m_currentBuffer );
+        m_closing = true;
+    }
+
+    m_changed.notify_all();
+    m_thread.join();
+
+    m_recordsWritten += m_pWrite - &m_buffers[m_currentBuffer][0];
+    m_pWrite = m_pWriteEnd = 0;
+    m_free.clear();
+
+    m_file.close();
+
+    return !m_writeFailed && !m_file.fail();
+}
+
+uint64_t tMCUTraceWriter::getRecordCount() const
+{
+    return m_pWrite ? m_recordsWritten + (m_pWrite - &m_buffers[m_currentBuffer][0]) : m_recordsWritten;
+}
+
+void tMCUTraceWriter::nextBuffer()
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    m_fullRecords[m_currentBuffer] = cBufferRecords;
+    m_full.push( m_currentBuffer );
+    m_recordsWritten += cBufferRecords;
+    m_changed.notify_all();
+
+    if( m_free.empty() )
+    {
+        ++m_stalls;
+        m_changed.wait( lock, [this] { return !m_free.empty(); } );
+    }
+
+    m_currentBuffer = m_free.back();
+    m_free.pop_back();
+
+    m_pWrite = &m_buffers[m_currentBuffer][0];
+    m_pWriteEnd = m_pWrite + cBufferRecords;
+}
+
+// Writes each buffer out in one go, without holding the lock
+void tMCUTraceWriter::writerThread()
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    while( true )
+    {
+        m_changed.wait( lock, [this] { return !m_full.empty() || m_closing; } );
+
+        if( m_full.empty() )
+            break;
+
+        unsigned buffer = m_full.front();
+        m_full.pop();
+
+        lock.unlock();
+        m_file.write( reinterpret_cast<const char*>(&m_buffers[buffer][0]), m_fullRecords[buffer] * sizeof(tTraceRecord) );
+        lock.lock();
+
+        if( !m_file )
+            m_writeFailed = true;
+
+        m_free.push_back( buffer );
+        m_changed.notify_all();
+    }
+}
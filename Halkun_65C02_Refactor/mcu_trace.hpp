@@ -2,9 +2,13 @@
 #define MCU_TRACE_HPP
 
 #include <cstdint>
+#include <cstddef>
 #include <queue>
-
-#ifdef DO_MCU_TRACE
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 struct tMemoryTrace
 {
@@ -28,6 +32,116 @@ struct tTraceState
     int regSP;
 };
 
-#endif
+enum eTraceAccess
+{
+    access_Fetch,   // Opcode or operand, through memFetchByte()
+    access_Read,
+    access_Write,
+};
+
+//   One access in a trace file.  The file is a tTraceFileHeader and then these back to back, in the host's byte
+// order.  The PC, opcode and cycle count are the instruction's, as it started.
+struct tTraceRecord
+{
+    uint32_t m_cycle; // Bottom 32 bits of the cycle count...
+    uint16_t m_pc;
+    uint16_t m_address;
+    uint8_t m_opCode;
+    uint8_t m_value;
+    uint8_t m_access; // eTraceAccess
+    uint8_t m_cycleHigh; // ...and the 8 above them
+
+    uint64_t getCycle() const { return m_cycle | (uint64_t(m_cycleHigh) << 32); }
+};
+
+struct tTraceFileHeader
+{
+    static const uint32_t cVersion = 1;
+
+    char m_magic[8]; // "HK65TRCE"
+    uint32_t m_version;
+    uint32_t m_recordSize; // sizeof(tTraceRecord)
+};
+
+//   Streams memory accesses to a file, from tMCUTraceFileBus (mcu_bus.hpp) or tMCUState::pcExecuteTraced().
+//   Records go into one of a few preallocated buffers, and each full buffer is queued for the one writer thread to
+// write out, so the core only ever stops if the disk can't keep up.  Only the accesses inside the ranges
+// given to addFilter() are recorded (everything, if there aren't any), so an uninteresting access costs a bit test.
+class tMCUTraceWriter
+{
+public:
+    static const size_t cBufferRecords  = 1 << 16; // 768k a buffer
+    static const unsigned cBufferCount  = 8;
+
+    tMCUTraceWriter();
+    ~tMCUTraceWriter(); // Closes the file
+
+    // Only records accesses from firstAddress to lastAddress - can be called more than once to add more ranges
+    void addFilter( uint16_t firstAddress, uint16_t lastAddress );
+    void clearFilters();
+
+    // Starts a new trace in the file.  Returns false if it can't be created.
+    bool open( const char *pFileName );
+
+    // Writes out what's left, and waits for it.  Returns false if anything couldn't be written.
+    bool close();
+
+    // The instruction that the following accesses are for
+    void beginInstruction( uint16_t pc, uint8_t opCode, uint64_t cycle )
+    {
+        m_current.m_cycle = static_cast<uint32_t>(cycle);
+        m_current.m_cycleHigh = static_cast<uint8_t>(cycle >> 32);
+        m_current.m_pc = pc;
+        m_current.m_opCode = opCode;
+    }
+
+    // Only while the file is open
+    void record( uint16_t address, uint8_t value, eTraceAccess access )
+    {
+        if( !(m_filter[address >> 3] & (1 << (address & 7))) )
+            return;
+
+        if( m_pWrite == m_pWriteEnd )
+            nextBuffer();
+
+        *m_pWrite = m_current;
+        m_pWrite->m_address = address;
+        m_pWrite->m_value = value;
+        m_pWrite->m_access = static_cast<uint8_t>(access);
+        ++m_pWrite;
+    }
+
+    bool isOpen() const { return m_pWrite != 0; }
+
+    // Accesses recorded since open(), and how many times the core had to wait for a buffer to be written out
+    uint64_t getRecordCount() const;
+    uint64_t getStallCount() const { return m_stalls; }
+
+private:
+    tMCUTraceWriter( const tMCUTraceWriter& ); // Disallowed
+
+    void nextBuffer(); // Hands the current buffer over to be written, and starts on a free one
+    void writerThread();
+
+    uint8_t                     m_filter[65536 / 8]; // A bit for each address that's recorded
+    bool                        m_filtered; // addFilter() has been called - otherwise every bit is set
+    tTraceRecord                m_current; // The instruction's part of the next record
+    tTraceRecord               *m_pWrite; // Next record in the current buffer, or 0 when there's no file open
+    tTraceRecord               *m_pWriteEnd;
+    unsigned                    m_currentBuffer;
+    uint64_t                    m_recordsWritten; // In the buffers handed over so far
+    uint64_t                    m_stalls;
+
+    std::vector< tTraceRecord > m_buffers[cBufferCount];
+    std::ofstream               m_file;
+    std::thread                 m_thread;
+    std::mutex                  m_mutex;
+    std::condition_variable     m_changed; // Signalled by both sides
+    std::queue< unsigned >      m_full; // Buffers waiting to be written, oldest first
+    size_t                      m_fullRecords[cBufferCount]; // How much of each buffer in m_full is used
+    std::vector< unsigned >     m_free;
+    bool                        m_closing;
+    bool                        m_writeFailed;
+};
 
 #endif
@@ -0,0 +1,182 @@
+#include "mcu_core.hpp"
+
+tMCUVia::tMCUVia( tMCUState& rState, unsigned irqSource )
+    : m_rState( rState )
+    , m_irqSource( irqSource )
+    , m_auxControl( 0 )
+    , m_interruptFlags( 0 )
+    , m_interruptEnable( 0 )
+    , m_irqAsserted( false )
+{
+    m_timer1.m_pVia = this;
+    m_timer1.m_flag = cFlagT1;
+    m_timer2.m_pVia = this;
+    m_timer2.m_flag = cFlagT2;
+}
+
+void tMCUVia::reset()
+{
+    m_auxControl = 0;
+    m_interruptFlags = 0;
+    m_interruptEnable = 0;
+    updateIRQ();
+}
+
+uint8_t tMCUVia::read( uint16_t address )
+{
+    switch( address & 0x0F )
+    {
+    case cT1CounterLow:
+        clearFlags( cFlagT1 );
+        return static_cast<uint8_t>(counter( m_timer1 ));
+
+    case cT1CounterHigh:    return static_cast<uint8_t>(counter( m_timer1 ) >> 8);
+    case cT1LatchLow:       return static_cast<uint8_t>(m_timer1.m_latch);
+    case cT1LatchHigh:      return static_cast<uint8_t>(m_timer1.m_latch >> 8);
+
+    case cT2CounterLow:
+        clearFlags( cFlagT2 );
+        return static_cast<uint8_t>(counter( m_timer2 ));
+
+    case cT2CounterHigh:    return static_cast<uint8_t>(counter( m_timer2 ) >> 8);
+    case cAuxControl:       return m_auxControl;
+    case cInterruptFlags:   return m_interruptFlags | ((m_interruptFlags & m_interruptEnable) ? cFlagIRQ : 0);
+    case cInterruptEnable:  return m_interruptEnable | 0x80;
+    }
+
+    return 0;
+}
+
+void tMCUVia::write( uint16_t address, uint8_t data )
+{
+    switch( address & 0x0F )
+    {
+    case cT1CounterLow:
+    case cT1LatchLow:
+        m_timer1.m_latch = (m_timer1.m_latch & 0xFF00) | data;
+        break;
+
+    case cT1CounterHigh:
+        m_timer1.m_latch = static_cast<uint16_t>((m_timer1.m_latch & 0x00FF) | (data << 8));
+        clearFlags( cFlagT1 );
+        startTimer( m_timer1, m_timer1.m_latch );
+        break;
+
+    case cT1LatchHigh:
+        m_timer1.m_latch = static_cast<uint16_t>((m_timer1.m_latch & 0x00FF) | (data << 8));
+        clearFlags( cFlagT1 );
+        break;
+
+    case cT2CounterLow:
+        m_timer2.m_latch = (m_timer2.m_latch & 0xFF00) | data;
+        break;
+
+    case cT2CounterHigh:
+        clearFlags( cFlagT2 );
+        startTimer( m_timer2, static_cast<uint16_t>((m_timer2.m_latch & 0x00FF) | (data << 8)) );
+        break;
+
+    case cAuxControl:
+        m_auxControl = data;
+        break;
+
+    case cInterruptFlags:
+        clearFlags( data & 0x7F );
+        break;
+
+    case cInterruptEnable:
+        if( data & 0x80 )
+            m_interruptEnable |= data & 0x7F;
+        else
+            m_interruptEnable &= ~data;
+
+        updateIRQ();
+        break;
+    }
+}
+
+//   Timer 1 in free running mode goes round again every latch + 2 cycles once it first reaches $FFFF.  That's
+// normally taken care of by timerExpired() moving the start along, but a read can come in ahead of the event
+// (e.g. from translated code, which only fires events between blocks).
+uint16_t tMCUVia::counter( const tTimer& rTimer ) const
+{
+    uint64_t cycle = m_rState.getCycleCount();
+    uint64_t elapsed = cycle > rTimer.m_startCycle ? cycle - rTimer.m_startCycle : 0;
+
+    if( elapsed <= rTimer.m_startValue || &rTimer != &m_timer1 || !(m_auxControl & cAuxT1FreeRun) )
+        return static_cast<uint16_t>(rTimer.m_startValue - elapsed);
+
+    uint64_t periodPos = (elapsed - rTimer.m_startValue - 1) % (uint64_t(rTimer.m_latch) + 2);
+    return periodPos == 0 ? 0xFFFF : static_cast<uint16_t>(rTimer.m_latch + 1 - periodPos);
+}
+
+void tMCUVia::startTimer( tTimer& rTimer, uint16_t value )
+{
+    rTimer.m_startValue = value;
+    rTimer.m_startCycle = m_rState.getCycleCount();
+    m_rState.scheduleEvent( &rTimer, rTimer.m_startCycle + value + 1 );
+}
+
+void tMCUVia::timerExpired( tTimer& rTimer, uint64_t cycle )
+{
+    setFlags( rTimer.m_flag );
+
+    // Reloads from the latch on the cycle after reading $FFFF
+    if( &rTimer == &m_timer1 && (m_auxControl & cAuxT1FreeRun) )
+    {
+        rTimer.m_startValue = rTimer.m_latch;
+        rTimer.m_startCycle = cycle + 1;
+        m_rState.scheduleEvent( &rTimer, rTimer.m_startCycle + rTimer.m_latch + 1 );
+    }
+}
+
+void tMCUVia::updateIRQ()
+{
+    bool asserted = (m_interruptFlags & m_interruptEnable) != 0;
+    if( asserted != m_irqAsserted )
+    {
+        m_irqAsserted = asserted;
+        m_rState.setIRQLine( m_irqSource, asserted );
+    }
+}
+
+void tMCUVia::saveState( tSavedState& rSaved ) const
+{
+    const tTimer *pTimers[2] = { &m_timer1, &m_timer2 };
+    for( unsigned timer = 0; timer < 2; ++timer )
+    {
+        rSaved.m_latch[timer] = pTimers[timer]->m_latch;
+        rSaved.m_startValue[timer] = pTimers[timer]->m_startValue;
+        rSaved.m_startCycle[timer] = pTimers[timer]->m_startCycle;
+        rSaved.m_eventCycle[timer] = m_rState.getEventCycle( pTimers[timer] );
+    }
+
+    rSaved.m_auxControl = m_auxControl;
+    rSaved.m_interruptFlags = m_interruptFlags;
+    rSaved.m_interruptEnable = m_interruptEnable;
+    rSaved.m_irqAsserted = m_irqAsserted;
+}
+
+void tMCUVia::restoreState( const tSavedState& rSaved, bool scheduleEvents )
+{
+    tTimer *pTimers[2] = { &m_timer1, &m_timer2 };
+    for( unsigned timer = 0; timer < 2; ++timer )
+    {
+        pTimers[timer]->m_latch = rSaved.m_latch[timer];
+        pTimers[timer]->m_startValue = rSaved.m_startValue[timer];
+        pTimers[timer]->m_startCycle = rSaved.m_startCycle[timer];
+
+        if( !scheduleEvents )
+            continue;
+
+        if( rSaved.m_eventCycle[timer] != UINT64_MAX )
+            m_rState.scheduleEvent( pTimers[timer], rSaved.m_eventCycle[timer] );
+        else
+            m_rState.cancelEvent( pTimers[timer] );
+    }
+
+    m_auxControl = rSaved.m_auxControl;
+    m_interruptFlags = rSaved.m_interruptFlags;
+    m_interruptEnable = rSaved.m_interruptEnable;
+    m_irqAsserted = rSaved.m_irqAsserted;
+}